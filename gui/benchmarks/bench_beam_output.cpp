@@ -0,0 +1,174 @@
+// Measures the cost of routing BEAM stdout at high line rates. A child copy
+// of this program stands in for the BEAM, printing Elixir Logger-style
+// lines at a fixed rate, and the parent consumes them two ways:
+//
+//   - legacy:   readAllStandardOutput() -> QString::fromUtf8 -> trimmed(),
+//               then one QString copy per consumer (logger, debug pane,
+//               console overlay), per read; partial lines split wherever
+//               the read happened to end
+//   - pipeline: BeamLineSplitter into a batch per event-loop tick, levels
+//               parsed once per line, one decode per stream run
+//
+// Both report lines delivered, time spent in the handlers and the share of
+// one core that represents.
+//
+//   tau5-bench-beam-output [linesPerSec=100000] [seconds=5]
+//
+// linesPerSec=0 prints as fast as the pipe allows.
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QProcess>
+#include <QTextStream>
+#include <QThread>
+#include <QTimer>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include "shared/beam_output.h"
+
+using Tau5Common::BeamLineSplitter;
+using Tau5Common::BeamOutputBatch;
+
+static int emitLines(qint64 linesPerSec, qint64 seconds)
+{
+    static const char* const levels[] = {"info", "debug", "info", "warning", "info"};
+    char line[256];
+    QElapsedTimer clock;
+    clock.start();
+
+    const qint64 total = linesPerSec > 0 ? linesPerSec * seconds : 0;
+    qint64 written = 0;
+    while (linesPerSec > 0 ? written < total : clock.elapsed() < seconds * 1000) {
+        // Write in 1ms slices so the rate is steady rather than bursty
+        qint64 due = linesPerSec > 0 ? qMin(total, linesPerSec * (clock.elapsed() + 1) / 1000) : written + 1000;
+        for (; written < due; ++written) {
+            int n = std::snprintf(line, sizeof(line),
+                                  "12:34:56.%03lld [%s] Elixir.Tau5.Link: tick %lld beat=%lld phase=0.%04lld peers=3\n",
+                                  written % 1000, levels[written % 5], written, written / 4, written % 10000);
+            std::fwrite(line, 1, static_cast<size_t>(n), stdout);
+        }
+        std::fflush(stdout);
+        if (linesPerSec > 0) {
+            qint64 ahead = written * 1000 / linesPerSec - clock.elapsed();
+            if (ahead > 0) {
+                QThread::msleep(static_cast<unsigned long>(ahead));
+            }
+        }
+    }
+    return 0;
+}
+
+struct Result {
+    qint64 lines = 0;
+    qint64 bytes = 0;
+    qint64 handlerNs = 0;
+    qint64 wallMs = 0;
+    qint64 deliveries = 0;
+};
+
+static Result run(const QString& self, qint64 linesPerSec, qint64 seconds, bool pipeline)
+{
+    Result result;
+    QProcess child;
+    BeamLineSplitter splitter(false);
+    BeamOutputBatch pending;
+    bool flushScheduled = false;
+    QString sinkLog, sinkPane, sinkOverlay;  // Stand-ins for the consumers
+    QElapsedTimer handler;
+
+    auto deliver = [&]() {
+        flushScheduled = false;
+        handler.start();
+        BeamOutputBatch batch = std::exchange(pending, BeamOutputBatch());
+        // Logger: one record per level run; pane and overlay: one decode per stream run
+        qsizetype start = 0;
+        while (start < batch.lines.size()) {
+            qsizetype end = start + 1;
+            while (end < batch.lines.size() && batch.lines.at(end).level == batch.lines.at(start).level) {
+                ++end;
+            }
+            sinkLog = batch.joined(start, end);
+            start = end;
+        }
+        batch.forEachStreamRun([&](const QString& text, bool) { sinkPane = text; });
+        sinkOverlay = batch.joined(0, batch.lines.size());
+        result.lines += batch.lines.size();
+        result.deliveries++;
+        result.handlerNs += handler.nsecsElapsed();
+    };
+
+    QObject::connect(&child, &QProcess::readyReadStandardOutput, [&]() {
+        handler.start();
+        if (pipeline) {
+            result.bytes += splitter.readFrom(&child, pending);
+            result.handlerNs += handler.nsecsElapsed();
+            if (!flushScheduled && !pending.isEmpty()) {
+                flushScheduled = true;
+                QTimer::singleShot(0, deliver);
+            }
+            return;
+        }
+
+        QByteArray output = child.readAllStandardOutput();
+        QString text = QString::fromUtf8(output);
+        sinkLog = text.trimmed();
+        sinkPane = text;
+        sinkOverlay = text;
+        result.bytes += output.size();
+        result.lines += output.count('\n');
+        result.deliveries++;
+        result.handlerNs += handler.nsecsElapsed();
+    });
+
+    QElapsedTimer wall;
+    wall.start();
+    child.start(self, {"--emit", QString::number(linesPerSec), QString::number(seconds)});
+    child.waitForStarted();
+    while (child.state() != QProcess::NotRunning) {
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents, 50);
+    }
+    QCoreApplication::processEvents();
+    if (pipeline) {
+        splitter.finish(pending);
+        if (!pending.isEmpty()) {
+            deliver();
+        }
+    }
+    result.wallMs = wall.elapsed();
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc >= 4 && std::strcmp(argv[1], "--emit") == 0) {
+        return emitLines(QByteArray(argv[2]).toLongLong(), QByteArray(argv[3]).toLongLong());
+    }
+
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+
+    qint64 linesPerSec = argc > 1 ? QString(argv[1]).toLongLong() : 100000;
+    qint64 seconds = argc > 2 ? QString(argv[2]).toLongLong() : 5;
+    if (seconds <= 0) {
+        seconds = 5;
+    }
+
+    out << "BEAM stand-in: " << (linesPerSec > 0 ? QString::number(linesPerSec) + " lines/s" : QString("unthrottled"))
+        << " for " << seconds << " s\n\n";
+
+    for (bool pipeline : {false, true}) {
+        Result r = run(QCoreApplication::applicationFilePath(), linesPerSec, seconds, pipeline);
+        double handlerMs = r.handlerNs / 1e6;
+        out << QString("  %1 %2 lines (%3 lines/s)  %4 deliveries  handlers %5 ms (%6% of a core)\n")
+               .arg(pipeline ? "pipeline" : "legacy  ")
+               .arg(r.lines, 9)
+               .arg(r.wallMs > 0 ? r.lines * 1000 / r.wallMs : 0, 8)
+               .arg(r.deliveries, 7)
+               .arg(handlerMs, 8, 'f', 1)
+               .arg(r.wallMs > 0 ? 100.0 * handlerMs / r.wallMs : 0.0, 5, 'f', 1);
+        out.flush();
+    }
+
+    return 0;
+}
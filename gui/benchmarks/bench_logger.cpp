@@ -0,0 +1,77 @@
+// Measures the per-call cost of Tau5Logger for filtered and unfiltered
+// messages, comparing eager QString::arg() formatting with the lazy
+// TAU5_LOGF macros.
+//
+//   tau5-bench-logger [iterations]
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <functional>
+#include "shared/tau5logger.h"
+
+static double nsPerCall(int iterations, const std::function<void(int)>& body)
+{
+    // Warm up so thread-local buffers and file buffers are sized
+    for (int i = 0; i < 1000; ++i) {
+        body(i);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+        body(i);
+    }
+    return static_cast<double>(timer.nsecsElapsed()) / iterations;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    int iterations = argc > 1 ? QString(argv[1]).toInt() : 200000;
+    if (iterations <= 0) {
+        iterations = 200000;
+    }
+
+    QTemporaryDir logDir;
+
+    Tau5LoggerConfig config;
+    config.appName = "bench";
+    config.baseLogDir = logDir.path();
+    config.logFiles = {{"bench.log", "bench", false}};
+    config.consoleEnabled = false;
+    config.minLevel = LogLevel::Info;
+    Tau5Logger::initialize(config);
+
+    Tau5Logger& logger = Tau5Logger::instance();
+    const QString host = "127.0.0.1";
+
+    QTextStream out(stdout);
+    out << "Tau5Logger micro-benchmark (" << iterations << " iterations, minLevel=Info)\n";
+    out << "TAU5_LOG_COMPILE_MIN_LEVEL=" << TAU5_LOG_COMPILE_MIN_LEVEL << "\n\n";
+
+    auto report = [&out](const char* name, double ns) {
+        out << QString("  %1 %2 ns/call\n").arg(name, -36).arg(ns, 10, 'f', 1);
+    };
+
+    report("filtered   debug() + QString::arg", nsPerCall(iterations, [&](int i) {
+        logger.debug(QString("Heartbeat #%1 sent to %2 (bytes: %3)").arg(i).arg(host).arg(42));
+    }));
+
+    report("filtered   TAU5_LOGF_DEBUG", nsPerCall(iterations, [&](int i) {
+        TAU5_LOGF_DEBUG("Heartbeat #{} sent to {} (bytes: {})", i, host, 42);
+    }));
+
+    report("unfiltered info() + QString::arg", nsPerCall(iterations, [&](int i) {
+        logger.info(QString("Heartbeat #%1 sent to %2 (bytes: %3)").arg(i).arg(host).arg(42));
+    }));
+
+    report("unfiltered TAU5_LOGF_INFO", nsPerCall(iterations, [&](int i) {
+        TAU5_LOGF_INFO("Heartbeat #{} sent to {} (bytes: {})", i, host, 42);
+    }));
+
+    logger.flush();
+    out.flush();
+    return 0;
+}
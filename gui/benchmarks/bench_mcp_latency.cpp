@@ -0,0 +1,143 @@
+// Measures MCP round-trip latency through tau5-spectra's stdin/stdout pipes:
+// time from writing a tools/list request to reading its response line.
+//
+//   tau5-bench-mcp-latency [iterations=500] [path/to/tau5-spectra]
+//
+// tau5-spectra is looked up next to this executable and one directory up
+// (the default build layout) when no path is given.
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QTextStream>
+#include <QThread>
+#include <QVector>
+#include <algorithm>
+
+static QString findSpectra(const QString& explicitPath)
+{
+    if (!explicitPath.isEmpty()) {
+        return explicitPath;
+    }
+#ifdef Q_OS_WIN
+    const QString name = "tau5-spectra.exe";
+#else
+    const QString name = "tau5-spectra";
+#endif
+    QDir dir(QCoreApplication::applicationDirPath());
+    for (const QString& candidate : {dir.filePath(name), dir.filePath("../" + name)}) {
+        if (QFileInfo(candidate).isExecutable()) {
+            return QFileInfo(candidate).canonicalFilePath();
+        }
+    }
+    return QString();
+}
+
+// Writes one request and blocks until the matching response line arrives
+static bool roundTrip(QProcess& process, int id, const char* method, QByteArray& pending)
+{
+    QJsonObject request{
+        {"jsonrpc", "2.0"},
+        {"id", id},
+        {"method", method},
+        {"params", QJsonObject{}}
+    };
+    process.write(QJsonDocument(request).toJson(QJsonDocument::Compact) + "\n");
+
+    for (;;) {
+        qsizetype newline;
+        while ((newline = pending.indexOf('\n')) >= 0) {
+            QByteArray line = pending.left(newline);
+            pending.remove(0, newline + 1);
+            QJsonObject response = QJsonDocument::fromJson(line).object();
+            if (response.value("id").toInt(-1) == id) {
+                return true;
+            }
+        }
+        if (!process.waitForReadyRead(10000)) {
+            return false;
+        }
+        pending += process.readAllStandardOutput();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+
+    int iterations = argc > 1 ? QString(argv[1]).toInt() : 500;
+    if (iterations <= 0) {
+        iterations = 500;
+    }
+
+    QString spectraPath = findSpectra(argc > 2 ? QString(argv[2]) : QString());
+    if (spectraPath.isEmpty()) {
+        out << "tau5-spectra not found; pass its path as the second argument "
+               "(configure with -DBUILD_MCP_SERVER=ON)\n";
+        return 1;
+    }
+
+    QProcess process;
+    process.setProcessChannelMode(QProcess::SeparateChannels);
+    process.setStandardErrorFile(QProcess::nullDevice());
+    process.start(spectraPath, QStringList());
+    if (!process.waitForStarted(5000)) {
+        out << "Failed to start " << spectraPath << "\n";
+        return 1;
+    }
+
+    QByteArray pending;
+    if (!roundTrip(process, 0, "initialize", pending)) {
+        out << "No response to initialize\n";
+        return 1;
+    }
+
+    // Let the server's pre-emptive DevTools connection attempt settle so it
+    // doesn't land in the measured window
+    QThread::msleep(1500);
+    pending += process.readAllStandardOutput();
+
+    for (int i = 0; i < 20; ++i) {
+        roundTrip(process, 1 + i, "tools/list", pending);
+    }
+
+    QVector<double> samples;
+    samples.reserve(iterations);
+    QElapsedTimer timer;
+    for (int i = 0; i < iterations; ++i) {
+        timer.start();
+        if (!roundTrip(process, 100 + i, "tools/list", pending)) {
+            out << "Timed out waiting for response " << i << "\n";
+            break;
+        }
+        samples.append(static_cast<double>(timer.nsecsElapsed()) / 1000.0);
+    }
+
+    process.closeWriteChannel();
+    process.waitForFinished(5000);
+
+    if (samples.isEmpty()) {
+        return 1;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&samples](double p) {
+        return samples.at(qMin(samples.size() - 1, static_cast<qsizetype>(p * samples.size())));
+    };
+    double total = 0;
+    for (double sample : samples) {
+        total += sample;
+    }
+
+    out << "tools/list round trip over stdio (" << samples.size() << " requests)\n";
+    out << QString("  min    %1 us\n").arg(samples.first(), 10, 'f', 1);
+    out << QString("  mean   %1 us\n").arg(total / samples.size(), 10, 'f', 1);
+    out << QString("  p50    %1 us\n").arg(percentile(0.50), 10, 'f', 1);
+    out << QString("  p99    %1 us\n").arg(percentile(0.99), 10, 'f', 1);
+    out << QString("  max    %1 us\n").arg(samples.last(), 10, 'f', 1);
+    return 0;
+}
@@ -0,0 +1,161 @@
+// Compares log search strategies on a synthetic Tau5 session log:
+//
+//   - QTextStream::readLine() + QString::contains / QRegularExpression
+//     (how tau5_logs_search worked before the sidecar index)
+//   - LogIndexReader::line() + QString::contains / QRegularExpression
+//     (decode every line from the mapped log)
+//   - LogSearch::matchingLines() (byte-level prefilter, no decoding)
+//
+// Every strategy scans the whole file and reports its match count, which
+// must agree across strategies.
+//
+//   tau5-bench-search [sizeMB=1024] [logPath]
+//
+// Without logPath a log of sizeMB is generated in a temporary directory.
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRegularExpression>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <climits>
+#include <functional>
+#include "shared/log_index.h"
+#include "shared/log_search.h"
+
+static void generateLog(const QString& path, qint64 targetBytes)
+{
+    static const char* const categories[] = {"beam", "gui", "server", "mcp", "debug-pane"};
+    static const char* const levels[] = {"DEBUG", "INFO", "INFO", "INFO", "WARN"};
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    QDateTime timestamp = QDateTime::currentDateTime().addDays(-1);
+    QByteArray chunk;
+    chunk.reserve(4 * 1024 * 1024);
+    qint64 written = 0;
+    qint64 line = 0;
+    while (written < targetBytes) {
+        QByteArray prefix = timestamp.toString("yyyy-MM-dd HH:mm:ss.zzz").toUtf8();
+        if (line % 100000 == 99999) {
+            chunk += prefix + " [ERROR] [beam] Connection refused by upstream 127.0.0.1:4000 (attempt "
+                     + QByteArray::number(line / 100000) + ")\n";
+        } else {
+            chunk += prefix + " [" + levels[line % 5] + "] [" + categories[line % 5]
+                     + "] Heartbeat #" + QByteArray::number(line) + " sent to 127.0.0.1 (bytes: "
+                     + QByteArray::number(40 + line % 17) + ") - all systems nominal\n";
+        }
+        ++line;
+        if (line % 50 == 0) {
+            timestamp = timestamp.addMSecs(7);
+        }
+        if (chunk.size() >= 4 * 1024 * 1024) {
+            file.write(chunk);
+            written += chunk.size();
+            chunk.clear();
+        }
+    }
+    file.write(chunk);
+}
+
+struct Query {
+    const char* name;
+    QString pattern;
+    bool isRegex;
+    Qt::CaseSensitivity cs;
+};
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+
+    qint64 sizeMb = argc > 1 ? QString(argv[1]).toLongLong() : 1024;
+    if (sizeMb <= 0) {
+        sizeMb = 1024;
+    }
+
+    QTemporaryDir tempDir;
+    QString logPath = argc > 2 ? QString(argv[2]) : tempDir.filePath("gui.log");
+    if (!QFile::exists(logPath)) {
+        out << "Generating " << sizeMb << " MB synthetic log at " << logPath << "\n";
+        out.flush();
+        generateLog(logPath, sizeMb * 1024 * 1024);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    Tau5Common::LogIndexReader reader;
+    if (!reader.open(logPath)) {
+        out << "Failed to open " << logPath << "\n";
+        return 1;
+    }
+    const double sizeMbActual = static_cast<double>(reader.size()) / (1024 * 1024);
+    out << QString("Opened %1 MB, %2 lines in %3 ms (%4)\n\n")
+           .arg(sizeMbActual, 0, 'f', 1)
+           .arg(reader.lineCount())
+           .arg(timer.elapsed())
+           .arg(reader.usedSidecar() ? "sidecar index" : "indexed in memory");
+
+    const Query queries[] = {
+        {"literal, rare, case-sensitive", "Connection refused", false, Qt::CaseSensitive},
+        {"literal, rare, case-insensitive", "connection REFUSED", false, Qt::CaseInsensitive},
+        {"literal, common, case-insensitive", "heartbeat #4242", false, Qt::CaseInsensitive},
+        {"regex with literal prefix", "refused by \\S+:\\d+", true, Qt::CaseSensitive},
+        {"regex without literal prefix", "(attempt|retry) 1\\d\\)", true, Qt::CaseInsensitive},
+    };
+
+    auto report = [&](const char* strategy, qint64 ms, qint64 matches) {
+        double mbPerSec = ms > 0 ? sizeMbActual * 1000.0 / ms : 0.0;
+        out << QString("    %1 %2 ms %3 MB/s  %4 matches\n")
+               .arg(strategy, -28).arg(ms, 7).arg(mbPerSec, 8, 'f', 0).arg(matches);
+        out.flush();
+    };
+
+    for (const Query& query : queries) {
+        out << "  " << query.name << ": \"" << query.pattern << "\"\n";
+
+        QRegularExpression regex(query.pattern, query.cs == Qt::CaseInsensitive
+                                 ? QRegularExpression::CaseInsensitiveOption
+                                 : QRegularExpression::NoPatternOption);
+        auto lineMatches = [&](const QString& line) {
+            return query.isRegex ? regex.match(line).hasMatch() : line.contains(query.pattern, query.cs);
+        };
+
+        timer.restart();
+        qint64 count = 0;
+        QFile file(logPath);
+        if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            QTextStream in(&file);
+            while (!in.atEnd()) {
+                if (lineMatches(in.readLine())) {
+                    ++count;
+                }
+            }
+        }
+        report("QTextStream::readLine", timer.elapsed(), count);
+
+        timer.restart();
+        count = 0;
+        for (qint64 i = 0; i < reader.lineCount(); ++i) {
+            if (lineMatches(reader.line(i))) {
+                ++count;
+            }
+        }
+        report("LogIndexReader::line", timer.elapsed(), count);
+
+        Tau5Common::LogSearch search = query.isRegex
+            ? Tau5Common::LogSearch::regex(query.pattern, query.cs)
+            : Tau5Common::LogSearch::literal(query.pattern, query.cs);
+        timer.restart();
+        count = search.matchingLines(reader, 0, reader.lineCount(), INT_MAX).size();
+        report("LogSearch::matchingLines", timer.elapsed(), count);
+    }
+
+    return 0;
+}
@@ -33,6 +33,7 @@
 #include "shared/qt_message_handler.h"
 #include "shared/server_info.h"
 #include "shared/cli_help.h"
+#include "shared/startup_trace.h"
 #include "styles/StyleManager.h"
 
 using namespace Tau5Common;
@@ -229,6 +230,9 @@ bool initializeApplication(QApplication &app, const Tau5CLI::CommonArgs &args)
 
 int main(int argc, char *argv[])
 {
+  // Starts the startup trace clock
+  StartupTrace::start("tau5").begin("args");
+
   // Enforce release settings before anything else
   Tau5CLI::enforceReleaseSettings();
 
@@ -324,6 +328,7 @@ int main(int argc, char *argv[])
   setupConsoleOutput();
 
   Tau5CLI::ServerConfig serverConfig(args, "tau5-gui");
+  StartupTrace::instance().end("args");
 
   Tau5Common::ChromeCDP::configure(args.chromeDevtools, serverConfig.getChromePort());
 
@@ -380,7 +385,12 @@ int main(int argc, char *argv[])
   }
 
   // Initialize logger for normal operation (not health check)
+  // Move file/console I/O off the GUI thread so a chatty BEAM can't stall the UI
+  logConfig.asyncWriter = true;
+  logConfig.writeLineIndex = true;  // Lets tau5_logs_search skip straight to lines
+  StartupTrace::instance().begin("logger.init");
   Tau5Logger::initialize(logConfig);
+  StartupTrace::instance().end("logger.init");
   Tau5Logger::instance().info("Starting Tau5...");
 
   if (isGuiDevMode)
@@ -408,6 +418,7 @@ int main(int argc, char *argv[])
   QCoreApplication::setAttribute(Qt::AA_UseDesktopOpenGL, true);
 #endif
 
+  StartupTrace::instance().begin("qt.init");
   QApplication app(argc, argv);
 
   if (!initializeApplication(app, args))
@@ -415,8 +426,10 @@ int main(int argc, char *argv[])
     QMessageBox::critical(nullptr, "Error", "Failed to initialize application");
     return 1;
   }
+  StartupTrace::instance().end("qt.init");
 
   // Check if required ports are available before starting services
+  StartupTrace::instance().begin("port.checks");
   QStringList portsInUse;
 
   // Check MCP port if enabled
@@ -454,6 +467,7 @@ int main(int argc, char *argv[])
     QMessageBox::critical(nullptr, "Port Conflict", errorMsg);
     return 1;
   }
+  StartupTrace::instance().end("port.checks");
 
   Tau5Logger::instance().info(QString("Using port: %1").arg(port));
 
@@ -528,8 +542,22 @@ int main(int argc, char *argv[])
   }
 #endif
 
+  // Boot the BEAM first so it comes up while WebEngine and the main window
+  // initialise; its output is delivered from the event loop, so nothing is
+  // missed before setBeamInstance()
+  if (args.verbose || isGuiDevMode) {
+    Tau5Logger::instance().info("Starting BEAM server...");
+  }
+
+  StartupTrace::instance().begin("beam.construct");
+  std::shared_ptr<Beam> beam = std::make_shared<Beam>(&app, serverConfig, basePath, Tau5Common::Config::APP_NAME,
+                                                       Tau5Common::Config::APP_VERSION, port);
+  StartupTrace::instance().end("beam.construct");
+
   // Map CLI arguments to mainwindow constructor parameters
+  StartupTrace::instance().begin("mainwindow");
   MainWindow mainWindow(serverConfig);
+  StartupTrace::instance().end("mainwindow");
 
   if (args.debugPane) {
     QObject::connect(&Tau5Logger::instance(), &Tau5Logger::logMessage,
@@ -568,13 +596,6 @@ int main(int argc, char *argv[])
   Tau5Logger::instance().info("Debug pane not included in build");
 #endif
 
-  if (args.verbose || isGuiDevMode) {
-    Tau5Logger::instance().info("Starting BEAM server...");
-  }
-
-  std::shared_ptr<Beam> beam = std::make_shared<Beam>(&app, serverConfig, basePath, Tau5Common::Config::APP_NAME,
-                                                       Tau5Common::Config::APP_VERSION, port);
-
   mainWindow.setBeamInstance(beam.get());
 
   if (args.verbose) {
@@ -633,6 +654,8 @@ int main(int argc, char *argv[])
   }
 
   QObject::connect(beam.get(), &Beam::otpReady, [&mainWindow, &args, &serverConfig, &serverInfo, &beam, cmdLineArgs]() {
+      StartupTrace::instance().instant("otp.ready");
+
       // Get the actual allocated port from BEAM
       quint16 actualPort = beam->getPort();
 
@@ -29,6 +29,7 @@
 #include "shared/beam.h"
 #include "shared/tau5logger.h"
 #include "shared/cli_args.h"
+#include "shared/startup_trace.h"
 #include "styles/StyleManager.h"
 
 #ifndef Q_OS_MACOS
@@ -272,6 +273,14 @@ MainWindow::MainWindow(const Tau5CLI::ServerConfig& config, QWidget *parent)
     if (!m_mainWindowLoaded) {
       m_mainWindowLoaded = true;
       Tau5Logger::instance().info( "Shader page loaded and ready");
+      Tau5Common::StartupTrace::instance().end("shader.load");
+
+      // Show the shader only while there is something to wait for; if the
+      // BEAM beat it, /app loads behind the still-opaque overlay instead
+      if (!m_beamReady && transitionOverlay) {
+        m_shaderRevealed = true;
+        transitionOverlay->fadeOut(1000);
+      }
       checkAllComponentsLoaded();
     }
   });
@@ -282,6 +291,7 @@ MainWindow::MainWindow(const Tau5CLI::ServerConfig& config, QWidget *parent)
     initializeWebViewConnections();
   });
 
+  Tau5Common::StartupTrace::instance().begin("shader.load");
   phxWidget->loadShaderPage();
 
   // Console overlay must be a direct child of MainWindow to appear above transition overlay
@@ -305,11 +315,6 @@ MainWindow::MainWindow(const Tau5CLI::ServerConfig& config, QWidget *parent)
     transitionOverlay->activateWindow();
   }
   
-  QTimer::singleShot(1000, [this]() {
-    if (transitionOverlay) {
-      transitionOverlay->fadeOut(1000);
-    }
-  });
 
   #ifdef BUILD_WITH_DEBUG_PANE
   if (m_enableDebugPane) {
@@ -353,6 +358,10 @@ void MainWindow::setBeamInstance(Beam *beam)
               consoleOverlay.get(), &ConsoleOverlay::appendLog);
       connect(beamInstance, &Beam::standardError,
               consoleOverlay.get(), &ConsoleOverlay::appendLog);
+      connect(beamInstance, &Beam::outputBatch, consoleOverlay.get(),
+              [overlay = consoleOverlay.get()](const Tau5Common::BeamOutputBatch &batch) {
+        overlay->appendLog(batch.joined(0, batch.lines.size()));
+      });
     }
     
 #ifdef BUILD_WITH_DEBUG_PANE
@@ -361,6 +370,8 @@ void MainWindow::setBeamInstance(Beam *beam)
               this, &MainWindow::handleBeamOutput);
       connect(beamInstance, &Beam::standardError,
               this, &MainWindow::handleBeamError);
+      connect(beamInstance, &Beam::outputBatch,
+              this, &MainWindow::handleBeamOutputBatch);
     }
 #endif
   }
@@ -431,31 +442,29 @@ void MainWindow::startTransitionToApp()
   }
 
   qint64 elapsedMs = bootStartTime.msecsTo(QDateTime::currentDateTime());
-  qint64 minDisplayMs = 1500;  // Just enough to see the shader, not so long it feels slow
-  qint64 remainingMs = qMax(0LL, minDisplayMs - elapsedMs);
-
-  Tau5Logger::instance().info( QString("Boot elapsed: %1ms, waiting %2ms before transition").arg(elapsedMs).arg(remainingMs));
-
-  QTimer::singleShot(remainingMs, [this]() {
-    Tau5Logger::instance().info( "Starting transition - fading to black");
-
-    m_appPageReadyReceived = false;
-    m_fadeToBlackComplete = false;
+  m_appPageReadyReceived = false;
+  m_fadeToBlackComplete = false;
+  Tau5Common::StartupTrace::instance().begin("transition.fade_to_black");
+
+  // Never revealed: the overlay is still opaque, so load /app straight away
+  if (!m_shaderRevealed || !transitionOverlay) {
+    Tau5Logger::instance().info(QString("Boot elapsed: %1ms, shader not shown - loading /app directly").arg(elapsedMs));
+    onFadeToBlackComplete();
+    return;
+  }
 
-    // Just fade to black - don't load /app yet
-    if (transitionOverlay) {
-      transitionOverlay->fadeIn(500);
+  Tau5Logger::instance().info(QString("Boot elapsed: %1ms, starting transition - fading to black").arg(elapsedMs));
 
-      connect(transitionOverlay.get(), &TransitionOverlay::fadeInComplete,
-              this, &MainWindow::onFadeToBlackComplete, Qt::SingleShotConnection);
-    }
+  // Just fade to black - don't load /app yet
+  transitionOverlay->fadeIn(500);
+  connect(transitionOverlay.get(), &TransitionOverlay::fadeInComplete,
+          this, &MainWindow::onFadeToBlackComplete, Qt::SingleShotConnection);
 
-    // Ensure console stays above transition during fade
-    if (consoleOverlay) {
-      consoleOverlay->raise();
-      consoleOverlay->show();
-    }
-  });
+  // Ensure console stays above transition during fade
+  if (consoleOverlay) {
+    consoleOverlay->raise();
+    consoleOverlay->show();
+  }
 }
 
 void MainWindow::onFadeToBlackComplete()
@@ -463,6 +472,8 @@ void MainWindow::onFadeToBlackComplete()
   qint64 fadeElapsed = bootStartTime.msecsTo(QDateTime::currentDateTime());
   Tau5Logger::instance().info(QString("Fade to black complete at T+%1ms - now loading /app while hidden").arg(fadeElapsed));
   m_fadeToBlackComplete = true;
+  Tau5Common::StartupTrace::instance().end("transition.fade_to_black");
+  Tau5Common::StartupTrace::instance().begin("app.load");
 
   // Keep console overlay visible on top during page load
   if (consoleOverlay) {
@@ -500,6 +511,7 @@ void MainWindow::onAppPageReady()
   qint64 totalElapsed = bootStartTime.msecsTo(QDateTime::currentDateTime());
   Tau5Logger::instance().info(QString("App page ready (LiveView mounted) at T+%1ms - fading in to reveal /app").arg(totalElapsed));
   m_appPageReadyReceived = true;
+  Tau5Common::StartupTrace::instance().end("app.load");
 
   // Page is loaded and ready, fade in to reveal it
   startFadeOut();
@@ -512,11 +524,15 @@ void MainWindow::startFadeOut()
   if (transitionOverlay) {
     transitionOverlay->fadeOut(600);
 
+    Tau5Common::StartupTrace::instance().begin("transition.reveal");
     connect(transitionOverlay.get(), &TransitionOverlay::fadeOutComplete, this, [this]() {
       Tau5Logger::instance().info( "Transition complete, cleaning up overlay");
       if (transitionOverlay) {
         transitionOverlay->hide();
       }
+      // The app is on screen: startup is over
+      Tau5Common::StartupTrace::instance().end("transition.reveal");
+      Tau5Common::StartupTrace::instance().finish(m_config->getArgs().verbose);
     }, Qt::SingleShotConnection);
   }
   
@@ -533,6 +549,8 @@ void MainWindow::startFadeOut()
                   consoleOverlay.get(), &ConsoleOverlay::appendLog);
         disconnect(beamInstance, &Beam::standardError,
                   consoleOverlay.get(), &ConsoleOverlay::appendLog);
+        disconnect(beamInstance, &Beam::outputBatch,
+                  consoleOverlay.get(), nullptr);
       }
     }, Qt::SingleShotConnection);
   }
@@ -696,6 +714,19 @@ void MainWindow::handleBeamError(const QString &error)
 #endif
 }
 
+void MainWindow::handleBeamOutputBatch(const Tau5Common::BeamOutputBatch &batch)
+{
+#ifdef BUILD_WITH_DEBUG_PANE
+  if (debugPane) {
+    batch.forEachStreamRun([this](const QString &text, bool isError) {
+      debugPane->appendOutput(text, isError);
+    });
+  }
+#else
+  Q_UNUSED(batch);
+#endif
+}
+
 void MainWindow::handleBootLog(const QString &message, bool isError)
 {
 #ifdef BUILD_WITH_DEBUG_PANE
@@ -900,7 +931,7 @@ void MainWindow::handleBeamRestart()
   m_allComponentsSignalEmitted = false;
   
   QObject *context = new QObject();
-  connect(beamInstance, &Beam::restartComplete, context, [this, context]() {
+  connect(beamInstance, &Beam::restartComplete, context, [this, context](bool success, qint64 latencyMs) {
     Tau5Logger::instance().info( "BEAM restart complete, reconnecting to server...");
     
     if (debugPane)
@@ -908,7 +939,9 @@ void MainWindow::handleBeamRestart()
       debugPane->setRestartButtonEnabled(true);
       
       QString separator = "\n" + QString("=").repeated(60) + "\n";
-      debugPane->appendOutput(separator + "       BEAM RESTART COMPLETE!" + separator, false);
+      QString status = success ? QString("BEAM RESTART COMPLETE! (%1ms)").arg(latencyMs)
+                               : QString("BEAM RESTART FAILED (after %1ms)").arg(latencyMs);
+      debugPane->appendOutput(separator + "       " + status + separator, false);
     }
     
     // Since we're reusing the session token, we don't need to reset the main browser
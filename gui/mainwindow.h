@@ -9,6 +9,8 @@
 #include <winsock2.h>
 #endif
 
+#include "shared/beam_output.h"
+
 class MainPhxWidget;
 #ifdef BUILD_WITH_DEBUG_PANE
 class DebugPane;
@@ -65,6 +67,7 @@ private slots:
   void showAbout() const;
   void handleBeamOutput(const QString &output);
   void handleBeamError(const QString &error);
+  void handleBeamOutputBatch(const Tau5Common::BeamOutputBatch &batch);
   void handleSizeDown();
   void handleSizeUp();
   void handleOpenExternalBrowser();
@@ -123,6 +126,7 @@ private:
   int m_channel;
   bool m_appPageReadyReceived;
   bool m_fadeToBlackComplete;
+  bool m_shaderRevealed = false;  // Initial overlay faded out to show the shader
 
   static constexpr int DEBUG_PANE_RESTORE_DELAY_MS = 500;
 };
\ No newline at end of file
@@ -7,8 +7,6 @@
 #include <QOperatingSystemVersion>
 #include <QCoreApplication>
 #include <QTimer>
-#include <QRegularExpression>
-#include <QThread>
 #include <QUuid>
 #include <QHostAddress>
 #include <QTcpServer>
@@ -16,16 +14,22 @@
 #include <QtConcurrent/QtConcurrent>
 #include <QStandardPaths>
 #include <QCryptographicHash>
+#include <QElapsedTimer>
 #include "tau5logger.h"
 #include "error_codes.h"
 #include "cli_args.h"
 #include "common.h"
+#include "process_control.h"
+#include "control_channel.h"
+#include "startup_trace.h"
+#include <string_view>
+#include <utility>
 
 using namespace Tau5Common;
 
 Beam::Beam(QObject *parent, const Tau5CLI::ServerConfig& config, const QString &basePath, const QString &appName, const QString &version, quint16 port)
     : QObject(parent), appBasePath(basePath), process(new QProcess(this)),
-      beamPid(0), heartbeatPort(0), serverReady(false), otpTreeReady(false),
+      beamPid(0), serverReady(false), otpTreeReady(false),
       appName(appName), appVersion(version), isRestarting(false),
       m_config(&config)
 {
@@ -57,9 +61,17 @@ Beam::Beam(QObject *parent, const Tau5CLI::ServerConfig& config, const QString &
   QRandomGenerator::system()->fillRange(buffer, 16);
   memcpy(randomBytes.data(), buffer, 64);
   secretKeyBase = randomBytes.toBase64();
-  heartbeatSocket = new QUdpSocket(this);
   heartbeatEnabled = true;
 
+  // Readiness, startup errors, metrics and heartbeats all go over the
+  // control channel, so stdout carries nothing but log output
+  controlChannel = new ControlChannel(heartbeatToken, this);
+  if (!controlChannel->listen()) {
+    Tau5Logger::instance().error("FATAL: Could not open the control channel to the BEAM");
+    QCoreApplication::exit(static_cast<int>(ExitCode::HEARTBEAT_PORT_FAILED));
+  }
+  connectControlChannel(controlChannel);
+
   connect(process, &QProcess::readyReadStandardOutput,
           this, &Beam::handleStandardOutput);
   connect(process, &QProcess::readyReadStandardError,
@@ -73,9 +85,33 @@ Beam::Beam(QObject *parent, const Tau5CLI::ServerConfig& config, const QString &
   heartbeatTimer->setTimerType(Qt::CoarseTimer);
   connect(heartbeatTimer, &QTimer::timeout, this, &Beam::sendHeartbeat);
   
-  Tau5Logger::instance().debug(QString("Heartbeat timer configured: interval=%1ms, single-shot=%2")
-                                .arg(heartbeatTimer->interval())
-                                .arg(heartbeatTimer->isSingleShot() ? "true" : "false"));
+  TAU5_LOGF_DEBUG("Heartbeat timer configured: interval={}ms, single-shot={}",
+                  heartbeatTimer->interval(), heartbeatTimer->isSingleShot());
+
+  QString graceStr = qEnvironmentVariable("TAU5_BEAM_SHUTDOWN_GRACE_MS");
+  shutdownGraceMs = graceStr.isEmpty() ? ProcessControl::DEFAULT_GRACE_MS : graceStr.toInt();
+  if (shutdownGraceMs < 0) shutdownGraceMs = ProcessControl::DEFAULT_GRACE_MS;
+
+  // Hot standby: a second BEAM, booted but holding no ports, that restart()
+  // promotes instead of cold-booting a new one. Costs a second VM's memory.
+  QString standbyStr = qEnvironmentVariable("TAU5_BEAM_STANDBY");
+  standbyEnabled = (standbyStr == "1" || standbyStr == "true" || standbyStr == "yes");
+  if (standbyEnabled)
+  {
+    standbyChannel = new ControlChannel(heartbeatToken, this);
+    if (standbyChannel->listen())
+    {
+      connectControlChannel(standbyChannel);
+      Tau5Logger::instance().info("Hot standby enabled, restarts will promote a pre-booted BEAM");
+    }
+    else
+    {
+      Tau5Logger::instance().warning("Could not open a control channel for the standby BEAM, restarts will cold start");
+      delete standbyChannel;
+      standbyChannel = nullptr;
+      standbyEnabled = false;
+    }
+  }
 
   if (devMode)
   {
@@ -126,9 +162,7 @@ Beam::~Beam()
     heartbeatTimer->stop();
   }
 
-  if (heartbeatSocket) {
-    heartbeatSocket->deleteLater();
-  }
+  stopStandby();
 
   if (beamPid > 0)
   {
@@ -153,113 +187,194 @@ Beam::~Beam()
 
 void Beam::handleStandardOutput()
 {
-  QByteArray output = process->readAllStandardOutput();
-  QString outputStr = QString::fromUtf8(output);
+  process->setReadChannel(QProcess::StandardOutput);
+  stdoutSplitter.readFrom(process, pendingOutput);
+  scheduleOutputFlush();
+}
+
+void Beam::handleStandardError()
+{
+  process->setReadChannel(QProcess::StandardError);
+  stderrSplitter.readFrom(process, pendingOutput);
+  scheduleOutputFlush();
+}
 
-  if (Tau5Logger::isInitialized() && !outputStr.trimmed().isEmpty()) {
-    Tau5Logger::instance().log(LogLevel::Info, "beam", outputStr.trimmed());
+void Beam::scheduleOutputFlush()
+{
+  // However many reads arrive in one event-loop tick, consumers see one batch
+  if (!outputFlushScheduled && !pendingOutput.isEmpty()) {
+    outputFlushScheduled = true;
+    QMetaObject::invokeMethod(this, &Beam::flushOutput, Qt::QueuedConnection);
   }
+}
 
-  // Check for error messages first
-  QRegularExpression serverErrorRegex("\\[TAU5_SERVER_ERROR:(.+)\\]");
-  QRegularExpressionMatch serverErrorMatch = serverErrorRegex.match(outputStr);
-  
-  if (serverErrorMatch.hasMatch())
-  {
-    QString errorMessage = serverErrorMatch.captured(1);
-    QString fullErrorMessage = QString("Server startup failed: %1").arg(errorMessage);
-    QString logPath = Tau5Logger::instance().currentSessionPath();
-
-    // Log to Tau5Logger
-    Tau5Logger::instance().error(fullErrorMessage);
-
-    // CRITICAL: Print detailed error to stderr for visibility
-    std::cerr << "\n========================================\n";
-    std::cerr << "FATAL: Server Startup Error\n";
-    std::cerr << "========================================\n";
-    std::cerr << "Error: " << errorMessage.toStdString() << "\n\n";
-    std::cerr << "Logs: " << logPath.toStdString() << "\n";
-    std::cerr << "========================================\n" << std::endl;
-
-    // Emit signal for GUI mode
-    emit standardError(fullErrorMessage);
-
-    // Exit with appropriate error code
-    if (errorMessage.contains("port") && errorMessage.contains("in use")) {
-      QCoreApplication::exit(static_cast<int>(ExitCode::PORT_IN_USE));
-    } else if (errorMessage.contains("heartbeat")) {
-      QCoreApplication::exit(static_cast<int>(ExitCode::HEARTBEAT_PORT_FAILED));
-    } else {
-      QCoreApplication::exit(static_cast<int>(ExitCode::BEAM_START_FAILED));
-    }
+void Beam::flushOutput()
+{
+  outputFlushScheduled = false;
+  if (pendingOutput.isEmpty()) {
     return;
   }
-  
-  QRegularExpression serverInfoRegex("\\[TAU5_SERVER_INFO:PID=(\\d+),HTTP_PORT=(\\d+),HEARTBEAT_PORT=(\\d+),MCP_PORT=(\\d+)\\]");
-  QRegularExpressionMatch serverInfoMatch = serverInfoRegex.match(outputStr);
-  
-  if (serverInfoMatch.hasMatch())
-  {
-    beamPid = serverInfoMatch.captured(1).toLongLong();
-    quint16 actualPort = serverInfoMatch.captured(2).toUInt();
-    quint16 receivedHeartbeatPort = serverInfoMatch.captured(3).toUInt();
-    quint16 receivedMcpPort = serverInfoMatch.captured(4).toUInt();
-
-    Tau5Logger::instance().debug(QString("Captured server info - PID: %1, HTTP: %2, Heartbeat: %3, MCP: %4")
-      .arg(beamPid).arg(actualPort).arg(receivedHeartbeatPort).arg(receivedMcpPort));
-
-    if (actualPort > 0) {
-      appPort = actualPort;
+  BeamOutputBatch batch = std::exchange(pendingOutput, BeamOutputBatch());
+
+  // One log record per run of lines sharing a level, not one per line
+  qsizetype start = 0;
+  while (start < batch.lines.size()) {
+    LogLevel level = batch.lines.at(start).level;
+    qsizetype end = start + 1;
+    while (end < batch.lines.size() && batch.lines.at(end).level == level) {
+      ++end;
     }
-    
-    if (receivedHeartbeatPort > 0 && heartbeatEnabled) {
-      heartbeatPort = receivedHeartbeatPort;
-      Tau5Logger::instance().info(QString("Using BEAM-allocated heartbeat port: %1").arg(heartbeatPort));
-    } else if (heartbeatEnabled && receivedHeartbeatPort == 0) {
-      Tau5Logger::instance().error("FATAL: Heartbeat enabled but no port received from BEAM");
-      emit standardError("Server failed to allocate heartbeat port");
-      QCoreApplication::exit(static_cast<int>(ExitCode::HEARTBEAT_PORT_FAILED));
-      return;
+    if (Tau5Logger* logger = Tau5Logger::enabledFor(level)) {
+      QString text = batch.joined(start, end).trimmed();
+      if (!text.isEmpty()) {
+        logger->log(level, "beam", text);
+      }
     }
+    start = end;
+  }
 
-    serverReady = true;
-
-    if (heartbeatPort > 0 && heartbeatEnabled && heartbeatTimer && !heartbeatTimer->isActive()) {
-      heartbeatTimer->start();
+  if (isRestarting) {
+    for (const BeamOutputLine& line : batch.lines) {
+      if (!line.isError) {
+        continue;
+      }
+      std::string_view text(batch.text(line).data(), static_cast<size_t>(line.length));
+      if (text.find("ddress already in use") != std::string_view::npos ||
+          text.find("EADDRINUSE") != std::string_view::npos)
+      {
+        Tau5Logger::instance().error( "Port is still in use, restart failed");
+        finishRestart(false);
+        break;
+      }
     }
+  }
 
-    if (!otpTreeReady) {
-      otpTreeReady = true;
-      emit otpReady();
-    }
+  emit outputBatch(batch);
+}
 
-    if (actualPort > 0 && actualPort != appPort) {
-      emit actualPortAllocated(actualPort);
+void Beam::handleServerError(const QString &errorMessage)
+{
+  if (isRestarting && promotingStandby)
+  {
+    Tau5Logger::instance().warning(QString("Standby promotion failed (%1), falling back to a cold start").arg(errorMessage));
+    promotingStandby = false;
+    if (QProcess *failed = std::exchange(process, nullptr))
+    {
+      disconnect(failed, nullptr, this, nullptr);
+      if (failed->state() == QProcess::NotRunning)
+      {
+        failed->deleteLater();
+      }
+      else
+      {
+        connect(failed, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), failed, &QObject::deleteLater);
+        failed->kill();
+      }
     }
+    beamPid = 0;
+    coldStartBeamProcess();
+    return;
   }
 
-  emit standardOutput(outputStr);
+  QString fullErrorMessage = QString("Server startup failed: %1").arg(errorMessage);
+  QString logPath = Tau5Logger::instance().currentSessionPath();
+
+  // Log to Tau5Logger
+  Tau5Logger::instance().error(fullErrorMessage);
+
+  // CRITICAL: Print detailed error to stderr for visibility
+  std::cerr << "\n========================================\n";
+  std::cerr << "FATAL: Server Startup Error\n";
+  std::cerr << "========================================\n";
+  std::cerr << "Error: " << errorMessage.toStdString() << "\n\n";
+  std::cerr << "Logs: " << logPath.toStdString() << "\n";
+  std::cerr << "========================================\n" << std::endl;
+
+  // Emit signal for GUI mode
+  emit standardError(fullErrorMessage);
+
+  // Exit with appropriate error code
+  if (errorMessage.contains("port") && errorMessage.contains("in use")) {
+    QCoreApplication::exit(static_cast<int>(ExitCode::PORT_IN_USE));
+  } else if (errorMessage.contains("heartbeat")) {
+    QCoreApplication::exit(static_cast<int>(ExitCode::HEARTBEAT_PORT_FAILED));
+  } else {
+    QCoreApplication::exit(static_cast<int>(ExitCode::BEAM_START_FAILED));
+  }
 }
 
-void Beam::handleStandardError()
+void Beam::handleServerReady(qint64 pid, quint16 actualPort, quint16 mcpPort)
 {
-  QByteArray error = process->readAllStandardError();
-  QString errorStr = QString::fromUtf8(error);
+  beamPid = pid;
+  StartupTrace::instance().end("beam.boot");
+
+  Tau5Logger::instance().debug(QString("Captured server info - PID: %1, HTTP: %2, MCP: %3")
+    .arg(beamPid).arg(actualPort).arg(mcpPort));
 
-  if (Tau5Logger::isInitialized() && !errorStr.trimmed().isEmpty()) {
-    Tau5Logger::instance().log(LogLevel::Error, "beam", errorStr.trimmed());
+  if (actualPort > 0) {
+    appPort = actualPort;
   }
 
-  if (isRestarting && (errorStr.contains("address already in use") ||
-                       errorStr.contains("Address already in use") ||
-                       errorStr.contains("EADDRINUSE")))
-  {
-    Tau5Logger::instance().error( "Port is still in use, restart failed");
-    isRestarting = false;
-    emit restartComplete();
+  serverReady = true;
+
+  if (heartbeatEnabled && heartbeatTimer && !heartbeatTimer->isActive()) {
+    heartbeatTimer->start();
+  }
+
+  if (!otpTreeReady) {
+    otpTreeReady = true;
+    emit otpReady();
   }
 
-  emit standardError(errorStr);
+  if (actualPort > 0 && actualPort != appPort) {
+    emit actualPortAllocated(actualPort);
+  }
+
+  // Boot the next standby once this server no longer needs the CPU
+  if (standbyEnabled && !standbyProcess) {
+    QTimer::singleShot(0, this, &Beam::startStandby);
+  }
+}
+
+void Beam::connectControlChannel(ControlChannel *channel)
+{
+  // The active and standby channels swap roles on promotion, so route by
+  // the role the channel has when the message arrives
+  connect(channel, &ControlChannel::ready, this, [this, channel](qint64 pid, quint16 actualPort, quint16 mcpPort) {
+    if (channel == controlChannel) {
+      handleServerReady(pid, actualPort, mcpPort);
+    }
+  });
+  connect(channel, &ControlChannel::standbyReady, this, [this, channel](qint64 pid) {
+    if (channel == standbyChannel) {
+      handleStandbyReady(pid);
+    }
+  });
+  connect(channel, &ControlChannel::serverError, this, [this, channel](const QString &errorMessage) {
+    if (channel == controlChannel) {
+      handleServerError(errorMessage);
+    } else {
+      // The standby halts after reporting; its exit handler tidies up
+      Tau5Logger::instance().warning(QString("Standby BEAM failed to start: %1").arg(errorMessage));
+    }
+  });
+  connect(channel, &ControlChannel::startupTrace, this, [this, channel](const QList<BeamTraceSpan>& spans) {
+    if (channel != controlChannel || !process) {
+      return;
+    }
+    for (const BeamTraceSpan& span : spans) {
+      StartupTrace::instance().addSpan(span.name, process->processId(), "beam",
+                                       span.startEpochUs, span.durationUs);
+    }
+  });
+  connect(channel, &ControlChannel::metricsReceived, this, [this, channel](const ServerMetrics& metrics) {
+    if (channel != controlChannel) {
+      return;
+    }
+    TAU5_LOGF_DEBUG("BEAM metrics: memory={}MB processes={} run_queue={} uptime={}s",
+                    metrics.totalMemoryBytes / (1024 * 1024), metrics.processCount,
+                    metrics.runQueueLength, metrics.uptimeMs / 1000);
+  });
 }
 
 QProcessEnvironment Beam::createControlledEnvironment(const Tau5CLI::ServerConfig& config)
@@ -311,9 +426,12 @@ QProcessEnvironment Beam::createControlledEnvironment(const Tau5CLI::ServerConfi
     return env;
 }
 
-void Beam::startElixirServerDev()
+void Beam::startElixirServerDev(bool standby)
 {
-  Tau5Logger::instance().info( "Starting Elixir server in Development mode");
+  QProcess *target = standby ? standbyProcess : process;
+  ControlChannel *channel = standby ? standbyChannel : controlChannel;
+  Tau5Logger::instance().info(standby ? "Starting standby Elixir server in Development mode"
+                                      : "Starting Elixir server in Development mode");
 
   // Use controlled environment instead of system environment
   QProcessEnvironment env = createControlledEnvironment(*m_config);
@@ -321,6 +439,10 @@ void Beam::startElixirServerDev()
 
   env.insert("TAU5_USE_STDIN_CONFIG", "true");
   env.insert("TAU5_HEARTBEAT_ENABLED", "true");
+  env.insert("TAU5_CONTROL_PORT", QString::number(channel->port()));
+  if (standby) {
+    env.insert("TAU5_STANDBY", "true");
+  }
 
   if (appPort > 0) {
     env.insert("TAU5_LOCAL_PORT", QString::number(appPort));
@@ -352,7 +474,7 @@ void Beam::startElixirServerDev()
 #ifdef Q_OS_WIN
   QDir dir(QCoreApplication::applicationDirPath());
   dir.cd("../../scripts");
-  process->setWorkingDirectory(dir.absolutePath());
+  target->setWorkingDirectory(dir.absolutePath());
   QString cmd = QDir(dir.absolutePath()).filePath("win-start-server.bat");
   QStringList args = {};
 #else
@@ -361,17 +483,20 @@ void Beam::startElixirServerDev()
     Tau5Logger::instance().error("Please use --dev-server-path argument or set TAU5_SERVER_PATH environment variable");
     return;
   }
-  process->setWorkingDirectory(appBasePath);
+  target->setWorkingDirectory(appBasePath);
   QString cmd = "mix";
   QStringList args = {"phx.server"};
 #endif
-  process->setProcessEnvironment(env);
-  startProcess(cmd, args);
+  target->setProcessEnvironment(env);
+  startProcess(target, cmd, args);
 }
 
-void Beam::startElixirServerProd()
+void Beam::startElixirServerProd(bool standby)
 {
-  Tau5Logger::instance().info( "Starting Elixir server in Production mode");
+  QProcess *target = standby ? standbyProcess : process;
+  ControlChannel *channel = standby ? standbyChannel : controlChannel;
+  Tau5Logger::instance().info(standby ? "Starting standby Elixir server in Production mode"
+                                      : "Starting Elixir server in Production mode");
 
   // Use controlled environment instead of system environment
   QProcessEnvironment env = createControlledEnvironment(*m_config);
@@ -394,6 +519,10 @@ void Beam::startElixirServerProd()
 
   env.insert("TAU5_USE_STDIN_CONFIG", "true");
   env.insert("TAU5_HEARTBEAT_ENABLED", "true");
+  env.insert("TAU5_CONTROL_PORT", QString::number(channel->port()));
+  if (standby) {
+    env.insert("TAU5_STANDBY", "true");
+  }
   env.insert("PHX_SERVER", "1");
 
   if (appPort > 0) {
@@ -435,8 +564,8 @@ void Beam::startElixirServerProd()
   env.insert("RELEASE_ROOT", releaseRoot);
   env.insert("RELEASE_DISTRIBUTION", "none");
 
-  process->setWorkingDirectory(appBasePath);
-  process->setProcessEnvironment(env);
+  target->setWorkingDirectory(appBasePath);
+  target->setProcessEnvironment(env);
 
   QString cmd = releaseErlBinPath;
   QStringList args = {
@@ -449,12 +578,12 @@ void Beam::startElixirServerProd()
       "-mode", "embedded",
       "-extra", "--no-halt"};
 
-  startProcess(cmd, args);
+  startProcess(target, cmd, args);
 }
 
-void Beam::writeSecretsToStdin()
+void Beam::writeSecretsToStdin(QProcess *target)
 {
-  if (!process) {
+  if (!target) {
     Tau5Logger::instance().error("FATAL: Cannot write secrets - process not started");
     QCoreApplication::exit(static_cast<int>(ExitCode::STDIN_CONFIG_FAILED));
     return;
@@ -468,29 +597,37 @@ void Beam::writeSecretsToStdin()
   config += secretKeyBase + "\n";
   // Ports are now allocated by BEAM, not sent via stdin
 
-  process->write(config.toUtf8());
-  process->closeWriteChannel();
+  target->write(config.toUtf8());
+  target->closeWriteChannel();
 
   Tau5Logger::instance().debug(QString("Secure configuration written (%1 bytes) and stdin closed")
                               .arg(config.toUtf8().size()));
 }
 
-void Beam::startProcess(const QString &cmd, const QStringList &args)
+void Beam::watchActiveProcess()
 {
-  Tau5Logger::instance().debug( QString("Server process working directory: %1").arg(process->workingDirectory()));
-  Tau5Logger::instance().debug( QString("Starting process: %1 %2").arg(cmd).arg(args.join(" ")));
-
   connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
-          this, [this](int exitCode, QProcess::ExitStatus status)
+          this, [this, finished = process](int exitCode, QProcess::ExitStatus status)
           {
             QString message = QString("Process finished with exit code: %1 status: %2")
                             .arg(exitCode)
                             .arg(status == QProcess::NormalExit ? "Normal" : "Crashed");
             Tau5Logger::instance().info( message);
+
+            // Pass on whatever the process wrote last, newline or not
+            if (finished == process)
+            {
+              handleStandardOutput();
+              handleStandardError();
+              stdoutSplitter.finish(pendingOutput);
+              stderrSplitter.finish(pendingOutput);
+              scheduleOutputFlush();
+            }
+
             emit standardOutput(message);
           });
 
-  connect(process, &QProcess::errorOccurred, [this](QProcess::ProcessError error)
+  connect(process, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error)
           {
     QString errorMsg;
     switch (error)
@@ -518,6 +655,17 @@ void Beam::startProcess(const QString &cmd, const QStringList &args)
     Tau5Logger::instance().error( errorMsg);
     emit standardError(errorMsg);
   });
+}
+
+void Beam::startProcess(QProcess *target, const QString &cmd, const QStringList &args)
+{
+  Tau5Logger::instance().debug( QString("Server process working directory: %1").arg(target->workingDirectory()));
+  Tau5Logger::instance().debug( QString("Starting process: %1 %2").arg(cmd).arg(args.join(" ")));
+
+  if (target == process)
+  {
+    watchActiveProcess();
+  }
 
 #ifdef Q_OS_UNIX
   // For GUI builds: MUST prevent QWebEngine/Chrome file descriptors from being inherited
@@ -527,7 +675,7 @@ void Beam::startProcess(const QString &cmd, const QStringList &args)
     QProcess::UnixProcessParameters params;
     params.flags = QProcess::UnixProcessFlag::UseVFork |           // Avoid copying WebEngine memory
                    QProcess::UnixProcessFlag::CloseFileDescriptors; // Prevent Chrome FD inheritance
-    process->setUnixProcessParameters(params);
+    target->setUnixProcessParameters(params);
     Tau5Logger::instance().debug("Using vfork with FD isolation to prevent Chrome descriptor inheritance");
   #else
     // Node-only builds or Qt < 6.6
@@ -537,19 +685,32 @@ void Beam::startProcess(const QString &cmd, const QStringList &args)
 #endif
   // Note: Windows CreateProcess() doesn't need special handling - it already
   // behaves like spawn and doesn't copy the parent's memory
-  process->start(cmd, args);
+  if (target == process)
+  {
+    StartupTrace::instance().begin("beam.spawn");
+  }
+  target->start(cmd, args);
+  bool started = target->waitForStarted(5000);
+  if (target == process)
+  {
+    StartupTrace::instance().end("beam.spawn");
+    StartupTrace::instance().begin("beam.boot");
+  }
 
-  if (!process->waitForStarted(5000))
+  if (!started)
   {
     QString errorMsg = QString("Error starting BEAM: %1\nCommand: %2\nArgs: %3")
-                      .arg(process->errorString())
+                      .arg(target->errorString())
                       .arg(cmd)
                       .arg(args.join(" "));
     Tau5Logger::instance().error( errorMsg);
-    emit standardError(errorMsg);
+    if (target == process)
+    {
+      emit standardError(errorMsg);
+    }
   } else {
     // Always write secrets via stdin - no fallback
-    writeSecretsToStdin();
+    writeSecretsToStdin(target);
   }
 }
 
@@ -569,42 +730,26 @@ void Beam::sendHeartbeat()
   heartbeatCount++;
   
   if (!serverReady) {
-    Tau5Logger::instance().debug(QString("Heartbeat #%1 skipped - server not ready").arg(heartbeatCount));
+    TAU5_LOGF_DEBUG("Heartbeat #{} skipped - server not ready", heartbeatCount);
     return;
   }
   
   if (!process || process->state() != QProcess::Running) {
-    Tau5Logger::instance().debug(QString("Heartbeat #%1 skipped - process not running").arg(heartbeatCount));
+    TAU5_LOGF_DEBUG("Heartbeat #{} skipped - process not running", heartbeatCount);
     return;
   }
 
-  if (!heartbeatSocket)
+  if (!controlChannel->isConnected())
   {
-    Tau5Logger::instance().warning(QString("Heartbeat #%1 - Cannot send - UDP socket not created").arg(heartbeatCount));
+    Tau5Logger::instance().warning(QString("Heartbeat #%1 - Cannot send - control channel not connected").arg(heartbeatCount));
     return;
   }
-  
-  if (heartbeatPort == 0)
-  {
-    Tau5Logger::instance().warning(QString("Heartbeat #%1 - Cannot send - port not yet allocated").arg(heartbeatCount));
-    return;
-  }
-
-  QString heartbeatMsg = QString("HEARTBEAT:%1\n").arg(heartbeatToken);
-  QByteArray datagram = heartbeatMsg.toUtf8();
 
-  qint64 sent = heartbeatSocket->writeDatagram(datagram, QHostAddress::LocalHost, heartbeatPort);
-
-  if (sent == -1) {
-    Tau5Logger::instance().warning(QString("Heartbeat #%1 - Failed to send UDP: %2")
-                                  .arg(heartbeatCount)
-                                  .arg(heartbeatSocket->errorString()));
+  if (!controlChannel->sendHeartbeat()) {
+    Tau5Logger::instance().warning(QString("Heartbeat #%1 - Failed to send on control channel").arg(heartbeatCount));
   } else {
     if (heartbeatCount <= 10 || heartbeatCount % 10 == 0) {
-      Tau5Logger::instance().debug(QString("Heartbeat #%1 sent successfully to port %2 (bytes: %3)")
-                                  .arg(heartbeatCount)
-                                  .arg(heartbeatPort)
-                                  .arg(sent));
+      TAU5_LOGF_DEBUG("Heartbeat #{} sent on control channel", heartbeatCount);
     }
   }
   
@@ -620,94 +765,24 @@ void Beam::killBeamProcess()
     return;
   }
 
-  Tau5Logger::instance().debug(QString("Attempting to kill BEAM process with PID: %1").arg(beamPid));
-
-#ifdef Q_OS_WIN
-  Tau5Logger::instance().debug(QString("Windows: Sending graceful termination to PID: %1").arg(beamPid));
-
-  QProcess gracefulKill;
-  gracefulKill.start("taskkill", {"/PID", QString::number(beamPid), "/T"});
-  gracefulKill.waitForFinished(1000);
-
-  if (gracefulKill.exitCode() != 0) {
-    Tau5Logger::instance().debug(QString("taskkill graceful failed with exit code %1").arg(gracefulKill.exitCode()));
-  }
-
-  for (int i = 2; i > 0; --i)
-  {
-    QProcess checkProcess;
-    checkProcess.start("tasklist", {"/FI", QString("PID eq %1").arg(beamPid)});
-    checkProcess.waitForFinished(500);
-    QString output = checkProcess.readAllStandardOutput();
-
-    if (!output.contains(QString::number(beamPid)))
-    {
-      Tau5Logger::instance().debug(QString("Process %1 terminated gracefully").arg(beamPid));
-      beamPid = 0;
-      return;
-    }
-
-    Tau5Logger::instance().debug(QString("Process %1 still running, waiting... %2").arg(beamPid).arg(i));
-    QThread::msleep(500);
-  }
-
-  Tau5Logger::instance().debug(QString("Windows: Force killing PID: %1").arg(beamPid));
-
-  QProcess forceKill;
-  forceKill.start("taskkill", {"/F", "/PID", QString::number(beamPid), "/T"});
-  forceKill.waitForFinished(1000);
+  Tau5Logger::instance().debug(QString("Stopping BEAM process with PID: %1 (grace period %2ms)")
+                              .arg(beamPid).arg(shutdownGraceMs));
 
-  if (forceKill.exitCode() != 0) {
-    Tau5Logger::instance().debug(QString("taskkill force failed with exit code %1").arg(forceKill.exitCode()));
-  }
-
-  QProcess finalCheck;
-  finalCheck.start("tasklist", {"/FI", QString("PID eq %1").arg(beamPid)});
-  finalCheck.waitForFinished(500);
-  QString finalOutput = finalCheck.readAllStandardOutput();
+  QElapsedTimer timer;
+  timer.start();
+  ProcessControl::StopResult result = ProcessControl::stop(beamPid, shutdownGraceMs);
 
-  if (finalOutput.contains(QString::number(beamPid)))
+  if (result == ProcessControl::StopResult::Failed)
   {
     Tau5Logger::instance().error(QString("Process %1 could not be terminated").arg(beamPid));
-  }
-  else
-  {
-    Tau5Logger::instance().debug(QString("Process %1 successfully terminated").arg(beamPid));
-    beamPid = 0;
-  }
-
-#else
-  // Use synchronous QProcess::execute for reliable kill during shutdown
-  // This ensures the kill commands complete before the GUI process exits
-  Tau5Logger::instance().debug(QString("Unix: Sending SIGTERM to PID: %1").arg(beamPid));
-  int result = QProcess::execute("kill", {"-TERM", QString::number(beamPid)});
-
-  if (result != 0)
-  {
-    Tau5Logger::instance().debug(QString("Process %1 not found or already terminated").arg(beamPid));
-    beamPid = 0;
     return;
   }
 
-  for (int i = 5; i > 0; --i)
-  {
-    result = QProcess::execute("kill", {"-0", QString::number(beamPid)});
-
-    if (result != 0)
-    {
-      Tau5Logger::instance().debug(QString("Process %1 terminated gracefully").arg(beamPid));
-      beamPid = 0;
-      return;
-    }
-
-    Tau5Logger::instance().debug(QString("Process %1 still running, waiting... %2").arg(beamPid).arg(i));
-    QThread::msleep(1000);
-  }
-
-  Tau5Logger::instance().debug(QString("Unix: Sending SIGKILL to PID: %1").arg(beamPid));
-  QProcess::execute("kill", {"-9", QString::number(beamPid)});
+  Tau5Logger::instance().debug(QString("Process %1 %2 after %3ms")
+                              .arg(beamPid)
+                              .arg(ProcessControl::toString(result))
+                              .arg(timer.elapsed()));
   beamPid = 0;
-#endif
 }
 
 void Beam::restart()
@@ -720,6 +795,7 @@ void Beam::restart()
     return;
   }
   isRestarting = true;
+  restartTimer.start();
 
   if (heartbeatTimer && heartbeatTimer->isActive())
   {
@@ -735,6 +811,12 @@ void Beam::restart()
     disconnect(process, &QProcess::readyReadStandardError, this, &Beam::handleStandardError);
   }
 
+  // The BEAM hasn't reported its PID yet, so stop the process we launched
+  if (beamPid <= 0 && process && process->state() != QProcess::NotRunning)
+  {
+    beamPid = process->processId();
+  }
+
   if (beamPid > 0)
   {
     Tau5Logger::instance().info( "Terminating BEAM process by PID (in background thread)...");
@@ -778,39 +860,45 @@ void Beam::continueRestart()
 
 void Beam::checkPortAndStartNewProcess()
 {
-  static int retryCount = 0;
-  const int maxRetries = 20;
-
   if (!isRestarting)
   {
-    retryCount = 0;
     return;
   }
 
+  // killBeamProcess() has already waited for the old BEAM to exit, and both
+  // this probe and the endpoint bind with SO_REUSEADDR, so the port is
+  // normally free on the first attempt. The backoff only covers an old
+  // process that couldn't be stopped or one we never knew the PID of.
+  if (portWaitAttempt == 0)
+  {
+    portWaitTimer.start();
+  }
+
   QTcpServer testServer;
   bool portAvailable = testServer.listen(QHostAddress::LocalHost, appPort);
   testServer.close();
 
   if (portAvailable)
   {
-    Tau5Logger::instance().info( QString("Port %1 is now available, starting new BEAM process").arg(appPort));
-    retryCount = 0;
+    Tau5Logger::instance().info( QString("Port %1 is now available after %2ms, starting new BEAM process")
+                .arg(appPort).arg(portWaitTimer.elapsed()));
+    portWaitAttempt = 0;
     startNewBeamProcess();
   }
-  else if (retryCount < maxRetries)
+  else if (portWaitTimer.elapsed() < PORT_RELEASE_TIMEOUT_MS)
   {
-    retryCount++;
-    Tau5Logger::instance().debug( QString("Port %1 still in use, checking again in 500ms... (attempt %2/%3)")
-                .arg(appPort).arg(retryCount).arg(maxRetries));
-    QTimer::singleShot(500, this, &Beam::checkPortAndStartNewProcess);
+    int delay = qMin(PORT_RETRY_INITIAL_MS << qMin(portWaitAttempt, 16), PORT_RETRY_MAX_MS);
+    portWaitAttempt++;
+    Tau5Logger::instance().debug( QString("Port %1 still in use, checking again in %2ms... (attempt %3)")
+                .arg(appPort).arg(delay).arg(portWaitAttempt));
+    QTimer::singleShot(delay, this, &Beam::checkPortAndStartNewProcess);
   }
   else
   {
-    Tau5Logger::instance().error( QString("Port %1 still in use after %2 seconds, giving up")
-                .arg(appPort).arg(maxRetries * 0.5));
-    retryCount = 0;
-    isRestarting = false;
-    emit restartComplete();
+    Tau5Logger::instance().error( QString("Port %1 still in use after %2ms, giving up")
+                .arg(appPort).arg(portWaitTimer.elapsed()));
+    portWaitAttempt = 0;
+    finishRestart(false);
   }
 }
 
@@ -822,7 +910,36 @@ void Beam::startNewBeamProcess()
     return;
   }
 
+  // During restart, reuse all existing tokens so the GUI doesn't need to reload
+  // The tokens are already set from the initial startup (and were handed to
+  // the standby when it booted), no need to regenerate
+  Tau5Logger::instance().debug("Reusing existing secure tokens for restart");
+
+  if (!promoteStandby())
+  {
+    coldStartBeamProcess();
+  }
+
+  QTimer::singleShot(30000, this, [this]() {
+    if (isRestarting)
+    {
+      Tau5Logger::instance().error( "BEAM restart timeout - OTP failed to start");
+      finishRestart(false);
+    }
+  });
+
+  QObject *context = new QObject();
+  connect(this, &Beam::otpReady, context, [this, context]() {
+    finishRestart(true);
+    context->deleteLater();
+  });
+}
+
+void Beam::coldStartBeamProcess()
+{
   process = new QProcess(this);
+  stdoutSplitter = BeamLineSplitter(false);
+  stderrSplitter = BeamLineSplitter(true);
 
   connect(process, &QProcess::readyReadStandardOutput,
           this, &Beam::handleStandardOutput);
@@ -833,15 +950,10 @@ void Beam::startNewBeamProcess()
     if (error == QProcess::FailedToStart)
     {
       Tau5Logger::instance().error( "Failed to start new BEAM process");
-      isRestarting = false;
-      emit restartComplete();
+      finishRestart(false);
     }
   });
 
-  // During restart, reuse all existing tokens so the GUI doesn't need to reload
-  // The tokens are already set from the initial startup, no need to regenerate
-  Tau5Logger::instance().debug("Reusing existing secure tokens for restart");
-
   Tau5Logger::instance().info( "Starting new BEAM process...");
   if (devMode)
   {
@@ -851,21 +963,150 @@ void Beam::startNewBeamProcess()
   {
     startElixirServerProd();
   }
+}
 
-  QTimer::singleShot(30000, this, [this]() {
-    if (isRestarting)
+bool Beam::promoteStandby()
+{
+  if (!standbyProcess || !standbyBooted || !standbyChannel->isConnected())
+  {
+    if (standbyEnabled)
     {
-      Tau5Logger::instance().error( "BEAM restart timeout - OTP failed to start");
-      isRestarting = false;
-      emit restartComplete();
+      Tau5Logger::instance().info("No standby BEAM ready, cold starting");
     }
-  });
+    return false;
+  }
 
-  QObject *context = new QObject();
-  connect(this, &Beam::otpReady, context, [this, context]() {
-    Tau5Logger::instance().info( "BEAM restart complete");
-    isRestarting = false;
-    emit restartComplete();
-    context->deleteLater();
+  Tau5Logger::instance().info(QString("Promoting standby BEAM (PID %1)").arg(standbyPid));
+
+  // The standby's drain and exit handlers give way to the active ones, and
+  // the channels swap so the old one is free for the next standby
+  disconnect(standbyProcess, nullptr, this, nullptr);
+  process = std::exchange(standbyProcess, nullptr);
+  std::swap(controlChannel, standbyChannel);
+  beamPid = std::exchange(standbyPid, 0);
+  standbyBooted = false;
+
+  stdoutSplitter = BeamLineSplitter(false);
+  stderrSplitter = BeamLineSplitter(true);
+  connect(process, &QProcess::readyReadStandardOutput,
+          this, &Beam::handleStandardOutput);
+  connect(process, &QProcess::readyReadStandardError,
+          this, &Beam::handleStandardError);
+  watchActiveProcess();
+
+  // It binds the ports the old BEAM just released and then reports Ready
+  // like a cold start would
+  promotingStandby = true;
+  if (!controlChannel->sendPromote())
+  {
+    handleServerError("could not send promote");
+  }
+  return true;
+}
+
+void Beam::startStandby()
+{
+  if (!standbyEnabled || standbyProcess || isRestarting)
+  {
+    return;
+  }
+
+  QProcess *standby = new QProcess(this);
+  standbyProcess = standby;
+  standbyPid = 0;
+  standbyBooted = false;
+  standbyTimer.start();
+
+  // Nothing shows the standby's output, but its pipes must still be
+  // drained or it will block on a full one
+  auto drain = [standby](QProcess::ProcessChannel channel) {
+    standby->setReadChannel(channel);
+    QByteArray output = standby->readAll();
+    if (Tau5Logger* logger = Tau5Logger::enabledFor(LogLevel::Debug)) {
+      QString text = QString::fromUtf8(output).trimmed();
+      if (!text.isEmpty()) {
+        logger->log(LogLevel::Debug, "beam-standby", text);
+      }
+    }
+  };
+  connect(standby, &QProcess::readyReadStandardOutput, this, [drain]() { drain(QProcess::StandardOutput); });
+  connect(standby, &QProcess::readyReadStandardError, this, [drain]() { drain(QProcess::StandardError); });
+
+  auto discard = [this, standby](const QString &reason) {
+    if (standby != standbyProcess) {
+      return;
+    }
+    Tau5Logger::instance().warning(QString("Standby BEAM %1, the next restart will cold start").arg(reason));
+    standbyProcess = nullptr;
+    standbyPid = 0;
+    standbyBooted = false;
+    standby->deleteLater();
+  };
+  connect(standby, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+          this, [discard](int exitCode, QProcess::ExitStatus) {
+    discard(QString("exited with code %1").arg(exitCode));
+  });
+  connect(standby, &QProcess::errorOccurred, this, [discard](QProcess::ProcessError error) {
+    if (error == QProcess::FailedToStart) {
+      discard("failed to start");
+    }
   });
-}
\ No newline at end of file
+
+  if (devMode)
+  {
+    startElixirServerDev(true);
+  }
+  else
+  {
+    startElixirServerProd(true);
+  }
+}
+
+void Beam::handleStandbyReady(qint64 pid)
+{
+  if (!standbyProcess)
+  {
+    return;
+  }
+  standbyPid = pid;
+  standbyBooted = true;
+  Tau5Logger::instance().info(QString("Standby BEAM (PID %1) booted in %2ms")
+                              .arg(pid).arg(standbyTimer.elapsed()));
+}
+
+void Beam::stopStandby()
+{
+  QProcess *standby = std::exchange(standbyProcess, nullptr);
+  if (!standby)
+  {
+    return;
+  }
+  disconnect(standby, nullptr, this, nullptr);
+
+  qint64 pid = standbyPid > 0 ? standbyPid : standby->processId();
+  standbyPid = 0;
+  standbyBooted = false;
+  if (pid > 0)
+  {
+    ProcessControl::stop(pid, shutdownGraceMs);
+  }
+  standby->deleteLater();
+}
+
+void Beam::finishRestart(bool success)
+{
+  qint64 latencyMs = restartTimer.isValid() ? restartTimer.elapsed() : 0;
+  isRestarting = false;
+  promotingStandby = false;
+
+  if (success)
+  {
+    Tau5Logger::instance().info( QString("BEAM restart complete in %1ms").arg(latencyMs));
+  }
+  else
+  {
+    Tau5Logger::instance().warning( QString("BEAM restart failed after %1ms").arg(latencyMs));
+  }
+
+  emit restartComplete(success, latencyMs);
+}
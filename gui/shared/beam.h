@@ -5,12 +5,17 @@
 #include <QString>
 #include <QProcess>
 #include <QTimer>
-#include <QUdpSocket>
+#include <QElapsedTimer>
+#include "beam_output.h"
 
 namespace Tau5CLI {
     class ServerConfig;
 }
 
+namespace Tau5Common {
+    class ControlChannel;
+}
+
 class Beam : public QObject
 {
   Q_OBJECT
@@ -22,6 +27,10 @@ public:
     Central   // Running as the authoritative tau5.sonic-pi.net server
   };
 
+  static constexpr int PORT_RETRY_INITIAL_MS = 5;
+  static constexpr int PORT_RETRY_MAX_MS = 500;
+  static constexpr int PORT_RELEASE_TIMEOUT_MS = 10000;
+
   explicit Beam(QObject *parent, const Tau5CLI::ServerConfig& config, const QString &basePath, const QString &appName, const QString &version, quint16 port);
   ~Beam();
   
@@ -29,21 +38,32 @@ public:
   quint16 getPort() const { return appPort; }
   qint64 getBeamPid() const { return beamPid; }
 
-  void startElixirServerDev();
-  void startElixirServerProd();
+  // A standby boots with the same tokens and port but binds nothing until
+  // it is promoted by restart()
+  void startElixirServerDev(bool standby = false);
+  void startElixirServerProd(bool standby = false);
   void restart();
 
 signals:
+  // Beam's own status and error messages
   void standardOutput(const QString &output);
   void standardError(const QString &error);
+  // The BEAM's stdout/stderr, split into lines, at most one batch per
+  // event-loop tick
+  void outputBatch(const Tau5Common::BeamOutputBatch &batch);
   void otpReady();
-  void restartComplete();
+  // latencyMs runs from restart() to the new BEAM's OTP tree being ready
+  // (or to the failure)
+  void restartComplete(bool success, qint64 latencyMs);
   void actualPortAllocated(quint16 port);
 
 private slots:
   void handleStandardOutput();
   void handleStandardError();
+  void handleServerReady(qint64 pid, quint16 actualPort, quint16 mcpPort);
+  void handleServerError(const QString &errorMessage);
   void sendHeartbeat();
+  void flushOutput();
 
 private:
   quint16 appPort;
@@ -56,10 +76,13 @@ private:
   QString releaseLibPath;
   QString releaseErlBinPath;
   QProcess *process;
+  Tau5Common::BeamLineSplitter stdoutSplitter{false};
+  Tau5Common::BeamLineSplitter stderrSplitter{true};
+  Tau5Common::BeamOutputBatch pendingOutput;
+  bool outputFlushScheduled = false;
   qint64 beamPid;
   QTimer *heartbeatTimer;
-  QUdpSocket *heartbeatSocket;
-  quint16 heartbeatPort;
+  Tau5Common::ControlChannel *controlChannel;
   QString heartbeatToken;
   bool serverReady;
   bool otpTreeReady;
@@ -69,20 +92,40 @@ private:
   QString appName;
   QString appVersion;
   bool isRestarting;
+  int shutdownGraceMs;  // SIGTERM to SIGKILL, TAU5_BEAM_SHUTDOWN_GRACE_MS
+  QElapsedTimer restartTimer;
+  QElapsedTimer portWaitTimer;
+  int portWaitAttempt = 0;
+  bool standbyEnabled;  // TAU5_BEAM_STANDBY
+  QProcess *standbyProcess = nullptr;
+  Tau5Common::ControlChannel *standbyChannel = nullptr;
+  qint64 standbyPid = 0;
+  bool standbyBooted = false;
+  bool promotingStandby = false;
+  QElapsedTimer standbyTimer;
   bool enableMcp;
   bool enableRepl;
   QString secretKeyBase;
   DeploymentMode deploymentMode;
   const Tau5CLI::ServerConfig* m_config;
 
-  void startProcess(const QString &cmd, const QStringList &args);
-  void writeSecretsToStdin();
+  void startProcess(QProcess *target, const QString &cmd, const QStringList &args);
+  void writeSecretsToStdin(QProcess *target);
+  void watchActiveProcess();
+  void connectControlChannel(Tau5Common::ControlChannel *channel);
   bool isWindows() const;
   bool isMacOS() const;
   void killBeamProcess();
   void continueRestart();
   void checkPortAndStartNewProcess();
+  void finishRestart(bool success);
+  void scheduleOutputFlush();
   void startNewBeamProcess();
+  void coldStartBeamProcess();
+  void startStandby();
+  void stopStandby();
+  bool promoteStandby();
+  void handleStandbyReady(qint64 pid);
   QProcessEnvironment createControlledEnvironment(const Tau5CLI::ServerConfig& config);
 };
 
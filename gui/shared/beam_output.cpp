@@ -0,0 +1,181 @@
+#include "beam_output.h"
+#include <QIODevice>
+#include <cstring>
+
+namespace Tau5Common {
+
+namespace {
+
+constexpr qsizetype READ_CHUNK_BYTES = 64 * 1024;
+
+// A "line" this long without a newline is passed on as it is
+constexpr qsizetype MAX_PARTIAL_LINE_BYTES = 1024 * 1024;
+
+// Logger prefixes sit near the start of the line
+constexpr qsizetype LEVEL_SEARCH_BYTES = 64;
+
+struct LevelTag {
+    const char* tag;
+    LogLevel level;
+};
+
+const LevelTag LEVEL_TAGS[] = {
+    {"[debug]", LogLevel::Debug},
+    {"[info]", LogLevel::Info},
+    {"[notice]", LogLevel::Info},
+    {"[warning]", LogLevel::Warning},
+    {"[warn]", LogLevel::Warning},
+    {"[error]", LogLevel::Error},
+    {"[critical]", LogLevel::Critical},
+    {"[alert]", LogLevel::Critical},
+    {"[emergency]", LogLevel::Critical},
+};
+
+} // namespace
+
+LogLevel parseBeamLogLevel(QByteArrayView line, bool isError)
+{
+    if (line.startsWith("=ERROR REPORT") || line.startsWith("=CRASH REPORT")) {
+        return LogLevel::Error;
+    }
+    if (line.startsWith("=WARNING REPORT")) {
+        return LogLevel::Warning;
+    }
+
+    QByteArrayView head = line.first(qMin(line.size(), LEVEL_SEARCH_BYTES));
+    const char* p = head.data();
+    const char* end = p + head.size();
+    while ((p = static_cast<const char*>(std::memchr(p, '[', static_cast<size_t>(end - p))))) {
+        QByteArrayView rest(p, end - p);
+        for (const LevelTag& tag : LEVEL_TAGS) {
+            if (rest.startsWith(tag.tag)) {
+                return tag.level;
+            }
+        }
+        ++p;
+    }
+    return isError ? LogLevel::Error : LogLevel::Info;
+}
+
+QString BeamOutputBatch::joined(qsizetype first, qsizetype last) const
+{
+    if (first >= last) {
+        return QString();
+    }
+    // Gather the run into one buffer so it is decoded in one go
+    QByteArray bytes;
+    bytes.reserve(lines.at(last - 1).offset + lines.at(last - 1).length - lines.at(first).offset);
+    for (qsizetype i = first; i < last; ++i) {
+        if (i > first) {
+            bytes.append('\n');
+        }
+        bytes.append(text(lines.at(i)));
+    }
+    return QString::fromUtf8(bytes);
+}
+
+qint64 BeamLineSplitter::readFrom(QIODevice* device, BeamOutputBatch& batch)
+{
+    qint64 total = 0;
+    for (;;) {
+        qint64 available = device->bytesAvailable();
+        if (available <= 0) {
+            break;
+        }
+        qsizetype want = static_cast<qsizetype>(qMin<qint64>(available, READ_CHUNK_BYTES));
+        if (m_buffer.size() < m_used + want) {
+            m_buffer.resize(m_used + want);
+        }
+        qint64 got = device->read(m_buffer.data() + m_used, want);
+        if (got <= 0) {
+            break;
+        }
+        m_used += static_cast<qsizetype>(got);
+        total += got;
+        splitInto(batch);
+    }
+    return total;
+}
+
+void BeamLineSplitter::feed(const char* data, qsizetype size, BeamOutputBatch& batch)
+{
+    if (m_buffer.size() < m_used + size) {
+        m_buffer.resize(m_used + size);
+    }
+    std::memcpy(m_buffer.data() + m_used, data, static_cast<size_t>(size));
+    m_used += size;
+    splitInto(batch);
+}
+
+void BeamLineSplitter::finish(BeamOutputBatch& batch)
+{
+    if (m_used == 0) {
+        return;
+    }
+    qsizetype base = batch.data.size();
+    batch.data.append(m_buffer.constData(), m_used);
+    appendLine(batch, base, m_used);
+    m_used = 0;
+    m_scanned = 0;
+}
+
+void BeamLineSplitter::splitInto(BeamOutputBatch& batch)
+{
+    const char* start = m_buffer.constData();
+    const char* end = start + m_used;
+
+    // Everything up to the last newline moves to the batch in one copy.
+    // Only the bytes appended since the last call need searching, so a long
+    // line arriving in many small reads stays linear.
+    const char* scanFrom = start + m_scanned;
+    const char* lastNewline = nullptr;
+    for (const char* p = end; p > scanFrom; --p) {
+        if (p[-1] == '\n') {
+            lastNewline = p - 1;
+            break;
+        }
+    }
+    if (!lastNewline) {
+        m_scanned = m_used;
+        if (m_used >= MAX_PARTIAL_LINE_BYTES) {
+            finish(batch);
+        }
+        return;
+    }
+
+    qsizetype complete = (lastNewline - start) + 1;
+    qsizetype base = batch.data.size();
+    batch.data.append(start, complete);
+
+    const char* data = batch.data.constData() + base;
+    const char* p = data;
+    const char* dataEnd = data + complete;
+    while (p < dataEnd) {
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(dataEnd - p)));
+        appendLine(batch, base + (p - data), newline - p);
+        p = newline + 1;
+    }
+
+    // Keep the partial tail at the front of the buffer for the next read;
+    // it follows the last newline, so none of it needs searching again
+    m_used -= complete;
+    if (m_used > 0) {
+        std::memmove(m_buffer.data(), start + complete, static_cast<size_t>(m_used));
+    }
+    m_scanned = m_used;
+}
+
+void BeamLineSplitter::appendLine(BeamOutputBatch& batch, qsizetype offset, qsizetype length) const
+{
+    if (length > 0 && batch.data.at(offset + length - 1) == '\r') {
+        --length;
+    }
+    BeamOutputLine line;
+    line.offset = offset;
+    line.length = length;
+    line.isError = m_isError;
+    line.level = parseBeamLogLevel(QByteArrayView(batch.data.constData() + offset, length), m_isError);
+    batch.lines.append(line);
+}
+
+} // namespace Tau5Common
@@ -0,0 +1,99 @@
+#ifndef TAU5_BEAM_OUTPUT_H
+#define TAU5_BEAM_OUTPUT_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QList>
+#include <QMetaType>
+#include <QString>
+#include <QtGlobal>
+#include "tau5logger.h"
+
+class QIODevice;
+
+namespace Tau5Common {
+
+struct BeamOutputLine {
+    qsizetype offset = 0;   // Into BeamOutputBatch::data
+    qsizetype length = 0;   // Without the line terminator
+    LogLevel level = LogLevel::Info;
+    bool isError = false;   // Came from stderr
+};
+
+/**
+ * Complete lines of BEAM output gathered during one event-loop tick, from
+ * both streams in arrival order. The text lives back to back in one
+ * implicitly shared buffer, so passing a batch through signals copies no
+ * line data; each line's level is parsed once, when it is split.
+ */
+struct BeamOutputBatch {
+    QByteArray data;
+    QList<BeamOutputLine> lines;
+
+    bool isEmpty() const { return lines.isEmpty(); }
+    QByteArrayView text(const BeamOutputLine& line) const
+    {
+        return QByteArrayView(data.constData() + line.offset, line.length);
+    }
+
+    // Calls f(text, isError) once per run of consecutive lines from the
+    // same stream, the run's lines joined with '\n'
+    template <typename F>
+    void forEachStreamRun(F&& f) const
+    {
+        qsizetype start = 0;
+        while (start < lines.size()) {
+            qsizetype end = start + 1;
+            while (end < lines.size() && lines.at(end).isError == lines.at(start).isError) {
+                ++end;
+            }
+            f(joined(start, end), lines.at(start).isError);
+            start = end;
+        }
+    }
+
+    // Lines [first, last) joined with '\n'
+    QString joined(qsizetype first, qsizetype last) const;
+};
+
+/**
+ * Splits one output stream into lines. Bytes are read straight into a
+ * reusable buffer, complete lines are found in place with memchr and
+ * moved into the batch with a single copy per read; a trailing partial
+ * line stays behind until the rest of it arrives.
+ */
+class BeamLineSplitter
+{
+public:
+    explicit BeamLineSplitter(bool isError = false) : m_isError(isError) {}
+
+    // Reads everything available on the device's current read channel
+    qint64 readFrom(QIODevice* device, BeamOutputBatch& batch);
+
+    // Same, for bytes already in hand
+    void feed(const char* data, qsizetype size, BeamOutputBatch& batch);
+
+    // Emits a final unterminated line, e.g. when the process exits
+    void finish(BeamOutputBatch& batch);
+
+    qsizetype pendingBytes() const { return m_used; }
+
+private:
+    void splitInto(BeamOutputBatch& batch);
+    void appendLine(BeamOutputBatch& batch, qsizetype offset, qsizetype length) const;
+
+    QByteArray m_buffer;
+    qsizetype m_used = 0;
+    qsizetype m_scanned = 0;    // Leading bytes of m_buffer known to hold no newline
+    bool m_isError;
+};
+
+// Level from an Elixir Logger prefix ("... [warning] ...") or an Erlang
+// report header ("=ERROR REPORT===="); otherwise the stream's default
+LogLevel parseBeamLogLevel(QByteArrayView line, bool isError);
+
+} // namespace Tau5Common
+
+Q_DECLARE_METATYPE(Tau5Common::BeamOutputBatch)
+
+#endif // TAU5_BEAM_OUTPUT_H
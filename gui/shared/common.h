@@ -30,10 +30,6 @@ namespace Tau5Common {
         #else
             constexpr const char* APP_COMMIT = "unknown";
         #endif
-        
-        // Timer delays (in milliseconds)
-        constexpr int BEAM_STARTUP_DELAY_MS = 2000;  // Delay before starting BEAM in GUI mode
-        constexpr int NODE_STARTUP_DELAY_MS = 500;   // Delay before starting BEAM in node mode
     }
 
     // Get a free port for the server (deprecated - use allocatePort instead)
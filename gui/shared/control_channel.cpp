@@ -0,0 +1,252 @@
+#include "control_channel.h"
+#include "tau5logger.h"
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QtEndian>
+#include <cstring>
+#include <utility>
+
+namespace Tau5Common {
+
+namespace ControlProtocol {
+
+QByteArray encode(MessageType type, QByteArrayView payload)
+{
+    QByteArray frame(LENGTH_BYTES + 1 + payload.size(), Qt::Uninitialized);
+    qToBigEndian<quint32>(static_cast<quint32>(1 + payload.size()), frame.data());
+    frame[LENGTH_BYTES] = static_cast<char>(type);
+    if (!payload.isEmpty()) {
+        memcpy(frame.data() + LENGTH_BYTES + 1, payload.data(), static_cast<size_t>(payload.size()));
+    }
+    return frame;
+}
+
+} // namespace ControlProtocol
+
+using ControlProtocol::MessageType;
+
+ControlChannel::ControlChannel(const QString& token, QObject* parent)
+    : QObject(parent)
+    , m_token(token)
+    , m_server(new QTcpServer(this))
+{
+    connect(m_server, &QTcpServer::newConnection, this, &ControlChannel::onNewConnection);
+}
+
+ControlChannel::~ControlChannel()
+{
+    for (auto it = m_buffers.keyBegin(); it != m_buffers.keyEnd(); ++it) {
+        (*it)->disconnect(this);
+    }
+}
+
+bool ControlChannel::listen()
+{
+    if (m_server->isListening()) {
+        return true;
+    }
+    if (!m_server->listen(QHostAddress::LocalHost, 0)) {
+        Tau5Logger::instance().error(QString("Control channel failed to listen: %1").arg(m_server->errorString()));
+        return false;
+    }
+    Tau5Logger::instance().debug(QString("Control channel listening on port %1").arg(m_server->serverPort()));
+    return true;
+}
+
+quint16 ControlChannel::port() const
+{
+    return m_server->isListening() ? m_server->serverPort() : 0;
+}
+
+bool ControlChannel::sendHeartbeat()
+{
+    return send(MessageType::Heartbeat);
+}
+
+bool ControlChannel::sendPromote()
+{
+    return send(MessageType::Promote);
+}
+
+bool ControlChannel::send(MessageType type)
+{
+    if (!m_socket) {
+        return false;
+    }
+    return m_socket->write(ControlProtocol::encode(type)) > 0;
+}
+
+void ControlChannel::onNewConnection()
+{
+    while (QTcpSocket* socket = m_server->nextPendingConnection()) {
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        m_buffers.insert(socket, QByteArray());
+        connect(socket, &QTcpSocket::readyRead, this, &ControlChannel::onReadyRead);
+        connect(socket, &QTcpSocket::disconnected, this, &ControlChannel::onSocketDisconnected);
+
+        QTimer::singleShot(HELLO_TIMEOUT_MS, socket, [this, socket]() {
+            if (socket != m_socket) {
+                dropSocket(socket, "no hello received");
+            }
+        });
+    }
+}
+
+void ControlChannel::onReadyRead()
+{
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if (!socket || !m_buffers.contains(socket)) {
+        return;
+    }
+
+    // Work on a detached copy: a frame can drop sockets, which reshuffles m_buffers
+    QByteArray buffer = std::exchange(m_buffers[socket], QByteArray());
+    buffer.append(socket->readAll());
+
+    // Consume every complete frame, then drop the consumed prefix once
+    qsizetype offset = 0;
+    while (buffer.size() - offset >= ControlProtocol::LENGTH_BYTES) {
+        quint32 length = qFromBigEndian<quint32>(buffer.constData() + offset);
+        if (length == 0 || length > ControlProtocol::MAX_FRAME_BYTES) {
+            dropSocket(socket, QString("invalid frame length %1").arg(length));
+            return;
+        }
+        if (buffer.size() - offset < ControlProtocol::LENGTH_BYTES + static_cast<qsizetype>(length)) {
+            break;
+        }
+
+        const char* frame = buffer.constData() + offset + ControlProtocol::LENGTH_BYTES;
+        MessageType type = static_cast<MessageType>(static_cast<quint8>(frame[0]));
+        QByteArrayView payload(frame + 1, static_cast<qsizetype>(length) - 1);
+        offset += ControlProtocol::LENGTH_BYTES + length;
+
+        if (!handleFrame(socket, type, payload)) {
+            return;  // socket was dropped
+        }
+    }
+
+    if (offset > 0) {
+        buffer.remove(0, offset);
+    }
+    m_buffers[socket] = std::move(buffer);
+}
+
+bool ControlChannel::handleFrame(QTcpSocket* socket, MessageType type, QByteArrayView payload)
+{
+    if (socket != m_socket) {
+        if (type != MessageType::Hello || QString::fromUtf8(payload) != m_token) {
+            dropSocket(socket, "connection did not authenticate");
+            return false;
+        }
+
+        // A restarted BEAM replaces the previous connection
+        if (m_socket) {
+            dropSocket(m_socket, "replaced by a new connection");
+        }
+        m_socket = socket;
+        Tau5Logger::instance().debug("Control channel connected");
+        emit connected();
+        return true;
+    }
+
+    switch (type) {
+    case MessageType::Ready: {
+        if (payload.size() < 12) {
+            break;
+        }
+        const char* data = payload.data();
+        qint64 pid = static_cast<qint64>(qFromBigEndian<quint64>(data));
+        quint16 httpPort = qFromBigEndian<quint16>(data + 8);
+        quint16 mcpPort = qFromBigEndian<quint16>(data + 10);
+        emit ready(pid, httpPort, mcpPort);
+        return true;
+    }
+    case MessageType::Standby: {
+        if (payload.size() < 8) {
+            break;
+        }
+        emit standbyReady(static_cast<qint64>(qFromBigEndian<quint64>(payload.data())));
+        return true;
+    }
+    case MessageType::Error:
+        emit serverError(QString::fromUtf8(payload));
+        return true;
+    case MessageType::Metrics: {
+        if (payload.size() < 32) {
+            break;
+        }
+        const char* data = payload.data();
+        ServerMetrics metrics;
+        metrics.totalMemoryBytes = qFromBigEndian<quint64>(data);
+        metrics.processMemoryBytes = qFromBigEndian<quint64>(data + 8);
+        metrics.processCount = qFromBigEndian<quint32>(data + 16);
+        metrics.runQueueLength = qFromBigEndian<quint32>(data + 20);
+        metrics.uptimeMs = qFromBigEndian<quint64>(data + 24);
+        emit metricsReceived(metrics);
+        return true;
+    }
+    case MessageType::Trace: {
+        QList<BeamTraceSpan> spans;
+        const char* data = payload.data();
+        qsizetype offset = 0;
+        while (payload.size() - offset >= 2) {
+            qsizetype nameLength = qFromBigEndian<quint16>(data + offset);
+            if (payload.size() - offset < 2 + nameLength + 16) {
+                break;
+            }
+            BeamTraceSpan span;
+            span.name = QString::fromUtf8(data + offset + 2, nameLength);
+            span.startEpochUs = static_cast<qint64>(qFromBigEndian<quint64>(data + offset + 2 + nameLength));
+            span.durationUs = static_cast<qint64>(qFromBigEndian<quint64>(data + offset + 2 + nameLength + 8));
+            spans.append(span);
+            offset += 2 + nameLength + 16;
+        }
+        emit startupTrace(spans);
+        return true;
+    }
+    default:
+        break;
+    }
+
+    Tau5Logger::instance().warning(QString("Control channel: ignoring message type %1 (%2 bytes)")
+                                   .arg(static_cast<int>(type)).arg(payload.size()));
+    return true;
+}
+
+void ControlChannel::onSocketDisconnected()
+{
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if (!socket) {
+        return;
+    }
+    bool wasActive = (socket == m_socket);
+    m_buffers.remove(socket);
+    if (wasActive) {
+        m_socket = nullptr;
+        Tau5Logger::instance().debug("Control channel disconnected");
+        emit disconnected();
+    }
+    socket->deleteLater();
+}
+
+void ControlChannel::dropSocket(QTcpSocket* socket, const QString& reason)
+{
+    if (!m_buffers.contains(socket)) {
+        return;
+    }
+    Tau5Logger::instance().warning(QString("Control channel: dropping connection (%1)").arg(reason));
+
+    bool wasActive = (socket == m_socket);
+    m_buffers.remove(socket);
+    socket->disconnect(this);
+    socket->abort();
+    socket->deleteLater();
+    if (wasActive) {
+        m_socket = nullptr;
+        emit disconnected();
+    }
+}
+
+} // namespace Tau5Common
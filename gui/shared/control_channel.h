@@ -0,0 +1,113 @@
+#ifndef TAU5_CONTROL_CHANNEL_H
+#define TAU5_CONTROL_CHANNEL_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QtGlobal>
+
+class QTcpServer;
+class QTcpSocket;
+
+namespace Tau5Common {
+
+/**
+ * Wire format of the control connection between Beam and the BEAM node
+ * (Tau5.ControlChannel on the Elixir side).
+ *
+ * Every frame is a 4-byte big-endian length followed by that many bytes:
+ * a 1-byte message type, then the payload. This is Erlang's {packet, 4}
+ * framing, so the BEAM side gets whole frames from gen_tcp for free.
+ * Integers in payloads are big-endian.
+ */
+namespace ControlProtocol {
+    enum class MessageType : quint8 {
+        Hello = 1,      // BEAM -> GUI: heartbeat token; must be the first frame
+        Ready = 2,      // BEAM -> GUI: u64 OS pid, u16 HTTP port, u16 MCP port
+        Error = 3,      // BEAM -> GUI: UTF-8 startup error; the BEAM halts after it
+        Metrics = 4,    // BEAM -> GUI: see ServerMetrics
+        Heartbeat = 5,  // GUI -> BEAM: empty
+        Standby = 6,    // BEAM -> GUI: u64 OS pid; booted with no endpoints bound
+        Promote = 7,    // GUI -> BEAM: start the endpoints, then send Ready
+        Trace = 8       // BEAM -> GUI: startup phases, see BeamTraceSpan
+    };
+
+    constexpr int LENGTH_BYTES = 4;
+    constexpr quint32 MAX_FRAME_BYTES = 1024 * 1024;
+
+    QByteArray encode(MessageType type, QByteArrayView payload = {});
+}
+
+struct ServerMetrics {
+    quint64 totalMemoryBytes = 0;
+    quint64 processMemoryBytes = 0;
+    quint32 processCount = 0;
+    quint32 runQueueLength = 0;
+    quint64 uptimeMs = 0;
+};
+
+// Repeated in a Trace payload as u16 name length, UTF-8 name, u64 start
+// (wall clock, microseconds since the Unix epoch), u64 duration in microseconds
+struct BeamTraceSpan {
+    QString name;
+    qint64 startEpochUs = 0;
+    qint64 durationUs = 0;
+};
+
+/**
+ * Localhost TCP server the BEAM connects back to at startup (its port is
+ * passed in TAU5_CONTROL_PORT). Only a connection that opens with a Hello
+ * carrying the heartbeat token is trusted; anything else is dropped.
+ *
+ * The listener outlives individual connections, so a restarted BEAM
+ * simply connects again and replaces the previous connection.
+ */
+class ControlChannel : public QObject
+{
+    Q_OBJECT
+
+public:
+    // How long a new connection may take to say Hello
+    static constexpr int HELLO_TIMEOUT_MS = 5000;
+
+    ControlChannel(const QString& token, QObject* parent = nullptr);
+    ~ControlChannel();
+
+    bool listen();
+    quint16 port() const;
+    bool isConnected() const { return m_socket != nullptr; }
+
+    bool sendHeartbeat();
+    bool sendPromote();
+
+signals:
+    void connected();
+    void disconnected();
+    void ready(qint64 pid, quint16 httpPort, quint16 mcpPort);
+    void standbyReady(qint64 pid);
+    void serverError(const QString& message);
+    void metricsReceived(const Tau5Common::ServerMetrics& metrics);
+    void startupTrace(const QList<Tau5Common::BeamTraceSpan>& spans);
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+    void onSocketDisconnected();
+
+private:
+    bool handleFrame(QTcpSocket* socket, ControlProtocol::MessageType type, QByteArrayView payload);
+    void dropSocket(QTcpSocket* socket, const QString& reason);
+    bool send(ControlProtocol::MessageType type);
+
+    QString m_token;
+    QTcpServer* m_server;
+    QTcpSocket* m_socket = nullptr;             // The authenticated connection
+    QHash<QTcpSocket*, QByteArray> m_buffers;   // Partial frames per connection
+};
+
+} // namespace Tau5Common
+
+#endif // TAU5_CONTROL_CHANNEL_H
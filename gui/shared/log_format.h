@@ -0,0 +1,192 @@
+#ifndef TAU5_LOG_FORMAT_H
+#define TAU5_LOG_FORMAT_H
+
+#include <QString>
+#include <QStringView>
+#include <QByteArray>
+#include <QLatin1String>
+#include <charconv>
+#include <cstdio>
+#include <type_traits>
+
+/**
+ * fmt-style message formatting for the lazy logging macros in tau5logger.h.
+ *
+ * Placeholders are "{}" (use "{{" / "}}" for literal braces) and are filled
+ * in order. Output goes into a per-thread buffer that is reused between
+ * calls, so in synchronous mode a message that fits the buffer's existing
+ * capacity costs no allocation. The async writer keeps each message, so
+ * there the buffer is handed to the queued record and replaced with one
+ * fresh allocation per message. Missing arguments leave the "{}" in place;
+ * extra arguments are ignored.
+ */
+namespace Tau5LogFormat {
+
+inline void appendArg(QString& out, const QString& value) { out.append(value); }
+inline void appendArg(QString& out, QStringView value) { out.append(value); }
+inline void appendArg(QString& out, QLatin1String value) { out.append(value); }
+inline void appendArg(QString& out, const QByteArray& value) { out.append(QString::fromUtf8(value)); }
+inline void appendArg(QString& out, const char* value) { out.append(QString::fromUtf8(value)); }
+inline void appendArg(QString& out, char value) { out.append(QLatin1Char(value)); }
+inline void appendArg(QString& out, QChar value) { out.append(value); }
+inline void appendArg(QString& out, bool value) { out.append(value ? QLatin1String("true") : QLatin1String("false")); }
+
+template <typename T>
+inline std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>>
+appendArg(QString& out, T value)
+{
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(QLatin1String(digits, static_cast<int>(result.ptr - digits)));
+}
+
+template <typename T>
+inline std::enable_if_t<std::is_floating_point_v<T>>
+appendArg(QString& out, T value)
+{
+    char digits[32];
+    int length = std::snprintf(digits, sizeof(digits), "%g", static_cast<double>(value));
+    if (length > 0) {
+        out.append(QLatin1String(digits, qMin(length, static_cast<int>(sizeof(digits)) - 1)));
+    }
+}
+
+template <typename T>
+inline std::enable_if_t<std::is_enum_v<T>>
+appendArg(QString& out, T value)
+{
+    appendArg(out, static_cast<std::underlying_type_t<T>>(value));
+}
+
+// Copies the format text up to (not including) the next "{}" and returns
+// the position just past it, or -1 once the format is exhausted. Works on
+// both QLatin1String literals and QStringView without converting either.
+template <typename View>
+inline qsizetype appendUntilPlaceholder(QString& out, View format, qsizetype pos)
+{
+    const qsizetype length = format.size();
+    while (pos < length) {
+        QChar c = format[pos];
+        if (c == u'{' && pos + 1 < length) {
+            if (format[pos + 1] == u'}') {
+                return pos + 2;
+            }
+            if (format[pos + 1] == u'{') {
+                out.append(u'{');
+                pos += 2;
+                continue;
+            }
+        } else if (c == u'}' && pos + 1 < length && format[pos + 1] == u'}') {
+            out.append(u'}');
+            pos += 2;
+            continue;
+        }
+        out.append(c);
+        ++pos;
+    }
+    return -1;
+}
+
+template <typename View>
+inline void formatInto(QString& out, View format, qsizetype pos)
+{
+    while (pos >= 0) {
+        pos = appendUntilPlaceholder(out, format, pos);
+        if (pos >= 0) {
+            out.append(QLatin1String("{}"));
+        }
+    }
+}
+
+template <typename View, typename First, typename... Rest>
+inline void formatInto(QString& out, View format, qsizetype pos,
+                       const First& first, const Rest&... rest)
+{
+    pos = appendUntilPlaceholder(out, format, pos);
+    if (pos < 0) {
+        return;
+    }
+    appendArg(out, first);
+    formatInto(out, format, pos, rest...);
+}
+
+/**
+ * Borrows one of a small stack of thread-local buffers for the lifetime of
+ * a single log call. The stack keeps formatting re-entrant when a log call
+ * (e.g. through the logMessage signal) ends up logging again.
+ */
+class ScopedBuffer {
+public:
+    ScopedBuffer()
+    {
+        int& depth = nestingDepth();
+        m_buffer = depth < MaxDepth ? &buffers()[depth] : &m_overflow;
+        ++depth;
+        if (m_buffer->isDetached()) {
+            m_buffer->resize(0);  // Keeps capacity from previous calls
+        } else {
+            // The last message is still held elsewhere (the async queue or
+            // a queued logMessage receiver), so leave it to them and start
+            // over with the same capacity rather than detach and regrow
+            QString fresh;
+            fresh.reserve(m_buffer->capacity());
+            m_buffer->swap(fresh);
+        }
+    }
+
+    ~ScopedBuffer() { --nestingDepth(); }
+
+    ScopedBuffer(const ScopedBuffer&) = delete;
+    ScopedBuffer& operator=(const ScopedBuffer&) = delete;
+
+    template <typename... Args>
+    const QString& format(const char* format, const Args&... args)
+    {
+        // ASCII literals are scanned in place; anything else is UTF-8 and
+        // needs decoding first.
+        const char* p = format;
+        while (*p && static_cast<unsigned char>(*p) < 0x80) {
+            ++p;
+        }
+        if (*p) {
+            return this->format(QString::fromUtf8(format), args...);
+        }
+        return this->format(QLatin1String(format, p - format), args...);
+    }
+
+    template <typename... Args>
+    const QString& format(QLatin1String format, const Args&... args)
+    {
+        formatInto(*m_buffer, format, 0, args...);
+        return *m_buffer;
+    }
+
+    template <typename... Args>
+    const QString& format(const QString& format, const Args&... args)
+    {
+        formatInto(*m_buffer, QStringView(format), 0, args...);
+        return *m_buffer;
+    }
+
+private:
+    static constexpr int MaxDepth = 4;
+
+    static QString* buffers()
+    {
+        thread_local QString stack[MaxDepth];
+        return stack;
+    }
+
+    static int& nestingDepth()
+    {
+        thread_local int depth = 0;
+        return depth;
+    }
+
+    QString* m_buffer;
+    QString m_overflow;
+};
+
+} // namespace Tau5LogFormat
+
+#endif // TAU5_LOG_FORMAT_H
@@ -0,0 +1,370 @@
+#include "log_index.h"
+#include <QDate>
+#include <QDateTime>
+#include <QTime>
+#include <cstring>
+
+namespace Tau5Common {
+
+using namespace LogIndexFormat;
+
+namespace {
+
+// Log files are opened in text mode, so "\n" becomes "\r\n" on Windows
+#ifdef Q_OS_WIN
+constexpr qint64 NEWLINE_BYTES = 2;
+#else
+constexpr qint64 NEWLINE_BYTES = 1;
+#endif
+
+// Bytes QTextStream produces for this text in UTF-8 (lone surrogates are
+// written as U+FFFD, which is also three bytes)
+qint64 utf8Length(QStringView text)
+{
+    qint64 bytes = 0;
+    const qsizetype size = text.size();
+    for (qsizetype i = 0; i < size; ++i) {
+        char16_t c = text[i].unicode();
+        if (c < 0x80) {
+            bytes += 1;
+        } else if (c < 0x800) {
+            bytes += 2;
+        } else if (QChar::isHighSurrogate(c) && i + 1 < size && QChar::isLowSurrogate(text[i + 1].unicode())) {
+            bytes += 4;
+            ++i;
+        } else {
+            bytes += 3;
+        }
+    }
+    return bytes;
+}
+
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+int digits(const char* p, int count)
+{
+    int value = 0;
+    for (int i = 0; i < count; ++i) {
+        value = value * 10 + (p[i] - '0');
+    }
+    return value;
+}
+
+// Matches Tau5Logger's "yyyy-MM-dd HH:mm:ss.zzz" line prefix
+bool parseLineTimestamp(const char* line, qint64 length, qint64& outMs)
+{
+    static const char pattern[] = "dddd-dd-dd dd:dd:dd.ddd";
+    const qint64 patternLength = sizeof(pattern) - 1;
+    if (length < patternLength) {
+        return false;
+    }
+    for (qint64 i = 0; i < patternLength; ++i) {
+        if (pattern[i] == 'd' ? !isDigit(line[i]) : line[i] != pattern[i]) {
+            return false;
+        }
+    }
+
+    QDate date(digits(line, 4), digits(line + 5, 2), digits(line + 8, 2));
+    QTime time(digits(line + 11, 2), digits(line + 14, 2), digits(line + 17, 2), digits(line + 20, 3));
+    if (!date.isValid() || !time.isValid()) {
+        return false;
+    }
+    outMs = QDateTime(date, time).toMSecsSinceEpoch();
+    return true;
+}
+
+} // namespace
+
+quint8 parseLogLevelTag(const char* line, qint64 length)
+{
+    // The tag follows the 23-character timestamp and a space
+    const char* open = static_cast<const char*>(std::memchr(line, '[', static_cast<size_t>(qMin<qint64>(length, 32))));
+    if (!open) {
+        return UNKNOWN_LEVEL;
+    }
+    qint64 remaining = length - (open - line);
+
+    struct Tag { const char* text; LogLevel level; };
+    static const Tag tags[] = {
+        {"[DEBUG]", LogLevel::Debug},
+        {"[INFO]", LogLevel::Info},
+        {"[WARN]", LogLevel::Warning},
+        {"[ERROR]", LogLevel::Error},
+        {"[CRITICAL]", LogLevel::Critical},
+    };
+    for (const Tag& tag : tags) {
+        qint64 tagLength = static_cast<qint64>(std::strlen(tag.text));
+        if (remaining >= tagLength && std::memcmp(open, tag.text, static_cast<size_t>(tagLength)) == 0) {
+            return static_cast<quint8>(tag.level);
+        }
+    }
+    return UNKNOWN_LEVEL;
+}
+
+// ---------------------------------------------------------------------------
+// LogIndexWriter
+
+bool LogIndexWriter::open(const QString& logPath, qint64 logSize)
+{
+    close();
+
+    m_file.setFileName(indexPathFor(logPath));
+    qint64 indexSize = m_file.exists() ? m_file.size() : 0;
+
+    if (logSize > 0 && indexSize < HEADER_SIZE) {
+        return false;
+    }
+
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+
+    bool validHeader = false;
+    if (indexSize >= HEADER_SIZE) {
+        QByteArray header = m_file.read(HEADER_SIZE);
+        quint32 version = 0;
+        std::memcpy(&version, header.constData() + 4, sizeof(version));
+        validHeader = std::memcmp(header.constData(), MAGIC, 4) == 0 && version == VERSION;
+    }
+
+    if (!validHeader) {
+        if (logSize > 0) {
+            m_file.close();
+            return false;
+        }
+        QByteArray header(HEADER_SIZE, '\0');
+        std::memcpy(header.data(), MAGIC, 4);
+        quint32 version = VERSION;
+        quint32 entrySize = ENTRY_SIZE;
+        std::memcpy(header.data() + 4, &version, sizeof(version));
+        std::memcpy(header.data() + 8, &entrySize, sizeof(entrySize));
+        m_file.resize(0);
+        m_file.write(header);
+    } else {
+        // Drop a torn trailing entry from an interrupted write
+        qint64 whole = HEADER_SIZE + ((indexSize - HEADER_SIZE) / ENTRY_SIZE) * ENTRY_SIZE;
+        m_file.resize(whole);
+        m_file.seek(whole);
+    }
+
+    m_offset = logSize;
+    m_pending.clear();
+    return true;
+}
+
+void LogIndexWriter::close()
+{
+    if (m_file.isOpen()) {
+        flush();
+        m_file.close();
+    }
+}
+
+void LogIndexWriter::appendMessage(QStringView prefix, QStringView message,
+                                   qint64 timestampMs, LogLevel level)
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+
+    const quint8 levelValue = static_cast<quint8>(level);
+    qint64 lineStart = m_offset;
+    qint64 pos = m_offset + utf8Length(prefix);
+
+    const qsizetype size = message.size();
+    qsizetype segmentStart = 0;
+    for (qsizetype i = 0; i < size; ++i) {
+        if (message[i] == u'\n') {
+            pos += utf8Length(message.mid(segmentStart, i - segmentStart));
+            appendEntry(lineStart, timestampMs, levelValue);
+            pos += NEWLINE_BYTES;
+            lineStart = pos;
+            segmentStart = i + 1;
+        }
+    }
+    pos += utf8Length(message.mid(segmentStart));
+    appendEntry(lineStart, timestampMs, levelValue);
+    m_offset = pos + NEWLINE_BYTES;
+
+    if (m_pending.size() >= 64 * 1024) {
+        m_file.write(m_pending);
+        m_pending.clear();
+    }
+}
+
+void LogIndexWriter::appendEntry(qint64 offset, qint64 timestampMs, quint8 level)
+{
+    Entry entry;
+    entry.offsetAndLevel = (static_cast<quint64>(offset) & OFFSET_MASK) | (static_cast<quint64>(level) << 56);
+    entry.timestampMs = timestampMs;
+    m_pending.append(reinterpret_cast<const char*>(&entry), ENTRY_SIZE);
+}
+
+void LogIndexWriter::flush()
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+    if (!m_pending.isEmpty()) {
+        m_file.write(m_pending);
+        m_pending.clear();
+    }
+    m_file.flush();
+}
+
+// ---------------------------------------------------------------------------
+// LogIndexReader
+
+LogIndexReader::~LogIndexReader()
+{
+    close();
+}
+
+bool LogIndexReader::open(const QString& logPath)
+{
+    close();
+
+    m_logFile.setFileName(logPath);
+    if (!m_logFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    m_logSize = m_logFile.size();
+    if (m_logSize == 0) {
+        return true;
+    }
+
+    uchar* mappedLog = m_logFile.map(0, m_logSize);
+    if (!mappedLog) {
+        m_logFile.close();
+        return false;
+    }
+    m_logData = reinterpret_cast<const char*>(mappedLog);
+
+    m_indexFile.setFileName(indexPathFor(logPath));
+    if (m_indexFile.open(QIODevice::ReadOnly)) {
+        qint64 indexSize = m_indexFile.size();
+        uchar* mappedIndex = indexSize >= HEADER_SIZE + ENTRY_SIZE ? m_indexFile.map(0, indexSize) : nullptr;
+        quint32 version = 0;
+        if (mappedIndex) {
+            std::memcpy(&version, mappedIndex + 4, sizeof(version));
+        }
+        if (mappedIndex && std::memcmp(mappedIndex, MAGIC, 4) == 0 && version == VERSION) {
+            const Entry* entries = reinterpret_cast<const Entry*>(mappedIndex + HEADER_SIZE);
+            qint64 count = (indexSize - HEADER_SIZE) / ENTRY_SIZE;
+            if (entries[0].offset() == 0) {
+                // The index can run ahead of what has reached the log on disk
+                while (count > 0 && entries[count - 1].offset() >= m_logSize) {
+                    --count;
+                }
+                m_mappedEntries = entries;
+                m_mappedCount = count;
+            }
+        }
+    }
+
+    if (m_mappedCount > 0) {
+        const Entry& last = m_mappedEntries[m_mappedCount - 1];
+        const char* lineStart = m_logData + last.offset();
+        const char* newline = static_cast<const char*>(
+            std::memchr(lineStart, '\n', static_cast<size_t>(m_logSize - last.offset())));
+        if (newline) {
+            indexTail(newline - m_logData + 1, last.level(), last.timestampMs);
+        }
+    } else {
+        indexTail(0, UNKNOWN_LEVEL, 0);
+    }
+
+    return true;
+}
+
+void LogIndexReader::close()
+{
+    if (m_logData) {
+        m_logFile.unmap(reinterpret_cast<uchar*>(const_cast<char*>(m_logData)));
+    }
+    if (m_mappedEntries) {
+        m_indexFile.unmap(reinterpret_cast<uchar*>(const_cast<Entry*>(m_mappedEntries)) - HEADER_SIZE);
+    }
+    m_logFile.close();
+    m_indexFile.close();
+    m_logData = nullptr;
+    m_logSize = 0;
+    m_mappedEntries = nullptr;
+    m_mappedCount = 0;
+    m_extra.clear();
+}
+
+void LogIndexReader::indexTail(qint64 fromOffset, quint8 level, qint64 timestampMs)
+{
+    qint64 pos = fromOffset;
+    while (pos < m_logSize) {
+        const char* lineStart = m_logData + pos;
+        const char* newline = static_cast<const char*>(
+            std::memchr(lineStart, '\n', static_cast<size_t>(m_logSize - pos)));
+        qint64 length = newline ? newline - lineStart : m_logSize - pos;
+
+        // Lines without a timestamp continue the previous message
+        qint64 lineMs;
+        if (parseLineTimestamp(lineStart, length, lineMs)) {
+            timestampMs = lineMs;
+            level = parseLogLevelTag(lineStart, length);
+        }
+
+        Entry entry;
+        entry.offsetAndLevel = (static_cast<quint64>(pos) & OFFSET_MASK) | (static_cast<quint64>(level) << 56);
+        entry.timestampMs = timestampMs;
+        m_extra.append(entry);
+
+        pos += length + 1;
+    }
+}
+
+QByteArray LogIndexReader::lineBytes(qint64 index) const
+{
+    if (index < 0 || index >= lineCount()) {
+        return QByteArray();
+    }
+
+    qint64 start = entry(index).offset();
+    qint64 end = index + 1 < lineCount() ? entry(index + 1).offset() : m_logSize;
+    end = qMin(end, m_logSize);
+
+    while (end > start && (m_logData[end - 1] == '\n' || m_logData[end - 1] == '\r')) {
+        --end;
+    }
+    // fromRawData: the bytes stay in the mapping, nothing is copied here
+    return QByteArray::fromRawData(m_logData + start, static_cast<qsizetype>(end - start));
+}
+
+qint64 LogIndexReader::lineAtOffset(qint64 offset) const
+{
+    qint64 low = 0;
+    qint64 high = lineCount();
+    while (low < high) {
+        qint64 mid = low + (high - low) / 2;
+        if (entry(mid).offset() <= offset) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return qMax<qint64>(0, low - 1);
+}
+
+qint64 LogIndexReader::lowerBoundTime(qint64 ms) const
+{
+    qint64 low = 0;
+    qint64 high = lineCount();
+    while (low < high) {
+        qint64 mid = low + (high - low) / 2;
+        if (entry(mid).timestampMs < ms) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+} // namespace Tau5Common
@@ -0,0 +1,145 @@
+#ifndef TAU5_LOG_INDEX_H
+#define TAU5_LOG_INDEX_H
+
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <QVector>
+#include <QtGlobal>
+#include "tau5logger.h"
+
+namespace Tau5Common {
+
+/**
+ * Sidecar line index for plain-text session logs ("gui.log" -> "gui.log.idx").
+ *
+ * The index is a 32-byte header followed by one fixed 16-byte entry per
+ * physical log line:
+ *
+ *   quint64 offsetAndLevel   byte offset of the line start (low 56 bits),
+ *                            LogLevel in the top byte (0xFF = unknown)
+ *   qint64  timestampMs      msecs since epoch of the record the line belongs to
+ *
+ * Entries are appended as lines are written, so the index is always a
+ * prefix of the log. Continuation lines of a multi-line message share the
+ * message's level and timestamp.
+ */
+namespace LogIndexFormat {
+    constexpr char MAGIC[4] = {'T', '5', 'L', 'I'};
+    constexpr quint32 VERSION = 1;
+    constexpr int HEADER_SIZE = 32;
+    constexpr int ENTRY_SIZE = 16;
+    constexpr quint64 OFFSET_MASK = (quint64(1) << 56) - 1;
+    constexpr quint8 UNKNOWN_LEVEL = 0xFF;
+
+    struct Entry {
+        quint64 offsetAndLevel;
+        qint64 timestampMs;
+
+        qint64 offset() const { return static_cast<qint64>(offsetAndLevel & OFFSET_MASK); }
+        quint8 level() const { return static_cast<quint8>(offsetAndLevel >> 56); }
+    };
+
+    // Sidecar path for a given log file
+    inline QString indexPathFor(const QString& logPath) { return logPath + ".idx"; }
+}
+
+/**
+ * Appends index entries alongside Tau5Logger's plain-text writes. Tracks the
+ * log's byte offset itself by measuring the UTF-8 length of what is written.
+ */
+class LogIndexWriter {
+public:
+    // logSize is the current size of the log being appended to. Indexing is
+    // skipped for a non-empty log with no matching index, since the entries
+    // would not start at line 1.
+    bool open(const QString& logPath, qint64 logSize);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+
+    // Record one logical message written as prefix + message + newline
+    void appendMessage(QStringView prefix, QStringView message,
+                       qint64 timestampMs, LogLevel level);
+    void flush();
+
+private:
+    void appendEntry(qint64 offset, qint64 timestampMs, quint8 level);
+
+    QFile m_file;
+    qint64 m_offset = 0;
+    QByteArray m_pending;
+};
+
+/**
+ * Read-only view of a log file and its sidecar index, both memory mapped.
+ *
+ * Lines are addressed by 0-based index. Only the bytes of lines that are
+ * actually requested through line() are touched; range, level and time
+ * lookups are answered from the index. Lines written after the last index
+ * entry (or a whole log with no usable index) are indexed in memory on open.
+ */
+class LogIndexReader {
+public:
+    LogIndexReader() = default;
+    ~LogIndexReader();
+
+    LogIndexReader(const LogIndexReader&) = delete;
+    LogIndexReader& operator=(const LogIndexReader&) = delete;
+
+    bool open(const QString& logPath);
+    void close();
+
+    qint64 lineCount() const { return m_mappedCount + m_extra.size(); }
+    bool usedSidecar() const { return m_mappedCount > 0; }
+
+    // Raw UTF-8 bytes of a line without its line terminator
+    QByteArray lineBytes(qint64 index) const;
+    QString line(qint64 index) const { return QString::fromUtf8(lineBytes(index)); }
+
+    // Byte offset where a line starts; lineCount() maps to the end of the log
+    qint64 lineStart(qint64 index) const {
+        return index < lineCount() ? entry(index).offset() : m_logSize;
+    }
+    // Line containing the given byte offset
+    qint64 lineAtOffset(qint64 offset) const;
+
+    quint8 level(qint64 index) const { return entry(index).level(); }
+    qint64 timestampMs(qint64 index) const { return entry(index).timestampMs; }
+
+    // Bitmask over LogLevel values; bit n set means level n matches
+    static quint32 levelBit(LogLevel level) { return 1u << static_cast<int>(level); }
+
+    // Whether a line's level is in levelMask, read from its index entry
+    // without touching the log
+    bool levelMatches(qint64 index, quint32 levelMask) const {
+        quint8 lineLevel = level(index);
+        return lineLevel < 32 && (levelMask & (1u << lineLevel)) != 0;
+    }
+
+    // First line whose timestamp is >= ms (timestamps are non-decreasing)
+    qint64 lowerBoundTime(qint64 ms) const;
+
+    const char* data() const { return m_logData; }
+    qint64 size() const { return m_logSize; }
+
+private:
+    LogIndexFormat::Entry entry(qint64 index) const {
+        return index < m_mappedCount ? m_mappedEntries[index] : m_extra.at(index - m_mappedCount);
+    }
+    void indexTail(qint64 fromOffset, quint8 level, qint64 timestampMs);
+
+    QFile m_logFile;
+    QFile m_indexFile;
+    const char* m_logData = nullptr;
+    qint64 m_logSize = 0;
+    const LogIndexFormat::Entry* m_mappedEntries = nullptr;
+    qint64 m_mappedCount = 0;
+    QVector<LogIndexFormat::Entry> m_extra;
+};
+
+// Parse the "[LEVEL]" tag Tau5Logger writes after the timestamp
+quint8 parseLogLevelTag(const char* line, qint64 length);
+
+} // namespace Tau5Common
+
+#endif // TAU5_LOG_INDEX_H
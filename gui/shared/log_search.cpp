@@ -0,0 +1,425 @@
+#include "log_search.h"
+#include "log_index.h"
+#include <QtAlgorithms>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TAU5_SEARCH_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define TAU5_SEARCH_NEON
+#endif
+
+namespace Tau5Common {
+
+namespace {
+
+// Matches found per chunk are buffered so the chunk can be reported newest-first
+constexpr qint64 REVERSE_CHUNK_BYTES = 4 * 1024 * 1024;
+
+inline char asciiLower(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c | 0x20) : c;
+}
+
+inline bool isAsciiLetter(char c)
+{
+    char lower = static_cast<char>(c | 0x20);
+    return lower >= 'a' && lower <= 'z';
+}
+
+bool equalsFolded(const char* data, const char* folded, qint64 length)
+{
+    for (qint64 i = 0; i < length; ++i) {
+        if (asciiLower(data[i]) != folded[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+qint64 utf8Length(QStringView text)
+{
+    qint64 bytes = 0;
+    const qsizetype size = text.size();
+    for (qsizetype i = 0; i < size; ++i) {
+        char16_t c = text[i].unicode();
+        if (c < 0x80) {
+            bytes += 1;
+        } else if (c < 0x800) {
+            bytes += 2;
+        } else if (QChar::isHighSurrogate(c) && i + 1 < size && QChar::isLowSurrogate(text[i + 1].unicode())) {
+            bytes += 4;
+            ++i;
+        } else {
+            bytes += 3;
+        }
+    }
+    return bytes;
+}
+
+// UTF-16 code units encoded by data[0, length)
+qsizetype utf16Length(const char* data, qint64 length)
+{
+    qsizetype units = 0;
+    for (qint64 i = 0; i < length; ++i) {
+        unsigned char b = static_cast<unsigned char>(data[i]);
+        if ((b & 0xC0) != 0x80) {
+            units += b >= 0xF0 ? 2 : 1;
+        }
+    }
+    return units;
+}
+
+// The run of plain characters a regex match must start with, e.g. "Beam"
+// for "Beam (started|stopped)". Empty when the pattern has a top-level
+// alternation or does not start with a literal.
+QString leadingLiteral(const QString& pattern, bool caseInsensitive)
+{
+    static const QString metaCharacters = QStringLiteral("^$.|?*+()[]{}");
+
+    bool escaped = false;
+    for (QChar c : pattern) {
+        if (escaped) {
+            escaped = false;
+        } else if (c == u'\\') {
+            escaped = true;
+        } else if (c == u'|') {
+            return QString();
+        }
+    }
+
+    QString literal;
+    const qsizetype length = pattern.size();
+    qsizetype i = pattern.startsWith(u'^') ? 1 : 0;
+    while (i < length) {
+        QChar c = pattern[i];
+        qsizetype next = i + 1;
+        if (c == u'\\') {
+            // \d, \w, \Q, back-references... are not literals
+            if (next >= length || pattern[next].isLetterOrNumber()) {
+                break;
+            }
+            c = pattern[next];
+            ++next;
+        } else if (metaCharacters.contains(c)) {
+            break;
+        }
+
+        // PCRE folds non-ASCII by Unicode rules the byte prefilter can't follow
+        if (caseInsensitive && c.unicode() >= 0x80) {
+            break;
+        }
+
+        if (next < length) {
+            QChar quantifier = pattern[next];
+            if (quantifier == u'?' || quantifier == u'*' || quantifier == u'{') {
+                break;
+            }
+            if (quantifier == u'+') {
+                literal.append(c);
+                break;
+            }
+        }
+        literal.append(c);
+        i = next;
+    }
+    return literal;
+}
+
+} // namespace
+
+qint64 findFirstByte(const char* data, qint64 length, char c, bool foldAscii)
+{
+    if (length <= 0) {
+        return -1;
+    }
+
+    if (!foldAscii || !isAsciiLetter(c)) {
+        const void* hit = std::memchr(data, c, static_cast<size_t>(length));
+        return hit ? static_cast<const char*>(hit) - data : -1;
+    }
+
+    // For letters, (b | 0x20) == lower holds for exactly the two cases of c
+    const char lower = static_cast<char>(c | 0x20);
+    qint64 i = 0;
+#if defined(TAU5_SEARCH_SSE2)
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    const __m128i target = _mm_set1_epi8(lower);
+    for (; i + 16 <= length; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(chunk, caseBit), target));
+        if (mask) {
+            return i + qCountTrailingZeroBits(static_cast<quint32>(mask));
+        }
+    }
+#elif defined(TAU5_SEARCH_NEON)
+    const uint8x16_t caseBit = vdupq_n_u8(0x20);
+    const uint8x16_t target = vdupq_n_u8(static_cast<uint8_t>(lower));
+    for (; i + 16 <= length; i += 16) {
+        uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+        if (vmaxvq_u8(vceqq_u8(vorrq_u8(chunk, caseBit), target))) {
+            break;  // The scalar loop below pins down the lane
+        }
+    }
+#endif
+    for (; i < length; ++i) {
+        if (static_cast<char>(data[i] | 0x20) == lower) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+LogSearch LogSearch::literal(const QString& needle, Qt::CaseSensitivity cs)
+{
+    LogSearch search;
+    if (needle.isEmpty()) {
+        return search;
+    }
+
+    bool ascii = true;
+    for (QChar c : needle) {
+        if (c.unicode() >= 0x80) {
+            ascii = false;
+            break;
+        }
+    }
+    if (cs == Qt::CaseInsensitive && !ascii) {
+        return regex(QRegularExpression::escape(needle), cs);
+    }
+
+    search.m_prefix = needle.toUtf8();
+    search.m_foldAscii = cs == Qt::CaseInsensitive;
+    if (search.m_foldAscii) {
+        search.m_prefixFolded = search.m_prefix.toLower();
+    }
+    return search;
+}
+
+LogSearch LogSearch::regex(const QString& pattern, Qt::CaseSensitivity cs)
+{
+    LogSearch search;
+    search.m_isRegex = true;
+
+    QRegularExpression::PatternOptions options = QRegularExpression::NoPatternOption;
+    if (cs == Qt::CaseInsensitive) {
+        options |= QRegularExpression::CaseInsensitiveOption;
+    }
+    search.m_regex = QRegularExpression(pattern, options);
+    if (!search.m_regex.isValid()) {
+        return search;
+    }
+    search.m_regex.optimize();
+
+    search.m_prefix = leadingLiteral(pattern, cs == Qt::CaseInsensitive).toUtf8();
+    search.m_foldAscii = cs == Qt::CaseInsensitive;
+    if (search.m_foldAscii) {
+        search.m_prefixFolded = search.m_prefix.toLower();
+    }
+    return search;
+}
+
+qint64 LogSearch::findCandidate(const char* data, qint64 length, qint64 from) const
+{
+    const qint64 prefixLength = m_prefix.size();
+    if (prefixLength == 0) {
+        return from < length ? from : -1;
+    }
+
+    const char* rest = m_foldAscii ? m_prefixFolded.constData() + 1 : m_prefix.constData() + 1;
+    qint64 pos = from;
+    while (pos + prefixLength <= length) {
+        qint64 hit = findFirstByte(data + pos, length - pos - prefixLength + 1, m_prefix[0], m_foldAscii);
+        if (hit < 0) {
+            return -1;
+        }
+        pos += hit;
+        bool equal = m_foldAscii
+            ? equalsFolded(data + pos + 1, rest, prefixLength - 1)
+            : std::memcmp(data + pos + 1, rest, static_cast<size_t>(prefixLength - 1)) == 0;
+        if (equal) {
+            return pos;
+        }
+        ++pos;
+    }
+    return -1;
+}
+
+bool LogSearch::regexMatchInLine(const char* line, qint64 length, qint64 from, Match& match) const
+{
+    while (length > 0 && line[length - 1] == '\r') {
+        --length;
+    }
+    if (from > length) {
+        return false;
+    }
+
+    QString text = QString::fromUtf8(line, static_cast<qsizetype>(length));
+    QRegularExpressionMatch result = m_regex.match(text, utf16Length(line, from));
+    if (!result.hasMatch()) {
+        return false;
+    }
+    QStringView view(text);
+    match.start = utf8Length(view.left(result.capturedStart()));
+    match.end = match.start + utf8Length(view.mid(result.capturedStart(), result.capturedLength()));
+    return true;
+}
+
+bool LogSearch::findNext(const char* data, qint64 length, qint64 from, Match& match) const
+{
+    if (!m_isRegex) {
+        qint64 hit = isEmpty() ? -1 : findCandidate(data, length, from);
+        if (hit < 0) {
+            return false;
+        }
+        match.start = hit;
+        match.end = hit + m_prefix.size();
+        return true;
+    }
+
+    if (!m_regex.isValid()) {
+        return false;
+    }
+
+    qint64 pos = from;
+    while (pos <= length) {
+        qint64 hit = findCandidate(data, length, pos);
+        if (hit < 0) {
+            // An empty line at the very end can still match, e.g. "^$"
+            if (m_prefix.isEmpty() && pos == length && (length == 0 || data[length - 1] == '\n')) {
+                hit = pos;
+            } else {
+                return false;
+            }
+        }
+
+        qint64 lineStart = hit;
+        while (lineStart > 0 && data[lineStart - 1] != '\n') {
+            --lineStart;
+        }
+        const void* newline = std::memchr(data + hit, '\n', static_cast<size_t>(length - hit));
+        qint64 lineEnd = newline ? static_cast<const char*>(newline) - data : length;
+
+        if (regexMatchInLine(data + lineStart, lineEnd - lineStart, qMax(from, lineStart) - lineStart, match)) {
+            match.start += lineStart;
+            match.end += lineStart;
+            return true;
+        }
+        if (lineEnd >= length) {
+            return false;
+        }
+        pos = lineEnd + 1;
+    }
+    return false;
+}
+
+bool LogSearch::matchesLine(const char* line, qint64 length) const
+{
+    if (isEmpty()) {
+        return true;
+    }
+    if (findCandidate(line, length, 0) < 0 && !(m_isRegex && m_prefix.isEmpty())) {
+        return false;
+    }
+    if (!m_isRegex) {
+        return true;
+    }
+    Match match;
+    return m_regex.isValid() && regexMatchInLine(line, length, 0, match);
+}
+
+QVector<qint64> LogSearch::matchingLines(const LogIndexReader& reader, qint64 first, qint64 last,
+                                         int maxResults,
+                                         const std::function<bool(qint64)>& lineFilter) const
+{
+    QVector<qint64> results;
+    first = qMax<qint64>(0, first);
+    last = qMin(last, reader.lineCount());
+    if (maxResults <= 0 || first >= last || !isValid()) {
+        return results;
+    }
+
+    const char* data = reader.data();
+    const qint64 prefixLength = m_prefix.size();
+    QVector<qint64> chunkHits;
+
+    qint64 endLine = last;
+    while (endLine > first && results.size() < maxResults) {
+        const qint64 chunkEnd = reader.lineStart(endLine);
+        const qint64 startLine = qMax(first, qMin(endLine - 1,
+            reader.lineAtOffset(qMax<qint64>(0, chunkEnd - REVERSE_CHUNK_BYTES))));
+
+        chunkHits.clear();
+        qint64 pos = reader.lineStart(startLine);
+        while (pos < chunkEnd) {
+            qint64 hit = findCandidate(data, chunkEnd, pos);
+            if (hit < 0) {
+                break;
+            }
+
+            const qint64 line = reader.lineAtOffset(hit);
+            const qint64 lineBegin = reader.lineStart(line);
+            const qint64 lineEnd = reader.lineStart(line + 1);
+            qint64 contentEnd = lineEnd;
+            while (contentEnd > lineBegin && (data[contentEnd - 1] == '\n' || data[contentEnd - 1] == '\r')) {
+                --contentEnd;
+            }
+
+            bool matched = !lineFilter || lineFilter(line);
+            if (matched) {
+                if (m_isRegex) {
+                    Match match;
+                    matched = regexMatchInLine(data + lineBegin, contentEnd - lineBegin, 0, match);
+                } else {
+                    matched = hit + prefixLength <= contentEnd;
+                }
+            }
+            if (matched) {
+                chunkHits.append(line);
+            }
+            pos = lineEnd;
+        }
+
+        for (qsizetype i = chunkHits.size() - 1; i >= 0 && results.size() < maxResults; --i) {
+            results.append(chunkHits.at(i));
+        }
+        endLine = startLine;
+    }
+    return results;
+}
+
+QVector<QPair<int, int>> LogSearch::findAll(const QString& text) const
+{
+    QVector<QPair<int, int>> results;
+    if (isEmpty() || !isValid()) {
+        return results;
+    }
+
+    const QByteArray utf8 = text.toUtf8();
+    const char* data = utf8.constData();
+    const qint64 length = utf8.size();
+
+    // Matches come back in order, so byte offsets convert to UTF-16 positions
+    // in a single forward walk
+    qint64 bytePos = 0;
+    qsizetype charPos = 0;
+    auto advanceTo = [&](qint64 target) {
+        charPos += utf16Length(data + bytePos, target - bytePos);
+        bytePos = target;
+    };
+
+    qint64 from = 0;
+    Match match;
+    while (from <= length && findNext(data, length, from, match)) {
+        advanceTo(match.start);
+        int start = static_cast<int>(charPos);
+        advanceTo(match.end);
+        results.append(qMakePair(start, static_cast<int>(charPos)));
+        from = match.end > match.start ? match.end : match.end + 1;
+    }
+    return results;
+}
+
+} // namespace Tau5Common
@@ -0,0 +1,81 @@
+#ifndef TAU5_LOG_SEARCH_H
+#define TAU5_LOG_SEARCH_H
+
+#include <QString>
+#include <QByteArray>
+#include <QRegularExpression>
+#include <QVector>
+#include <QtGlobal>
+#include <functional>
+
+namespace Tau5Common {
+
+class LogIndexReader;
+
+/**
+ * Line-oriented search over raw UTF-8 log bytes.
+ *
+ * Candidates are located with a first-byte scan (memchr, or an SSE2/NEON
+ * loop when ASCII case folding is needed) followed by a byte compare of the
+ * rest of the literal. Literal searches never decode the log. Regex searches
+ * use the pattern's leading literal, when it has one, as the prefilter and
+ * only decode and run QRegularExpression on lines that contain it.
+ *
+ * Case-insensitive literals fold ASCII in place; a case-insensitive literal
+ * with non-ASCII characters is run as an escaped regex so it gets the same
+ * Unicode folding QString::contains() would apply.
+ */
+class LogSearch {
+public:
+    struct Match {
+        qint64 start = 0;  // Byte offsets into the searched buffer
+        qint64 end = 0;
+    };
+
+    LogSearch() = default;
+
+    static LogSearch literal(const QString& needle, Qt::CaseSensitivity cs);
+    // Check isValid() / errorString() afterwards
+    static LogSearch regex(const QString& pattern, Qt::CaseSensitivity cs);
+
+    bool isEmpty() const { return !m_isRegex && m_prefix.isEmpty(); }
+    bool isValid() const { return !m_isRegex || m_regex.isValid(); }
+    QString errorString() const { return m_regex.errorString(); }
+
+    // Next match starting at or after from in data[0, length). Regex
+    // matches never span a line break.
+    bool findNext(const char* data, qint64 length, qint64 from, Match& match) const;
+
+    // Whether one line (without its terminator) contains a match
+    bool matchesLine(const char* line, qint64 length) const;
+
+    // Newest-first indices of matching lines in [first, last), up to
+    // maxResults. The log is scanned backwards in chunks so a search that
+    // fills maxResults near the end never touches the start of the file.
+    // lineFilter, when set, is consulted before a line is verified.
+    QVector<qint64> matchingLines(const LogIndexReader& reader, qint64 first, qint64 last,
+                                  int maxResults,
+                                  const std::function<bool(qint64)>& lineFilter = {}) const;
+
+    // All matches in an in-memory string, as UTF-16 [start, end) pairs
+    QVector<QPair<int, int>> findAll(const QString& text) const;
+
+private:
+    // Offset of the next prefilter hit in [from, length), or -1
+    qint64 findCandidate(const char* data, qint64 length, qint64 from) const;
+    bool regexMatchInLine(const char* line, qint64 length, qint64 from, Match& match) const;
+
+    QByteArray m_prefix;        // UTF-8 literal every match must contain
+    QByteArray m_prefixFolded;  // Lower-cased prefix when m_foldAscii is set
+    bool m_foldAscii = false;
+    bool m_isRegex = false;
+    QRegularExpression m_regex;
+};
+
+// Offset of the first byte equal to c (or to its other ASCII case when
+// foldAscii is set) in data[0, length), or -1
+qint64 findFirstByte(const char* data, qint64 length, char c, bool foldAscii);
+
+} // namespace Tau5Common
+
+#endif // TAU5_LOG_SEARCH_H
@@ -0,0 +1,306 @@
+#include "process_control.h"
+#include <QDeadlineTimer>
+#include <QThread>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <tlhelp32.h>
+#include <QList>
+#include <QMultiHash>
+#else
+#include <cerrno>
+#include <csignal>
+#include <poll.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#ifdef Q_OS_LINUX
+#include <sys/syscall.h>
+#endif
+
+#ifdef Q_OS_MACOS
+#include <sys/event.h>
+#include <sys/time.h>
+#endif
+
+namespace Tau5Common {
+namespace ProcessControl {
+
+namespace {
+
+// How long to wait for a force-killed process to disappear
+constexpr int FORCE_KILL_CONFIRM_MS = 2000;
+
+// Fallback probing: start fast, since most shutdowns finish in a few
+// milliseconds, and back off so a slow one doesn't spin
+constexpr int PROBE_INITIAL_MS = 1;
+constexpr int PROBE_MAX_MS = 50;
+
+enum class WaitResult { Exited, TimedOut, Unsupported };
+
+bool probeForExit(qint64 pid, int timeoutMs)
+{
+    QDeadlineTimer deadline(timeoutMs < 0 ? QDeadlineTimer::Forever : QDeadlineTimer(timeoutMs));
+    int interval = PROBE_INITIAL_MS;
+    while (isRunning(pid)) {
+        if (deadline.hasExpired()) {
+            return false;
+        }
+        qint64 remaining = deadline.remainingTime();
+        QThread::msleep(static_cast<unsigned long>(remaining < 0 ? interval : qMin<qint64>(interval, remaining)));
+        interval = qMin(interval * 2, PROBE_MAX_MS);
+    }
+    return true;
+}
+
+#if defined(Q_OS_LINUX)
+
+WaitResult waitForExitNative(qint64 pid, int timeoutMs)
+{
+#ifdef SYS_pidfd_open
+    int pidfd = static_cast<int>(::syscall(SYS_pidfd_open, static_cast<pid_t>(pid), 0));
+    if (pidfd < 0) {
+        return errno == ESRCH ? WaitResult::Exited : WaitResult::Unsupported;
+    }
+
+    // The pidfd becomes readable the moment the process exits
+    QDeadlineTimer deadline(timeoutMs < 0 ? QDeadlineTimer::Forever : QDeadlineTimer(timeoutMs));
+    int ready;
+    do {
+        pollfd fd = {pidfd, POLLIN, 0};
+        qint64 remaining = deadline.remainingTime();
+        ready = ::poll(&fd, 1, remaining < 0 ? -1 : static_cast<int>(remaining));
+    } while (ready < 0 && errno == EINTR);
+
+    ::close(pidfd);
+    if (ready < 0) {
+        return WaitResult::Unsupported;
+    }
+    return ready > 0 ? WaitResult::Exited : WaitResult::TimedOut;
+#else
+    Q_UNUSED(pid);
+    Q_UNUSED(timeoutMs);
+    return WaitResult::Unsupported;
+#endif
+}
+
+#elif defined(Q_OS_MACOS)
+
+WaitResult waitForExitNative(qint64 pid, int timeoutMs)
+{
+    int kq = ::kqueue();
+    if (kq < 0) {
+        return WaitResult::Unsupported;
+    }
+
+    struct kevent change;
+    EV_SET(&change, static_cast<uintptr_t>(pid), EVFILT_PROC, EV_ADD | EV_ONESHOT, NOTE_EXIT, 0, nullptr);
+    if (::kevent(kq, &change, 1, nullptr, 0, nullptr) < 0) {
+        int error = errno;
+        ::close(kq);
+        return error == ESRCH ? WaitResult::Exited : WaitResult::Unsupported;
+    }
+
+    QDeadlineTimer deadline(timeoutMs < 0 ? QDeadlineTimer::Forever : QDeadlineTimer(timeoutMs));
+    int ready;
+    do {
+        struct kevent event;
+        qint64 remaining = deadline.remainingTime();
+        struct timespec timeout = {static_cast<time_t>(remaining / 1000), static_cast<long>((remaining % 1000) * 1000000)};
+        ready = ::kevent(kq, nullptr, 0, &event, 1, remaining < 0 ? nullptr : &timeout);
+    } while (ready < 0 && errno == EINTR);
+
+    ::close(kq);
+    if (ready < 0) {
+        return WaitResult::Unsupported;
+    }
+    return ready > 0 ? WaitResult::Exited : WaitResult::TimedOut;
+}
+
+#elif defined(Q_OS_WIN)
+
+WaitResult waitForExitNative(qint64 pid, int timeoutMs)
+{
+    HANDLE handle = OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(pid));
+    if (!handle) {
+        return GetLastError() == ERROR_INVALID_PARAMETER ? WaitResult::Exited : WaitResult::Unsupported;
+    }
+    DWORD result = WaitForSingleObject(handle, timeoutMs < 0 ? INFINITE : static_cast<DWORD>(timeoutMs));
+    CloseHandle(handle);
+    if (result == WAIT_FAILED) {
+        return WaitResult::Unsupported;
+    }
+    return result == WAIT_OBJECT_0 ? WaitResult::Exited : WaitResult::TimedOut;
+}
+
+// pid followed by all of its descendants, like taskkill /T
+QList<DWORD> processTree(DWORD pid)
+{
+    QList<DWORD> tree{pid};
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+    if (snapshot == INVALID_HANDLE_VALUE) {
+        return tree;
+    }
+
+    QMultiHash<DWORD, DWORD> children;
+    PROCESSENTRY32W entry;
+    entry.dwSize = sizeof(entry);
+    for (BOOL ok = Process32FirstW(snapshot, &entry); ok; ok = Process32NextW(snapshot, &entry)) {
+        if (entry.th32ProcessID != entry.th32ParentProcessID) {
+            children.insert(entry.th32ParentProcessID, entry.th32ProcessID);
+        }
+    }
+    CloseHandle(snapshot);
+
+    for (qsizetype i = 0; i < tree.size(); ++i) {
+        for (DWORD child : children.values(tree.at(i))) {
+            if (!tree.contains(child)) {
+                tree.append(child);
+            }
+        }
+    }
+    return tree;
+}
+
+struct CloseRequest {
+    QList<DWORD> tree;
+    bool posted = false;
+};
+
+BOOL CALLBACK postCloseToWindow(HWND window, LPARAM param)
+{
+    CloseRequest* request = reinterpret_cast<CloseRequest*>(param);
+    DWORD owner = 0;
+    GetWindowThreadProcessId(window, &owner);
+    if (request->tree.contains(owner) && PostMessageW(window, WM_CLOSE, 0, 0)) {
+        request->posted = true;
+    }
+    return TRUE;
+}
+
+#else
+
+WaitResult waitForExitNative(qint64 pid, int timeoutMs)
+{
+    Q_UNUSED(pid);
+    Q_UNUSED(timeoutMs);
+    return WaitResult::Unsupported;
+}
+
+#endif
+
+} // namespace
+
+bool isRunning(qint64 pid)
+{
+    if (pid <= 0) {
+        return false;
+    }
+#ifdef Q_OS_WIN
+    HANDLE handle = OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(pid));
+    if (!handle) {
+        // Access denied means it exists but belongs to someone else
+        return GetLastError() == ERROR_ACCESS_DENIED;
+    }
+    bool running = WaitForSingleObject(handle, 0) == WAIT_TIMEOUT;
+    CloseHandle(handle);
+    return running;
+#else
+    return ::kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+bool requestTermination(qint64 pid)
+{
+    if (pid <= 0) {
+        return false;
+    }
+#ifdef Q_OS_WIN
+    // What taskkill does without /F. A console process has no windows to
+    // close, in which case there is nothing graceful to wait for.
+    CloseRequest request;
+    request.tree = processTree(static_cast<DWORD>(pid));
+    EnumWindows(postCloseToWindow, reinterpret_cast<LPARAM>(&request));
+    return request.posted;
+#else
+    return ::kill(static_cast<pid_t>(pid), SIGTERM) == 0;
+#endif
+}
+
+bool forceKill(qint64 pid)
+{
+    if (pid <= 0) {
+        return false;
+    }
+#ifdef Q_OS_WIN
+    bool killedRoot = false;
+    const QList<DWORD> tree = processTree(static_cast<DWORD>(pid));
+    for (DWORD member : tree) {
+        HANDLE handle = OpenProcess(PROCESS_TERMINATE, FALSE, member);
+        if (!handle) {
+            continue;
+        }
+        if (TerminateProcess(handle, 1) && member == static_cast<DWORD>(pid)) {
+            killedRoot = true;
+        }
+        CloseHandle(handle);
+    }
+    return killedRoot;
+#else
+    return ::kill(static_cast<pid_t>(pid), SIGKILL) == 0;
+#endif
+}
+
+bool waitForExit(qint64 pid, int timeoutMs)
+{
+    if (pid <= 0) {
+        return true;
+    }
+    switch (waitForExitNative(pid, timeoutMs)) {
+    case WaitResult::Exited:
+        return true;
+    case WaitResult::TimedOut:
+        return false;
+    case WaitResult::Unsupported:
+        break;
+    }
+    return probeForExit(pid, timeoutMs);
+}
+
+StopResult stop(qint64 pid, int graceMs)
+{
+    if (!isRunning(pid)) {
+        return StopResult::NotRunning;
+    }
+
+    if (requestTermination(pid) && waitForExit(pid, qMax(0, graceMs))) {
+        return StopResult::Exited;
+    }
+    if (!isRunning(pid)) {
+        return StopResult::Exited;
+    }
+
+    if (!forceKill(pid) && isRunning(pid)) {
+        return StopResult::Failed;
+    }
+    return waitForExit(pid, FORCE_KILL_CONFIRM_MS) ? StopResult::Killed : StopResult::Failed;
+}
+
+const char* toString(StopResult result)
+{
+    switch (result) {
+    case StopResult::NotRunning:
+        return "not running";
+    case StopResult::Exited:
+        return "exited";
+    case StopResult::Killed:
+        return "killed";
+    case StopResult::Failed:
+        return "failed";
+    }
+    return "unknown";
+}
+
+} // namespace ProcessControl
+} // namespace Tau5Common
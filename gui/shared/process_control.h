@@ -0,0 +1,51 @@
+#ifndef TAU5_PROCESS_CONTROL_H
+#define TAU5_PROCESS_CONTROL_H
+
+#include <QtGlobal>
+
+namespace Tau5Common {
+
+/**
+ * Native control of processes by PID, without spawning kill/taskkill.
+ *
+ * Waiting for exit is event-driven where the OS allows it: a pidfd on
+ * Linux (5.3+), a kqueue EVFILT_PROC filter on macOS and the process
+ * handle on Windows. Other systems, and older Linux kernels, fall back to
+ * probing with kill(pid, 0) on a short backoff.
+ *
+ * None of this reaps the process. The BEAM is usually a child of a
+ * QProcess, which owns reaping and its exit status.
+ */
+namespace ProcessControl {
+
+    enum class StopResult {
+        NotRunning,  // Already gone before anything was sent
+        Exited,      // Exited within the grace period
+        Killed,      // Force-killed once the grace period ran out
+        Failed       // Still running, or could not be signalled
+    };
+
+    // Default time between the graceful request and the force kill
+    constexpr int DEFAULT_GRACE_MS = 5000;
+
+    bool isRunning(qint64 pid);
+
+    // SIGTERM on Unix; WM_CLOSE to the process tree's windows on Windows
+    bool requestTermination(qint64 pid);
+
+    // SIGKILL on Unix; TerminateProcess on the whole tree on Windows
+    bool forceKill(qint64 pid);
+
+    // Blocks until pid has exited or timeoutMs has passed (-1 waits forever)
+    bool waitForExit(qint64 pid, int timeoutMs);
+
+    // Graceful request, wait up to graceMs, then force kill and confirm.
+    // Blocks, so callers on the GUI thread should keep graceMs small.
+    StopResult stop(qint64 pid, int graceMs = DEFAULT_GRACE_MS);
+
+    const char* toString(StopResult result);
+}
+
+} // namespace Tau5Common
+
+#endif // TAU5_PROCESS_CONTROL_H
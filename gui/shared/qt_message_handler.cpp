@@ -13,20 +13,21 @@ static void unifiedMessageHandler(QtMsgType type, const QMessageLogContext &cont
         originalMessageHandler(type, context, msg);
     }
 
-    // Route to Tau5Logger with appropriate level
+    // Route to Tau5Logger with appropriate level. The lazy macros skip
+    // building the "[Qt] ..." string when the level is filtered out.
     switch (type) {
     case QtDebugMsg:
-        Tau5Logger::instance().debug(QString("[Qt] %1").arg(msg));
+        TAU5_LOGF_DEBUG("[Qt] {}", msg);
         break;
     case QtInfoMsg:
-        Tau5Logger::instance().info(QString("[Qt] %1").arg(msg));
+        TAU5_LOGF_INFO("[Qt] {}", msg);
         break;
     case QtWarningMsg:
-        Tau5Logger::instance().warning(QString("[Qt] %1").arg(msg));
+        TAU5_LOGF_WARNING("[Qt] {}", msg);
         break;
     case QtCriticalMsg:
     case QtFatalMsg:
-        Tau5Logger::instance().error(QString("[Qt] %1").arg(msg));
+        TAU5_LOGF_ERROR("[Qt] {}", msg);
         break;
     }
 }
@@ -0,0 +1,187 @@
+#include "startup_trace.h"
+#include "tau5logger.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace Tau5Common {
+
+namespace {
+
+qint64 epochUs()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+StartupTrace& StartupTrace::start(const QString& processName)
+{
+    static StartupTrace trace(processName);
+    return trace;
+}
+
+StartupTrace& StartupTrace::instance()
+{
+    return start(QStringLiteral("tau5"));
+}
+
+StartupTrace::StartupTrace(const QString& processName)
+    : m_pid(QCoreApplication::applicationPid())
+{
+    m_clock.start();
+    m_originEpochUs = epochUs();
+    m_processNames.insert(m_pid, processName);
+}
+
+void StartupTrace::begin(const QString& name)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_finished) {
+        return;
+    }
+    Event event;
+    event.name = name;
+    event.pid = m_pid;
+    event.startUs = nowUs();
+    event.durationUs = 0;
+    m_open.insert(name, m_events.size());
+    m_events.append(event);
+}
+
+void StartupTrace::end(const QString& name)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_finished) {
+        return;
+    }
+    auto it = m_open.find(name);
+    if (it == m_open.end()) {
+        return;
+    }
+    Event& event = m_events[it.value()];
+    event.durationUs = nowUs() - event.startUs;
+    m_open.erase(it);
+}
+
+void StartupTrace::instant(const QString& name)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_finished) {
+        return;
+    }
+    Event event;
+    event.name = name;
+    event.pid = m_pid;
+    event.startUs = nowUs();
+    m_events.append(event);
+}
+
+void StartupTrace::addSpan(const QString& name, qint64 pid, const QString& processName,
+                           qint64 startEpochUs, qint64 durationUs)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_finished) {
+        return;
+    }
+    Event event;
+    event.name = name;
+    event.pid = pid;
+    event.startUs = startEpochUs - m_originEpochUs;
+    event.durationUs = qMax<qint64>(0, durationUs);
+    m_events.append(event);
+    m_processNames.insert(pid, processName);
+}
+
+bool StartupTrace::isFinished() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_finished;
+}
+
+QString StartupTrace::finish(bool logSummary)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_finished) {
+        return QString();
+    }
+    m_finished = true;
+
+    // Anything still open ran at least until now
+    qint64 finishedAtUs = nowUs();
+    for (qsizetype index : std::as_const(m_open)) {
+        m_events[index].durationUs = finishedAtUs - m_events[index].startUs;
+    }
+    m_open.clear();
+
+    std::stable_sort(m_events.begin(), m_events.end(), [](const Event& a, const Event& b) {
+        return a.startUs < b.startUs;
+    });
+
+    QJsonArray traceEvents;
+    for (auto it = m_processNames.constBegin(); it != m_processNames.constEnd(); ++it) {
+        traceEvents.append(QJsonObject{
+            {"name", "process_name"}, {"ph", "M"}, {"pid", it.key()}, {"tid", 0},
+            {"args", QJsonObject{{"name", it.value()}}}});
+    }
+    for (const Event& event : std::as_const(m_events)) {
+        QJsonObject json{
+            {"name", event.name}, {"cat", "startup"}, {"pid", event.pid}, {"tid", 0},
+            {"ts", event.startUs}};
+        if (event.durationUs < 0) {
+            json.insert("ph", "i");
+            json.insert("s", "g");
+        } else {
+            json.insert("ph", "X");
+            json.insert("dur", event.durationUs);
+        }
+        traceEvents.append(json);
+    }
+
+    QJsonObject root{{"traceEvents", traceEvents}, {"displayTimeUnit", "ms"}};
+
+    QString path;
+    QString sessionPath = Tau5Logger::isInitialized() ? Tau5Logger::instance().currentSessionPath() : QString();
+    if (!sessionPath.isEmpty()) {
+        path = QDir(sessionPath).filePath("startup-trace.json");
+        QFile file(path);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+        } else {
+            path.clear();
+        }
+    }
+
+    if (logSummary && Tau5Logger::isInitialized()) {
+        QString summary = QString("Startup took %1 ms%2\n")
+                              .arg(finishedAtUs / 1000.0, 0, 'f', 1)
+                              .arg(path.isEmpty() ? QString() : QString(" (trace: %1)").arg(path));
+        for (const Event& event : std::as_const(m_events)) {
+            QString process = event.pid == m_pid ? QString() : m_processNames.value(event.pid) + ":";
+            if (event.durationUs < 0) {
+                summary += QString("  %1 ms  %2  %3%4\n")
+                               .arg(event.startUs / 1000.0, 8, 'f', 1)
+                               .arg(QString(10, ' '))
+                               .arg(process, event.name);
+            } else {
+                summary += QString("  %1 ms  +%2 ms  %3%4\n")
+                               .arg(event.startUs / 1000.0, 8, 'f', 1)
+                               .arg(event.durationUs / 1000.0, 6, 'f', 1)
+                               .arg(process, event.name);
+            }
+        }
+        Tau5Logger::instance().info(summary.trimmed());
+    }
+
+    return path;
+}
+
+} // namespace Tau5Common
@@ -0,0 +1,83 @@
+#ifndef TAU5_STARTUP_TRACE_H
+#define TAU5_STARTUP_TRACE_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QtGlobal>
+
+namespace Tau5Common {
+
+/**
+ * Timeline of the startup phases of tau5 / tau5-node and the BEAM they
+ * launch. finish() writes it as Chrome trace-event JSON (startup-trace.json
+ * in the session log directory, for chrome://tracing or Perfetto) and can
+ * log a per-phase summary.
+ *
+ * Our phases are timed on a monotonic clock started by start(), so call
+ * it first thing in main(), before QCoreApplication exists to name the
+ * process. Spans the BEAM reports carry wall-clock times, the only clock
+ * both processes share, and are placed on the same timeline through the
+ * wall-clock time of that first call.
+ */
+class StartupTrace
+{
+public:
+    // Creates the trace, naming this process in it; later calls, and
+    // instance() if called first, return the existing one
+    static StartupTrace& start(const QString& processName);
+    static StartupTrace& instance();
+
+    void begin(const QString& name);
+    void end(const QString& name);
+    void instant(const QString& name);
+
+    // A span from another process, e.g. the BEAM
+    void addSpan(const QString& name, qint64 pid, const QString& processName,
+                 qint64 startEpochUs, qint64 durationUs);
+
+    // Writes the trace once and returns its path (empty on failure); after
+    // this, recording is a no-op
+    QString finish(bool logSummary);
+    bool isFinished() const;
+
+    // Times the enclosing block
+    class Scope
+    {
+    public:
+        explicit Scope(const QString& name) : m_name(name) { StartupTrace::instance().begin(m_name); }
+        ~Scope() { StartupTrace::instance().end(m_name); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        QString m_name;
+    };
+
+private:
+    explicit StartupTrace(const QString& processName);
+
+    struct Event {
+        QString name;
+        qint64 pid = 0;
+        qint64 startUs = 0;      // Since the trace started
+        qint64 durationUs = -1;  // -1 for an instant
+    };
+
+    qint64 nowUs() const { return m_clock.nsecsElapsed() / 1000; }
+
+    mutable QMutex m_mutex;
+    QElapsedTimer m_clock;
+    qint64 m_originEpochUs;
+    qint64 m_pid;
+    QList<Event> m_events;
+    QHash<QString, qsizetype> m_open;        // Begun but not ended, index into m_events
+    QHash<qint64, QString> m_processNames;
+    bool m_finished = false;
+};
+
+} // namespace Tau5Common
+
+#endif // TAU5_STARTUP_TRACE_H
@@ -1,5 +1,10 @@
 #include "tau5logger.h"
+#include "mpsc_queue.h"
+#include "log_index.h"
 #include <QDateTime>
+#include <QDeadlineTimer>
+#include <QElapsedTimer>
+#include <QThread>
 #include <QDir>
 #include <QStandardPaths>
 #include <QJsonDocument>
@@ -8,14 +13,22 @@
 #include <QDebug>
 #include <QCoreApplication>
 #include <iostream>
+#include <limits>
 
 std::unique_ptr<Tau5Logger> Tau5Logger::s_instance = nullptr;
+std::atomic<Tau5Logger*> Tau5Logger::s_instancePtr{nullptr};
 QMutex Tau5Logger::s_instanceMutex;
 
 Tau5Logger::Tau5Logger() : QObject(nullptr) {
 }
 
 Tau5Logger::~Tau5Logger() {
+    // Stop handing out this instance before it starts going away
+    Tau5Logger* self = this;
+    s_instancePtr.compare_exchange_strong(self, nullptr, std::memory_order_acq_rel);
+    
+    // Drain anything still queued before the files go away
+    stopWriterThread();
     flush();
     closeLogFiles();
 }
@@ -54,21 +67,22 @@ void Tau5Logger::initialize(const Tau5LoggerConfig& config) {
     
     s_instance = std::make_unique<Tau5Logger>();
     s_instance->initializeWithConfig(config);
+    s_instancePtr.store(s_instance.get(), std::memory_order_release);
 }
 
 Tau5Logger& Tau5Logger::instance() {
-    QMutexLocker locker(&s_instanceMutex);
+    // Every log call goes through here, so avoid taking s_instanceMutex
+    Tau5Logger* logger = s_instancePtr.load(std::memory_order_acquire);
     
-    if (!s_instance) {
+    if (!logger) {
         qFatal("Tau5Logger not initialized! Call Tau5Logger::initialize() first.");
     }
     
-    return *s_instance;
+    return *logger;
 }
 
 bool Tau5Logger::isInitialized() {
-    QMutexLocker locker(&s_instanceMutex);
-    return s_instance != nullptr;
+    return s_instancePtr.load(std::memory_order_acquire) != nullptr;
 }
 
 void Tau5Logger::initializeWithConfig(const Tau5LoggerConfig& config) {
@@ -82,6 +96,9 @@ void Tau5Logger::initializeWithConfig(const Tau5LoggerConfig& config) {
     
     m_sessionPath = findOrCreateSessionFolder();
     openLogFiles();
+    if (m_config.asyncWriter) {
+        startWriterThread();
+    }
     log(LogLevel::Info, m_defaultCategory, 
         QString("Tau5Logger initialized for '%1' in session: %2")
         .arg(m_config.appName)
@@ -151,9 +168,17 @@ void Tau5Logger::openLogFiles() {
         auto stream = std::make_unique<QTextStream>(file.get());
         
         FileInfo info;
+        info.jsonFormat = logFile.jsonFormat;
+        
+        if (m_config.writeLineIndex && !logFile.jsonFormat) {
+            info.index = std::make_unique<Tau5Common::LogIndexWriter>();
+            if (!info.index->open(filePath, file->size())) {
+                info.index.reset();
+            }
+        }
+        
         info.file = std::move(file);
         info.stream = std::move(stream);
-        info.jsonFormat = logFile.jsonFormat;
         
         m_files[logFile.category] = std::move(info);
     }
@@ -163,8 +188,9 @@ void Tau5Logger::closeLogFiles() {
     QMutexLocker locker(&m_mutex);
     
     for (auto& [category, info] : m_files) {
-        if (info.stream) {
-            info.stream->flush();
+        flushFile(info);
+        if (info.index) {
+            info.index->close();
         }
         if (info.file) {
             info.file->close();
@@ -221,14 +247,38 @@ void Tau5Logger::log(LogLevel level, const QString& category, const QString& mes
         return;
     }
     
+    // Counted before m_asyncActive is checked, so stopWriterThread() can
+    // wait out a producer that saw it still set
+    m_asyncProducers.fetch_add(1, std::memory_order_seq_cst);
+    if (m_asyncActive.load(std::memory_order_seq_cst)) {
+        LogRecord record;
+        record.level = level;
+        record.timestampMs = QDateTime::currentMSecsSinceEpoch();
+        record.category = category;
+        record.message = message;
+        record.metadata = metadata;
+        enqueue(std::move(record));
+        m_asyncProducers.fetch_sub(1, std::memory_order_release);
+        
+        if (m_config.emitQtSignals) {
+            emit logMessage(level, category, message, metadata);
+        }
+        return;
+    }
+    m_asyncProducers.fetch_sub(1, std::memory_order_release);
+    
     QMutexLocker locker(&m_mutex);
     
     if (m_config.consoleEnabled) {
         writeToConsole(level, category, message);
     }
     
-    // Write to file
-    writeToFile(category, level, message, metadata);
+    // Write to file, flushing every line as synchronous mode always has
+    FileInfo* info = writeToFile(category, level, message, metadata,
+                                 QDateTime::currentDateTime());
+    if (info) {
+        flushFile(*info);
+    }
     
     // Emit signal if enabled (for GUI integration)
     if (m_config.emitQtSignals) {
@@ -236,28 +286,29 @@ void Tau5Logger::log(LogLevel level, const QString& category, const QString& mes
     }
 }
 
-void Tau5Logger::writeToFile(const QString& category, LogLevel level,
-                             const QString& message, const QJsonObject& metadata) {
+Tau5Logger::FileInfo* Tau5Logger::writeToFile(const QString& category, LogLevel level,
+                                              const QString& message, const QJsonObject& metadata,
+                                              const QDateTime& timestamp) {
     auto it = m_files.find(category);
     if (it == m_files.end()) {
         // If category not found, try default category
         it = m_files.find(m_defaultCategory);
         if (it == m_files.end()) {
-            return;  // No file configured for this category
+            return nullptr;  // No file configured for this category
         }
     }
     
     auto& info = it->second;
     if (!info.stream) {
-        return;
+        return nullptr;
     }
     
-    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss.zzz");
+    QString timestampStr = timestamp.toString("yyyy-MM-dd HH:mm:ss.zzz");
     
     if (info.jsonFormat) {
         // Write as JSONL
         QJsonObject entry;
-        entry["timestamp"] = timestamp;
+        entry["timestamp"] = timestampStr;
         entry["level"] = levelToString(level);
         entry["category"] = category;
         entry["message"] = message;
@@ -270,49 +321,243 @@ void Tau5Logger::writeToFile(const QString& category, LogLevel level,
         }
         
         QJsonDocument doc(entry);
-        *info.stream << doc.toJson(QJsonDocument::Compact) << Qt::endl;
+        *info.stream << doc.toJson(QJsonDocument::Compact) << '\n';
     } else {
         // Write as plain text
-        QString levelStr = levelToString(level);
-        *info.stream << timestamp << " [" << levelStr << "] ";
+        QString prefix = timestampStr + " [" + levelToString(level) + "] ";
         
         // Include category if it's not the default
         if (category != m_defaultCategory) {
-            *info.stream << "[" << category << "] ";
+            prefix += "[" + category + "] ";
         }
         
-        *info.stream << message << Qt::endl;
+        *info.stream << prefix << message << '\n';
+        
+        if (info.index) {
+            info.index->appendMessage(prefix, message, timestamp.toMSecsSinceEpoch(), level);
+        }
     }
     
-    // Flush for important messages
-    if (level >= LogLevel::Warning) {
-        info.stream->flush();
-    }
+    info.dirty = true;
+    return &info;
 }
 
 void Tau5Logger::writeToConsole(LogLevel level, const QString& category, const QString& message) {
-    QString timestamp = QDateTime::currentDateTime().toString("HH:mm:ss.zzz");
-    QString levelStr = levelToString(level);
+    QString line;
+    appendConsoleLine(line, level, category, message, QDateTime::currentDateTime());
     
     QTextStream out(stderr);
+    out << line;
+    out.flush();
+}
+
+void Tau5Logger::appendConsoleLine(QString& out, LogLevel level, const QString& category,
+                                   const QString& message, const QDateTime& timestamp) const {
+    QString timestampStr = timestamp.toString("HH:mm:ss.zzz");
+    QString levelStr = levelToString(level);
     
     if (m_config.consoleColors) {
-        QString colorCode = levelToColorCode(level);
-        out << colorCode << timestamp << " [" << levelStr << "] ";
+        out += levelToColorCode(level);
+    }
+    out += timestampStr + " [" + levelStr + "] ";
+    
+    if (category != m_defaultCategory) {
+        out += "[" + category + "] ";
+    }
+    
+    out += message;
+    if (m_config.consoleColors) {
+        out += "\033[0m";  // Reset color
+    }
+    out += '\n';
+}
+
+void Tau5Logger::startWriterThread() {
+    if (m_writerThread) {
+        return;
+    }
+    
+    // The queue lives as long as the logger, so a producer can never be
+    // left pushing into a freed one
+    if (!m_queue) {
+        m_queue = std::make_unique<Tau5Common::MpscQueue<LogRecord>>(
+            static_cast<size_t>(qMax(64, m_config.asyncQueueCapacity)));
+    }
+    m_stopWriter = false;
+    m_writerThread = QThread::create([this]() { writerLoop(); });
+    m_writerThread->setObjectName("Tau5LoggerWriter");
+    m_writerThread->start(QThread::LowPriority);
+    m_asyncActive.store(true, std::memory_order_release);
+}
+
+void Tau5Logger::stopWriterThread() {
+    if (!m_writerThread) {
+        return;
+    }
+    
+    // Later log() calls fall back to the synchronous path. Wait for any
+    // that already chose the queue to finish pushing, so the writer's final
+    // drain sees their records; the writer is still running, so a blocked
+    // producer can make progress.
+    m_asyncActive.store(false, std::memory_order_seq_cst);
+    while (m_asyncProducers.load(std::memory_order_acquire) != 0) {
+        QThread::yieldCurrentThread();
+    }
+    
+    {
+        QMutexLocker locker(&m_wakeMutex);
+        m_stopWriter = true;
+        m_wakeCondition.wakeOne();
+    }
+    
+    // The writer only exits once the queue is empty
+    m_writerThread->wait();
+    delete m_writerThread;
+    m_writerThread = nullptr;
+}
+
+void Tau5Logger::enqueue(LogRecord&& record) {
+    const bool urgent = record.level >= LogLevel::Warning;
+    
+    if (!m_queue->tryPush(std::move(record))) {
+        if (m_config.asyncOverflow == LogOverflowPolicy::DropNewest) {
+            m_droppedRecords.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
         
-        if (category != m_defaultCategory) {
-            out << "[" << category << "] ";
+        // Block: keep the writer awake and retry until a slot frees up.
+        // tryPush only moves from the record on success, so it is intact here.
+        do {
+            {
+                QMutexLocker locker(&m_wakeMutex);
+                m_wakeCondition.wakeOne();
+            }
+            QThread::yieldCurrentThread();
+        } while (!m_queue->tryPush(std::move(record)));
+    }
+    
+    // Pairs with the fence in writerLoop() so that either the writer sees
+    // this record before sleeping or we see it idle and wake it.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (urgent || m_writerIdle.load(std::memory_order_relaxed)) {
+        QMutexLocker locker(&m_wakeMutex);
+        m_wakeCondition.wakeOne();
+    }
+}
+
+void Tau5Logger::writerLoop() {
+    const int maxBatch = 1024;
+    QString consoleBatch;
+    QElapsedTimer sinceFlush;
+    sinceFlush.start();
+    quint64 reportedDrops = 0;
+    qint64 pendingBytes = 0;
+    bool dirty = false;
+    
+    auto flushFiles = [this, &sinceFlush, &pendingBytes, &dirty]() {
+        for (auto& [category, info] : m_files) {
+            if (info.dirty) {
+                flushFile(info);
+                info.dirty = false;
+            }
         }
+        pendingBytes = 0;
+        dirty = false;
+        sinceFlush.restart();
+    };
+    
+    for (;;) {
+        int drained = 0;
         
-        out << message << "\033[0m" << Qt::endl;  // Reset color
-    } else {
-        out << timestamp << " [" << levelStr << "] ";
+        {
+            QMutexLocker locker(&m_mutex);
+            bool urgent = false;
+            LogRecord record;
+            
+            quint64 drops = m_droppedRecords.load(std::memory_order_relaxed);
+            if (drops != reportedDrops) {
+                LogRecord notice;
+                notice.level = LogLevel::Warning;
+                notice.timestampMs = QDateTime::currentMSecsSinceEpoch();
+                notice.category = m_defaultCategory;
+                notice.message = QString("Log queue full, dropped %1 message(s)").arg(drops - reportedDrops);
+                reportedDrops = drops;
+                
+                QDateTime timestamp = QDateTime::fromMSecsSinceEpoch(notice.timestampMs);
+                if (m_config.consoleEnabled) {
+                    appendConsoleLine(consoleBatch, notice.level, notice.category, notice.message, timestamp);
+                }
+                dirty = writeToFile(notice.category, notice.level, notice.message,
+                                    notice.metadata, timestamp) != nullptr || dirty;
+                urgent = true;
+            }
+            
+            while (drained < maxBatch && m_queue->tryPop(record)) {
+                QDateTime timestamp = QDateTime::fromMSecsSinceEpoch(record.timestampMs);
+                if (m_config.consoleEnabled) {
+                    appendConsoleLine(consoleBatch, record.level, record.category, record.message, timestamp);
+                }
+                if (writeToFile(record.category, record.level, record.message, record.metadata, timestamp)) {
+                    pendingBytes += record.message.size() + 32;
+                    dirty = true;
+                }
+                urgent = urgent || record.level >= LogLevel::Warning;
+                ++drained;
+            }
+            
+            if (!consoleBatch.isEmpty()) {
+                QTextStream out(stderr);
+                out << consoleBatch;
+                out.flush();
+                consoleBatch.clear();
+            }
+            
+            if (dirty && (urgent || pendingBytes >= m_config.asyncFlushBytes ||
+                          sinceFlush.elapsed() >= m_config.asyncFlushIntervalMs)) {
+                flushFiles();
+            }
+        }
         
-        if (category != m_defaultCategory) {
-            out << "[" << category << "] ";
+        if (drained == maxBatch) {
+            continue;
         }
         
-        out << message << Qt::endl;
+        QMutexLocker wakeLocker(&m_wakeMutex);
+        
+        if (m_flushRequested != m_flushCompleted || m_stopWriter) {
+            quint64 requested = m_flushRequested;
+            wakeLocker.unlock();
+            {
+                QMutexLocker locker(&m_mutex);
+                if (!m_queue->isEmpty()) {
+                    continue;  // Something arrived meanwhile, drain it first
+                }
+                flushFiles();
+            }
+            wakeLocker.relock();
+            m_flushCompleted = requested;
+            if (m_stopWriter && m_queue->isEmpty()) {
+                // Release any flush() that raced with shutdown
+                m_flushCompleted = std::numeric_limits<quint64>::max();
+                m_drainedCondition.wakeAll();
+                return;
+            }
+            m_drainedCondition.wakeAll();
+            continue;
+        }
+        
+        m_writerIdle.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_queue->isEmpty()) {
+            if (dirty) {
+                qint64 remaining = m_config.asyncFlushIntervalMs - sinceFlush.elapsed();
+                m_wakeCondition.wait(&m_wakeMutex, QDeadlineTimer(qMax<qint64>(0, remaining)));
+            } else {
+                // Nothing pending on disk: sleep until a producer needs us
+                m_wakeCondition.wait(&m_wakeMutex);
+            }
+        }
+        m_writerIdle.store(false, std::memory_order_relaxed);
     }
 }
 
@@ -339,12 +584,30 @@ QString Tau5Logger::levelToColorCode(LogLevel level) const {
 }
 
 void Tau5Logger::flush() {
+    if (m_asyncActive.load(std::memory_order_acquire)) {
+        QMutexLocker wakeLocker(&m_wakeMutex);
+        quint64 ticket = ++m_flushRequested;
+        m_wakeCondition.wakeOne();
+        while (m_flushCompleted < ticket) {
+            m_drainedCondition.wait(&m_wakeMutex);
+        }
+        return;
+    }
+    
     QMutexLocker locker(&m_mutex);
     
     for (auto& [category, info] : m_files) {
-        if (info.stream) {
-            info.stream->flush();
-        }
+        flushFile(info);
+    }
+}
+
+void Tau5Logger::flushFile(FileInfo& info) {
+    if (info.stream) {
+        info.stream->flush();
+    }
+    // Index after the log, so on disk it never points past the text
+    if (info.index) {
+        info.index->flush();
     }
 }
 
@@ -4,12 +4,23 @@
 #include <QObject>
 #include <QString>
 #include <QJsonObject>
+#include <QDateTime>
 #include <QVector>
 #include <QMutex>
 #include <QFile>
 #include <QTextStream>
+#include <QWaitCondition>
+#include <atomic>
 #include <memory>
 #include <unordered_map>
+#include "log_format.h"
+
+class QThread;
+
+namespace Tau5Common {
+    template <typename T> class MpscQueue;
+    class LogIndexWriter;
+}
 
 enum class LogLevel {
     Debug = 0,
@@ -19,6 +30,12 @@ enum class LogLevel {
     Critical = 4
 };
 
+// What producers do when the async queue is full
+enum class LogOverflowPolicy {
+    DropNewest,     // Discard the record and count it; the writer reports drops
+    Block           // Spin until the writer frees a slot
+};
+
 struct Tau5LoggerConfig {
     QString appName;                    // Required: "gui" or "mcp-gui-dev"
     QString baseLogDir;                 // Default: ~/.local/share/Tau5/logs
@@ -38,6 +55,17 @@ struct Tau5LoggerConfig {
     bool consoleColors = true;
     bool emitQtSignals = false;        // For GUI integration
     LogLevel minLevel = LogLevel::Debug;
+    
+    // Async mode: log() enqueues and returns, a writer thread does the I/O
+    bool asyncWriter = false;
+    int asyncQueueCapacity = 8192;      // Rounded up to a power of two
+    LogOverflowPolicy asyncOverflow = LogOverflowPolicy::DropNewest;
+    int asyncFlushIntervalMs = 250;     // Max time buffered lines wait on disk
+    int asyncFlushBytes = 64 * 1024;    // Flush early once this much is pending
+    
+    // Maintain a sidecar "<name>.idx" line index (offsets, timestamps,
+    // levels) for each plain-text log so searches can skip the text
+    bool writeLineIndex = false;
 };
 
 class Tau5Logger : public QObject {
@@ -56,6 +84,17 @@ public:
     // Check if initialized
     static bool isInitialized();
     
+    // The instance if it exists and would accept a message at this level,
+    // otherwise nullptr. Lock-free; used by the TAU5_LOGF macros to skip
+    // formatting entirely for filtered messages.
+    static Tau5Logger* enabledFor(LogLevel level) {
+        Tau5Logger* logger = s_instancePtr.load(std::memory_order_acquire);
+        return (logger && level >= logger->m_config.minLevel) ? logger : nullptr;
+    }
+    
+    // Category used by debug()/info()/... (first configured file)
+    const QString& defaultCategory() const { return m_defaultCategory; }
+    
     // Logging methods with category
     void log(LogLevel level, const QString& category, const QString& message);
     void log(LogLevel level, const QString& category, const QString& message, 
@@ -86,9 +125,12 @@ public:
     // Get the base log directory (Tau5/logs)
     static QString getBaseLogDir();
     
-    // Flush all file buffers
+    // Flush all file buffers (in async mode, waits for the queue to drain)
     void flush();
     
+    // Number of records discarded because the async queue was full
+    quint64 droppedRecords() const { return m_droppedRecords.load(std::memory_order_relaxed); }
+    
 signals:
     void logMessage(LogLevel level, const QString& category, 
                    const QString& message, const QJsonObject& metadata);
@@ -104,9 +146,26 @@ private:
     void cleanupOldSessions();
     void openLogFiles();
     void closeLogFiles();
-    void writeToFile(const QString& category, LogLevel level, 
-                    const QString& message, const QJsonObject& metadata);
+    struct FileInfo;
+    struct LogRecord {
+        LogLevel level = LogLevel::Debug;
+        qint64 timestampMs = 0;
+        QString category;
+        QString message;
+        QJsonObject metadata;
+    };
+    
+    FileInfo* writeToFile(const QString& category, LogLevel level,
+                          const QString& message, const QJsonObject& metadata,
+                          const QDateTime& timestamp);
     void writeToConsole(LogLevel level, const QString& category, const QString& message);
+    void appendConsoleLine(QString& out, LogLevel level, const QString& category,
+                           const QString& message, const QDateTime& timestamp) const;
+    
+    void startWriterThread();
+    void stopWriterThread();
+    void enqueue(LogRecord&& record);
+    void writerLoop();
     QString levelToString(LogLevel level) const;
     QString levelToColorCode(LogLevel level) const;
     
@@ -120,10 +179,29 @@ private:
         std::unique_ptr<QFile> file;
         std::unique_ptr<QTextStream> stream;
         bool jsonFormat;
+        bool dirty = false;             // Async mode: written since last flush
+        std::unique_ptr<Tau5Common::LogIndexWriter> index;
     };
+    void flushFile(FileInfo& info);
     std::unordered_map<QString, FileInfo> m_files;
     
+    // Async writer state. m_mutex guards the files, m_wakeMutex guards the
+    // writer's sleep/flush handshake; producers only touch the queue.
+    std::unique_ptr<Tau5Common::MpscQueue<LogRecord>> m_queue;
+    QThread* m_writerThread = nullptr;
+    std::atomic<bool> m_asyncActive{false};
+    std::atomic<int> m_asyncProducers{0};   // log() calls between the m_asyncActive check and the push
+    std::atomic<bool> m_writerIdle{false};
+    std::atomic<quint64> m_droppedRecords{0};
+    QMutex m_wakeMutex;
+    QWaitCondition m_wakeCondition;
+    QWaitCondition m_drainedCondition;
+    bool m_stopWriter = false;
+    quint64 m_flushRequested = 0;
+    quint64 m_flushCompleted = 0;
+    
     static std::unique_ptr<Tau5Logger> s_instance;
+    static std::atomic<Tau5Logger*> s_instancePtr;
     static QMutex s_instanceMutex;
 };
 
@@ -134,4 +212,44 @@ private:
 #define TAU5_LOG_ERROR(msg) Tau5Logger::instance().error(msg)
 #define TAU5_LOG_CRITICAL(msg) Tau5Logger::instance().critical(msg)
 
+// Messages below this level are removed at compile time by the TAU5_LOGF
+// macros. Release builds drop Debug; override with -DTAU5_LOG_COMPILE_MIN_LEVEL=n.
+#ifndef TAU5_LOG_COMPILE_MIN_LEVEL
+#ifdef TAU5_RELEASE_BUILD
+#define TAU5_LOG_COMPILE_MIN_LEVEL 1
+#else
+#define TAU5_LOG_COMPILE_MIN_LEVEL 0
+#endif
+#endif
+
+// Lazy, fmt-style logging: TAU5_LOGF(LogLevel::Debug, "beam", "port {} pid {}", port, pid)
+// (the level must be a constant expression).
+// The level is checked before any argument is formatted, and the message is
+// built in a reused thread-local buffer (see Tau5LogFormat::ScopedBuffer).
+#define TAU5_LOGF(level, category, ...) \
+    do { \
+        if constexpr (static_cast<int>(level) >= TAU5_LOG_COMPILE_MIN_LEVEL) { \
+            if (Tau5Logger* tau5Logger_ = Tau5Logger::enabledFor(level)) { \
+                Tau5LogFormat::ScopedBuffer tau5LogBuffer_; \
+                tau5Logger_->log(level, category, tau5LogBuffer_.format(__VA_ARGS__)); \
+            } \
+        } \
+    } while (0)
+
+#define TAU5_LOGF_DEFAULT(level, ...) \
+    do { \
+        if constexpr (static_cast<int>(level) >= TAU5_LOG_COMPILE_MIN_LEVEL) { \
+            if (Tau5Logger* tau5Logger_ = Tau5Logger::enabledFor(level)) { \
+                Tau5LogFormat::ScopedBuffer tau5LogBuffer_; \
+                tau5Logger_->log(level, tau5Logger_->defaultCategory(), tau5LogBuffer_.format(__VA_ARGS__)); \
+            } \
+        } \
+    } while (0)
+
+#define TAU5_LOGF_DEBUG(...) TAU5_LOGF_DEFAULT(LogLevel::Debug, __VA_ARGS__)
+#define TAU5_LOGF_INFO(...) TAU5_LOGF_DEFAULT(LogLevel::Info, __VA_ARGS__)
+#define TAU5_LOGF_WARNING(...) TAU5_LOGF_DEFAULT(LogLevel::Warning, __VA_ARGS__)
+#define TAU5_LOGF_ERROR(...) TAU5_LOGF_DEFAULT(LogLevel::Error, __VA_ARGS__)
+#define TAU5_LOGF_CRITICAL(...) TAU5_LOGF_DEFAULT(LogLevel::Critical, __VA_ARGS__)
+
 #endif // TAU5LOGGER_H
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "cdp_peek.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <cstring>
+
+namespace {
+
+const char* skipSpace(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) {
+        ++p;
+    }
+    return p;
+}
+
+// p is at an opening quote; returns just past the closing one, or nullptr
+const char* skipString(const char* p, const char* end)
+{
+    ++p;
+    while (p < end) {
+        const char* quote = static_cast<const char*>(std::memchr(p, '"', static_cast<size_t>(end - p)));
+        if (!quote) {
+            return nullptr;
+        }
+        // The quote is escaped if preceded by an odd number of backslashes
+        const char* back = quote;
+        while (back > p && back[-1] == '\\') {
+            --back;
+        }
+        if ((quote - back) % 2 == 0) {
+            return quote + 1;
+        }
+        p = quote + 1;
+    }
+    return nullptr;
+}
+
+// Returns just past the value starting at p, or nullptr
+const char* skipValue(const char* p, const char* end)
+{
+    if (p >= end) {
+        return nullptr;
+    }
+    if (*p == '"') {
+        return skipString(p, end);
+    }
+    if (*p == '{' || *p == '[') {
+        int depth = 0;
+        while (p < end) {
+            char c = *p;
+            if (c == '"') {
+                p = skipString(p, end);
+                if (!p) {
+                    return nullptr;
+                }
+                continue;
+            }
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if ((c == '}' || c == ']') && --depth == 0) {
+                return p + 1;
+            }
+            ++p;
+        }
+        return nullptr;
+    }
+    // Number, true, false or null
+    while (p < end && *p != ',' && *p != '}' && *p != ']' &&
+           *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') {
+        ++p;
+    }
+    return p;
+}
+
+} // namespace
+
+QByteArrayView CDPPeek::value(QByteArrayView json, std::initializer_list<QByteArrayView> path)
+{
+    const char* p = json.data();
+    const char* end = p + json.size();
+
+    for (QByteArrayView key : path) {
+        p = skipSpace(p, end);
+        if (p == end || *p != '{') {
+            return {};
+        }
+        ++p;
+
+        for (;;) {
+            p = skipSpace(p, end);
+            if (p == end || *p != '"') {
+                return {};
+            }
+            const char* nameStart = p + 1;
+            p = skipString(p, end);
+            if (!p) {
+                return {};
+            }
+            QByteArrayView name(nameStart, p - 1 - nameStart);
+
+            p = skipSpace(p, end);
+            if (p == end || *p != ':') {
+                return {};
+            }
+            p = skipSpace(p + 1, end);
+            if (name == key) {
+                break;
+            }
+
+            p = skipValue(p, end);
+            if (!p) {
+                return {};
+            }
+            p = skipSpace(p, end);
+            if (p == end || *p != ',') {
+                return {};  // End of object: key not present
+            }
+            ++p;
+        }
+    }
+
+    const char* valueEnd = skipValue(p, end);
+    if (!valueEnd) {
+        return {};
+    }
+    return QByteArrayView(p, valueEnd - p);
+}
+
+QByteArrayView CDPPeek::rawString(QByteArrayView json, std::initializer_list<QByteArrayView> path)
+{
+    QByteArrayView text = value(json, path);
+    if (text.size() < 2 || text.front() != '"') {
+        return {};
+    }
+    text = text.sliced(1, text.size() - 2);
+    if (std::memchr(text.data(), '\\', static_cast<size_t>(text.size()))) {
+        return {};
+    }
+    return text;
+}
+
+QString CDPPeek::string(QByteArrayView json, std::initializer_list<QByteArrayView> path)
+{
+    QByteArrayView text = value(json, path);
+    if (text.size() < 2 || text.front() != '"') {
+        return QString();
+    }
+    QByteArrayView inner = text.sliced(1, text.size() - 2);
+    if (!std::memchr(inner.data(), '\\', static_cast<size_t>(inner.size()))) {
+        return QString::fromUtf8(inner);
+    }
+
+    // Rare: let the JSON parser deal with the escapes
+    QByteArray wrapped = "[" + text.toByteArray() + "]";
+    return QJsonDocument::fromJson(wrapped).array().at(0).toString();
+}
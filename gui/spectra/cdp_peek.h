@@ -0,0 +1,31 @@
+#ifndef CDP_PEEK_H
+#define CDP_PEEK_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QString>
+#include <initializer_list>
+
+/**
+ * Reads single fields out of a raw CDP message without parsing all of it.
+ *
+ * A path names nested object keys, e.g. {"params", "entry", "level"}.
+ * Sibling values before the wanted key are skipped by tracking only string
+ * and nesting state, so peeking at "method" (which Chrome sends first)
+ * costs a few bytes whatever the size of the event. Anything malformed or
+ * missing yields an empty result; callers fall back to a full parse.
+ */
+class CDPPeek
+{
+public:
+    // The value's raw JSON text, quotes included for strings
+    static QByteArrayView value(QByteArrayView json, std::initializer_list<QByteArrayView> path);
+
+    // The unquoted bytes of a string value, if it has no escapes
+    static QByteArrayView rawString(QByteArrayView json, std::initializer_list<QByteArrayView> path);
+
+    // A string value, unescaped
+    static QString string(QByteArrayView json, std::initializer_list<QByteArrayView> path);
+};
+
+#endif // CDP_PEEK_H
@@ -0,0 +1,86 @@
+#include "cdp_pipeline.h"
+#include <utility>
+
+CDPPipeline& CDPPipeline::add(const QString& name, const QString& method, const QJsonObject& params)
+{
+    Step step;
+    step.name = name;
+    step.method = method;
+    step.params = params;
+    m_steps.append(std::move(step));
+    return *this;
+}
+
+CDPPipeline& CDPPipeline::add(const QString& name, const QString& method, const QStringList& dependsOn, ParamsBuilder buildParams)
+{
+    Step step;
+    step.name = name;
+    step.method = method;
+    step.dependsOn = dependsOn;
+    step.buildParams = std::move(buildParams);
+    m_steps.append(std::move(step));
+    return *this;
+}
+
+CDPPipeline& CDPPipeline::optional()
+{
+    if (!m_steps.isEmpty()) {
+        m_steps.last().optional = true;
+    }
+    return *this;
+}
+
+QVector<int> CDPPipeline::levels(QString& error) const
+{
+    QHash<QString, int> indexByName;
+    for (int i = 0; i < m_steps.size(); ++i) {
+        if (indexByName.contains(m_steps[i].name)) {
+            error = QString("Pipeline step '%1' is defined twice").arg(m_steps[i].name);
+            return QVector<int>();
+        }
+        indexByName.insert(m_steps[i].name, i);
+    }
+    for (const Step& step : m_steps) {
+        for (const QString& dependency : step.dependsOn) {
+            if (!indexByName.contains(dependency)) {
+                error = QString("Pipeline step '%1' depends on unknown step '%2'").arg(step.name, dependency);
+                return QVector<int>();
+            }
+        }
+    }
+
+    // Steps are nearly always added after what they depend on, so this
+    // settles in a pass or two
+    QVector<int> levels(m_steps.size(), -1);
+    int settled = 0;
+    bool progress = true;
+    while (settled < m_steps.size() && progress) {
+        progress = false;
+        for (int i = 0; i < m_steps.size(); ++i) {
+            if (levels[i] >= 0) {
+                continue;
+            }
+            int level = 0;
+            bool ready = true;
+            for (const QString& dependency : m_steps[i].dependsOn) {
+                int dependencyLevel = levels[indexByName.value(dependency)];
+                if (dependencyLevel < 0) {
+                    ready = false;
+                    break;
+                }
+                level = qMax(level, dependencyLevel + 1);
+            }
+            if (ready) {
+                levels[i] = level;
+                settled++;
+                progress = true;
+            }
+        }
+    }
+
+    if (settled < m_steps.size()) {
+        error = "Pipeline steps depend on each other in a circle";
+        return QVector<int>();
+    }
+    return levels;
+}
@@ -0,0 +1,56 @@
+#ifndef CDP_PIPELINE_H
+#define CDP_PIPELINE_H
+
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <functional>
+
+/**
+ * A graph of CDP commands, some feeding their results into the params of
+ * others, for CDPClient::runPipeline() to send without waiting on each in
+ * turn.
+ *
+ * A step goes out as soon as the steps it depends on have answered, so a
+ * pipeline costs one round trip per level of the graph rather than one per
+ * command. Chrome runs a session's commands in the order they arrive, so a
+ * step that only has to run after another, without needing its result, is
+ * best added after it with no dependency: both then go out together.
+ */
+class CDPPipeline
+{
+public:
+    // Results of the steps answered so far, by step name
+    using Results = QHash<QString, QJsonObject>;
+    // Builds a step's params; setting error stops the pipeline with it
+    using ParamsBuilder = std::function<QJsonObject(const Results& results, QString& error)>;
+
+    struct Step {
+        QString name;
+        QString method;
+        QJsonObject params;
+        QStringList dependsOn;
+        ParamsBuilder buildParams;  // Used instead of params when set
+        bool optional = false;      // A failure is reported but not fatal
+    };
+
+    CDPPipeline& add(const QString& name, const QString& method, const QJsonObject& params = QJsonObject());
+    CDPPipeline& add(const QString& name, const QString& method, const QStringList& dependsOn, ParamsBuilder buildParams);
+    // Lets the step added last fail without failing the pipeline
+    CDPPipeline& optional();
+
+    const QVector<Step>& steps() const { return m_steps; }
+    bool isEmpty() const { return m_steps.isEmpty(); }
+
+    // Each step's level, 0 for those depending on nothing, in step order.
+    // Empty, with error set, if a name is repeated or a dependency is
+    // unknown or circular.
+    QVector<int> levels(QString& error) const;
+
+private:
+    QVector<Step> m_steps;
+};
+
+#endif // CDP_PIPELINE_H
@@ -1,4 +1,5 @@
 #include "cdpclient.h"
+#include "cdp_peek.h"
 #include <iostream>
 #include <QNetworkRequest>
 #include <QNetworkReply>
@@ -7,10 +8,15 @@
 #include <QUrl>
 #include <QTimer>
 #include <QCoreApplication>
+#include <QMetaMethod>
+#include <QStringList>
+#include <algorithm>
+#include <utility>
 
 CDPClient::CDPClient(quint16 devToolsPort, QObject* parent)
     : QObject(parent)
     , m_devToolsPort(devToolsPort)
+    , m_primary(std::make_shared<TargetState>(m_historyLimits))
     , m_webSocket(new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this))
     , m_networkManager(new QNetworkAccessManager(this))
     , m_pingTimer(new QTimer(this))
@@ -23,6 +29,7 @@ CDPClient::CDPClient(quint16 devToolsPort, QObject* parent)
     QObject::connect(m_webSocket, &QWebSocket::connected, this, &CDPClient::onConnected);
     QObject::connect(m_webSocket, &QWebSocket::disconnected, this, &CDPClient::onDisconnected);
     QObject::connect(m_webSocket, &QWebSocket::textMessageReceived, this, &CDPClient::onTextMessageReceived);
+    QObject::connect(m_webSocket, &QWebSocket::binaryMessageReceived, this, &CDPClient::onBinaryMessageReceived);
     
     m_pingTimer->setInterval(PING_INTERVAL_MS);
     QObject::connect(m_pingTimer, &QTimer::timeout, this, &CDPClient::onPingTimeout);
@@ -33,6 +40,38 @@ CDPClient::~CDPClient()
     disconnect();
 }
 
+CDPClient::TargetState::TargetState(const HistoryLimits& limits)
+    : consoleMessages(limits.consoleMessages)
+    , networkRequests(limits.networkRequests)
+    , exceptions(limits.exceptions)
+    , webSocketFrames(limits.webSocketFrames)
+    , domMutations(limits.domMutations)
+{
+}
+
+void CDPClient::TargetState::setHistoryLimits(const HistoryLimits& limits)
+{
+    consoleMessages.setCapacity(limits.consoleMessages);
+    networkRequests.setCapacity(limits.networkRequests);
+    webSocketFrames.setCapacity(limits.webSocketFrames);
+    domMutations.setCapacity(limits.domMutations);
+    exceptions.setCapacity(limits.exceptions);
+}
+
+void CDPClient::setHistoryLimits(const HistoryLimits& limits)
+{
+    m_historyLimits = limits;
+    m_primary->setHistoryLimits(limits);
+    for (const std::shared_ptr<TargetState>& state : std::as_const(m_targets)) {
+        state->setHistoryLimits(limits);
+    }
+}
+
+CDPClient::HistoryLimits CDPClient::historyLimits() const
+{
+    return m_historyLimits;
+}
+
 bool CDPClient::connect()
 {
     if (m_isConnected) {
@@ -49,7 +88,7 @@ bool CDPClient::connect()
     m_connectionState = ConnectionState::Connecting;
     std::cerr << "# CDP: Connecting to Chrome DevTools Protocol on port " << m_devToolsPort << std::endl;
     
-    fetchTargetList();
+    fetchBrowserEndpoint();
     
     return false;
 }
@@ -61,11 +100,22 @@ void CDPClient::disconnect()
     }
     m_pingTimer->stop();
     m_pendingCommands.clear();
+    m_pendingMethods.clear();
+    m_pendingSessions.clear();
+    discardHeapSnapshot();
+    if (m_trace) {
+        m_trace->callback = nullptr;
+        finishTrace(QString());
+    }
     m_isConnected = false;
     m_isConnecting = false;
     m_connectionState = ConnectionState::NotConnected;
     m_webSocketDebuggerUrl.clear();
     m_targetId.clear();
+    m_browserEndpoint = false;
+    m_attaching.clear();
+    m_targets.clear();
+    m_primary->attached = false;
 }
 
 bool CDPClient::isConnected() const
@@ -78,6 +128,48 @@ CDPClient::ConnectionState CDPClient::getConnectionState() const
     return m_connectionState;
 }
 
+void CDPClient::fetchBrowserEndpoint()
+{
+    // The browser endpoint reaches every page, so one connection observes
+    // them all; without one, connect to the page itself as before
+    QUrl url(QString("http://localhost:%1/json/version").arg(m_devToolsPort));
+    QNetworkRequest request(url);
+
+    QNetworkReply* reply = m_networkManager->get(request);
+    QObject::connect(reply, &QNetworkReply::finished, [this, reply]() {
+        reply->deleteLater();
+        if (!m_isConnecting) {
+            return;
+        }
+
+        QString browserUrl;
+        if (reply->error() == QNetworkReply::NoError) {
+            browserUrl = QJsonDocument::fromJson(reply->readAll()).object()["webSocketDebuggerUrl"].toString();
+        }
+        if (browserUrl.isEmpty()) {
+            fetchTargetList();
+            return;
+        }
+
+        m_browserEndpoint = true;
+        m_webSocketDebuggerUrl = browserUrl;
+        std::cerr << "# CDP: Connecting to DevTools browser endpoint: " << m_webSocketDebuggerUrl.toStdString() << std::endl;
+        m_webSocket->open(QUrl(m_webSocketDebuggerUrl));
+    });
+}
+
+void CDPClient::failConnection(const QString& errorMsg)
+{
+    std::cerr << "# CDP Error: " << errorMsg.toStdString() << std::endl;
+    m_isConnecting = false;
+    m_isConnected = false;
+    m_connectionState = ConnectionState::NotConnected;
+    if (m_webSocket->state() != QAbstractSocket::UnconnectedState) {
+        m_webSocket->abort();
+    }
+    emit connectionFailed(errorMsg);
+}
+
 void CDPClient::fetchTargetList()
 {
     QUrl url(QString("http://localhost:%1/json/list").arg(m_devToolsPort));
@@ -89,28 +181,14 @@ void CDPClient::fetchTargetList()
         
         if (reply->error() != QNetworkReply::NoError) {
             QString errorMsg = QString("Cannot connect to Chrome DevTools on port %1: %2").arg(m_devToolsPort).arg(reply->errorString());
-            std::cerr << "# CDP Error: " << errorMsg.toStdString() << std::endl;
-            m_isConnecting = false;
-            m_isConnected = false;
-            m_connectionState = ConnectionState::NotConnected;
-            if (m_webSocket->state() != QAbstractSocket::UnconnectedState) {
-                m_webSocket->abort();
-            }
-            emit connectionFailed(errorMsg);
+            failConnection(errorMsg);
             return;
         }
         
         QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
         if (!doc.isArray()) {
             QString errorMsg = "Invalid DevTools target list format - Tau5 may not be running";
-            std::cerr << "# CDP Error: " << errorMsg.toStdString() << std::endl;
-            m_isConnecting = false;
-            m_isConnected = false;
-            m_connectionState = ConnectionState::NotConnected;
-            if (m_webSocket->state() != QAbstractSocket::UnconnectedState) {
-                m_webSocket->abort();
-            }
-            emit connectionFailed(errorMsg);
+            failConnection(errorMsg);
             return;
         }
         
@@ -120,14 +198,7 @@ void CDPClient::fetchTargetList()
 
         if (targetId.isEmpty()) {
             QString errorMsg = "No suitable DevTools target found - check if Tau5 is running in dev mode";
-            std::cerr << "# CDP Error: " << errorMsg.toStdString() << std::endl;
-            m_isConnecting = false;
-            m_isConnected = false;
-            m_connectionState = ConnectionState::NotConnected;
-            if (m_webSocket->state() != QAbstractSocket::UnconnectedState) {
-                m_webSocket->abort();
-            }
-            emit connectionFailed(errorMsg);
+            failConnection(errorMsg);
             return;
         }
         
@@ -142,14 +213,7 @@ void CDPClient::fetchTargetList()
         
         if (m_webSocketDebuggerUrl.isEmpty()) {
             QString errorMsg = "No WebSocket debugger URL found - ensure Tau5 is running with DevTools enabled";
-            std::cerr << "# CDP Error: " << errorMsg.toStdString() << std::endl;
-            m_isConnecting = false;
-            m_isConnected = false;
-            m_connectionState = ConnectionState::NotConnected;
-            if (m_webSocket->state() != QAbstractSocket::UnconnectedState) {
-                m_webSocket->abort();
-            }
-            emit connectionFailed(errorMsg);
+            failConnection(errorMsg);
             return;
         }
         
@@ -188,19 +252,194 @@ void CDPClient::connectToTarget(const QString& targetId)
 }
 
 void CDPClient::onConnected()
+{
+    if (!m_browserEndpoint) {
+        // The page itself is the root session
+        TargetInfo& info = m_primary->info;
+        info.targetId = m_targetId;
+        info.sessionId.clear();
+        info.type = "page";
+        info.title = m_currentTargetTitle;
+        for (const QJsonValue& value : std::as_const(m_lastTargetList)) {
+            if (value.toObject()["id"].toString() == m_targetId) {
+                info.url = value.toObject()["url"].toString();
+            }
+        }
+        m_primary->attached = true;
+        m_targets = {m_primary};
+        enableDomains(QString(), info.type);
+        finishConnecting();
+        return;
+    }
+
+    // Attach to every page and keep attaching to new ones. Connected once
+    // the primary page is attached.
+    sendSessionCommand(QString(), "Target.setDiscoverTargets", QJsonObject{{"discover", true}},
+                       [](const QJsonObject&, const QString& error) {
+        if (!error.isEmpty()) {
+            std::cerr << "# CDP Warning: Failed to discover targets: " << error.toStdString() << std::endl;
+        }
+    });
+    sendSessionCommand(QString(), "Target.getTargets", QJsonObject(), [this](const QJsonObject& result, const QString& error) {
+        QJsonArray targets = result["targetInfos"].toArray();
+        m_targetId.clear();
+        for (const QJsonValue& value : std::as_const(targets)) {
+            QJsonObject target = value.toObject();
+            if (target["type"].toString() == "page" && target["title"].toString() == m_targetTitle) {
+                m_targetId = target["targetId"].toString();
+                std::cerr << "# CDP: Found target with title '" << m_targetTitle.toStdString()
+                          << "' at " << target["url"].toString().toStdString() << std::endl;
+                break;
+            }
+        }
+        if (m_targetId.isEmpty()) {
+            failConnection(error.isEmpty() ? QString("No suitable DevTools target found - check if Tau5 is running in dev mode") : error);
+            return;
+        }
+
+        for (const QJsonValue& value : std::as_const(targets)) {
+            attachToTarget(value.toObject());
+        }
+    });
+}
+
+void CDPClient::finishConnecting()
 {
     std::cerr << "# CDP: Connected to Chrome DevTools Protocol" << std::endl;
     m_isConnected = true;
     m_isConnecting = false;
     m_connectionState = ConnectionState::Connected;
     m_pingTimer->start();
-    
-    enableDomains();
-    
+
     emit connected();
     emit logMessage("CDP Client connected");
 }
 
+void CDPClient::attachToTarget(const QJsonObject& targetInfo)
+{
+    // Pages, and workers that no page started; everything else is
+    // auto-attached under the page it belongs to
+    QString type = targetInfo["type"].toString();
+    if (type != "page" && type != "service_worker" && type != "shared_worker") {
+        return;
+    }
+    QString targetId = targetInfo["targetId"].toString();
+    if (m_attaching.contains(targetId)) {
+        return;
+    }
+    for (const std::shared_ptr<TargetState>& state : std::as_const(m_targets)) {
+        if (state->info.targetId == targetId) {
+            return;
+        }
+    }
+
+    // Target.attachedToTarget arrives before the response
+    m_attaching.insert(targetId);
+    QJsonObject params{
+        {"targetId", targetId},
+        {"flatten", true}
+    };
+    sendSessionCommand(QString(), "Target.attachToTarget", params, [this, targetId](const QJsonObject&, const QString& error) {
+        if (error.isEmpty()) {
+            return;
+        }
+        m_attaching.remove(targetId);
+        if (targetId == m_targetId && !m_isConnected) {
+            failConnection(QString("Cannot attach to target '%1': %2").arg(m_targetTitle, error));
+            return;
+        }
+        std::cerr << "# CDP Warning: Failed to attach to target " << targetId.toStdString() << ": " << error.toStdString() << std::endl;
+    });
+}
+
+void CDPClient::handleTargetEvent(const QString& method, const QJsonObject& params)
+{
+    if (method == "Target.targetCreated") {
+        if (m_browserEndpoint) {
+            attachToTarget(params["targetInfo"].toObject());
+        }
+    } else if (method == "Target.attachedToTarget") {
+        QJsonObject targetInfo = params["targetInfo"].toObject();
+        QString targetId = targetInfo["targetId"].toString();
+        m_attaching.remove(targetId);
+
+        // The primary page keeps the history it had before a reconnect
+        bool primary = m_browserEndpoint && targetId == m_targetId && !m_primary->attached;
+        std::shared_ptr<TargetState> state = primary ? m_primary : std::make_shared<TargetState>(m_historyLimits);
+        state->info.targetId = targetId;
+        state->info.sessionId = params["sessionId"].toString();
+        state->info.type = targetInfo["type"].toString();
+        state->info.title = targetInfo["title"].toString();
+        state->info.url = targetInfo["url"].toString();
+        state->attached = true;
+        m_targets.append(state);
+
+        enableDomains(state->info.sessionId, state->info.type);
+        if (params["waitingForDebugger"].toBool()) {
+            sendSessionCommand(state->info.sessionId, "Runtime.runIfWaitingForDebugger", QJsonObject(),
+                               [](const QJsonObject&, const QString&) {});
+        }
+        if (primary) {
+            m_currentTargetTitle = state->info.title;
+            finishConnecting();
+        }
+    } else if (method == "Target.detachedFromTarget") {
+        std::shared_ptr<TargetState> state = findSession(params["sessionId"].toString());
+        if (!state) {
+            return;
+        }
+        state->attached = false;
+        m_targets.removeOne(state);
+
+        // Commands sent to it will never be answered
+        QList<int> ids;
+        for (auto it = m_pendingSessions.cbegin(); it != m_pendingSessions.cend(); ++it) {
+            if (it.value() == state->info.sessionId) {
+                ids.append(it.key());
+            }
+        }
+        for (int id : ids) {
+            ResponseCallback callback = m_pendingCommands.take(id);
+            m_pendingMethods.remove(id);
+            m_pendingSessions.remove(id);
+            if (callback) {
+                callback(QJsonObject(), "Target detached");
+            }
+        }
+
+        // Commands without a target go to the primary, so move it to another
+        // attached page. With none left it keeps its history but drops the
+        // dead session, and is picked up again if the same page reattaches.
+        if (state == m_primary) {
+            for (const std::shared_ptr<TargetState>& candidate : std::as_const(m_targets)) {
+                if (candidate->info.type == "page") {
+                    m_primary = candidate;
+                    m_targetId = candidate->info.targetId;
+                    m_currentTargetTitle = candidate->info.title;
+                    std::cerr << "# CDP: Primary target detached, switched to '"
+                              << m_currentTargetTitle.toStdString() << "'" << std::endl;
+                    break;
+                }
+            }
+            if (m_primary == state) {
+                state->info.sessionId.clear();
+                m_currentTargetTitle.clear();
+            }
+        }
+    } else if (method == "Target.targetInfoChanged") {
+        QJsonObject targetInfo = params["targetInfo"].toObject();
+        for (const std::shared_ptr<TargetState>& state : std::as_const(m_targets)) {
+            if (state->info.targetId == targetInfo["targetId"].toString()) {
+                state->info.title = targetInfo["title"].toString();
+                state->info.url = targetInfo["url"].toString();
+                if (state == m_primary) {
+                    m_currentTargetTitle = state->info.title;
+                }
+            }
+        }
+    }
+}
+
 void CDPClient::onDisconnected()
 {
     std::cerr << "# CDP: Disconnected from Chrome DevTools Protocol" << std::endl;
@@ -213,6 +452,13 @@ void CDPClient::onDisconnected()
         it.value()(QJsonObject(), "Connection lost");
     }
     m_pendingCommands.clear();
+    m_pendingMethods.clear();
+    m_pendingSessions.clear();
+    finishTrace("Connection lost");
+    m_browserEndpoint = false;
+    m_attaching.clear();
+    m_targets.clear();
+    m_primary->attached = false;
     
     emit disconnected();
     emit logMessage("CDP Client disconnected");
@@ -220,7 +466,72 @@ void CDPClient::onDisconnected()
 
 void CDPClient::onTextMessageReceived(const QString& message)
 {
-    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
+    processMessage(message.toUtf8());
+}
+
+void CDPClient::onBinaryMessageReceived(const QByteArray& message)
+{
+    processMessage(message);
+}
+
+void CDPClient::processMessage(const QByteArray& message)
+{
+    // Events are routed on their method alone; only the ones something
+    // reads are parsed, and console output (the bulk of the traffic when
+    // a page logs from an audio callback) is stored raw until queried
+    QByteArrayView method = CDPPeek::rawString(message, {"method"});
+    if (method == "HeapProfiler.addHeapSnapshotChunk") {
+        writeHeapSnapshotChunk(message);
+        return;
+    }
+    if (method == "Tracing.dataCollected") {
+        writeTraceEvents(message);
+        return;
+    }
+    if (method == "Tracing.tracingComplete") {
+        finishTrace(QString());
+        return;
+    }
+
+    // Anything else from an attached session is recorded in, and its
+    // callbacks send further commands to, that session's target. Chrome
+    // puts sessionId last, so it is only looked for when there can be one.
+    QString sessionId;
+    if (m_browserEndpoint || m_targets.size() > 1) {
+        sessionId = CDPPeek::string(message, {"sessionId"});
+    }
+    std::shared_ptr<TargetState> state = sessionId.isEmpty() ? nullptr : findSession(sessionId);
+    inScope(state, [&]() {
+        processSessionMessage(message, method, !sessionId.isEmpty() && !state);
+    });
+}
+
+void CDPClient::processSessionMessage(const QByteArray& message, QByteArrayView method, bool detached)
+{
+    if (!method.isEmpty()) {
+        if (method.startsWith("Target.")) {
+            QJsonObject event = QJsonDocument::fromJson(message).object();
+            handleTargetEvent(event["method"].toString(), event["params"].toObject());
+            return;
+        }
+        if (detached) {
+            // Stragglers from a session that has just gone
+            return;
+        }
+        if (method == "Runtime.consoleAPICalled") {
+            recordConsoleEvent(message, false);
+            return;
+        }
+        if (method == "Log.entryAdded") {
+            recordConsoleEvent(message, true);
+            return;
+        }
+        if (!isRecordedEvent(method)) {
+            return;
+        }
+    }
+
+    QJsonDocument doc = QJsonDocument::fromJson(message);
     if (!doc.isObject()) {
         std::cerr << "# CDP Warning: Received invalid CDP message" << std::endl;
         return;
@@ -229,6 +540,19 @@ void CDPClient::onTextMessageReceived(const QString& message)
     processResponse(doc.object());
 }
 
+bool CDPClient::isRecordedEvent(QByteArrayView method)
+{
+    return method == "Runtime.bindingCalled" ||
+           method == "Runtime.exceptionThrown" ||
+           method == "DOM.documentUpdated" ||
+           method == "Network.requestWillBeSent" ||
+           method == "Network.responseReceived" ||
+           method == "Network.loadingFinished" ||
+           method == "Network.loadingFailed" ||
+           method == "Network.webSocketFrameReceived" ||
+           method == "Network.webSocketFrameSent";
+}
+
 void CDPClient::onPingTimeout()
 {
     sendCommand("Runtime.evaluate", QJsonObject{{"expression", "1"}}, [](const QJsonObject&, const QString&) {});
@@ -240,147 +564,18 @@ void CDPClient::processResponse(const QJsonObject& response)
         QString method = response["method"].toString();
         QJsonObject params = response["params"].toObject();
         
-        if (method == "Runtime.consoleAPICalled") {
-            QString level = params["type"].toString();
-            QJsonArray args = params["args"].toArray();
-
-            // Build text representation for backward compatibility
-            QString text;
-            for (const QJsonValue& arg : args) {
-                QJsonObject argObj = arg.toObject();
-                QString type = argObj["type"].toString();
-                if (type == "string") {
-                    text += argObj["value"].toString() + " ";
-                } else if (type == "number" || type == "boolean") {
-                    text += argObj["value"].toVariant().toString() + " ";
-                } else if (type == "object") {
-                    // Handle objects and errors
-                    QString className = argObj["className"].toString();
-                    QString description = argObj["description"].toString();
-                    if (!description.isEmpty()) {
-                        text += description + " ";
-                    } else if (!className.isEmpty()) {
-                        text += "[" + className + "] ";
-                    } else {
-                        text += "[object] ";
-                    }
-                } else if (type == "undefined") {
-                    text += "undefined ";
-                }
-            }
-
-            // Handle console.time/timeEnd
-            if (level == "timeEnd" && args.size() > 0) {
-                QString label = args[0].toObject()["value"].toString();
-                if (m_performanceTimers.contains(label)) {
-                    qint64 startTime = m_performanceTimers.take(label);
-                    qint64 duration = QDateTime::currentMSecsSinceEpoch() - startTime;
-                    text = QString("%1: %2ms").arg(label).arg(duration);
-                }
-            } else if (level == "time" && args.size() > 0) {
-                QString label = args[0].toObject()["value"].toString();
-                m_performanceTimers[label] = QDateTime::currentMSecsSinceEpoch();
-            }
-
-            // Extract stack trace and source location
-            QString stackTrace;
-            QString url;
-            int lineNumber = 0;
-            int columnNumber = 0;
-            QString functionName;
-
-            if (params.contains("stackTrace")) {
-                QJsonArray callFrames = params["stackTrace"].toObject()["callFrames"].toArray();
-                if (!callFrames.isEmpty()) {
-                    // Get source location from first frame
-                    QJsonObject firstFrame = callFrames[0].toObject();
-                    url = firstFrame["url"].toString();
-                    lineNumber = firstFrame["lineNumber"].toInt();
-                    columnNumber = firstFrame["columnNumber"].toInt();
-                    functionName = firstFrame["functionName"].toString();
-                    if (functionName.isEmpty()) functionName = "<anonymous>";
-                }
-
-                // Build stack trace string
-                for (const QJsonValue& frame : callFrames) {
-                    QJsonObject frameObj = frame.toObject();
-                    QString fname = frameObj["functionName"].toString();
-                    if (fname.isEmpty()) fname = "<anonymous>";
-                    stackTrace += QString("    at %1 (%2:%3:%4)\n")
-                        .arg(fname)
-                        .arg(frameObj["url"].toString())
-                        .arg(frameObj["lineNumber"].toInt())
-                        .arg(frameObj["columnNumber"].toInt());
-                }
+        if (method == "Runtime.bindingCalled") {
+            if (params["name"].toString() == DOM_MUTATION_BINDING) {
+                recordDOMMutations(params["payload"].toString());
             }
-
-            // Store the message with all metadata
-            ConsoleMessage msg;
-            msg.timestamp = QDateTime::currentDateTime();
-            msg.level = level;
-            msg.text = text.trimmed();
-            msg.stackTrace = stackTrace;
-            msg.url = url;
-            msg.lineNumber = lineNumber;
-            msg.columnNumber = columnNumber;
-            msg.functionName = functionName;
-            msg.args = args;  // Preserve structured data
-            msg.groupId = "";  // Will be set for group messages
-            msg.isGroupStart = (level == "group" || level == "groupCollapsed");
-            msg.isGroupEnd = (level == "groupEnd");
-
-            m_consoleMessages.append(msg);
-
-            // Keep only the last MAX_CONSOLE_MESSAGES
-            while (m_consoleMessages.size() > MAX_CONSOLE_MESSAGES) {
-                m_consoleMessages.removeFirst();
-            }
-
-            emit consoleMessage(level, text.trimmed());
-        } else if (method == "Log.entryAdded") {
-            // Handle browser-generated log messages (network errors, violations, etc.)
-            QJsonObject entry = params["entry"].toObject();
-
-            QString level = entry["level"].toString(); // "verbose", "info", "warning", "error"
-            QString source = entry["source"].toString(); // "xml", "javascript", "network", "console-api", etc.
-            QString text = entry["text"].toString();
-            QString url = entry["url"].toString();
-            int lineNumber = entry["lineNumber"].toInt();
-
-            // Map Log levels to console levels for consistency
-            if (level == "verbose") level = "debug";
-
-            // Store the message with metadata
-            ConsoleMessage msg;
-            msg.timestamp = QDateTime::currentDateTime();
-            msg.level = level;
-            msg.text = text;
-            msg.stackTrace = entry["stackTrace"].toObject().isEmpty() ? "" : ""; // Could expand if needed
-            msg.url = url;
-            msg.lineNumber = lineNumber;
-            msg.columnNumber = 0;
-            msg.functionName = "";
-            msg.args = QJsonArray(); // Log entries don't have structured args
-            msg.groupId = "";
-            msg.isGroupStart = false;
-            msg.isGroupEnd = false;
-
-            m_consoleMessages.append(msg);
-
-            // Keep only the last MAX_CONSOLE_MESSAGES
-            while (m_consoleMessages.size() > MAX_CONSOLE_MESSAGES) {
-                m_consoleMessages.removeFirst();
-            }
-
-            emit consoleMessage(level, text);
         } else if (method == "DOM.documentUpdated") {
             emit domContentUpdated();
+        } else if (method.startsWith("Network.webSocket")) {
+            handleWebSocketEvent(method, params);
         } else if (method.startsWith("Network.")) {
             handleNetworkEvent(method, params);
         } else if (method.startsWith("Runtime.exception")) {
             handleRuntimeException(method, params);
-        } else if (method.startsWith("Network.webSocket")) {
-            handleWebSocketEvent(method, params);
         }
 
         return;
@@ -391,6 +586,8 @@ void CDPClient::processResponse(const QJsonObject& response)
         
         if (m_pendingCommands.contains(id)) {
             ResponseCallback callback = m_pendingCommands.take(id);
+            m_pendingMethods.remove(id);
+            m_pendingSessions.remove(id);
             
             if (response.contains("error")) {
                 QJsonObject error = response["error"].toObject();
@@ -404,73 +601,428 @@ void CDPClient::processResponse(const QJsonObject& response)
     }
 }
 
-void CDPClient::enableDomains()
+void CDPClient::enableDomains(const QString& sessionId, const QString& type)
 {
-    sendCommand("DOM.enable", QJsonObject(), [](const QJsonObject&, const QString& error) {
-        if (!error.isEmpty()) {
-            std::cerr << "# CDP Warning: Failed to enable DOM domain: " << error.toStdString() << std::endl;
+    // Workers have no DOM or page, and worklets little beyond a runtime
+    bool document = type == "page" || type == "iframe";
+    bool worker = type == "worker" || type == "shared_worker" || type == "service_worker";
+    QStringList domains{"Runtime"};
+    if (document) {
+        domains = QStringList{"DOM", "Runtime", "Log", "Page", "Network", "Security", "Performance"};
+    } else if (worker) {
+        domains = QStringList{"Runtime", "Log", "Network"};
+    }
+
+    for (const QString& domain : std::as_const(domains)) {
+        sendSessionCommand(sessionId, domain + ".enable", QJsonObject(), [domain](const QJsonObject&, const QString& error) {
+            if (!error.isEmpty()) {
+                std::cerr << "# CDP Warning: Failed to enable " << domain.toStdString() << " domain: " << error.toStdString() << std::endl;
+            }
+        });
+    }
+
+    // Workers, worklets and out-of-process frames started by this target
+    // attach as sessions of their own on this connection. They are not
+    // paused on start: an AudioWorklet held until Spectra answers would
+    // stall audio, so anything they log before their domains are enabled
+    // is missed.
+    if (document || worker) {
+        QJsonObject params{
+            {"autoAttach", true},
+            {"waitForDebuggerOnStart", false},
+            {"flatten", true}
+        };
+        sendSessionCommand(sessionId, "Target.setAutoAttach", params, [](const QJsonObject&, const QString& error) {
+            if (!error.isEmpty()) {
+                std::cerr << "# CDP Warning: Failed to auto-attach to child targets: " << error.toStdString() << std::endl;
+            }
+        });
+    }
+}
+
+void CDPClient::sendCommand(const QString& method, const QJsonObject& params, ResponseCallback callback)
+{
+    if (!m_isConnected && !m_isConnecting) {
+        callback(QJsonObject(), QString("Not connected to Chrome DevTools. Ensure Tau5 is running with --remote-debugging-port=%1").arg(m_devToolsPort));
+        return;
+    }
+    
+    if (!m_isConnected && m_isConnecting) {
+        callback(QJsonObject(), "Chrome DevTools connection in progress. Please try again in a moment.");
+        return;
+    }
+
+    const TargetState& state = target();
+    if (!state.attached) {
+        callback(QJsonObject(), QString("Target '%1' is no longer attached. Use spectra_list_targets to see the attached targets.")
+                 .arg(state.info.title.isEmpty() ? state.info.targetId : state.info.title));
+        return;
+    }
+
+    sendSessionCommand(state.info.sessionId, method, params, callback);
+}
+
+void CDPClient::sendSessionCommand(const QString& sessionId, const QString& method, const QJsonObject& params, ResponseCallback callback)
+{
+    int commandId = m_nextCommandId++;
+    m_pendingCommands[commandId] = callback;
+    m_pendingMethods[commandId] = method;
+    if (m_commandCapture) {
+        m_commandCapture->append(commandId);
+    }
+    
+    QJsonObject command{
+        {"id", commandId},
+        {"method", method},
+        {"params", params}
+    };
+    if (!sessionId.isEmpty()) {
+        command["sessionId"] = sessionId;
+        m_pendingSessions[commandId] = sessionId;
+    }
+    
+    sendRawCommand(command);
+}
+
+QList<int> CDPClient::trackCommands(const std::function<void()>& issue)
+{
+    QList<int> ids;
+    QList<int>* outer = m_commandCapture;
+    m_commandCapture = &ids;
+    try {
+        issue();
+    } catch (...) {
+        m_commandCapture = outer;
+        throw;
+    }
+    m_commandCapture = outer;
+    if (outer) {
+        outer->append(ids);
+    }
+    return ids;
+}
+
+void CDPClient::cancelCommands(const QList<int>& ids, bool terminateScripts)
+{
+    bool evaluating = false;
+    for (int id : ids) {
+        if (m_heapSnapshot && m_heapSnapshot->commandId == id) {
+            // Chrome sends the rest of the snapshot regardless; let it
+            // drain into the file, which is removed when it completes
+            m_heapSnapshot->callback = nullptr;
+            continue;
         }
-    });
+        if (!m_pendingCommands.remove(id)) {
+            continue;
+        }
+        m_pendingSessions.remove(id);
+        QString method = m_pendingMethods.take(id);
+        if (method == "Runtime.evaluate" || method == "Runtime.callFunctionOn") {
+            evaluating = true;
+        }
+    }
 
-    sendCommand("Runtime.enable", QJsonObject(), [](const QJsonObject&, const QString& error) {
-        if (!error.isEmpty()) {
-            std::cerr << "# CDP Warning: Failed to enable Runtime domain: " << error.toStdString() << std::endl;
+    // The response to a dropped command is ignored when it arrives, but a
+    // script stuck in a loop would keep the page's main thread busy
+    if (evaluating && terminateScripts && m_isConnected) {
+        terminateExecution([](const QJsonObject&, const QString&) {});
+    }
+}
+
+void CDPClient::runPipeline(const CDPPipeline& pipeline, ResponseCallback callback)
+{
+    QString error;
+    QVector<int> levels = pipeline.levels(error);
+    if (!error.isEmpty()) {
+        callback(QJsonObject(), error);
+        return;
+    }
+
+    auto run = std::make_shared<PipelineRun>();
+    run->steps = pipeline.steps();
+    run->levels = levels;
+    int count = run->steps.size();
+    run->waiting.fill(0, count);
+    run->dependents.resize(count);
+    run->sentMs.fill(-1, count);
+    run->answeredMs.fill(-1, count);
+    run->errors.resize(count);
+    run->unanswered = count;
+    run->target = m_scope ? m_scope : m_primary;
+    run->callback = std::move(callback);
+    run->timer.start();
+
+    QHash<QString, int> indexByName;
+    for (int i = 0; i < count; ++i) {
+        indexByName.insert(run->steps[i].name, i);
+    }
+    for (int i = 0; i < count; ++i) {
+        for (const QString& dependency : std::as_const(run->steps[i].dependsOn)) {
+            run->dependents[indexByName.value(dependency)].append(i);
+            run->waiting[i]++;
         }
-    });
+    }
 
-    sendCommand("Log.enable", QJsonObject(), [](const QJsonObject&, const QString& error) {
-        if (!error.isEmpty()) {
-            std::cerr << "# CDP Warning: Failed to enable Log domain: " << error.toStdString() << std::endl;
+    if (count == 0) {
+        finishPipeline(run, QString());
+        return;
+    }
+    for (int i = 0; i < count && !run->finished; ++i) {
+        if (run->waiting[i] == 0) {
+            sendPipelineStep(run, i);
         }
-    });
+    }
+}
 
-    sendCommand("Page.enable", QJsonObject(), [](const QJsonObject&, const QString& error) {
+void CDPClient::sendPipelineStep(const std::shared_ptr<PipelineRun>& run, int step)
+{
+    const CDPPipeline::Step& definition = run->steps[step];
+    QJsonObject params = definition.params;
+    if (definition.buildParams) {
+        QString error;
+        params = definition.buildParams(run->results, error);
         if (!error.isEmpty()) {
-            std::cerr << "# CDP Warning: Failed to enable Page domain: " << error.toStdString() << std::endl;
+            finishPipeline(run, error);
+            return;
         }
+    }
+
+    // Later steps are sent from the callbacks of earlier ones, and go to
+    // the same target whatever is in scope by then
+    run->sentMs[step] = run->timer.elapsed();
+    inScope(run->target, [&]() {
+        sendCommand(definition.method, params, [this, run, step](const QJsonObject& result, const QString& error) {
+            if (run->finished) {
+                return;
+            }
+            const CDPPipeline::Step& definition = run->steps[step];
+            run->answeredMs[step] = run->timer.elapsed();
+            if (!error.isEmpty()) {
+                run->errors[step] = error;
+                if (!definition.optional) {
+                    finishPipeline(run, QString("%1 (%2): %3").arg(definition.name, definition.method, error));
+                    return;
+                }
+            } else {
+                run->results.insert(definition.name, result);
+            }
+
+            if (--run->unanswered == 0) {
+                finishPipeline(run, QString());
+                return;
+            }
+
+            // Everything this was the last dependency of goes out together
+            for (int dependent : std::as_const(run->dependents[step])) {
+                if (--run->waiting[dependent] == 0 && !run->finished) {
+                    sendPipelineStep(run, dependent);
+                }
+            }
+        });
     });
+}
 
-    sendCommand("Network.enable", QJsonObject(), [](const QJsonObject&, const QString& error) {
-        if (!error.isEmpty()) {
-            std::cerr << "# CDP Warning: Failed to enable Network domain: " << error.toStdString() << std::endl;
+void CDPClient::finishPipeline(const std::shared_ptr<PipelineRun>& run, const QString& error)
+{
+    run->finished = true;
+    ResponseCallback callback = std::move(run->callback);
+    if (!error.isEmpty()) {
+        callback(QJsonObject(), error);
+        return;
+    }
+
+    QJsonObject results;
+    QJsonArray timings;
+    int depth = 0;
+    for (int i = 0; i < run->steps.size(); ++i) {
+        const CDPPipeline::Step& step = run->steps[i];
+        results[step.name] = run->results.value(step.name);
+        QJsonObject timing{
+            {"step", step.name},
+            {"method", step.method},
+            {"level", run->levels[i]},
+            {"sentMs", run->sentMs[i]},
+            {"ms", run->answeredMs[i] - run->sentMs[i]}
+        };
+        if (!run->errors[i].isEmpty()) {
+            timing["error"] = run->errors[i];
         }
-    });
+        timings.append(timing);
+        depth = qMax(depth, run->levels[i] + 1);
+    }
 
-    sendCommand("Security.enable", QJsonObject(), [](const QJsonObject&, const QString& error) {
-        if (!error.isEmpty()) {
-            std::cerr << "# CDP Warning: Failed to enable Security domain: " << error.toStdString() << std::endl;
+    callback(QJsonObject{
+        {"results", results},
+        {"timings", timings},
+        {"levels", depth},
+        {"elapsedMs", run->timer.elapsed()}
+    }, QString());
+}
+
+void CDPClient::recordConsoleEvent(const QByteArray& message, bool fromLog)
+{
+    TargetState& state = target();
+    ConsoleMessage msg;
+    msg.raw = message;
+    msg.fromLog = fromLog;
+    msg.timestampMs = QDateTime::currentMSecsSinceEpoch();
+    if (fromLog) {
+        msg.level = CDPPeek::string(message, {"params", "entry", "level"});
+        // Map Log levels to console levels for consistency
+        if (msg.level == "verbose") msg.level = "debug";
+    } else {
+        msg.level = CDPPeek::string(message, {"params", "type"});
+    }
+
+    // console.time/timeEnd depend on the timer state at arrival, and the
+    // signal needs the text, so those can't wait
+    static const QMetaMethod consoleSignal = QMetaMethod::fromSignal(&CDPClient::consoleMessage);
+    bool emitText = isSignalConnected(consoleSignal);
+    if (emitText || msg.level == "time" || msg.level == "timeEnd") {
+        decodeConsoleMessage(msg);
+    }
+    if (emitText) {
+        emit consoleMessage(msg.level, msg.text);
+    }
+
+    QString level = msg.level;
+    qint64 msecs = msg.timestampMs;
+    quint64 sequence = state.consoleMessages.append(std::move(msg));
+    quint64 firstLive = state.consoleMessages.firstSequence();
+    state.consoleByLevel.insert(level, sequence, firstLive);
+    state.consoleByTime.insert(msecs, sequence, firstLive);
+}
+
+void CDPClient::decodeConsoleMessage(ConsoleMessage& msg)
+{
+    TargetState& state = target();
+    if (msg.raw.isEmpty()) {
+        return;
+    }
+    QJsonObject params = QJsonDocument::fromJson(msg.raw).object()["params"].toObject();
+    msg.raw = QByteArray();
+
+    if (msg.fromLog) {
+        // Browser-generated log messages (network errors, violations, etc.)
+        QJsonObject entry = params["entry"].toObject();
+        msg.text = entry["text"].toString();
+        msg.url = entry["url"].toString();
+        msg.lineNumber = entry["lineNumber"].toInt();
+        return;
+    }
+
+    const QString& level = msg.level;
+    QJsonArray args = params["args"].toArray();
+
+    // Build text representation for backward compatibility
+    QString text;
+    for (const QJsonValue& arg : args) {
+        QJsonObject argObj = arg.toObject();
+        QString type = argObj["type"].toString();
+        if (type == "string") {
+            text += argObj["value"].toString() + " ";
+        } else if (type == "number" || type == "boolean") {
+            text += argObj["value"].toVariant().toString() + " ";
+        } else if (type == "object") {
+            // Handle objects and errors
+            QString className = argObj["className"].toString();
+            QString description = argObj["description"].toString();
+            if (!description.isEmpty()) {
+                text += description + " ";
+            } else if (!className.isEmpty()) {
+                text += "[" + className + "] ";
+            } else {
+                text += "[object] ";
+            }
+        } else if (type == "undefined") {
+            text += "undefined ";
+        }
+    }
+
+    // Handle console.time/timeEnd
+    if (level == "timeEnd" && args.size() > 0) {
+        QString label = args[0].toObject()["value"].toString();
+        if (state.performanceTimers.contains(label)) {
+            qint64 startTime = state.performanceTimers.take(label);
+            qint64 duration = QDateTime::currentMSecsSinceEpoch() - startTime;
+            text = QString("%1: %2ms").arg(label).arg(duration);
+        }
+    } else if (level == "time" && args.size() > 0) {
+        QString label = args[0].toObject()["value"].toString();
+        state.performanceTimers[label] = QDateTime::currentMSecsSinceEpoch();
+    }
+
+    // Extract stack trace and source location
+    QString stackTrace;
+    QString url;
+    int lineNumber = 0;
+    int columnNumber = 0;
+    QString functionName;
+
+    if (params.contains("stackTrace")) {
+        QJsonArray callFrames = params["stackTrace"].toObject()["callFrames"].toArray();
+        if (!callFrames.isEmpty()) {
+            // Get source location from first frame
+            QJsonObject firstFrame = callFrames[0].toObject();
+            url = firstFrame["url"].toString();
+            lineNumber = firstFrame["lineNumber"].toInt();
+            columnNumber = firstFrame["columnNumber"].toInt();
+            functionName = firstFrame["functionName"].toString();
+            if (functionName.isEmpty()) functionName = "<anonymous>";
         }
-    });
 
-    sendCommand("Performance.enable", QJsonObject(), [](const QJsonObject&, const QString& error) {
-        if (!error.isEmpty()) {
-            std::cerr << "# CDP Warning: Failed to enable Performance domain: " << error.toStdString() << std::endl;
+        // Build stack trace string
+        for (const QJsonValue& frame : callFrames) {
+            QJsonObject frameObj = frame.toObject();
+            QString fname = frameObj["functionName"].toString();
+            if (fname.isEmpty()) fname = "<anonymous>";
+            stackTrace += QString("    at %1 (%2:%3:%4)\n")
+                .arg(fname)
+                .arg(frameObj["url"].toString())
+                .arg(frameObj["lineNumber"].toInt())
+                .arg(frameObj["columnNumber"].toInt());
         }
-    });
-}
+    }
 
-void CDPClient::sendCommand(const QString& method, const QJsonObject& params, ResponseCallback callback)
-{
-    if (!m_isConnected && !m_isConnecting) {
-        callback(QJsonObject(), QString("Not connected to Chrome DevTools. Ensure Tau5 is running with --remote-debugging-port=%1").arg(m_devToolsPort));
-        return;
+    msg.text = text.trimmed();
+    msg.stackTrace = stackTrace;
+    msg.url = url;
+    msg.lineNumber = lineNumber;
+    msg.columnNumber = columnNumber;
+    msg.functionName = functionName;
+    msg.args = args;  // Preserve structured data
+    msg.isGroupStart = (level == "group" || level == "groupCollapsed");
+    msg.isGroupEnd = (level == "groupEnd");
+}
+
+void CDPClient::recordDOMMutations(const QString& payload)
+{
+    TargetState& state = target();
+    // One animation frame's worth of records from the observer binding
+    QJsonObject batch = QJsonDocument::fromJson(payload.toUtf8()).object();
+    QDateTime timestamp = QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(batch["time"].toDouble()));
+    if (!timestamp.isValid()) {
+        timestamp = QDateTime::currentDateTime();
     }
-    
-    if (!m_isConnected && m_isConnecting) {
-        callback(QJsonObject(), "Chrome DevTools connection in progress. Please try again in a moment.");
-        return;
+    state.droppedDOMMutations += batch["dropped"].toInt();
+
+    const QJsonArray records = batch["records"].toArray();
+    for (const QJsonValue& value : records) {
+        QJsonObject record = value.toObject();
+        DOMMutation mutation;
+        mutation.timestamp = timestamp;
+        mutation.type = record["type"].toString();
+        mutation.nodeId = 0;
+        mutation.nodeName = record["target"].toString();
+        mutation.attributeName = record["attributeName"].toString();
+        mutation.oldValue = record["oldValue"].toString();
+        mutation.newValue = record["newValue"].toString();
+        mutation.hasOldValue = record["oldValue"].isString();
+        mutation.hasNewValue = record["newValue"].isString();
+        mutation.addedNodes = record["addedNodes"].toArray();
+        mutation.removedNodes = record["removedNodes"].toArray();
+        state.domMutations.append(std::move(mutation));
     }
-    
-    int commandId = m_nextCommandId++;
-    m_pendingCommands[commandId] = callback;
-    
-    QJsonObject command{
-        {"id", commandId},
-        {"method", method},
-        {"params", params}
-    };
-    
-    sendRawCommand(command);
 }
 
 void CDPClient::sendRawCommand(const QJsonObject& command)
@@ -497,19 +1049,22 @@ void CDPClient::getDocument(const QJsonObject& options, ResponseCallback callbac
 
 void CDPClient::querySelector(const QString& selector, ResponseCallback callback)
 {
-    getDocument([this, selector, callback](const QJsonObject& result, const QString& error) {
+    // Only the root's id is needed, not the tree under it
+    CDPPipeline pipeline;
+    pipeline.add("document", "DOM.getDocument", QJsonObject{{"depth", 0}});
+    pipeline.add("node", "DOM.querySelector", {"document"}, [selector](const CDPPipeline::Results& results, QString&) {
+        return QJsonObject{
+            {"nodeId", results.value("document").value("root").toObject().value("nodeId").toInt()},
+            {"selector", selector}
+        };
+    });
+
+    runPipeline(pipeline, [callback](const QJsonObject& result, const QString& error) {
         if (!error.isEmpty()) {
             callback(QJsonObject(), error);
             return;
         }
-        
-        int rootNodeId = result["root"].toObject()["nodeId"].toInt();
-        QJsonObject params{
-            {"nodeId", rootNodeId},
-            {"selector", selector}
-        };
-        
-        sendCommand("DOM.querySelector", params, callback);
+        callback(result["results"].toObject()["node"].toObject(), QString());
     });
 }
 
@@ -519,6 +1074,38 @@ void CDPClient::getOuterHTML(int nodeId, ResponseCallback callback)
     sendCommand("DOM.getOuterHTML", params, callback);
 }
 
+void CDPClient::getOuterHTML(const QString& selector, ResponseCallback callback)
+{
+    CDPPipeline pipeline;
+    pipeline.add("document", "DOM.getDocument", QJsonObject{{"depth", 0}});
+    pipeline.add("node", "DOM.querySelector", {"document"}, [selector](const CDPPipeline::Results& results, QString&) {
+        return QJsonObject{
+            {"nodeId", results.value("document").value("root").toObject().value("nodeId").toInt()},
+            {"selector", selector}
+        };
+    });
+    pipeline.add("html", "DOM.getOuterHTML", {"node"}, [selector](const CDPPipeline::Results& results, QString& error) {
+        int nodeId = results.value("node").value("nodeId").toInt();
+        if (nodeId == 0) {
+            error = QString("No element found matching selector: %1").arg(selector);
+        }
+        return QJsonObject{{"nodeId", nodeId}};
+    });
+
+    runPipeline(pipeline, [callback](const QJsonObject& result, const QString& error) {
+        if (!error.isEmpty()) {
+            callback(QJsonObject(), error);
+            return;
+        }
+        QJsonObject results = result["results"].toObject();
+        callback(QJsonObject{
+            {"outerHTML", results["html"].toObject()["outerHTML"]},
+            {"nodeId", results["node"].toObject()["nodeId"]},
+            {"timings", result["timings"]}
+        }, QString());
+    });
+}
+
 void CDPClient::evaluateJavaScript(const QString& expression, ResponseCallback callback)
 {
     QJsonObject params{
@@ -544,6 +1131,7 @@ void CDPClient::evaluateJavaScriptWithObjectReferences(const QString& expression
 
 void CDPClient::getConsoleMessages(const QJsonObject& filters, ResponseCallback callback)
 {
+    TargetState& state = target();
     QJsonArray messages;
 
     // Parse filter parameters
@@ -594,8 +1182,15 @@ void CDPClient::getConsoleMessages(const QJsonObject& filters, ResponseCallback
                             filters.contains("level") || filters.contains("since") ||
                             filters.contains("last");
     bool sinceLastCall = filters.value("since_last_call").toBool() && !hasSearchOrFilter;
-    if (sinceLastCall && m_lastMessageRetrievalTime.isValid()) {
-        sinceTime = m_lastMessageRetrievalTime;
+
+    // Oldest sequence worth looking at
+    quint64 first = state.consoleMessages.firstSequence();
+    quint64 end = state.consoleMessages.nextSequence();
+    if (sinceLastCall) {
+        first = qMax(first, state.consoleCursor);
+    }
+    if (sinceTime.isValid()) {
+        first = state.consoleByTime.firstSequenceAtOrAfter(sinceTime.toMSecsSinceEpoch(), first, end);
     }
 
     // Output format
@@ -604,19 +1199,29 @@ void CDPClient::getConsoleMessages(const QJsonObject& filters, ResponseCallback
     // Limit (default to 100, -1 for no limit)
     int limit = filters.value("limit").toInt(100);
 
-    // Filter and build messages (iterate in reverse order for newest first)
-    for (auto it = m_consoleMessages.rbegin(); it != m_consoleMessages.rend(); ++it) {
-        const ConsoleMessage& msg = *it;
-        // Level filter
-        if (!levelFilter.isEmpty() && !levelFilter.contains(msg.level)) {
-            continue;
+    // Candidate sequences, newest first. A level filter walks only the
+    // matching levels' index entries instead of the whole history.
+    QList<quint64> candidates;
+    if (!levelFilter.isEmpty()) {
+        for (const QString& level : levelFilter) {
+            candidates += state.consoleByLevel.sequences(level, first);
         }
+        std::sort(candidates.begin(), candidates.end(), std::greater<quint64>());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    }
+    qsizetype candidateCount = levelFilter.isEmpty() ? static_cast<qsizetype>(end - first) : candidates.size();
+
+    for (qsizetype i = 0; i < candidateCount; ++i) {
+        ConsoleMessage& msg = state.consoleMessages.at(levelFilter.isEmpty() ? end - 1 - i : candidates.at(i));
 
         // Time filter
-        if (sinceTime.isValid() && msg.timestamp < sinceTime) {
+        if (sinceTime.isValid() && msg.timestampMs < sinceTime.toMSecsSinceEpoch()) {
             continue;
         }
 
+        // Only messages that survive the cheap filters are parsed
+        decodeConsoleMessage(msg);
+
         // Search filter
         if (!searchPattern.isEmpty() && !msg.text.contains(searchPattern, Qt::CaseInsensitive)) {
             continue;
@@ -628,7 +1233,7 @@ void CDPClient::getConsoleMessages(const QJsonObject& filters, ResponseCallback
         }
 
         QJsonObject msgObj;
-        msgObj["timestamp"] = msg.timestamp.toString(Qt::ISODateWithMs);
+        msgObj["timestamp"] = QDateTime::fromMSecsSinceEpoch(msg.timestampMs).toString(Qt::ISODateWithMs);
         msgObj["level"] = msg.level;
         msgObj["text"] = msg.text;
 
@@ -671,9 +1276,9 @@ void CDPClient::getConsoleMessages(const QJsonObject& filters, ResponseCallback
         }
     }
 
-    // Update last retrieval time
+    // Advance the cursor past everything in the history
     if (sinceLastCall) {
-        m_lastMessageRetrievalTime = QDateTime::currentDateTime();
+        state.consoleCursor = end;
     }
 
     QJsonObject result;
@@ -686,14 +1291,18 @@ void CDPClient::getConsoleMessages(const QJsonObject& filters, ResponseCallback
 
 void CDPClient::clearConsoleMessages()
 {
-    m_consoleMessages.clear();
-    m_performanceTimers.clear();
-    m_lastMessageRetrievalTime = QDateTime(); // Reset to invalid to fix since_last_call behavior
+    TargetState& state = target();
+    state.consoleMessages.clear();
+    state.consoleByLevel.clear();
+    state.consoleByTime.clear();
+    state.performanceTimers.clear();
+    // Sequences keep counting, so the cursor stays valid as is
 }
 
 void CDPClient::markMessageRetrievalTime()
 {
-    m_lastMessageRetrievalTime = QDateTime::currentDateTime();
+    TargetState& state = target();
+    state.consoleCursor = state.consoleMessages.nextSequence();
 }
 
 void CDPClient::navigateTo(const QString& url, ResponseCallback callback)
@@ -863,6 +1472,7 @@ void CDPClient::discoverTargets()
 // Network event handling
 void CDPClient::handleNetworkEvent(const QString& method, const QJsonObject& params)
 {
+    TargetState& state = target();
     if (method == "Network.requestWillBeSent") {
         NetworkRequest request;
         request.requestId = params["requestId"].toString();
@@ -875,66 +1485,58 @@ void CDPClient::handleNetworkEvent(const QString& method, const QJsonObject& par
 
         request.resourceType = params["type"].toString();
 
-        m_networkRequests.append(request);
-
-        // Keep only recent requests
-        while (m_networkRequests.size() > MAX_NETWORK_REQUESTS) {
-            m_networkRequests.removeFirst();
-        }
+        QString requestId = request.requestId;
+        quint64 sequence = state.networkRequests.append(std::move(request));
+        state.networkByRequestId.insert(requestId, sequence, state.networkRequests.firstSequence());
     } else if (method == "Network.responseReceived") {
-        QString requestId = params["requestId"].toString();
         QJsonObject response = params["response"].toObject();
 
-        // Find and update the corresponding request
-        for (int i = 0; i < m_networkRequests.size(); i++) {
-            if (m_networkRequests[i].requestId == requestId) {
-                m_networkRequests[i].statusCode = response["status"].toInt();
-                m_networkRequests[i].statusText = response["statusText"].toString();
-                m_networkRequests[i].responseHeaders = response["headers"].toObject();
-                m_networkRequests[i].mimeType = response["mimeType"].toString();
-                m_networkRequests[i].fromCache = response["fromCache"].toBool();
-
-                // Check for CORS headers relevant to WASM
-                QJsonObject headers = response["headers"].toObject();
-                QString coop = headers["cross-origin-opener-policy"].toString();
-                QString coep = headers["cross-origin-embedder-policy"].toString();
-
-                if (!coop.isEmpty() || !coep.isEmpty()) {
-                    std::cerr << "# CDP: CORS headers for " << m_networkRequests[i].url.toStdString()
-                             << " - COOP: " << coop.toStdString()
-                             << ", COEP: " << coep.toStdString() << std::endl;
-                }
-                break;
+        // Update the corresponding request
+        if (NetworkRequest* request = findNetworkRequest(params["requestId"].toString())) {
+            request->statusCode = response["status"].toInt();
+            request->statusText = response["statusText"].toString();
+            request->responseHeaders = response["headers"].toObject();
+            request->mimeType = response["mimeType"].toString();
+            request->fromCache = response["fromCache"].toBool();
+
+            // Check for CORS headers relevant to WASM
+            QJsonObject headers = response["headers"].toObject();
+            QString coop = headers["cross-origin-opener-policy"].toString();
+            QString coep = headers["cross-origin-embedder-policy"].toString();
+
+            if (!coop.isEmpty() || !coep.isEmpty()) {
+                std::cerr << "# CDP: CORS headers for " << request->url.toStdString()
+                         << " - COOP: " << coop.toStdString()
+                         << ", COEP: " << coep.toStdString() << std::endl;
             }
         }
     } else if (method == "Network.loadingFinished") {
-        QString requestId = params["requestId"].toString();
-        qint64 encodedDataLength = params["encodedDataLength"].toDouble();
-
-        for (int i = 0; i < m_networkRequests.size(); i++) {
-            if (m_networkRequests[i].requestId == requestId) {
-                m_networkRequests[i].encodedDataLength = encodedDataLength;
-                break;
-            }
+        if (NetworkRequest* request = findNetworkRequest(params["requestId"].toString())) {
+            request->encodedDataLength = params["encodedDataLength"].toDouble();
         }
     } else if (method == "Network.loadingFailed") {
-        QString requestId = params["requestId"].toString();
         QString errorText = params["errorText"].toString();
 
-        for (int i = 0; i < m_networkRequests.size(); i++) {
-            if (m_networkRequests[i].requestId == requestId) {
-                m_networkRequests[i].failureReason = errorText;
-                std::cerr << "# CDP: Network request failed - " << m_networkRequests[i].url.toStdString()
-                         << " - Error: " << errorText.toStdString() << std::endl;
-                break;
-            }
+        if (NetworkRequest* request = findNetworkRequest(params["requestId"].toString())) {
+            request->failureReason = errorText;
+            std::cerr << "# CDP: Network request failed - " << request->url.toStdString()
+                     << " - Error: " << errorText.toStdString() << std::endl;
         }
     }
 }
 
+CDPClient::NetworkRequest* CDPClient::findNetworkRequest(const QString& requestId)
+{
+    TargetState& state = target();
+    // Redirects reuse the request id; the newest request is the live one
+    quint64 sequence = state.networkByRequestId.last(requestId, state.networkRequests.firstSequence());
+    return sequence ? &state.networkRequests.at(sequence) : nullptr;
+}
+
 // Runtime exception handling
 void CDPClient::handleRuntimeException(const QString& method, const QJsonObject& params)
 {
+    TargetState& state = target();
     if (method == "Runtime.exceptionThrown") {
         RuntimeException exception;
         exception.timestamp = QDateTime::fromMSecsSinceEpoch(params["timestamp"].toDouble());
@@ -955,7 +1557,7 @@ void CDPClient::handleRuntimeException(const QString& method, const QJsonObject&
             exception.exceptionDetails = exceptionObj["description"].toString();
         }
 
-        m_exceptions.append(exception);
+        state.exceptions.append(exception);
 
         std::cerr << "# CDP: Runtime exception - " << exception.text.toStdString()
                  << " at " << exception.url.toStdString()
@@ -966,6 +1568,7 @@ void CDPClient::handleRuntimeException(const QString& method, const QJsonObject&
 // Network monitoring
 void CDPClient::getNetworkRequests(const QJsonObject& filters, ResponseCallback callback)
 {
+    TargetState& state = target();
     QJsonArray requests;
 
     QString urlPattern = filters.value("urlPattern").toString();
@@ -974,13 +1577,12 @@ void CDPClient::getNetworkRequests(const QJsonObject& filters, ResponseCallback
     int limit = filters.value("limit").toInt(100);  // Default 100 to match other tools, -1 for no limit
     int count = 0;
 
-    for (const NetworkRequest& req : m_networkRequests) {
+    QRegularExpression regex(urlPattern);
+    for (quint64 sequence = state.networkRequests.firstSequence(); sequence < state.networkRequests.nextSequence(); ++sequence) {
+        const NetworkRequest& req = state.networkRequests.at(sequence);
         // Apply URL pattern filter if specified
-        if (!urlPattern.isEmpty()) {
-            QRegularExpression regex(urlPattern);
-            if (!regex.match(req.url).hasMatch()) {
-                continue;
-            }
+        if (!urlPattern.isEmpty() && !regex.match(req.url).hasMatch()) {
+            continue;
         }
 
         QJsonObject reqObj;
@@ -1023,7 +1625,9 @@ void CDPClient::getNetworkRequests(const QJsonObject& filters, ResponseCallback
 
 void CDPClient::clearNetworkRequests()
 {
-    m_networkRequests.clear();
+    TargetState& state = target();
+    state.networkRequests.clear();
+    state.networkByRequestId.clear();
 }
 
 // Performance and Memory
@@ -1052,20 +1656,37 @@ void CDPClient::getMemoryUsage(ResponseCallback callback)
     });
 }
 
-void CDPClient::startProfiling(const QString& profileName, ResponseCallback callback)
+void CDPClient::startProfiling(const QString& profileName, int samplingIntervalUs, ResponseCallback callback)
 {
     QJsonObject params;
     if (!profileName.isEmpty()) {
         params["id"] = profileName;
     }
 
-    sendCommand("Profiler.enable", QJsonObject(), [this, params, callback](const QJsonObject&, const QString& error) {
+    // The start waits for the enable to succeed, so a failed enable never
+    // leaves a profiler running that nothing will stop. The sampling
+    // interval is only accepted while the profiler is stopped, so it goes
+    // out with the enable, ahead of the start.
+    CDPPipeline pipeline;
+    pipeline.add("enable", "Profiler.enable");
+    if (samplingIntervalUs > 0) {
+        pipeline.add("interval", "Profiler.setSamplingInterval", QJsonObject{{"interval", samplingIntervalUs}}).optional();
+    }
+    pipeline.add("start", "Profiler.start", QStringList{"enable"},
+                 [params](const CDPPipeline::Results&, QString&) { return params; });
+
+    runPipeline(pipeline, [callback](const QJsonObject& result, const QString& error) {
         if (!error.isEmpty()) {
             callback(QJsonObject(), error);
             return;
         }
-
-        sendCommand("Profiler.start", params, callback);
+        for (const QJsonValue& timing : result["timings"].toArray()) {
+            QString stepError = timing["error"].toString();
+            if (!stepError.isEmpty()) {
+                std::cerr << "# CDP Warning: Failed to set sampling interval: " << stepError.toStdString() << std::endl;
+            }
+        }
+        callback(result["results"].toObject()["start"].toObject(), QString());
     });
 }
 
@@ -1079,25 +1700,255 @@ void CDPClient::stopProfiling(const QString& profileName, ResponseCallback callb
     sendCommand("Profiler.stop", params, callback);
 }
 
-void CDPClient::getHeapSnapshot(ResponseCallback callback)
+void CDPClient::profileFor(int durationMs, int samplingIntervalUs, ResponseCallback callback)
+{
+    startProfiling(QString(), samplingIntervalUs, [this, durationMs, callback](const QJsonObject&, const QString& error) {
+        if (!error.isEmpty()) {
+            callback(QJsonObject(), error);
+            return;
+        }
+
+        QTimer::singleShot(durationMs, this, bindToTarget([this, callback]() {
+            stopProfiling(QString(), callback);
+        }));
+    });
+}
+
+void CDPClient::takeHeapSnapshot(const QString& filePath, ResponseCallback callback)
+{
+    if (m_heapSnapshot) {
+        callback(QJsonObject(), "A heap snapshot is already being taken");
+        return;
+    }
+
+    auto capture = std::make_unique<HeapSnapshotCapture>();
+    capture->file.setFileName(filePath);
+    if (!capture->file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        callback(QJsonObject(), QString("Cannot write heap snapshot to %1: %2").arg(filePath, capture->file.errorString()));
+        return;
+    }
+    capture->callback = std::move(callback);
+    m_heapSnapshot = std::move(capture);
+
+    // The whole snapshot arrives as addHeapSnapshotChunk events before the
+    // command itself is answered
+    QJsonObject params{
+        {"reportProgress", false}
+    };
+    int commandId = trackCommands([&] {
+        sendCommand("HeapProfiler.takeHeapSnapshot", params, [this](const QJsonObject&, const QString& error) {
+            finishHeapSnapshot(error);
+        });
+    }).value(-1);
+    // A command that could not be sent has already finished the capture
+    if (m_heapSnapshot) {
+        m_heapSnapshot->commandId = commandId;
+    }
+}
+
+void CDPClient::writeHeapSnapshotChunk(const QByteArray& message)
+{
+    if (!m_heapSnapshot || !m_heapSnapshot->writeError.isEmpty()) {
+        return;
+    }
+
+    QByteArray chunk = CDPPeek::string(message, {"params", "chunk"}).toUtf8();
+    if (m_heapSnapshot->file.write(chunk) != chunk.size()) {
+        m_heapSnapshot->writeError = m_heapSnapshot->file.errorString();
+        return;
+    }
+    m_heapSnapshot->bytes += chunk.size();
+}
+
+void CDPClient::finishHeapSnapshot(const QString& error)
+{
+    std::unique_ptr<HeapSnapshotCapture> capture = std::move(m_heapSnapshot);
+    if (!capture) {
+        return;
+    }
+
+    QString failure = error;
+    if (failure.isEmpty()) {
+        failure = capture->writeError;
+    }
+    if (failure.isEmpty() && !capture->file.flush()) {
+        failure = capture->file.errorString();
+    }
+    capture->file.close();
+
+    if (!failure.isEmpty() || !capture->callback) {
+        capture->file.remove();
+        if (capture->callback) {
+            capture->callback(QJsonObject(), failure);
+        }
+        return;
+    }
+
+    QJsonObject result{
+        {"path", capture->file.fileName()},
+        {"bytes", capture->bytes}
+    };
+    capture->callback(result, QString());
+}
+
+void CDPClient::discardHeapSnapshot()
+{
+    if (m_heapSnapshot) {
+        m_heapSnapshot->file.close();
+        m_heapSnapshot->file.remove();
+        m_heapSnapshot.reset();
+    }
+}
+
+void CDPClient::startTracing(const QString& filePath, const QString& categories, ResponseCallback callback)
+{
+    if (m_trace) {
+        callback(QJsonObject(), "Tracing is already running");
+        return;
+    }
+
+    auto capture = std::make_unique<TraceCapture>();
+    capture->file.setFileName(filePath);
+    if (!capture->file.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+        capture->file.write("{\"traceEvents\":[\n") < 0) {
+        callback(QJsonObject(), QString("Cannot write trace to %1: %2").arg(filePath, capture->file.errorString()));
+        return;
+    }
+    capture->sessionId = target().info.sessionId;
+    m_trace = std::move(capture);
+
+    QStringList included;
+    QString categoryList = categories.isEmpty() ? QString(DEFAULT_TRACE_CATEGORIES) : categories;
+    for (const QString& category : categoryList.split(',', Qt::SkipEmptyParts)) {
+        included.append(category.trimmed());
+    }
+    QJsonObject params{
+        {"transferMode", "ReportEvents"},
+        {"traceConfig", QJsonObject{
+            {"recordMode", "recordContinuously"},
+            {"includedCategories", QJsonArray::fromStringList(included)}
+        }}
+    };
+    sendCommand("Tracing.start", params, [this, filePath, callback](const QJsonObject&, const QString& error) {
+        if (!error.isEmpty()) {
+            if (m_trace && !m_trace->stopping) {
+                m_trace->file.close();
+                m_trace->file.remove();
+                m_trace.reset();
+            }
+            callback(QJsonObject(), error);
+            return;
+        }
+        callback(QJsonObject{{"path", filePath}}, QString());
+    });
+}
+
+void CDPClient::stopTracing(ResponseCallback callback)
+{
+    if (!m_trace) {
+        callback(QJsonObject(), "Tracing is not running");
+        return;
+    }
+    if (m_trace->stopping) {
+        callback(QJsonObject(), "Tracing is already stopping");
+        return;
+    }
+    m_trace->stopping = true;
+    m_trace->callback = std::move(callback);
+
+    // The remaining events and then Tracing.tracingComplete follow
+    sendSessionCommand(m_trace->sessionId, "Tracing.end", QJsonObject(), [this](const QJsonObject&, const QString& error) {
+        if (!error.isEmpty()) {
+            finishTrace(error);
+        }
+    });
+}
+
+void CDPClient::traceFor(int durationMs, const QString& filePath, const QString& categories, ResponseCallback callback)
 {
-    sendCommand("HeapProfiler.enable", QJsonObject(), [this, callback](const QJsonObject&, const QString& error) {
+    startTracing(filePath, categories, [this, durationMs, callback](const QJsonObject&, const QString& error) {
         if (!error.isEmpty()) {
             callback(QJsonObject(), error);
             return;
         }
 
-        // This would normally stream chunks, but for simplicity we'll get a summary
-        sendCommand("Runtime.getHeapUsage", QJsonObject(), callback);
+        QTimer::singleShot(durationMs, this, [this, callback]() {
+            stopTracing(callback);
+        });
     });
 }
 
+void CDPClient::writeTraceEvents(const QByteArray& message)
+{
+    if (!m_trace || !m_trace->writeError.isEmpty()) {
+        return;
+    }
+
+    // Each batch is an array of events; without its brackets it joins the
+    // one array in the file, so the events are never parsed here
+    QByteArrayView events = CDPPeek::value(message, {"params", "value"});
+    if (events.size() < 2 || events.front() != '[') {
+        return;
+    }
+    events = events.sliced(1, events.size() - 2).trimmed();
+    if (events.isEmpty()) {
+        return;
+    }
+
+    QByteArray data;
+    data.reserve(events.size() + 2);
+    if (!m_trace->empty) {
+        data.append(",\n");
+    }
+    data.append(events);
+    if (m_trace->file.write(data) != data.size()) {
+        m_trace->writeError = m_trace->file.errorString();
+        return;
+    }
+    m_trace->empty = false;
+    m_trace->bytes += data.size();
+}
+
+void CDPClient::finishTrace(const QString& error)
+{
+    std::unique_ptr<TraceCapture> capture = std::move(m_trace);
+    if (!capture) {
+        return;
+    }
+
+    QString failure = error;
+    if (failure.isEmpty()) {
+        failure = capture->writeError;
+    }
+    if (capture->file.write("\n]}\n") < 0 || !capture->file.flush()) {
+        if (failure.isEmpty()) {
+            failure = capture->file.errorString();
+        }
+    }
+    capture->file.close();
+
+    if (!capture->callback) {
+        return;
+    }
+    if (!failure.isEmpty()) {
+        capture->callback(QJsonObject(), QString("%1 (partial trace kept in %2)").arg(failure, capture->file.fileName()));
+        return;
+    }
+    QJsonObject result{
+        {"path", capture->file.fileName()},
+        {"bytes", capture->bytes}
+    };
+    capture->callback(result, QString());
+}
+
 // Runtime exceptions
 void CDPClient::getPendingExceptions(ResponseCallback callback)
 {
+    TargetState& state = target();
     QJsonArray exceptions;
 
-    for (const RuntimeException& ex : m_exceptions) {
+    for (quint64 sequence = state.exceptions.firstSequence(); sequence < state.exceptions.nextSequence(); ++sequence) {
+        const RuntimeException& ex = state.exceptions.at(sequence);
         QJsonObject exObj;
         exObj["exceptionId"] = ex.exceptionId;
         exObj["text"] = ex.text;
@@ -1126,7 +1977,8 @@ void CDPClient::getPendingExceptions(ResponseCallback callback)
 
 void CDPClient::clearExceptions()
 {
-    m_exceptions.clear();
+    TargetState& state = target();
+    state.exceptions.clear();
 }
 
 void CDPClient::terminateExecution(ResponseCallback callback)
@@ -1599,6 +2451,7 @@ void CDPClient::executeInAudioWorklet(const QString& code, ResponseCallback call
 // LiveView debugging implementation
 void CDPClient::handleWebSocketEvent(const QString& method, const QJsonObject& params)
 {
+    TargetState& state = target();
     if (method == "Network.webSocketFrameReceived" || method == "Network.webSocketFrameSent") {
         WebSocketFrame frame;
         frame.timestamp = QDateTime::fromMSecsSinceEpoch(params["timestamp"].toDouble());
@@ -1610,24 +2463,17 @@ void CDPClient::handleWebSocketEvent(const QString& method, const QJsonObject& p
         frame.sent = (method == "Network.webSocketFrameSent");
 
         // Get URL from associated request
-        for (const auto& req : m_networkRequests) {
-            if (req.requestId == frame.requestId) {
-                frame.url = req.url;
-                break;
-            }
+        if (const NetworkRequest* request = findNetworkRequest(frame.requestId)) {
+            frame.url = request->url;
         }
 
-        m_webSocketFrames.append(frame);
-
-        // Limit storage
-        while (m_webSocketFrames.size() > MAX_WEBSOCKET_FRAMES) {
-            m_webSocketFrames.removeFirst();
-        }
+        state.webSocketFrames.append(std::move(frame));
     }
 }
 
 void CDPClient::getWebSocketFrames(const QJsonObject& filters, ResponseCallback callback)
 {
+    TargetState& state = target();
     QJsonArray frames;
 
     QString urlFilter = filters["url"].toString();
@@ -1637,7 +2483,8 @@ void CDPClient::getWebSocketFrames(const QJsonObject& filters, ResponseCallback
     int limit = filters["limit"].toInt(100);  // Default 100, -1 for no limit
 
     int count = 0;
-    for (const auto& frame : m_webSocketFrames) {
+    for (quint64 sequence = state.webSocketFrames.firstSequence(); sequence < state.webSocketFrames.nextSequence(); ++sequence) {
+        const WebSocketFrame& frame = state.webSocketFrames.at(sequence);
         // Apply filters
         if (!urlFilter.isEmpty() && !frame.url.contains(urlFilter))
             continue;
@@ -1685,40 +2532,77 @@ void CDPClient::getWebSocketFrames(const QJsonObject& filters, ResponseCallback
 
     QJsonObject result;
     result["frames"] = frames;
-    result["total"] = m_webSocketFrames.size();
+    result["total"] = state.webSocketFrames.size();
 
     callback(result, QString());
 }
 
 void CDPClient::clearWebSocketFrames()
 {
-    m_webSocketFrames.clear();
+    TargetState& state = target();
+    state.webSocketFrames.clear();
 }
 
 void CDPClient::startDOMMutationObserver(const QString& selector, ResponseCallback callback)
 {
+    // Mutations are buffered in the page and delivered once per animation
+    // frame through a Runtime binding, so a morphdom patch touching hundreds
+    // of nodes costs one CDP event rather than one console message per node
+    QString selectorLiteral = QString::fromUtf8(QJsonDocument(QJsonArray{selector}).toJson(QJsonDocument::Compact));
     QString observerScript = QString(R"(
         (function() {
             if (window.__cdpMutationObserver) {
                 window.__cdpMutationObserver.disconnect();
             }
 
-            const targetNode = document.querySelector('%1');
+            const selector = %1[0];
+            const targetNode = document.querySelector(selector);
             if (!targetNode) {
-                return { error: 'Element not found: %1' };
+                return { error: 'Element not found: ' + selector };
             }
 
+            const deliver = window.%2;
+            const nodeName = n => n.nodeType === 1 ? n.tagName : n.nodeName;
+            let pending = [];
+            let dropped = 0;
+            let scheduled = false;
+
+            const flush = function() {
+                scheduled = false;
+                if (pending.length === 0 && dropped === 0) {
+                    return;
+                }
+                deliver(JSON.stringify({ time: Date.now(), dropped: dropped, records: pending }));
+                pending = [];
+                dropped = 0;
+            };
+
             window.__cdpMutationObserver = new MutationObserver(function(mutations) {
-                mutations.forEach(function(mutation) {
-                    console.log('[DOM_MUTATION]', JSON.stringify({
-                        type: mutation.type,
-                        target: mutation.target.tagName || mutation.target.nodeType,
-                        attributeName: mutation.attributeName,
-                        oldValue: mutation.oldValue,
-                        addedNodes: Array.from(mutation.addedNodes).map(n => n.tagName || n.nodeType),
-                        removedNodes: Array.from(mutation.removedNodes).map(n => n.tagName || n.nodeType)
-                    }));
-                });
+                for (const m of mutations) {
+                    if (pending.length >= %3) {
+                        dropped++;
+                        continue;
+                    }
+                    pending.push({
+                        type: m.type,
+                        target: nodeName(m.target),
+                        attributeName: m.attributeName,
+                        oldValue: m.oldValue,
+                        newValue: m.type === 'attributes' ? m.target.getAttribute(m.attributeName) :
+                                  m.type === 'characterData' ? m.target.data : null,
+                        addedNodes: Array.from(m.addedNodes, nodeName),
+                        removedNodes: Array.from(m.removedNodes, nodeName)
+                    });
+                }
+                if (!scheduled) {
+                    scheduled = true;
+                    // Animation frames don't run in hidden pages
+                    if (document.hidden) {
+                        setTimeout(flush, 100);
+                    } else {
+                        requestAnimationFrame(flush);
+                    }
+                }
             });
 
             window.__cdpMutationObserver.observe(targetNode, {
@@ -1730,11 +2614,32 @@ void CDPClient::startDOMMutationObserver(const QString& selector, ResponseCallba
                 subtree: true
             });
 
-            return { success: true, observing: '%1' };
+            return { success: true, observing: selector };
         })();
-    )").arg(selector);
+    )").arg(selectorLiteral, QString::fromLatin1(DOM_MUTATION_BINDING), QString::number(MAX_DOM_MUTATIONS_PER_FRAME));
+
+    // The binding exists by the time the script runs, as Chrome handles
+    // the two in order, so both go out together
+    CDPPipeline pipeline;
+    pipeline.add("binding", "Runtime.addBinding", QJsonObject{{"name", DOM_MUTATION_BINDING}});
+    pipeline.add("observer", "Runtime.evaluate", QJsonObject{
+        {"expression", observerScript},
+        {"returnByValue", true},
+        {"awaitPromise", true}
+    });
 
-    evaluateJavaScript(observerScript, callback);
+    runPipeline(pipeline, [callback](const QJsonObject& result, const QString& error) {
+        if (!error.isEmpty()) {
+            callback(QJsonObject(), error);
+            return;
+        }
+        QJsonObject observer = result["results"].toObject()["observer"].toObject();
+        if (observer.contains("exceptionDetails")) {
+            callback(QJsonObject(), observer["exceptionDetails"].toObject()["text"].toString());
+            return;
+        }
+        callback(observer["result"].toObject()["value"].toObject(), QString());
+    });
 }
 
 void CDPClient::stopDOMMutationObserver(ResponseCallback callback)
@@ -1750,7 +2655,15 @@ void CDPClient::stopDOMMutationObserver(ResponseCallback callback)
         })();
     )";
 
-    evaluateJavaScript(script, callback);
+    evaluateJavaScript(script, [this, callback](const QJsonObject& result, const QString& error) {
+        sendCommand("Runtime.removeBinding", QJsonObject{{"name", DOM_MUTATION_BINDING}},
+                    [](const QJsonObject&, const QString&) {});
+        if (!error.isEmpty()) {
+            callback(QJsonObject(), error);
+            return;
+        }
+        callback(result["result"].toObject()["value"].toObject(), QString());
+    });
 }
 
 void CDPClient::getDOMMutations(ResponseCallback callback)
@@ -1760,44 +2673,50 @@ void CDPClient::getDOMMutations(ResponseCallback callback)
 
 void CDPClient::getDOMMutations(const QJsonObject& options, ResponseCallback callback)
 {
-    // Parse mutations from console messages
+    TargetState& state = target();
     QJsonArray mutations;
     int limit = options.value("limit").toInt(100);  // Default 100, but allow override
-    int count = 0;
 
-    for (const auto& msg : m_consoleMessages) {
-        if (msg.text.startsWith("[DOM_MUTATION]")) {
-            QString jsonStr = msg.text.mid(14).trimmed();
-            QJsonDocument doc = QJsonDocument::fromJson(jsonStr.toUtf8());
-            if (!doc.isNull()) {
-                QJsonObject mutation = doc.object();
-                mutation["timestamp"] = msg.timestamp.toString(Qt::ISODate);
-                mutations.append(mutation);
+    for (quint64 sequence = state.domMutations.firstSequence(); sequence < state.domMutations.nextSequence(); ++sequence) {
+        const DOMMutation& record = state.domMutations.at(sequence);
+        QJsonObject mutation;
+        mutation["type"] = record.type;
+        mutation["target"] = record.nodeName;
+        if (!record.attributeName.isEmpty()) {
+            mutation["attributeName"] = record.attributeName;
+        }
+        // An attribute set to "" or text cleared is still a value
+        if (record.hasOldValue) {
+            mutation["oldValue"] = record.oldValue;
+        }
+        if (record.hasNewValue) {
+            mutation["newValue"] = record.newValue;
+        }
+        mutation["addedNodes"] = record.addedNodes;
+        mutation["removedNodes"] = record.removedNodes;
+        mutation["timestamp"] = record.timestamp.toString(Qt::ISODate);
+        mutations.append(mutation);
 
-                count++;
-                if (limit > 0 && count >= limit) {
-                    break;
-                }
-            }
+        if (limit > 0 && mutations.size() >= limit) {
+            break;
         }
     }
 
     QJsonObject result;
     result["mutations"] = mutations;
     result["count"] = mutations.size();
+    if (state.droppedDOMMutations > 0) {
+        result["dropped"] = static_cast<qint64>(state.droppedDOMMutations);
+    }
 
     callback(result, QString());
 }
 
 void CDPClient::clearDOMMutations()
 {
-    // Remove DOM mutation messages from console
-    m_consoleMessages.erase(
-        std::remove_if(m_consoleMessages.begin(), m_consoleMessages.end(),
-                      [](const ConsoleMessage& msg) {
-                          return msg.text.startsWith("[DOM_MUTATION]");
-                      }),
-        m_consoleMessages.end());
+    TargetState& state = target();
+    state.domMutations.clear();
+    state.droppedDOMMutations = 0;
 }
 
 void CDPClient::getJavaScriptProfile(ResponseCallback callback)
@@ -1872,6 +2791,17 @@ bool CDPClient::setTargetByTitle(const QString& title)
     // Store the new target title
     m_targetTitle = title;
 
+    // A page that is already attached is switched to in place
+    for (const std::shared_ptr<TargetState>& state : std::as_const(m_targets)) {
+        if (state->info.type == "page" && state->info.title == title) {
+            m_primary = state;
+            m_targetId = state->info.targetId;
+            m_currentTargetTitle = title;
+            std::cerr << "# CDP: Switched target to '" << title.toStdString() << "'" << std::endl;
+            return true;
+        }
+    }
+
     // If we're connected, disconnect and reconnect to the new target
     if (m_isConnected) {
         std::cerr << "# CDP: Switching target to '" << title.toStdString() << "'" << std::endl;
@@ -1884,4 +2814,86 @@ bool CDPClient::setTargetByTitle(const QString& title)
         std::cerr << "# CDP: Target set to '" << title.toStdString() << "' for next connection" << std::endl;
         return true;
     }
-}
\ No newline at end of file
+}
+
+QList<CDPClient::TargetInfo> CDPClient::attachedTargets() const
+{
+    QList<TargetInfo> targets;
+    for (const std::shared_ptr<TargetState>& state : m_targets) {
+        TargetInfo info = state->info;
+        info.primary = state == m_primary;
+        targets.append(info);
+    }
+    return targets;
+}
+
+bool CDPClient::withTarget(const QString& spec, const std::function<void()>& issue)
+{
+    std::shared_ptr<TargetState> state = findTarget(spec);
+    if (!state) {
+        return false;
+    }
+    inScope(state, issue);
+    return true;
+}
+
+std::shared_ptr<CDPClient::TargetState> CDPClient::findSession(const QString& sessionId) const
+{
+    for (const std::shared_ptr<TargetState>& state : m_targets) {
+        if (state->info.sessionId == sessionId) {
+            return state;
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<CDPClient::TargetState> CDPClient::findTarget(const QString& spec) const
+{
+    QList<std::shared_ptr<TargetState>> targets = m_targets;
+    if (targets.removeOne(m_primary)) {
+        targets.prepend(m_primary);
+    }
+
+    // Most exact first
+    const std::function<bool(const TargetInfo&)> matches[] = {
+        [&](const TargetInfo& info) {
+            return info.targetId == spec || (!info.sessionId.isEmpty() && info.sessionId == spec);
+        },
+        [&](const TargetInfo& info) {
+            return info.type.compare(spec, Qt::CaseInsensitive) == 0 ||
+                   info.title.compare(spec, Qt::CaseInsensitive) == 0;
+        },
+        [&](const TargetInfo& info) {
+            return info.title.contains(spec, Qt::CaseInsensitive) || info.url.contains(spec, Qt::CaseInsensitive);
+        }
+    };
+    for (const auto& match : matches) {
+        for (const std::shared_ptr<TargetState>& state : std::as_const(targets)) {
+            if (match(state->info)) {
+                return state;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void CDPClient::inScope(const std::shared_ptr<TargetState>& state, const std::function<void()>& run)
+{
+    std::shared_ptr<TargetState> outer = std::move(m_scope);
+    m_scope = state;
+    try {
+        run();
+    } catch (...) {
+        m_scope = std::move(outer);
+        throw;
+    }
+    m_scope = std::move(outer);
+}
+
+std::function<void()> CDPClient::bindToTarget(std::function<void()> run)
+{
+    std::shared_ptr<TargetState> state = m_scope ? m_scope : m_primary;
+    return [this, state, run = std::move(run)]() {
+        inScope(state, run);
+    };
+}
@@ -8,11 +8,17 @@
 #include <QJsonDocument>
 #include <QNetworkAccessManager>
 #include <QMap>
+#include <QSet>
 #include <QTimer>
 #include <QList>
+#include <QByteArrayView>
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
 #include <functional>
 #include <memory>
+#include "event_ring.h"
+#include "cdp_pipeline.h"
 
 class CDPClient : public QObject
 {
@@ -28,9 +34,33 @@ public:
 
     using ResponseCallback = std::function<void(const QJsonObject& result, const QString& error)>;
 
+    // How many events of each kind are retained; the oldest are overwritten
+    struct HistoryLimits {
+        int consoleMessages = 1000;
+        int networkRequests = 500;
+        int webSocketFrames = 200;
+        int domMutations = 5000;
+        int exceptions = 1000;
+    };
+
+    // A page, frame, worker or worklet attached over the connection. Each
+    // keeps its own console, network, exception, WebSocket and DOM history.
+    struct TargetInfo {
+        QString targetId;
+        QString sessionId;  // Empty for a page connected to directly
+        QString type;       // page, iframe, worker, service_worker, worklet, ...
+        QString title;
+        QString url;
+        bool primary = false;  // Where commands go unless another is chosen
+    };
+
     explicit CDPClient(quint16 devToolsPort, QObject* parent = nullptr);
     ~CDPClient();
 
+    // Can be changed at any time; shrinking keeps the newest events
+    void setHistoryLimits(const HistoryLimits& limits);
+    HistoryLimits historyLimits() const;
+
     bool connect();
     void disconnect();
     bool isConnected() const;
@@ -39,15 +69,42 @@ public:
 
     // Target selection methods
     QJsonArray getAvailableTargets();
+    // Makes the page with this title the primary target; one that is
+    // already attached is switched to without reconnecting
     bool setTargetByTitle(const QString& title);
     QString getCurrentTargetTitle() const { return m_currentTargetTitle; }
+    // In the order they attached
+    QList<TargetInfo> attachedTargets() const;
+    // Runs issue() with its commands and history queries aimed at the
+    // attached target matching spec instead of the primary one. spec is a
+    // target or session id, a type ("worker", "worklet"), or a title or URL,
+    // whole or in part; the primary target wins ties. False if none matches.
+    bool withTarget(const QString& spec, const std::function<void()>& issue);
 
     void sendCommand(const QString& method, const QJsonObject& params, ResponseCallback callback);
+
+    // Ids of the commands sent while issue() runs, for cancelCommands()
+    QList<int> trackCommands(const std::function<void()>& issue);
+    // Drops the callbacks of any of these commands still pending. If one
+    // of them is a script evaluation, the running script is terminated
+    // too unless terminateScripts is false.
+    void cancelCommands(const QList<int>& ids, bool terminateScripts = true);
+
+    // Sends the pipeline's steps to the target in scope, each as soon as
+    // the steps it depends on have answered, without waiting in between.
+    // The result has each step's result under "results", by name, and
+    // under "timings" its level and when it was sent and answered, in ms
+    // from the start. A step failing that is not optional fails the whole
+    // pipeline; steps already sent are left to finish unheeded.
+    void runPipeline(const CDPPipeline& pipeline, ResponseCallback callback);
     
     void getDocument(ResponseCallback callback);
     void getDocument(const QJsonObject& options, ResponseCallback callback);
     void querySelector(const QString& selector, ResponseCallback callback);
     void getOuterHTML(int nodeId, ResponseCallback callback);
+    // Document, query and HTML as one pipeline; the result also has the
+    // nodeId and the pipeline's timings
+    void getOuterHTML(const QString& selector, ResponseCallback callback);
     void evaluateJavaScript(const QString& expression, ResponseCallback callback);
     void evaluateJavaScriptWithObjectReferences(const QString& expression, ResponseCallback callback);
     void getConsoleMessages(const QJsonObject& filters, ResponseCallback callback);
@@ -70,9 +127,29 @@ public:
 
     // Performance and Memory
     void getMemoryUsage(ResponseCallback callback);
-    void startProfiling(const QString& profileName, ResponseCallback callback);
+    // samplingIntervalUs of 0 keeps Chrome's default
+    void startProfiling(const QString& profileName, int samplingIntervalUs, ResponseCallback callback);
     void stopProfiling(const QString& profileName, ResponseCallback callback);
-    void getHeapSnapshot(ResponseCallback callback);
+    // Profiles the page for durationMs; the result is Profiler.stop's
+    void profileFor(int durationMs, int samplingIntervalUs, ResponseCallback callback);
+    // Streams a HeapProfiler snapshot into filePath as Chrome sends it,
+    // without holding it in memory. The result has the path and size in
+    // bytes once the snapshot is complete; a failed one is removed.
+    void takeHeapSnapshot(const QString& filePath, ResponseCallback callback);
+
+    // Tracing: while it runs, Tracing.dataCollected events are appended to
+    // filePath as a Chrome trace (for chrome://tracing, Perfetto or
+    // TraceAnalysis). categories is comma-separated, empty for
+    // DEFAULT_TRACE_CATEGORIES. The stop result has the path and size in
+    // bytes; a trace cut short by an error is still closed and kept.
+    static constexpr const char* DEFAULT_TRACE_CATEGORIES =
+        "devtools.timeline,disabled-by-default-devtools.timeline,"
+        "disabled-by-default-devtools.timeline.frame,toplevel,v8.execute,"
+        "blink.user_timing,benchmark,latencyInfo,rail,gpu,cc,viz";
+    void startTracing(const QString& filePath, const QString& categories, ResponseCallback callback);
+    void stopTracing(ResponseCallback callback);
+    void traceFor(int durationMs, const QString& filePath, const QString& categories, ResponseCallback callback);
+    bool isTracing() const { return m_trace != nullptr; }
 
     // Runtime exceptions
     void getPendingExceptions(ResponseCallback callback);
@@ -124,43 +201,60 @@ private slots:
     void onConnected();
     void onDisconnected();
     void onTextMessageReceived(const QString& message);
+    void onBinaryMessageReceived(const QByteArray& message);
     void onPingTimeout();
 
 private:
     void sendRawCommand(const QJsonObject& command);
+    void sendSessionCommand(const QString& sessionId, const QString& method, const QJsonObject& params, ResponseCallback callback);
+    void processMessage(const QByteArray& message);
+    void processSessionMessage(const QByteArray& message, QByteArrayView method, bool detached);
+    static bool isRecordedEvent(QByteArrayView method);
     void processResponse(const QJsonObject& response);
-    void enableDomains();
+    void enableDomains(const QString& sessionId, const QString& type);
 
+    void fetchBrowserEndpoint();
     void fetchTargetList();
     QString findMainPageTarget(const QJsonArray& targets);
     void connectToTarget(const QString& targetId);
     void discoverTargets();
+    void failConnection(const QString& errorMsg);
+    void finishConnecting();
+    void attachToTarget(const QJsonObject& targetInfo);
+    void handleTargetEvent(const QString& method, const QJsonObject& params);
 
     void handleNetworkEvent(const QString& method, const QJsonObject& params);
     void handleRuntimeException(const QString& method, const QJsonObject& params);
     void handleWebSocketEvent(const QString& method, const QJsonObject& params);
+    void writeHeapSnapshotChunk(const QByteArray& message);
+    void finishHeapSnapshot(const QString& error);
+    void discardHeapSnapshot();
+    void writeTraceEvents(const QByteArray& message);
+    void finishTrace(const QString& error);
 
 private:
+    // Only the level and arrival time are filled in on arrival. The rest
+    // is decoded from raw by decodeConsoleMessage() when a query needs it.
     struct ConsoleMessage {
-        QDateTime timestamp;
+        QByteArray raw;        // Undecoded event JSON; empty once decoded
+        bool fromLog = false;  // Log.entryAdded rather than Runtime.consoleAPICalled
+        qint64 timestampMs = 0;
         QString level;
         QString text;
         QString stackTrace;
         QString url;           // Source URL
-        int lineNumber;        // Line number in source
-        int columnNumber;      // Column number in source
+        int lineNumber = 0;    // Line number in source
+        int columnNumber = 0;  // Column number in source
         QString functionName;  // Function name if available
         QJsonArray args;       // Preserve structured arguments
         QString groupId;       // For console.group support
-        bool isGroupStart;     // console.group
-        bool isGroupEnd;       // console.groupEnd
+        bool isGroupStart = false;  // console.group
+        bool isGroupEnd = false;    // console.groupEnd
     };
 
     quint16 m_devToolsPort;
-    QList<ConsoleMessage> m_consoleMessages;
-    static const int MAX_CONSOLE_MESSAGES = 1000;
-    QDateTime m_lastMessageRetrievalTime;
-    QMap<QString, qint64> m_performanceTimers;  // For console.time tracking
+    void recordConsoleEvent(const QByteArray& message, bool fromLog);
+    void decodeConsoleMessage(ConsoleMessage& msg);
 
     // Network monitoring
     struct NetworkRequest {
@@ -180,8 +274,7 @@ private:
         QString failureReason;
         bool fromCache;
     };
-    QList<NetworkRequest> m_networkRequests;
-    static const int MAX_NETWORK_REQUESTS = 500;
+    NetworkRequest* findNetworkRequest(const QString& requestId);
 
     // Runtime exceptions
     struct RuntimeException {
@@ -194,7 +287,6 @@ private:
         QDateTime timestamp;
         QString exceptionDetails;
     };
-    QList<RuntimeException> m_exceptions;
 
     // WASM instantiation tracking
     struct WasmInstantiation {
@@ -217,8 +309,6 @@ private:
         bool sent;  // true if sent, false if received
         QString url;
     };
-    QList<WebSocketFrame> m_webSocketFrames;
-    static const int MAX_WEBSOCKET_FRAMES = 200;
 
     // DOM mutations for LiveView morphdom tracking
     struct DOMMutation {
@@ -229,11 +319,89 @@ private:
         QString attributeName;
         QString oldValue;
         QString newValue;
+        bool hasOldValue = false;  // Null in the record, as opposed to empty
+        bool hasNewValue = false;
         QJsonArray addedNodes;
         QJsonArray removedNodes;
     };
-    QList<DOMMutation> m_domMutations;
-    static const int MAX_DOM_MUTATIONS = 100;
+    void recordDOMMutations(const QString& payload);
+    static constexpr const char* DOM_MUTATION_BINDING = "__spectraDomMutations";
+    static constexpr int MAX_DOM_MUTATIONS_PER_FRAME = 1000;
+
+    // What is recorded for one attached target
+    struct TargetState {
+        explicit TargetState(const HistoryLimits& limits);
+        void setHistoryLimits(const HistoryLimits& limits);
+
+        TargetInfo info;
+        bool attached = false;
+
+        EventRing<ConsoleMessage> consoleMessages;
+        EventKeyIndex<QString> consoleByLevel;
+        EventTimeIndex consoleByTime;
+        quint64 consoleCursor = 0;  // First sequence not yet returned by since_last_call
+        QMap<QString, qint64> performanceTimers;  // For console.time tracking
+        EventRing<NetworkRequest> networkRequests;
+        EventKeyIndex<QString> networkByRequestId;
+        EventRing<RuntimeException> exceptions;
+        EventRing<WebSocketFrame> webSocketFrames;
+        EventRing<DOMMutation> domMutations;
+        quint64 droppedDOMMutations = 0;  // Over the page's per-frame cap
+    };
+    HistoryLimits m_historyLimits;
+    // The primary target outlives its attachment, so its history survives
+    // a reconnect; the others are dropped when they detach
+    std::shared_ptr<TargetState> m_primary;
+    QList<std::shared_ptr<TargetState>> m_targets;  // Attached, in attach order
+    // Set by withTarget() and while a session's messages are dispatched
+    std::shared_ptr<TargetState> m_scope;
+    TargetState& target() { return m_scope ? *m_scope : *m_primary; }
+    std::shared_ptr<TargetState> findSession(const QString& sessionId) const;
+    std::shared_ptr<TargetState> findTarget(const QString& spec) const;
+    void inScope(const std::shared_ptr<TargetState>& state, const std::function<void()>& run);
+    // Wraps run, for a timer, to go to the target in scope now
+    std::function<void()> bindToTarget(std::function<void()> run);
+
+    // A runPipeline() in progress, kept alive by its commands' callbacks
+    struct PipelineRun {
+        QVector<CDPPipeline::Step> steps;
+        QVector<int> levels;
+        QVector<int> waiting;  // Dependencies yet to answer
+        QVector<QVector<int>> dependents;
+        QVector<qint64> sentMs;
+        QVector<qint64> answeredMs;
+        QVector<QString> errors;
+        CDPPipeline::Results results;
+        int unanswered = 0;
+        bool finished = false;
+        QElapsedTimer timer;
+        std::shared_ptr<TargetState> target;
+        ResponseCallback callback;
+    };
+    void sendPipelineStep(const std::shared_ptr<PipelineRun>& run, int step);
+    void finishPipeline(const std::shared_ptr<PipelineRun>& run, const QString& error);
+
+    // Heap snapshot being streamed to disk, one at a time
+    struct HeapSnapshotCapture {
+        QFile file;
+        int commandId = -1;
+        qint64 bytes = 0;
+        QString writeError;
+        ResponseCallback callback;  // Cleared if the command is cancelled
+    };
+    std::unique_ptr<HeapSnapshotCapture> m_heapSnapshot;
+
+    // Trace being streamed to disk, from Tracing.start to tracingComplete
+    struct TraceCapture {
+        QFile file;
+        qint64 bytes = 0;
+        bool empty = true;      // No events written yet
+        bool stopping = false;  // Tracing.end sent
+        QString sessionId;      // Of the target tracing started in
+        QString writeError;
+        ResponseCallback callback;  // stopTracing()'s
+    };
+    std::unique_ptr<TraceCapture> m_trace;
 
     QWebSocket* m_webSocket;
     QNetworkAccessManager* m_networkManager;
@@ -241,12 +409,19 @@ private:
     
     int m_nextCommandId;
     QMap<int, ResponseCallback> m_pendingCommands;
+    QMap<int, QString> m_pendingMethods;
+    QMap<int, QString> m_pendingSessions;
+    QList<int>* m_commandCapture = nullptr;  // Set during trackCommands()
     
     QString m_targetId;
     QString m_webSocketDebuggerUrl;
     QString m_currentTargetTitle;  // Store current target title
     QString m_targetTitle;  // Target title to look for (defaults to "Tau5")
     QJsonArray m_lastTargetList;  // Cache of last fetched targets
+    // Connected to the browser rather than a page: every page is attached
+    // as a flattened session, and workers and worklets under each of them
+    bool m_browserEndpoint = false;
+    QSet<QString> m_attaching;  // Target ids with attachToTarget in flight
 
     bool m_isConnecting;
     bool m_isConnected;
@@ -0,0 +1,201 @@
+#include "cpu_profile.h"
+#include <QHash>
+#include <QJsonArray>
+#include <QStringList>
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+struct Node {
+    int function = -1;   // Into the function list
+    int parent = -1;
+    QVector<int> children;
+    qint64 selfTime = 0;
+    qint64 totalTime = 0;
+    qint64 samples = 0;
+};
+
+// Frame label for folded stacks, which use ';' between frames and the last
+// space before the weight
+QString frameLabel(const CpuProfile::Function& function)
+{
+    QString label = function.name;
+    if (!function.url.isEmpty()) {
+        QString file = function.url.section('/', -1);
+        if (file.isEmpty()) {
+            file = function.url;
+        }
+        label += QString(" %1:%2").arg(file).arg(function.lineNumber);
+    }
+    label.replace(';', ',');
+    return label;
+}
+
+} // namespace
+
+bool CpuProfile::load(const QJsonObject& profile)
+{
+    *this = CpuProfile();
+
+    QJsonArray nodeArray = profile["nodes"].toArray();
+    if (nodeArray.isEmpty()) {
+        m_error = "The profile has no call tree";
+        return false;
+    }
+
+    // Nodes by id; functions by call frame, so the same function reached
+    // through different stacks is counted together
+    QVector<Node> nodes(nodeArray.size());
+    QHash<qint64, int> nodeById;
+    QHash<QString, int> functionByFrame;
+    for (int i = 0; i < nodeArray.size(); ++i) {
+        QJsonObject node = nodeArray.at(i).toObject();
+        nodeById.insert(node["id"].toInteger(), i);
+
+        QJsonObject frame = node["callFrame"].toObject();
+        QString name = frame["functionName"].toString();
+        QString url = frame["url"].toString();
+        int line = frame["lineNumber"].toInt(-1) + 1;
+        QString key = QString("%1\n%2\n%3\n%4").arg(name, url).arg(line).arg(frame["columnNumber"].toInt());
+        auto it = functionByFrame.find(key);
+        if (it == functionByFrame.end()) {
+            it = functionByFrame.insert(key, m_functions.size());
+            Function function;
+            function.name = name.isEmpty() ? QString("(anonymous)") : name;
+            function.url = url;
+            function.lineNumber = line;
+            m_functions.append(function);
+        }
+        nodes[i].function = it.value();
+    }
+
+    // Chrome lists children; older versions gave each node its parent
+    for (int i = 0; i < nodeArray.size(); ++i) {
+        QJsonObject node = nodeArray.at(i).toObject();
+        for (const QJsonValue& childId : node["children"].toArray()) {
+            int child = nodeById.value(childId.toInteger(), -1);
+            if (child >= 0 && child != i && nodes[child].parent < 0) {
+                nodes[child].parent = i;
+                nodes[i].children.append(child);
+            }
+        }
+        if (node.contains("parent")) {
+            int parent = nodeById.value(node["parent"].toInteger(), -1);
+            if (parent >= 0 && parent != i && nodes[i].parent < 0) {
+                nodes[i].parent = parent;
+                nodes[parent].children.append(i);
+            }
+        }
+    }
+
+    // Charge each sample the time until the next one, the last one the
+    // time until the end of the profile
+    qint64 startTime = profile["startTime"].toInteger();
+    qint64 endTime = profile["endTime"].toInteger();
+    m_duration = qMax<qint64>(0, endTime - startTime);
+    QJsonArray samples = profile["samples"].toArray();
+    QJsonArray timeDeltas = profile["timeDeltas"].toArray();
+    m_sampleCount = samples.size();
+    if (!samples.isEmpty()) {
+        qint64 time = startTime;
+        qint64 previousTime = startTime;
+        int previous = -1;
+        for (int i = 0; i < samples.size(); ++i) {
+            time += i < timeDeltas.size() ? timeDeltas.at(i).toInteger() : 0;
+            if (previous >= 0) {
+                nodes[previous].selfTime += qMax<qint64>(0, time - previousTime);
+            }
+            previous = nodeById.value(samples.at(i).toInteger(), -1);
+            if (previous >= 0) {
+                nodes[previous].samples++;
+            }
+            previousTime = time;
+        }
+        if (previous >= 0) {
+            nodes[previous].selfTime += qMax<qint64>(0, endTime - previousTime);
+        }
+    } else {
+        // No sample list: spread the duration over the hit counts
+        qint64 hits = 0;
+        for (int i = 0; i < nodeArray.size(); ++i) {
+            nodes[i].samples = nodeArray.at(i).toObject()["hitCount"].toInteger();
+            hits += nodes[i].samples;
+        }
+        for (Node& node : nodes) {
+            node.selfTime = hits > 0 ? m_duration * node.samples / hits : 0;
+        }
+        m_sampleCount = hits;
+    }
+
+    // Walk each tree depth first: totals add up on the way back, a
+    // function's total counts only its outermost calls, and every stack
+    // with self time becomes a folded line
+    QVector<int> open(m_functions.size(), 0);
+    QVector<QString> labels;
+    labels.reserve(m_functions.size());
+    for (const Function& function : std::as_const(m_functions)) {
+        labels.append(frameLabel(function));
+    }
+
+    struct Frame {
+        int node;
+        int child;
+    };
+    QVector<Frame> stack;
+    QStringList path;
+    int rootFunction = -1;
+    for (int root = 0; root < nodes.size(); ++root) {
+        if (nodes[root].parent >= 0) {
+            continue;
+        }
+        rootFunction = nodes[root].function;
+        stack.append({root, 0});
+        while (!stack.isEmpty()) {
+            Frame& frame = stack.last();
+            Node& node = nodes[frame.node];
+            if (frame.child == 0) {
+                open[node.function]++;
+                if (stack.size() > 1) {
+                    path.append(labels[node.function]);
+                }
+                if (node.selfTime > 0 && !path.isEmpty()) {
+                    m_foldedStacks += path.join(';').toUtf8() + ' ' + QByteArray::number(node.selfTime) + '\n';
+                }
+            }
+            if (frame.child < node.children.size()) {
+                int child = node.children.at(frame.child++);
+                stack.append({child, 0});
+                continue;
+            }
+
+            node.totalTime += node.selfTime;
+            Function& function = m_functions[node.function];
+            function.selfTime += node.selfTime;
+            function.samples += node.samples;
+            if (--open[node.function] == 0) {
+                function.totalTime += node.totalTime;
+            }
+            if (node.parent >= 0) {
+                nodes[node.parent].totalTime += node.totalTime;
+            }
+            if (stack.size() > 1) {
+                path.removeLast();
+            }
+            stack.removeLast();
+        }
+    }
+
+    for (const Function& function : std::as_const(m_functions)) {
+        if (function.name == "(idle)" && function.url.isEmpty()) {
+            m_idleTime += function.selfTime;
+        }
+    }
+    if (rootFunction >= 0 && m_functions[rootFunction].name == "(root)") {
+        m_functions.removeAt(rootFunction);
+    }
+    std::sort(m_functions.begin(), m_functions.end(), [](const Function& a, const Function& b) {
+        return a.selfTime > b.selfTime;
+    });
+    return true;
+}
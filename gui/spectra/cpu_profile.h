@@ -0,0 +1,55 @@
+#ifndef CPU_PROFILE_H
+#define CPU_PROFILE_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * Aggregates a CDP Profiler.Profile (the call tree plus its samples) into
+ * per-function times and folded stacks, so the profile itself never has to
+ * leave Spectra.
+ *
+ * Each sample is charged the time until the next one, as DevTools does, so
+ * an irregular sampling rate does not skew the result. A function's total
+ * time counts recursive calls once. Times are in microseconds.
+ */
+class CpuProfile
+{
+public:
+    struct Function {
+        QString name;      // "(anonymous)" for unnamed functions
+        QString url;
+        int lineNumber = 0;  // 1-based, 0 if unknown
+        qint64 selfTime = 0;
+        qint64 totalTime = 0;
+        qint64 samples = 0;  // Samples taken in the function itself
+    };
+
+    bool load(const QJsonObject& profile);
+    QString errorString() const { return m_error; }
+
+    qint64 duration() const { return m_duration; }      // Wall time covered
+    qint64 sampleCount() const { return m_sampleCount; }
+    // Time spent idle, which the percentages of busy time leave out
+    qint64 idleTime() const { return m_idleTime; }
+
+    // Sorted by self time, largest first; excludes the synthetic root
+    const QVector<Function>& functions() const { return m_functions; }
+
+    // One "frame;frame;frame weight" line per distinct stack, weighted by
+    // self time, as read by flamegraph.pl, speedscope and inferno
+    const QByteArray& foldedStacks() const { return m_foldedStacks; }
+
+private:
+    QString m_error;
+    qint64 m_duration = 0;
+    qint64 m_sampleCount = 0;
+    qint64 m_idleTime = 0;
+    QVector<Function> m_functions;
+    QByteArray m_foldedStacks;
+};
+
+#endif // CPU_PROFILE_H
@@ -0,0 +1,218 @@
+#ifndef EVENT_RING_H
+#define EVENT_RING_H
+
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QtGlobal>
+#include <algorithm>
+#include <utility>
+
+/**
+ * Fixed-capacity history of events, overwriting the oldest once full.
+ *
+ * Every appended event gets a sequence number, starting at 1 and never
+ * reused (not even across clear()), so a caller can remember "everything
+ * before sequence N has been seen" as a plain integer cursor. Events are
+ * addressed by sequence; the live range is [firstSequence(), nextSequence()).
+ *
+ * Storage grows with use up to the capacity, so a large capacity costs
+ * nothing until the events actually arrive.
+ */
+template <typename T>
+class EventRing
+{
+public:
+    explicit EventRing(qsizetype capacity)
+        : m_capacity(qMax<qsizetype>(1, capacity))
+    {
+    }
+
+    qsizetype capacity() const { return m_capacity; }
+    qsizetype size() const { return m_slots.size(); }
+    bool isEmpty() const { return m_slots.isEmpty(); }
+
+    quint64 firstSequence() const { return m_nextSequence - static_cast<quint64>(m_slots.size()); }
+    quint64 nextSequence() const { return m_nextSequence; }
+    bool contains(quint64 sequence) const { return sequence >= firstSequence() && sequence < m_nextSequence; }
+
+    // Returns the new event's sequence number
+    quint64 append(T event)
+    {
+        if (m_slots.size() < m_capacity) {
+            m_slots.append(std::move(event));
+        } else {
+            m_slots[m_start] = std::move(event);
+            m_start = (m_start + 1) % m_capacity;
+        }
+        return m_nextSequence++;
+    }
+
+    T& at(quint64 sequence)
+    {
+        Q_ASSERT(contains(sequence));
+        return m_slots[slotFor(sequence)];
+    }
+
+    const T& at(quint64 sequence) const
+    {
+        Q_ASSERT(contains(sequence));
+        return m_slots[slotFor(sequence)];
+    }
+
+    // Keeps the newest events that still fit
+    void setCapacity(qsizetype capacity)
+    {
+        capacity = qMax<qsizetype>(1, capacity);
+        if (capacity == m_capacity) {
+            return;
+        }
+
+        qsizetype keep = qMin(capacity, m_slots.size());
+        QList<T> slots;
+        slots.reserve(keep);
+        for (quint64 sequence = m_nextSequence - keep; sequence < m_nextSequence; ++sequence) {
+            slots.append(std::move(at(sequence)));
+        }
+        m_slots = std::move(slots);
+        m_start = 0;
+        m_capacity = capacity;
+    }
+
+    void clear()
+    {
+        m_slots.clear();
+        m_start = 0;
+    }
+
+private:
+    qsizetype slotFor(quint64 sequence) const
+    {
+        return static_cast<qsizetype>((m_start + (sequence - firstSequence())) % m_slots.size());
+    }
+
+    QList<T> m_slots;
+    qsizetype m_start = 0;  // Slot of the oldest event once the ring is full
+    qsizetype m_capacity;
+    quint64 m_nextSequence = 1;
+};
+
+/**
+ * Secondary index from a key (level, request id, ...) to the sequences of
+ * the events carrying it, oldest first.
+ *
+ * Entries for events the ring has since overwritten are not removed one by
+ * one; lookups skip them, and a sweep runs once stale entries could
+ * outnumber live ones, so insertion stays amortized O(1).
+ */
+template <typename Key>
+class EventKeyIndex
+{
+public:
+    void insert(const Key& key, quint64 sequence, quint64 firstLive)
+    {
+        m_sequences[key].append(sequence);
+        if (++m_entries > 2 * (sequence - firstLive + 1) + 64) {
+            prune(firstLive);
+        }
+    }
+
+    // Live sequences for key at or after from, oldest first
+    QList<quint64> sequences(const Key& key, quint64 from) const
+    {
+        auto it = m_sequences.constFind(key);
+        if (it == m_sequences.constEnd()) {
+            return {};
+        }
+        const QList<quint64>& sequences = it.value();
+        auto begin = std::lower_bound(sequences.cbegin(), sequences.cend(), from);
+        return QList<quint64>(begin, sequences.cend());
+    }
+
+    // Newest live sequence for key, or 0 if none
+    quint64 last(const Key& key, quint64 firstLive) const
+    {
+        auto it = m_sequences.constFind(key);
+        if (it == m_sequences.constEnd() || it.value().isEmpty() || it.value().last() < firstLive) {
+            return 0;
+        }
+        return it.value().last();
+    }
+
+    void prune(quint64 firstLive)
+    {
+        m_entries = 0;
+        for (auto it = m_sequences.begin(); it != m_sequences.end();) {
+            QList<quint64>& sequences = it.value();
+            sequences.erase(sequences.begin(), std::lower_bound(sequences.begin(), sequences.end(), firstLive));
+            if (sequences.isEmpty()) {
+                it = m_sequences.erase(it);
+            } else {
+                m_entries += static_cast<quint64>(sequences.size());
+                ++it;
+            }
+        }
+    }
+
+    void clear()
+    {
+        m_sequences.clear();
+        m_entries = 0;
+    }
+
+private:
+    QHash<Key, QList<quint64>> m_sequences;
+    quint64 m_entries = 0;
+};
+
+/**
+ * Coarse time index: the first sequence seen in each time bucket, so a
+ * "since" query can start near the right place instead of scanning the
+ * whole history. Assumes timestamps arrive in (roughly) increasing order;
+ * callers still compare each event's exact timestamp.
+ */
+class EventTimeIndex
+{
+public:
+    explicit EventTimeIndex(qint64 bucketMs = 1000)
+        : m_bucketMs(bucketMs)
+    {
+    }
+
+    void insert(qint64 msecs, quint64 sequence, quint64 firstLive)
+    {
+        qint64 bucket = msecs / m_bucketMs;
+        if (!m_buckets.isEmpty() && bucket <= m_buckets.last().first) {
+            return;
+        }
+        m_buckets.append({bucket, sequence});
+
+        // Keep the bucket straddling the oldest live event
+        while (m_buckets.size() > 1 && m_buckets.at(1).second <= firstLive) {
+            m_buckets.removeFirst();
+        }
+    }
+
+    // Lowest sequence that can have a timestamp at or after msecs;
+    // end if no indexed event is that recent
+    quint64 firstSequenceAtOrAfter(qint64 msecs, quint64 firstLive, quint64 end) const
+    {
+        qint64 bucket = msecs / m_bucketMs;
+        auto it = std::lower_bound(m_buckets.cbegin(), m_buckets.cend(), bucket,
+                                   [](const QPair<qint64, quint64>& entry, qint64 value) {
+                                       return entry.first < value;
+                                   });
+        if (it == m_buckets.cend()) {
+            return end;
+        }
+        return qMax(it->second, firstLive);
+    }
+
+    void clear() { m_buckets.clear(); }
+
+private:
+    qint64 m_bucketMs;
+    QList<QPair<qint64, quint64>> m_buckets;  // (bucket, first sequence in it)
+};
+
+#endif // EVENT_RING_H
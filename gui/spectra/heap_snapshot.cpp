@@ -0,0 +1,734 @@
+#include "heap_snapshot.h"
+#include <QByteArrayView>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace {
+
+constexpr quint32 NONE = std::numeric_limits<quint32>::max();
+constexpr int MAX_NAME_LENGTH = 80;
+
+// Cursor over the mapped file, knowing only as much JSON as the snapshot
+// format uses. Nothing is copied: strings come back as views with their
+// escapes left in place.
+class JsonCursor
+{
+public:
+    JsonCursor(const char* data, qint64 size)
+        : m_p(data), m_end(data + size)
+    {
+    }
+
+    bool consume(char c)
+    {
+        skipSpace();
+        if (m_p < m_end && *m_p == c) {
+            ++m_p;
+            return true;
+        }
+        return false;
+    }
+
+    // The bytes between the quotes
+    bool string(QByteArrayView& out)
+    {
+        skipSpace();
+        if (m_p >= m_end || *m_p != '"') {
+            return false;
+        }
+        const char* start = ++m_p;
+        while (true) {
+            const void* found = std::memchr(m_p, '"', static_cast<size_t>(m_end - m_p));
+            if (!found) {
+                return false;
+            }
+            const char* quote = static_cast<const char*>(found);
+            m_p = quote + 1;
+
+            // Escaped if preceded by an odd number of backslashes
+            const char* backslashes = quote;
+            while (backslashes > start && backslashes[-1] == '\\') {
+                --backslashes;
+            }
+            if ((quote - backslashes) % 2 == 0) {
+                out = QByteArrayView(start, quote - start);
+                return true;
+            }
+        }
+    }
+
+    // The raw text of a value of any kind
+    bool value(QByteArrayView& out)
+    {
+        skipSpace();
+        const char* start = m_p;
+        if (!skipValue()) {
+            return false;
+        }
+        out = QByteArrayView(start, m_p - start);
+        return true;
+    }
+
+    bool skipValue()
+    {
+        skipSpace();
+        if (m_p >= m_end) {
+            return false;
+        }
+
+        QByteArrayView ignored;
+        if (*m_p == '"') {
+            return string(ignored);
+        }
+        if (*m_p == '{' || *m_p == '[') {
+            int depth = 0;
+            while (m_p < m_end) {
+                char c = *m_p;
+                if (c == '"') {
+                    if (!string(ignored)) {
+                        return false;
+                    }
+                    continue;
+                }
+                ++m_p;
+                if (c == '{' || c == '[') {
+                    depth++;
+                } else if ((c == '}' || c == ']') && --depth == 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Number, true, false or null
+        const char* start = m_p;
+        while (m_p < m_end && *m_p != ',' && *m_p != '}' && *m_p != ']' && !isSpace(*m_p)) {
+            ++m_p;
+        }
+        return m_p > start;
+    }
+
+    // An array of non-negative integers, each fitting in 32 bits
+    bool uintArray(std::vector<quint32>& out)
+    {
+        if (!consume('[')) {
+            return false;
+        }
+        if (consume(']')) {
+            return true;
+        }
+        while (true) {
+            skipSpace();
+            const char* digits = m_p;
+            quint64 value = 0;
+            while (m_p < m_end && *m_p >= '0' && *m_p <= '9') {
+                value = value * 10 + static_cast<quint64>(*m_p - '0');
+                if (value > std::numeric_limits<quint32>::max()) {
+                    return false;
+                }
+                ++m_p;
+            }
+            if (m_p == digits) {
+                return false;
+            }
+            out.push_back(static_cast<quint32>(value));
+            if (!consume(',')) {
+                return consume(']');
+            }
+        }
+    }
+
+    bool stringArray(std::vector<QByteArrayView>& out)
+    {
+        if (!consume('[')) {
+            return false;
+        }
+        if (consume(']')) {
+            return true;
+        }
+        while (true) {
+            QByteArrayView text;
+            if (!string(text)) {
+                return false;
+            }
+            out.push_back(text);
+            if (!consume(',')) {
+                return consume(']');
+            }
+        }
+    }
+
+private:
+    static bool isSpace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+    void skipSpace()
+    {
+        while (m_p < m_end && isSpace(*m_p)) {
+            ++m_p;
+        }
+    }
+
+    const char* m_p;
+    const char* m_end;
+};
+
+QString decodeString(QByteArrayView raw)
+{
+    if (!std::memchr(raw.data(), '\\', static_cast<size_t>(raw.size()))) {
+        return QString::fromUtf8(raw);
+    }
+
+    // Rare: let the JSON parser deal with the escapes. A name cut short
+    // may end in half an escape; show it as it is then.
+    QByteArray wrapped = "[\"" + raw.toByteArray() + "\"]";
+    QJsonValue value = QJsonDocument::fromJson(wrapped).array().at(0);
+    return value.isString() ? value.toString() : QString::fromUtf8(raw);
+}
+
+QString shortName(QByteArrayView raw)
+{
+    QString name = decodeString(raw.first(qMin<qsizetype>(raw.size(), MAX_NAME_LENGTH * 4)));
+    if (name.size() > MAX_NAME_LENGTH) {
+        name = name.left(MAX_NAME_LENGTH) + "...";
+    }
+    return name;
+}
+
+int fieldIndex(const QJsonArray& fields, const char* name)
+{
+    for (int i = 0; i < fields.size(); ++i) {
+        if (fields.at(i).toString() == QLatin1String(name)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// The node and edge arrays of a snapshot, laid out as its meta describes
+struct Graph {
+    std::vector<quint32> nodes;
+    std::vector<quint32> edges;
+    std::vector<QByteArrayView> strings;
+    QStringList nodeTypes;
+
+    int nodeFieldCount = 0;
+    int typeField = -1;
+    int nameField = -1;
+    int idField = -1;
+    int selfSizeField = -1;
+    int edgeCountField = -1;
+
+    int edgeFieldCount = 0;
+    int edgeTypeField = -1;
+    int toNodeField = -1;
+    quint32 weakEdgeType = NONE;
+
+    quint32 nodeCount = 0;
+    std::vector<quint32> firstEdge;  // Per node, plus one past the last
+
+    quint32 field(quint32 node, int field) const { return nodes[static_cast<size_t>(node) * nodeFieldCount + field]; }
+    quint32 edgeTarget(quint32 edge) const { return edges[static_cast<size_t>(edge) * edgeFieldCount + toNodeField] / nodeFieldCount; }
+    bool isWeak(quint32 edge) const { return edges[static_cast<size_t>(edge) * edgeFieldCount + edgeTypeField] == weakEdgeType; }
+
+    QString typeName(quint32 node) const
+    {
+        quint32 type = field(node, typeField);
+        return type < static_cast<quint32>(nodeTypes.size()) ? nodeTypes.at(type) : QString();
+    }
+
+    QByteArrayView name(quint32 node) const
+    {
+        quint32 index = field(node, nameField);
+        return index < strings.size() ? strings[index] : QByteArrayView();
+    }
+
+    bool setMeta(const QJsonObject& meta)
+    {
+        QJsonArray nodeFields = meta["node_fields"].toArray();
+        nodeFieldCount = nodeFields.size();
+        typeField = fieldIndex(nodeFields, "type");
+        nameField = fieldIndex(nodeFields, "name");
+        idField = fieldIndex(nodeFields, "id");
+        selfSizeField = fieldIndex(nodeFields, "self_size");
+        edgeCountField = fieldIndex(nodeFields, "edge_count");
+
+        QJsonArray edgeFields = meta["edge_fields"].toArray();
+        edgeFieldCount = edgeFields.size();
+        edgeTypeField = fieldIndex(edgeFields, "type");
+        toNodeField = fieldIndex(edgeFields, "to_node");
+
+        if (typeField < 0 || nameField < 0 || idField < 0 || selfSizeField < 0 ||
+            edgeCountField < 0 || edgeTypeField < 0 || toNodeField < 0) {
+            return false;
+        }
+
+        for (const QJsonValue& type : meta["node_types"].toArray().at(typeField).toArray()) {
+            nodeTypes.append(type.toString());
+        }
+        QJsonArray edgeTypes = meta["edge_types"].toArray().at(edgeTypeField).toArray();
+        int weak = fieldIndex(edgeTypes, "weak");
+        weakEdgeType = weak < 0 ? NONE : static_cast<quint32>(weak);
+        return true;
+    }
+
+    // Checks the arrays agree with each other and indexes the edges
+    bool index()
+    {
+        if (nodeFieldCount == 0 || edgeFieldCount == 0 ||
+            nodes.size() % nodeFieldCount != 0 || edges.size() % edgeFieldCount != 0) {
+            return false;
+        }
+        nodeCount = static_cast<quint32>(nodes.size() / nodeFieldCount);
+        size_t edgeCount = edges.size() / edgeFieldCount;
+        if (nodeCount == 0) {
+            return false;
+        }
+
+        firstEdge.resize(static_cast<size_t>(nodeCount) + 1);
+        quint64 edge = 0;
+        for (quint32 node = 0; node < nodeCount; ++node) {
+            firstEdge[node] = static_cast<quint32>(edge);
+            edge += field(node, edgeCountField);
+            if (edge > edgeCount) {
+                return false;
+            }
+        }
+        firstEdge[nodeCount] = static_cast<quint32>(edge);
+        if (edge != edgeCount) {
+            return false;
+        }
+
+        for (size_t i = 0; i < edgeCount; ++i) {
+            quint32 to = edges[i * edgeFieldCount + toNodeField];
+            if (to % nodeFieldCount != 0 || to / nodeFieldCount >= nodeCount) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// Dominator tree of the nodes reachable from the root (node 0) through
+// strong edges, in postorder numbering: the root is last and every node's
+// dominator comes after it
+struct Dominators {
+    std::vector<quint32> nodeAt;     // Postorder number to node
+    std::vector<quint32> dominator;  // Postorder number to its dominator's
+
+    void compute(const Graph& graph)
+    {
+        std::vector<quint8> visited(graph.nodeCount, 0);
+        std::vector<quint32> postorder(graph.nodeCount, NONE);
+        nodeAt.reserve(graph.nodeCount);
+
+        struct Frame {
+            quint32 node;
+            quint32 edge;
+        };
+        std::vector<Frame> stack;
+        stack.push_back({0, graph.firstEdge[0]});
+        visited[0] = 1;
+        while (!stack.empty()) {
+            Frame& frame = stack.back();
+            if (frame.edge < graph.firstEdge[frame.node + 1]) {
+                quint32 edge = frame.edge++;
+                if (graph.isWeak(edge)) {
+                    continue;
+                }
+                quint32 target = graph.edgeTarget(edge);
+                if (!visited[target]) {
+                    visited[target] = 1;
+                    stack.push_back({target, graph.firstEdge[target]});
+                }
+            } else {
+                postorder[frame.node] = static_cast<quint32>(nodeAt.size());
+                nodeAt.push_back(frame.node);
+                stack.pop_back();
+            }
+        }
+
+        // Predecessors of each reachable node, by postorder number
+        size_t count = nodeAt.size();
+        std::vector<quint32> predecessorStart(count + 1, 0);
+        for (quint32 post = 0; post < count; ++post) {
+            quint32 node = nodeAt[post];
+            for (quint32 edge = graph.firstEdge[node]; edge < graph.firstEdge[node + 1]; ++edge) {
+                if (!graph.isWeak(edge)) {
+                    predecessorStart[postorder[graph.edgeTarget(edge)] + 1]++;
+                }
+            }
+        }
+        for (size_t i = 0; i < count; ++i) {
+            predecessorStart[i + 1] += predecessorStart[i];
+        }
+        std::vector<quint32> predecessors(predecessorStart[count]);
+        std::vector<quint32> fill(predecessorStart.begin(), predecessorStart.end() - 1);
+        for (quint32 post = 0; post < count; ++post) {
+            quint32 node = nodeAt[post];
+            for (quint32 edge = graph.firstEdge[node]; edge < graph.firstEdge[node + 1]; ++edge) {
+                if (!graph.isWeak(edge)) {
+                    predecessors[fill[postorder[graph.edgeTarget(edge)]]++] = post;
+                }
+            }
+        }
+
+        // Cooper, Harvey and Kennedy: refine in reverse postorder until
+        // nothing changes, which on heap graphs takes a handful of passes
+        quint32 root = static_cast<quint32>(count - 1);
+        dominator.assign(count, NONE);
+        dominator[root] = root;
+        auto intersect = [this](quint32 a, quint32 b) {
+            while (a != b) {
+                while (a < b) {
+                    a = dominator[a];
+                }
+                while (b < a) {
+                    b = dominator[b];
+                }
+            }
+            return a;
+        };
+
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (qint64 post = static_cast<qint64>(root) - 1; post >= 0; --post) {
+                quint32 idom = NONE;
+                for (quint32 i = predecessorStart[post]; i < predecessorStart[post + 1]; ++i) {
+                    quint32 predecessor = predecessors[i];
+                    if (dominator[predecessor] == NONE) {
+                        continue;
+                    }
+                    idom = idom == NONE ? predecessor : intersect(predecessor, idom);
+                }
+                if (idom != NONE && dominator[post] != idom) {
+                    dominator[post] = idom;
+                    changed = true;
+                }
+            }
+        }
+    }
+};
+
+// Types whose instances are grouped by their name, as DevTools does
+bool isNamedType(const QString& type)
+{
+    return type == "object" || type == "native" || type == "synthetic";
+}
+
+QString className(const Graph& graph, quint32 node)
+{
+    QString type = graph.typeName(node);
+    if (isNamedType(type)) {
+        QString name = decodeString(graph.name(node));
+        return name.isEmpty() ? QString("(%1)").arg(type) : name;
+    }
+    if (type == "hidden") {
+        return "(system)";
+    }
+    if (type.endsWith("string")) {
+        return "(string)";
+    }
+    if (type == "code") {
+        return "(compiled code)";
+    }
+    return QString("(%1)").arg(type);
+}
+
+} // namespace
+
+bool HeapSnapshot::load(const QString& path)
+{
+    *this = HeapSnapshot();
+    m_path = path;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        m_error = QString("Cannot open %1: %2").arg(path, file.errorString());
+        return false;
+    }
+    qint64 size = file.size();
+    const char* data = size > 0 ? reinterpret_cast<const char*>(file.map(0, size)) : nullptr;
+    if (!data) {
+        m_error = QString("Cannot read %1: %2").arg(path, file.errorString());
+        return false;
+    }
+
+    // The arrays are read into integers as they are met; "snapshot" (the
+    // meta) is small and goes through QJsonDocument
+    Graph graph;
+    QJsonObject snapshot;
+    JsonCursor json(data, size);
+    bool ok = json.consume('{');
+    while (ok && !json.consume('}')) {
+        QByteArrayView key;
+        ok = json.string(key) && json.consume(':');
+        if (!ok) {
+            break;
+        }
+        if (key == "snapshot") {
+            QByteArrayView text;
+            ok = json.value(text);
+            snapshot = QJsonDocument::fromJson(text.toByteArray()).object();
+            graph.nodes.reserve(static_cast<size_t>(snapshot["node_count"].toInteger()) *
+                                static_cast<size_t>(snapshot["meta"].toObject()["node_fields"].toArray().size()));
+            graph.edges.reserve(static_cast<size_t>(snapshot["edge_count"].toInteger()) *
+                                static_cast<size_t>(snapshot["meta"].toObject()["edge_fields"].toArray().size()));
+        } else if (key == "nodes") {
+            ok = json.uintArray(graph.nodes);
+        } else if (key == "edges") {
+            ok = json.uintArray(graph.edges);
+        } else if (key == "strings") {
+            ok = json.stringArray(graph.strings);
+        } else {
+            ok = json.skipValue();
+        }
+        json.consume(',');
+    }
+
+    if (!ok || !graph.setMeta(snapshot["meta"].toObject()) || !graph.index()) {
+        m_error = QString("%1 is not a V8 heap snapshot this version understands").arg(path);
+        return false;
+    }
+    m_nodeCount = graph.nodeCount;
+
+    Dominators dominators;
+    dominators.compute(graph);
+    size_t count = dominators.nodeAt.size();
+    quint32 root = static_cast<quint32>(count - 1);
+
+    std::vector<quint64> retained(count);
+    for (size_t post = 0; post < count; ++post) {
+        retained[post] = graph.field(dominators.nodeAt[post], graph.selfSizeField);
+    }
+    for (quint32 post = 0; post < root; ++post) {
+        retained[dominators.dominator[post]] += retained[post];
+    }
+
+    // Per node type: grouped by name, and listed among the largest objects
+    QVector<bool> namedType;
+    QVector<bool> listedType;
+    for (const QString& type : std::as_const(graph.nodeTypes)) {
+        namedType.append(isNamedType(type));
+        listedType.append(type != "synthetic" && type != "hidden");
+    }
+    auto typeOf = [&graph](quint32 node) {
+        return static_cast<qsizetype>(graph.field(node, graph.typeField));
+    };
+
+    // Group by class; names are decoded once per distinct string
+    std::vector<quint32> classOf(count, NONE);
+    QHash<quint32, quint32> classByName;  // Name string index to class
+    QHash<QString, quint32> classByText;
+    QVector<quint32> classByType(graph.nodeTypes.size(), NONE);
+    for (quint32 post = 0; post < root; ++post) {
+        quint32 node = dominators.nodeAt[post];
+        qsizetype type = typeOf(node);
+        bool knownType = type < classByType.size();
+        bool named = knownType && namedType[type];
+        quint32 cached = NONE;
+        if (named) {
+            cached = classByName.value(graph.field(node, graph.nameField), NONE);
+        } else if (knownType) {
+            cached = classByType[type];
+        }
+
+        if (cached == NONE) {
+            QString name = className(graph, node);
+            cached = classByText.value(name, NONE);
+            if (cached == NONE) {
+                cached = static_cast<quint32>(m_classes.size());
+                classByText.insert(name, cached);
+                ClassSummary summary;
+                summary.name = name;
+                m_classes.append(summary);
+            }
+            if (named) {
+                classByName.insert(graph.field(node, graph.nameField), cached);
+            } else if (knownType) {
+                classByType[type] = cached;
+            }
+        }
+
+        classOf[post] = cached;
+        quint64 selfSize = graph.field(node, graph.selfSizeField);
+        m_classes[cached].count++;
+        m_classes[cached].selfSize += static_cast<qint64>(selfSize);
+        m_totalSize += static_cast<qint64>(selfSize);
+        m_objects.push_back({graph.field(node, graph.idField), cached, selfSize});
+    }
+
+    // A class retains what its outermost instances retain; walk the
+    // dominator tree counting the instances of each class on the path
+    std::vector<quint32> childStart(count + 1, 0);
+    for (quint32 post = 0; post < root; ++post) {
+        childStart[dominators.dominator[post] + 1]++;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        childStart[i + 1] += childStart[i];
+    }
+    std::vector<quint32> children(childStart[count]);
+    {
+        std::vector<quint32> fill(childStart.begin(), childStart.end() - 1);
+        for (quint32 post = 0; post < root; ++post) {
+            children[fill[dominators.dominator[post]]++] = post;
+        }
+    }
+
+    std::vector<quint32> open(static_cast<size_t>(m_classes.size()), 0);
+    struct Frame {
+        quint32 post;
+        quint32 child;
+    };
+    std::vector<Frame> stack;
+    stack.push_back({root, childStart[root]});
+    while (!stack.empty()) {
+        Frame& frame = stack.back();
+        if (frame.child < childStart[frame.post + 1]) {
+            quint32 post = children[frame.child++];
+            quint32 cls = classOf[post];
+            if (open[cls]++ == 0) {
+                m_classes[cls].retainedSize += static_cast<qint64>(retained[post]);
+            }
+            stack.push_back({post, childStart[post]});
+        } else {
+            if (frame.post != root) {
+                open[classOf[frame.post]]--;
+            }
+            stack.pop_back();
+        }
+    }
+
+    // Largest single objects, leaving out the synthetic and internal ones
+    std::vector<quint32> candidates;
+    for (quint32 post = 0; post < root; ++post) {
+        qsizetype type = typeOf(dominators.nodeAt[post]);
+        if (type < listedType.size() && listedType[type]) {
+            candidates.push_back(post);
+        }
+    }
+    size_t keep = qMin(candidates.size(), static_cast<size_t>(LARGEST_OBJECTS));
+    std::partial_sort(candidates.begin(), candidates.begin() + keep, candidates.end(),
+                      [&retained](quint32 a, quint32 b) { return retained[a] > retained[b]; });
+    for (size_t i = 0; i < keep; ++i) {
+        quint32 post = candidates[i];
+        quint32 node = dominators.nodeAt[post];
+        ObjectSummary object;
+        object.id = graph.field(node, graph.idField);
+        object.className = m_classes[classOf[post]].name;
+        object.name = shortName(graph.name(node));
+        object.selfSize = graph.field(node, graph.selfSizeField);
+        object.retainedSize = static_cast<qint64>(retained[post]);
+        m_largestObjects.append(object);
+    }
+
+    // Sort the classes and renumber the objects to match
+    QVector<quint32> order(m_classes.size());
+    for (int i = 0; i < order.size(); ++i) {
+        order[i] = static_cast<quint32>(i);
+    }
+    std::sort(order.begin(), order.end(), [this](quint32 a, quint32 b) {
+        return m_classes[a].retainedSize > m_classes[b].retainedSize;
+    });
+    QVector<ClassSummary> sorted;
+    QVector<quint32> renumber(m_classes.size());
+    sorted.reserve(m_classes.size());
+    for (int i = 0; i < order.size(); ++i) {
+        renumber[order[i]] = static_cast<quint32>(i);
+        sorted.append(m_classes[order[i]]);
+    }
+    m_classes = sorted;
+    for (Object& object : m_objects) {
+        object.classIndex = renumber[object.classIndex];
+    }
+    std::sort(m_objects.begin(), m_objects.end(), [](const Object& a, const Object& b) {
+        return a.id < b.id;
+    });
+
+    return true;
+}
+
+QVector<HeapSnapshot::ClassDiff> HeapSnapshot::diff(const HeapSnapshot& before, const HeapSnapshot& after)
+{
+    QVector<ClassDiff> diffs;
+    QHash<QString, int> byName;
+    auto entry = [&](const QString& name) -> ClassDiff& {
+        auto it = byName.find(name);
+        if (it == byName.end()) {
+            it = byName.insert(name, diffs.size());
+            ClassDiff diff;
+            diff.name = name;
+            diffs.append(diff);
+        }
+        return diffs[it.value()];
+    };
+
+    // Class indices of each snapshot into diffs
+    QVector<int> beforeIndex;
+    for (const ClassSummary& summary : before.m_classes) {
+        ClassDiff& diff = entry(summary.name);
+        diff.countBefore = summary.count;
+        diff.retainedBefore = summary.retainedSize;
+        beforeIndex.append(byName.value(summary.name));
+    }
+    QVector<int> afterIndex;
+    for (const ClassSummary& summary : after.m_classes) {
+        ClassDiff& diff = entry(summary.name);
+        diff.countAfter = summary.count;
+        diff.retainedAfter = summary.retainedSize;
+        afterIndex.append(byName.value(summary.name));
+    }
+
+    // Both object lists are sorted by id
+    auto removed = [&](const Object& object) {
+        ClassDiff& diff = diffs[beforeIndex[object.classIndex]];
+        diff.removed++;
+        diff.removedSize += static_cast<qint64>(object.selfSize);
+    };
+    auto added = [&](const Object& object) {
+        ClassDiff& diff = diffs[afterIndex[object.classIndex]];
+        diff.added++;
+        diff.addedSize += static_cast<qint64>(object.selfSize);
+    };
+    size_t i = 0;
+    size_t j = 0;
+    while (i < before.m_objects.size() && j < after.m_objects.size()) {
+        const Object& a = before.m_objects[i];
+        const Object& b = after.m_objects[j];
+        if (a.id < b.id) {
+            removed(a);
+            ++i;
+        } else if (b.id < a.id) {
+            added(b);
+            ++j;
+        } else {
+            ++i;
+            ++j;
+        }
+    }
+    for (; i < before.m_objects.size(); ++i) {
+        removed(before.m_objects[i]);
+    }
+    for (; j < after.m_objects.size(); ++j) {
+        added(after.m_objects[j]);
+    }
+
+    diffs.erase(std::remove_if(diffs.begin(), diffs.end(), [](const ClassDiff& diff) {
+        return diff.added == 0 && diff.removed == 0 && diff.retainedBefore == diff.retainedAfter;
+    }), diffs.end());
+    std::sort(diffs.begin(), diffs.end(), [](const ClassDiff& a, const ClassDiff& b) {
+        if (a.sizeDelta() != b.sizeDelta()) {
+            return a.sizeDelta() > b.sizeDelta();
+        }
+        return a.retainedAfter - a.retainedBefore > b.retainedAfter - b.retainedBefore;
+    });
+    return diffs;
+}
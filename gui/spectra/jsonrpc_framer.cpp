@@ -0,0 +1,128 @@
+#include "jsonrpc_framer.h"
+#include <cstring>
+#include <utility>
+
+JsonRpcFramer::JsonRpcFramer(qint64 maxMessageBytes)
+    : m_maxMessageBytes(maxMessageBytes)
+{
+}
+
+void JsonRpcFramer::feed(const char* data, qint64 size, QList<QByteArray>& messages, QList<Error>& errors)
+{
+    qint64 i = 0;
+    while (i < size) {
+        if (m_skippingLine) {
+            const char* newline = static_cast<const char*>(std::memchr(data + i, '\n', static_cast<size_t>(size - i)));
+            if (!newline) {
+                m_skippedBytes += size - i;
+                return;
+            }
+            qint64 end = newline - data;
+            m_skippedBytes += end - i;
+            errors.append({Error::UnexpectedData, m_skippedBytes});
+            m_skippingLine = false;
+            m_skippedBytes = 0;
+            i = end + 1;
+            continue;
+        }
+
+        qint64 spanStart = i;
+        if (m_depth == 0) {
+            char c = data[i];
+            if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+                ++i;
+                continue;
+            }
+            if (c != '{' && c != '[') {
+                m_skippingLine = true;
+                continue;
+            }
+            m_depth = 1;
+            ++i;
+        }
+
+        bool complete = false;
+        while (i < size) {
+            if (m_inString) {
+                if (m_escape) {
+                    m_escape = false;
+                    ++i;
+                    continue;
+                }
+                // String contents (eval code, HTML bodies) are skipped in one run
+                while (i < size && data[i] != '"' && data[i] != '\\') {
+                    ++i;
+                }
+                if (i == size) {
+                    break;
+                }
+                if (data[i] == '\\') {
+                    m_escape = true;
+                } else {
+                    m_inString = false;
+                }
+                ++i;
+                continue;
+            }
+
+            char c = data[i++];
+            if (c == '"') {
+                m_inString = true;
+            } else if (c == '{' || c == '[') {
+                ++m_depth;
+            } else if (c == '}' || c == ']') {
+                if (--m_depth == 0) {
+                    complete = true;
+                    break;
+                }
+            }
+        }
+
+        appendSpan(data + spanStart, i - spanStart);
+        if (complete) {
+            if (m_oversized) {
+                errors.append({Error::MessageTooLarge, m_messageBytes});
+            } else {
+                messages.append(std::move(m_message));
+            }
+            reset();
+        }
+    }
+}
+
+void JsonRpcFramer::finish(QList<Error>& errors)
+{
+    if (m_depth > 0) {
+        errors.append({Error::UnexpectedData, m_messageBytes});
+    } else if (m_skippingLine && m_skippedBytes > 0) {
+        errors.append({Error::UnexpectedData, m_skippedBytes});
+    }
+    reset();
+    m_skippingLine = false;
+    m_skippedBytes = 0;
+}
+
+void JsonRpcFramer::appendSpan(const char* data, qint64 size)
+{
+    m_messageBytes += size;
+    if (m_oversized) {
+        return;
+    }
+    if (m_messageBytes > m_maxMessageBytes) {
+        // Keep counting structure, stop keeping bytes
+        m_oversized = true;
+        m_message = QByteArray();
+        return;
+    }
+    m_message.append(data, static_cast<qsizetype>(size));
+}
+
+void JsonRpcFramer::reset()
+{
+    m_message = QByteArray();
+    m_messageBytes = 0;
+    m_depth = 0;
+    m_inString = false;
+    m_escape = false;
+    m_oversized = false;
+}
@@ -0,0 +1,60 @@
+#ifndef JSONRPC_FRAMER_H
+#define JSONRPC_FRAMER_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+/**
+ * Incremental framer for a stream of JSON-RPC messages.
+ *
+ * Bytes are fed as they arrive. The framer tracks object/array depth and
+ * string/escape state, so each byte is looked at once and a message is
+ * complete the moment its closing brace arrives, whether or not it is
+ * followed by a newline or spread across several lines. Complete messages
+ * come out as raw UTF-8 for a single QJsonDocument::fromJson() call.
+ *
+ * A message growing past maxMessageBytes is dropped while the framer keeps
+ * tracking its structure, so the stream stays in sync afterwards. Stray
+ * bytes between messages are skipped up to the next newline.
+ */
+class JsonRpcFramer
+{
+public:
+    static constexpr qint64 DEFAULT_MAX_MESSAGE_BYTES = 32 * 1024 * 1024;
+
+    struct Error {
+        enum Kind { MessageTooLarge, UnexpectedData };
+        Kind kind;
+        qint64 bytes;  // Size of the dropped message or data
+    };
+
+    explicit JsonRpcFramer(qint64 maxMessageBytes = DEFAULT_MAX_MESSAGE_BYTES);
+
+    void setMaxMessageBytes(qint64 maxMessageBytes) { m_maxMessageBytes = maxMessageBytes; }
+    qint64 maxMessageBytes() const { return m_maxMessageBytes; }
+
+    // Appends every message completed by data to messages
+    void feed(const char* data, qint64 size, QList<QByteArray>& messages, QList<Error>& errors);
+
+    // End of stream: reports a partial message, if any, and resets
+    void finish(QList<Error>& errors);
+
+    bool inMessage() const { return m_depth > 0; }
+
+private:
+    void appendSpan(const char* data, qint64 size);
+    void reset();
+
+    qint64 m_maxMessageBytes;
+    QByteArray m_message;
+    qint64 m_messageBytes = 0;
+    int m_depth = 0;
+    bool m_inString = false;
+    bool m_escape = false;
+    bool m_oversized = false;
+    bool m_skippingLine = false;
+    qint64 m_skippedBytes = 0;
+};
+
+#endif // JSONRPC_FRAMER_H
@@ -1,9 +1,9 @@
 #include "mcpserver_stdio.h"
+#include "stdin_reader.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QCoreApplication>
-#include <QTimer>
 #include <QDateTime>
 #include <QFile>
 #include <QTextStream>
@@ -43,7 +43,7 @@ static void initDebugLogging() {
 
 MCPServerStdio::MCPServerStdio(QObject* parent)
     : QObject(parent)
-    , m_stdin(stdin, QIODevice::ReadOnly)
+    , m_stdinReader(new StdinReader(this))
     , m_stdout(stdout, QIODevice::WriteOnly)
     , m_serverName("Spectra MCP Server")
     , m_serverVersion("1.0.0")
@@ -65,6 +65,10 @@ MCPServerStdio::MCPServerStdio(QObject* parent)
     
     m_stdout.setAutoDetectUnicode(false);
     
+    connect(m_stdinReader, &StdinReader::messagesReady, this, &MCPServerStdio::handleStdinMessages);
+    connect(m_stdinReader, &StdinReader::messageRejected, this, &MCPServerStdio::handleStdinRejected);
+    connect(m_stdinReader, &StdinReader::closed, this, &MCPServerStdio::handleStdinClosed);
+    
     debugLog("MCPServerStdio constructed");
 }
 
@@ -93,9 +97,9 @@ void MCPServerStdio::start()
     
     m_running = true;
     
-    QTimer* timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, &MCPServerStdio::handleStdinReady);
-    timer->start(50);
+    // Blocking reads on a dedicated thread: requests are dispatched as soon
+    // as their line arrives and an idle server never wakes up
+    m_stdinReader->start();
     
     emit logMessage("MCP stdio server started");
 }
@@ -103,6 +107,7 @@ void MCPServerStdio::start()
 void MCPServerStdio::stop()
 {
     m_running = false;
+    m_stdinReader->stop();
     emit logMessage("MCP stdio server stopped");
 }
 
@@ -111,6 +116,20 @@ void MCPServerStdio::registerTool(const ToolDefinition& tool)
     m_tools[tool.name] = tool;
 }
 
+void MCPServerStdio::addToolProperty(const QString& prefix, const QString& name, const QJsonObject& schema)
+{
+    for (auto it = m_tools.begin(); it != m_tools.end(); ++it) {
+        if (!it.key().startsWith(prefix)) {
+            continue;
+        }
+        QJsonObject properties = it->inputSchema["properties"].toObject();
+        if (!properties.contains(name)) {
+            properties[name] = schema;
+            it->inputSchema["properties"] = properties;
+        }
+    }
+}
+
 void MCPServerStdio::setServerInfo(const QString& name, const QString& version)
 {
     m_serverName = name;
@@ -130,104 +149,50 @@ void MCPServerStdio::setDebugMode(bool enabled)
     }
 }
 
-void MCPServerStdio::handleStdinReady()
+void MCPServerStdio::setMaxMessageBytes(qint64 maxMessageBytes)
+{
+    m_stdinReader->setMaxMessageBytes(maxMessageBytes);
+}
+
+void MCPServerStdio::handleStdinClosed()
+{
+    debugLog("EOF detected on stdin");
+    std::cerr << "# EOF detected on stdin, exiting..." << std::endl;
+    emit stdinClosed();
+}
+
+void MCPServerStdio::handleStdinMessages(const QList<QByteArray>& messages)
 {
-    static int callCount = 0;
-    callCount++;
-    
     if (!m_running) {
-        debugLog("handleStdinReady called but not running");
-        return;
-    }
-    
-    if (g_debugMode && callCount % 100 == 0) {
-        debugLog(QString("handleStdinReady #%1, buffer: %2 bytes").arg(callCount).arg(m_inputBuffer.length()));
-    }
-    
-#ifdef Q_OS_WIN
-    HANDLE hStdin = GetStdHandle(STD_INPUT_HANDLE);
-    if (hStdin == INVALID_HANDLE_VALUE) {
-        debugLog("Windows: stdin handle is invalid");
-        std::cerr << "# stdin handle is invalid, exiting..." << std::endl;
-        emit stdinClosed();
-        return;
-    }
-    
-    DWORD available = 0;
-    if (!PeekNamedPipe(hStdin, NULL, 0, NULL, &available, NULL)) {
-        DWORD error = GetLastError();
-        debugLog(QString("Windows: PeekNamedPipe failed, error %1").arg(error));
-        if (error == ERROR_BROKEN_PIPE || error == ERROR_PIPE_NOT_CONNECTED) {
-            std::cerr << "# stdin pipe is broken, exiting..." << std::endl;
-            emit stdinClosed();
-            return;
-        }
-    } else if (g_debugMode && available > 0) {
-        debugLog(QString("Windows: %1 bytes available on stdin").arg(available));
-    }
-#else
-    if (feof(stdin) || ferror(stdin)) {
-        debugLog("Unix: stdin closed (feof or ferror)");
-        std::cerr << "# stdin closed, exiting..." << std::endl;
-        emit stdinClosed();
+        debugLog("handleStdinMessages called but not running");
         return;
     }
-#endif
-    
-    if (m_stdin.atEnd()) {
-        char ch;
-        if (std::cin.get(ch)) {
-            std::cin.unget();
-        } else {
-            debugLog("EOF detected on stdin");
-            std::cerr << "# EOF detected on stdin, exiting..." << std::endl;
-            emit stdinClosed();
-            return;
-        }
-    }
     
-    bool dataRead = false;
-    while (!m_stdin.atEnd()) {
-        QString line = m_stdin.readLine();
-        if (line.isNull()) {
-            debugLog("Null line read from stdin");
-            std::cerr << "# Null line read from stdin, exiting..." << std::endl;
-            emit stdinClosed();
-            return;
-        }
-        
-        dataRead = true;
+    // The reader has already framed each message, so each is parsed once
+    for (const QByteArray& message : messages) {
         if (g_debugMode) {
-            debugLog(QString("Read %1 chars: %2").arg(line.length()).arg(line.left(100)));
+            debugLog(QString("Read %1 bytes: %2").arg(message.size()).arg(QString::fromUtf8(message.left(100))));
         }
         
-        m_inputBuffer += line;
-        
         QJsonParseError error;
-        QJsonDocument doc = QJsonDocument::fromJson(m_inputBuffer.toUtf8(), &error);
+        QJsonDocument doc = QJsonDocument::fromJson(message, &error);
         
         if (error.error == QJsonParseError::NoError && doc.isObject()) {
-            debugLog(QString("Valid JSON parsed, buffer was %1 bytes").arg(m_inputBuffer.length()));
             processJsonRpcRequest(doc.object());
-            m_inputBuffer.clear();
-        } else if (error.error == QJsonParseError::GarbageAtEnd) {
-            debugLog(QString("JSON parse: GarbageAtEnd, continuing to buffer (%1 bytes)").arg(m_inputBuffer.length()));
-        } else if (m_inputBuffer.length() < 65536) {
-            debugLog(QString("JSON parse error: %1 at offset %2").arg(error.errorString()).arg(error.offset));
-            if (error.error != QJsonParseError::GarbageAtEnd) {
-                sendError(QJsonValue::Null, -32700, "Parse error");
-                m_inputBuffer.clear();
-            }
+        } else if (error.error == QJsonParseError::NoError) {
+            debugLog("Message is not a JSON object (batches are not supported)");
+            sendError(QJsonValue::Null, -32600, "Invalid Request");
         } else {
-            debugLog("Buffer exceeded 65536 bytes, clearing");
-            sendError(QJsonValue::Null, -32700, "Message too large");
-            m_inputBuffer.clear();
+            debugLog(QString("JSON parse error: %1 at offset %2").arg(error.errorString()).arg(error.offset));
+            sendError(QJsonValue::Null, -32700, "Parse error");
         }
     }
-    
-    if (dataRead && g_debugMode) {
-        debugLog(QString("Read cycle complete, buffer: %1 bytes").arg(m_inputBuffer.length()));
-    }
+}
+
+void MCPServerStdio::handleStdinRejected(const QString& reason, qint64 bytes)
+{
+    debugLog(QString("Dropped %1 bytes from stdin: %2").arg(bytes).arg(reason));
+    sendError(QJsonValue::Null, -32700, reason);
 }
 
 void MCPServerStdio::processJsonRpcRequest(const QJsonObject& request)
@@ -267,12 +232,15 @@ void MCPServerStdio::processJsonRpcRequest(const QJsonObject& request)
         } else if (method == "tools/call") {
             QString toolName = params["name"].toString();
             debugLog(QString("Calling tool: %1").arg(toolName));
-            result = handleCallTool(params);
+            // Responds through completeToolCall(), possibly after later requests
+            handleCallTool(id, params);
+            return;
         } else if (method == "notifications/initialized") {
             debugLog("Received initialized notification");
             return;
         } else if (method == "notifications/cancelled") {
             debugLog("Received cancelled notification");
+            handleCancelled(params);
             return;
         } else {
             debugLog(QString("Unknown method: %1").arg(method));
@@ -322,7 +290,61 @@ QJsonObject MCPServerStdio::handleListTools(const QJsonObject& params)
     return QJsonObject{{"tools", tools}};
 }
 
-QJsonObject MCPServerStdio::handleCallTool(const QJsonObject& params)
+struct MCPServerStdio::ToolCall::State {
+    QPointer<MCPServerStdio> server;
+    QJsonValue id;
+    QJsonObject arguments;
+    bool finished = false;
+    bool cancelled = false;
+    std::function<void()> cancelHandler;
+};
+
+void MCPServerStdio::ToolCall::finish(const QJsonObject& content) const
+{
+    if (!m_state || m_state->finished || m_state->cancelled) {
+        return;
+    }
+    m_state->finished = true;
+    m_state->cancelHandler = nullptr;
+    if (m_state->server) {
+        m_state->server->completeToolCall(*this, content);
+    }
+}
+
+bool MCPServerStdio::ToolCall::isCancelled() const
+{
+    return m_state && m_state->cancelled;
+}
+
+QJsonObject MCPServerStdio::ToolCall::arguments() const
+{
+    return m_state ? m_state->arguments : QJsonObject();
+}
+
+void MCPServerStdio::ToolCall::onCancel(std::function<void()> handler) const
+{
+    if (m_state && !m_state->finished && !m_state->cancelled) {
+        m_state->cancelHandler = std::move(handler);
+    }
+}
+
+QString MCPServerStdio::requestKey(const QJsonValue& id)
+{
+    if (id.isString()) {
+        return QStringLiteral("s:") + id.toString();
+    }
+    if (id.isDouble()) {
+        return QStringLiteral("n:") + QString::number(id.toInteger());
+    }
+    return QString();
+}
+
+MCPServerStdio::ToolCall MCPServerStdio::currentToolCall() const
+{
+    return m_runningHandlers.isEmpty() ? ToolCall() : m_runningHandlers.last();
+}
+
+void MCPServerStdio::handleCallTool(const QJsonValue& id, const QJsonObject& params)
 {
     if (!params.contains("name")) {
         throw std::runtime_error("Missing tool name");
@@ -334,24 +356,79 @@ QJsonObject MCPServerStdio::handleCallTool(const QJsonObject& params)
         throw std::runtime_error(QString("Unknown tool: %1").arg(toolName).toStdString());
     }
     
-    const ToolDefinition& tool = m_tools[toolName];
+    QString key = requestKey(id);
+    if (!key.isEmpty() && m_inFlight.contains(key)) {
+        sendError(id, -32600, "Request id is already in flight");
+        return;
+    }
+    
+    const ToolDefinition tool = m_tools[toolName];
     QJsonObject toolParams = params.value("arguments").toObject();
     
+    ToolCall call;
+    call.m_state = std::make_shared<ToolCall::State>();
+    call.m_state->server = this;
+    call.m_state->id = id;
+    call.m_state->arguments = toolParams;
+    if (!key.isEmpty()) {
+        m_inFlight.insert(key, call);
+    }
+    
+    // Synchronous handlers may spin nested event loops, during which other
+    // requests are dispatched; the stack tracks whose handler is innermost
+    m_runningHandlers.append(call);
     try {
-        QJsonObject result = tool.handler(toolParams);
-        
-        return QJsonObject{
-            {"content", QJsonArray{result}}
-        };
+        if (tool.asyncHandler) {
+            tool.asyncHandler(toolParams, call);
+        } else {
+            call.finish(tool.handler(toolParams));
+        }
     } catch (const std::exception& e) {
-        return QJsonObject{
-            {"content", QJsonArray{
-                QJsonObject{
-                    {"type", "text"},
-                    {"text", QString("Error executing tool: %1").arg(e.what())}
-                }
-            }}
-        };
+        call.finish(QJsonObject{
+            {"type", "text"},
+            {"text", QString("Error executing tool: %1").arg(e.what())}
+        });
+    } catch (...) {
+        call.finish(QJsonObject{
+            {"type", "text"},
+            {"text", "Error executing tool: unknown exception"}
+        });
+    }
+    m_runningHandlers.removeLast();
+}
+
+void MCPServerStdio::handleCancelled(const QJsonObject& params)
+{
+    QString key = requestKey(params.value("requestId"));
+    if (key.isEmpty() || !m_inFlight.contains(key)) {
+        debugLog("Cancellation for a request that is not in flight");
+        return;
+    }
+    
+    ToolCall call = m_inFlight.take(key);
+    debugLog(QString("Cancelling request %1: %2").arg(key, params.value("reason").toString()));
+    
+    // Per MCP, a cancelled request gets no response
+    call.m_state->cancelled = true;
+    std::function<void()> handler = std::move(call.m_state->cancelHandler);
+    call.m_state->cancelHandler = nullptr;
+    if (handler) {
+        handler();
+    }
+}
+
+void MCPServerStdio::completeToolCall(const ToolCall& call, const QJsonObject& content)
+{
+    QJsonValue id = call.m_state->id;
+    QString key = requestKey(id);
+    if (!key.isEmpty()) {
+        m_inFlight.remove(key);
+    }
+    
+    if (!id.isNull() && !id.isUndefined()) {
+        sendResponse(id, QJsonObject{
+            {"content", QJsonArray{content}}
+        });
     }
 }
 
@@ -5,18 +5,52 @@
 #include <QJsonObject>
 #include <QJsonDocument>
 #include <QJsonArray>
+#include <QList>
+#include <QByteArray>
 #include <QMap>
+#include <QHash>
+#include <QPointer>
 #include <QTextStream>
 #include <QIODevice>
 #include <functional>
 #include <memory>
 
+class StdinReader;
+
 class MCPServerStdio : public QObject
 {
     Q_OBJECT
 
 public:
+    /**
+     * Handle for one in-flight tools/call request.
+     *
+     * Async handlers keep a copy and call finish() once, on the server's
+     * thread, whenever the result is ready. Responses go out in completion
+     * order and are matched to their request by id, so any number of calls
+     * can be in flight at once. If the client sends notifications/cancelled
+     * first, the onCancel() handler runs and finish() becomes a no-op.
+     */
+    class ToolCall {
+    public:
+        ToolCall() = default;
+        explicit operator bool() const { return static_cast<bool>(m_state); }
+
+        void finish(const QJsonObject& content) const;
+        bool isCancelled() const;
+        // As sent by the client, for helpers shared between tools
+        QJsonObject arguments() const;
+        // Replaces any previous handler; pass nullptr to clear it
+        void onCancel(std::function<void()> handler) const;
+
+    private:
+        friend class MCPServerStdio;
+        struct State;
+        std::shared_ptr<State> m_state;
+    };
+
     using ToolHandler = std::function<QJsonObject(const QJsonObject& params)>;
+    using AsyncToolHandler = std::function<void(const QJsonObject& params, const ToolCall& call)>;
 
     explicit MCPServerStdio(QObject* parent = nullptr);
     ~MCPServerStdio();
@@ -28,28 +62,44 @@ public:
         QString name;
         QString description;
         QJsonObject inputSchema;
-        ToolHandler handler;
+        ToolHandler handler;              // Runs to completion before returning
+        AsyncToolHandler asyncHandler;    // Used instead of handler when set
     };
 
     void registerTool(const ToolDefinition& tool);
+    // Adds an input property to every registered tool whose name starts
+    // with prefix, for arguments handled outside the tools themselves.
+    // Tools that already define it keep their own.
+    void addToolProperty(const QString& prefix, const QString& name, const QJsonObject& schema);
 
     void setServerInfo(const QString& name, const QString& version);
     void setCapabilities(const QJsonObject& capabilities);
     void setDebugMode(bool enabled);
+    // Largest request accepted on stdin; set before start()
+    void setMaxMessageBytes(qint64 maxMessageBytes);
+
+    // The call whose handler is currently running on the stack, if any.
+    // Lets helpers shared between tools read its arguments.
+    ToolCall currentToolCall() const;
 
 signals:
     void logMessage(const QString& message);
     void stdinClosed();
 
 private slots:
-    void handleStdinReady();
+    void handleStdinMessages(const QList<QByteArray>& messages);
+    void handleStdinRejected(const QString& reason, qint64 bytes);
+    void handleStdinClosed();
 
 private:
     void processJsonRpcRequest(const QJsonObject& request);
     
     QJsonObject handleInitialize(const QJsonObject& params);
     QJsonObject handleListTools(const QJsonObject& params);
-    QJsonObject handleCallTool(const QJsonObject& params);
+    void handleCallTool(const QJsonValue& id, const QJsonObject& params);
+    void handleCancelled(const QJsonObject& params);
+    void completeToolCall(const ToolCall& call, const QJsonObject& content);
+    static QString requestKey(const QJsonValue& id);
     
     void sendResponse(const QJsonValue& id, const QJsonObject& result);
     void sendError(const QJsonValue& id, int code, const QString& message);
@@ -57,15 +107,16 @@ private:
     void writeMessage(const QJsonObject& message);
 
 private:
-    QTextStream m_stdin;
+    StdinReader* m_stdinReader;
     QTextStream m_stdout;
-    QString m_inputBuffer;
     
     QString m_serverName;
     QString m_serverVersion;
     QJsonObject m_capabilities;
     
     QMap<QString, ToolDefinition> m_tools;
+    QHash<QString, ToolCall> m_inFlight;   // tools/call requests awaiting finish(), by id
+    QList<ToolCall> m_runningHandlers;     // Handlers currently on the stack
     
     bool m_initialized;
     bool m_running;
@@ -0,0 +1,181 @@
+#include "stdin_reader.h"
+#include <QThread>
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr qint64 READ_CHUNK_BYTES = 64 * 1024;
+// How often the reader checks for stop() when there is no wake pipe
+constexpr int STOP_POLL_MS = 100;
+}
+
+StdinReader::StdinReader(QObject* parent)
+    : QObject(parent)
+{
+}
+
+StdinReader::~StdinReader()
+{
+    stop();
+}
+
+void StdinReader::start()
+{
+    if (m_thread) {
+        return;
+    }
+
+    m_stopping.store(false);
+#ifndef Q_OS_WIN
+    if (::pipe(m_wakePipe) != 0) {
+        m_wakePipe[0] = m_wakePipe[1] = -1;
+    }
+#endif
+
+    m_thread = QThread::create([this]() { readLoop(); });
+    m_thread->setObjectName("StdinReader");
+    m_thread->start();
+}
+
+void StdinReader::stop()
+{
+    if (!m_thread) {
+        return;
+    }
+
+    m_stopping.store(true);
+#ifdef Q_OS_WIN
+    // The thread may be between its stop check and ReadFile(), so keep
+    // cancelling until it has actually left the call
+    do {
+        HANDLE handle = static_cast<HANDLE>(m_threadHandle.load());
+        if (handle) {
+            CancelSynchronousIo(handle);
+        }
+    } while (!m_thread->wait(50));
+#else
+    if (m_wakePipe[1] >= 0) {
+        char wake = 1;
+        ssize_t ignored = ::write(m_wakePipe[1], &wake, 1);
+        Q_UNUSED(ignored);
+    }
+    // Without a wake pipe the reader notices m_stopping within
+    // STOP_POLL_MS
+    m_thread->wait();
+#endif
+
+    delete m_thread;
+    m_thread = nullptr;
+
+#ifndef Q_OS_WIN
+    for (int& fd : m_wakePipe) {
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+#endif
+}
+
+void StdinReader::frame(JsonRpcFramer& framer, const char* data, qint64 size)
+{
+    QList<QByteArray> messages;
+    QList<JsonRpcFramer::Error> errors;
+    framer.feed(data, size, messages, errors);
+
+    reportErrors(errors);
+    if (!messages.isEmpty()) {
+        emit messagesReady(messages);
+    }
+}
+
+void StdinReader::reportErrors(const QList<JsonRpcFramer::Error>& errors)
+{
+    for (const JsonRpcFramer::Error& error : errors) {
+        emit messageRejected(error.kind == JsonRpcFramer::Error::MessageTooLarge
+                                 ? QStringLiteral("Message too large")
+                                 : QStringLiteral("Parse error"),
+                             error.bytes);
+    }
+}
+
+void StdinReader::readLoop()
+{
+    JsonRpcFramer framer(m_maxMessageBytes);
+    char buffer[READ_CHUNK_BYTES];
+
+#ifdef Q_OS_WIN
+    HANDLE thread = OpenThread(THREAD_TERMINATE, FALSE, GetCurrentThreadId());
+    m_threadHandle.store(thread);
+    HANDLE input = GetStdHandle(STD_INPUT_HANDLE);
+
+    while (!m_stopping.load()) {
+        DWORD bytesRead = 0;
+        if (!ReadFile(input, buffer, sizeof(buffer), &bytesRead, nullptr)) {
+            if (GetLastError() == ERROR_OPERATION_ABORTED && !m_stopping.load()) {
+                continue;
+            }
+            break;
+        }
+        if (bytesRead == 0) {
+            break;
+        }
+        frame(framer, buffer, bytesRead);
+    }
+
+    m_threadHandle.store(nullptr);
+    if (thread) {
+        CloseHandle(thread);
+    }
+#else
+    while (!m_stopping.load()) {
+        pollfd fds[2] = {
+            {STDIN_FILENO, POLLIN, 0},
+            {m_wakePipe[0], POLLIN, 0},
+        };
+        // Without a wake pipe stop() has no way to interrupt poll(), so
+        // wake up now and then to check for it instead
+        bool canWake = m_wakePipe[0] >= 0;
+        int ready = ::poll(fds, canWake ? 2 : 1, canWake ? -1 : STOP_POLL_MS);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (fds[1].revents) {
+            break;
+        }
+        if (!fds[0].revents) {
+            continue;
+        }
+
+        ssize_t bytesRead = ::read(STDIN_FILENO, buffer, sizeof(buffer));
+        if (bytesRead < 0) {
+            if (errno == EINTR || errno == EAGAIN) {
+                continue;
+            }
+            break;
+        }
+        if (bytesRead == 0) {
+            break;
+        }
+        frame(framer, buffer, bytesRead);
+    }
+#endif
+
+    if (m_stopping.load()) {
+        return;
+    }
+
+    // A message cut off by EOF can't be answered, but is worth reporting
+    QList<JsonRpcFramer::Error> errors;
+    framer.finish(errors);
+    reportErrors(errors);
+    emit closed();
+}
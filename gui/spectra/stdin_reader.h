@@ -0,0 +1,60 @@
+#ifndef STDIN_READER_H
+#define STDIN_READER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <atomic>
+#include "jsonrpc_framer.h"
+
+class QThread;
+
+/**
+ * Reads stdin on a dedicated thread with blocking reads, frames the bytes
+ * into JSON-RPC messages (see JsonRpcFramer) and hands them to the owning
+ * thread through queued signals. Nothing runs while stdin is idle, and a
+ * message is dispatched as soon as its closing brace arrives.
+ *
+ * On Unix the thread waits in poll() on stdin and a wake pipe so stop() can
+ * interrupt it, falling back to a short poll timeout if the pipe can't be
+ * created; on Windows stop() cancels the pending ReadFile().
+ */
+class StdinReader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit StdinReader(QObject* parent = nullptr);
+    ~StdinReader();
+
+    // Takes effect on the next start()
+    void setMaxMessageBytes(qint64 maxMessageBytes) { m_maxMessageBytes = maxMessageBytes; }
+
+    void start();
+    void stop();
+
+signals:
+    // Complete messages as raw UTF-8, in arrival order
+    void messagesReady(const QList<QByteArray>& messages);
+    // A message over the size cap, or bytes that aren't JSON, was dropped
+    void messageRejected(const QString& reason, qint64 bytes);
+    // EOF or a read error on stdin
+    void closed();
+
+private:
+    void readLoop();
+    void frame(JsonRpcFramer& framer, const char* data, qint64 size);
+    void reportErrors(const QList<JsonRpcFramer::Error>& errors);
+
+    QThread* m_thread = nullptr;
+    qint64 m_maxMessageBytes = JsonRpcFramer::DEFAULT_MAX_MESSAGE_BYTES;
+    std::atomic<bool> m_stopping{false};
+#ifdef Q_OS_WIN
+    std::atomic<void*> m_threadHandle{nullptr};
+#else
+    int m_wakePipe[2] = {-1, -1};
+#endif
+};
+
+#endif // STDIN_READER_H
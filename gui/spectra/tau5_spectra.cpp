@@ -10,18 +10,40 @@
 #include <QUuid>
 #include <QElapsedTimer>
 #include <QRegularExpression>
+#include <QtConcurrent>
+#include <QFutureWatcher>
 #include <iostream>
 #include <memory>
 #include <algorithm>
 #include "mcpserver_stdio.h"
 #include "../shared/tau5logger.h"
+#include "../shared/log_index.h"
+#include "../shared/log_search.h"
 #include "cdpclient.h"
+#include "cpu_profile.h"
+#include "heap_snapshot.h"
+#include "trace_analysis.h"
 #include "tidewaveproxy.h"
 
 static void debugLog(const QString& message) {
     std::cerr << "# " << message.toStdString() << std::endl;
 }
 
+static QString formatBytes(qint64 bytes) {
+    qint64 size = qAbs(bytes);
+    QString sign = bytes < 0 ? "-" : "";
+    if (size < 1024) {
+        return QString("%1%2 B").arg(sign).arg(size);
+    }
+    if (size < 1024 * 1024) {
+        return QString("%1%2 KB").arg(sign).arg(size / 1024.0, 0, 'f', 1);
+    }
+    if (size < 1024LL * 1024 * 1024) {
+        return QString("%1%2 MB").arg(sign).arg(size / (1024.0 * 1024), 0, 'f', 1);
+    }
+    return QString("%1%2 GB").arg(sign).arg(size / (1024.0 * 1024 * 1024), 0, 'f', 2);
+}
+
 class MCPActivityLogger
 {
 public:
@@ -133,40 +155,93 @@ public:
     explicit TidewaveBridge(TidewaveProxy* proxy, QObject* parent = nullptr)
         : QObject(parent), m_proxy(proxy) {}
 
-    QJsonObject executeCommand(const QString& toolName, const QJsonObject& params)
+    // Calls a Tidewave tool and hands the result, or {"error": true,
+    // "message": ...}, to done on this thread. Returns a function that
+    // aborts the request; done is not called after that.
+    std::function<void()> executeCommandAsync(const QString& toolName, const QJsonObject& params,
+                                              std::function<void(const QJsonObject&)> done)
     {
         if (!m_proxy->isAvailable()) {
-            return QJsonObject{
+            done(QJsonObject{
                 {"error", true},
                 {"message", "Tidewave MCP server is not available"}
-            };
+            });
+            return []() {};
         }
 
-        QJsonObject result;
-        QString error;
-        QEventLoop loop;
-
-        m_proxy->callTool(toolName, params, [&result, &error, &loop](const QJsonObject& res, const QString& err) {
-            result = res;
-            error = err;
-            loop.quit();
-        });
+        struct Pending {
+            int requestId = -1;
+            bool finished = false;
+            QTimer* timeout = nullptr;
+            std::function<void(const QJsonObject&)> done;
+        };
+        auto pending = std::make_shared<Pending>();
+        pending->done = std::move(done);
+        pending->timeout = new QTimer(this);
+        pending->timeout->setSingleShot(true);
 
-        QTimer timeout;
-        timeout.setSingleShot(true);
-        connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
-        timeout.start(30000); // 30 second timeout
+        auto complete = [pending](const QJsonObject& result) {
+            if (pending->finished) {
+                return;
+            }
+            pending->finished = true;
+            pending->timeout->deleteLater();
+            std::function<void(const QJsonObject&)> done = std::move(pending->done);
+            done(result);
+        };
 
-        loop.exec();
+        pending->requestId = m_proxy->callTool(toolName, params, [complete](const QJsonObject& res, const QString& err) {
+            if (!err.isEmpty()) {
+                complete(QJsonObject{
+                    {"error", true},
+                    {"message", err}
+                });
+                return;
+            }
+            complete(res);
+        });
 
-        if (!error.isEmpty()) {
-            return QJsonObject{
+        connect(pending->timeout, &QTimer::timeout, this, [this, pending, complete]() {
+            m_proxy->cancelRequest(pending->requestId);
+            complete(QJsonObject{
                 {"error", true},
-                {"message", error}
-            };
-        }
+                {"message", "Tidewave request timed out after 30 seconds"}
+            });
+        });
+        pending->timeout->start(30000);
+
+        return [this, pending]() {
+            if (pending->finished) {
+                return;
+            }
+            pending->finished = true;
+            pending->timeout->deleteLater();
+            pending->done = nullptr;
+            m_proxy->cancelRequest(pending->requestId);
+        };
+    }
 
-        return result;
+    // Runs a Tidewave tool for an MCP tools/call. The call stays in flight
+    // until Tidewave answers, and cancelling it aborts the Tidewave request.
+    void callTool(const QString& toolName, const QJsonObject& params,
+                  const MCPServerStdio::ToolCall& call, bool markErrors = false)
+    {
+        std::function<void()> cancel = executeCommandAsync(toolName, params,
+            [this, call, markErrors](const QJsonObject& result) {
+                if (result.contains("error")) {
+                    QJsonObject content{
+                        {"type", "text"},
+                        {"text", result["message"].toString()}
+                    };
+                    if (markErrors) {
+                        content["isError"] = true;
+                    }
+                    call.finish(content);
+                    return;
+                }
+                call.finish(formatResponse(result));
+            });
+        call.onCancel(cancel);
     }
 
     QJsonObject formatResponse(const QJsonObject& result)
@@ -197,8 +272,8 @@ class CDPBridge : public QObject
     Q_OBJECT
 
 public:
-    explicit CDPBridge(CDPClient* client, QObject* parent = nullptr)
-        : QObject(parent), m_client(client)
+    explicit CDPBridge(CDPClient* client, MCPServerStdio* server, QObject* parent = nullptr)
+        : QObject(parent), m_client(client), m_server(server)
     {
         // Set up automatic reconnection timer
         m_reconnectionTimer = new QTimer(this);
@@ -293,308 +368,90 @@ public:
         return false;
     }
     
-    QJsonObject executeCommand(std::function<void(CDPClient*, CDPClient::ResponseCallback)> command)
+    // Issues a CDP command without blocking. done gets the result, or an
+    // error result on failure or timeout; a timeout also runs the frozen
+    // browser recovery below. The returned function cancels the command,
+    // after which done is not called. The command goes to the target named
+    // by the tool call's "target" argument, if it has one.
+    std::function<void()> executeCommandAsync(std::function<void(CDPClient*, CDPClient::ResponseCallback)> command,
+                                              int timeoutMs,
+                                              std::function<void(const QJsonObject&)> done)
     {
-        const int maxRetries = 0;  // No retries - fail fast to keep MCP connection responsive
-        const int timeoutMs = 8000;  // Default timeout
-
-        for (int retry = 0; retry <= maxRetries; retry++) {
-            try {
-                if (retry > 0) {
-                    debugLog(QString("Attempting command retry %1/%2").arg(retry).arg(maxRetries));
-                }
-
-                if (!ensureConnected()) {
-                    debugLog(QString("CDP connection failed after retries - port: %1").arg(m_client->getDevToolsPort()));
-                    return createErrorResult(QString("Chrome DevTools not responding after multiple connection attempts. Make sure Tau5 is running in dev mode with --devtools (port %1). Check that the browser is not frozen or crashed.").arg(m_client->getDevToolsPort()));
-                }
-
-                QEventLoop loop;
-                QTimer timeout;
-                timeout.setSingleShot(true);
-                timeout.setInterval(timeoutMs);
-                
-                QJsonObject result;
-                QString error;
-                bool completed = false;
-                
-                connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
-                
-                command(m_client, [&](const QJsonObject& cdpResult, const QString& cdpError) {
-                    result = cdpResult;
-                    error = cdpError;
-                    completed = true;
-                    loop.quit();
-                });
-                
-                timeout.start();
-                loop.exec();
-                
-                if (!completed) {
-                    QString connectionStatus = m_client->isConnected() ? "connected" : "disconnected";
-                    auto connectionState = m_client->getConnectionState();
-                    QString stateStr = (connectionState == CDPClient::ConnectionState::Connected) ? "Connected" :
-                                      (connectionState == CDPClient::ConnectionState::Connecting) ? "Connecting" :
-                                      (connectionState == CDPClient::ConnectionState::NotConnected) ? "NotConnected" : "Unknown";
-
-                    debugLog(QString("Command timeout - connection: %1, state: %2, retry: %3/%4")
-                            .arg(connectionStatus).arg(stateStr).arg(retry).arg(maxRetries));
-
-                    // Terminate long-running JavaScript to prevent CDP connection poisoning
-                    if (m_client->isConnected()) {
-                        debugLog("Terminating long-running JavaScript execution to prevent CDP deadlock...");
-                        m_client->terminateExecution([](const QJsonObject& result, const QString& error) {
-                            if (error.isEmpty()) {
-                                debugLog("JavaScript execution terminated successfully");
-                            } else {
-                                debugLog(QString("Termination failed (non-fatal): %1").arg(error));
-                            }
-                        });
-                        QThread::msleep(200);
-
-                        // Test if browser is responsive after termination
-                        debugLog("Testing browser responsiveness...");
-                        bool browserResponsive = false;
-                        QEventLoop testLoop;
-                        QTimer testTimeout;
-                        testTimeout.setSingleShot(true);
-                        testTimeout.setInterval(500);  // Quick 500ms test
-
-                        m_client->evaluateJavaScript("1+1", [&](const QJsonObject& result, const QString& error) {
-                            if (error.isEmpty() && !result.isEmpty()) {
-                                browserResponsive = true;
-                                debugLog("Browser is responsive after termination");
-                            }
-                            testLoop.quit();
-                        });
-
-                        connect(&testTimeout, &QTimer::timeout, &testLoop, &QEventLoop::quit);
-                        testTimeout.start();
-                        testLoop.exec();
-
-                        // If browser is still frozen, force a hard refresh to recover
-                        if (!browserResponsive) {
-                            debugLog("Browser is frozen - triggering automatic hard refresh for recovery...");
-
-                            // Try hard refresh (fire-and-forget, may not work if browser is frozen)
-                            m_client->evaluateJavaScript("window.tau5 && window.tau5.hardRefresh ? window.tau5.hardRefresh() : null",
-                                [](const QJsonObject&, const QString&) {
-                                    debugLog("Hard refresh triggered");
-                                });
-
-                            QThread::msleep(500);
-
-                            return createErrorResult(QString("CDP command timed out after %1ms and browser became unresponsive. "
-                                "Attempted automatic recovery via hard refresh. The page should reload and become responsive again. "
-                                "Note: Page state has been reset.").arg(timeoutMs));
-                        }
-                    }
-
-                    // Check if this is a connection issue
-                    if (!m_client->isConnected() && retry < maxRetries) {
-                        debugLog("Connection lost, retrying command...");
-                        QThread::msleep(1000);
-                        continue;
-                    }
-
-                    // Provide detailed timeout error message
-                    QString timeoutMsg = QString("CDP command timed out after %1ms. Connection state: %2 (%3). ")
-                                        .arg(timeoutMs).arg(stateStr).arg(connectionStatus);
-
-                    if (m_client->isConnected()) {
-                        timeoutMsg += "Successfully terminated execution and browser is responsive. ";
-                        timeoutMsg += "You can continue using Spectra normally.";
-                    } else {
-                        timeoutMsg += QString("DevTools disconnected. Ensure Tau5 is running with --devtools on port %1. ")
-                                     .arg(m_client->getDevToolsPort());
-                        timeoutMsg += "Restart Spectra to reconnect.";
-                    }
-
-                    return createErrorResult(timeoutMsg);
-                }
-                
-                if (!error.isEmpty()) {
-                    // Check if this is a connection-related error and we can retry
-                    if ((error.contains("Not connected") || error.contains("Connection lost")) && retry < maxRetries) {
-                        debugLog(QString("Connection error, retrying command: %1").arg(error));
-                        QThread::msleep(1000);
-                        continue;
-                    }
-                    debugLog(QString("Command error: %1").arg(error));
-                    return createErrorResult(error);
-                }
-                
-                return result;
-            } catch (const std::exception& e) {
-                if (retry < maxRetries) {
-                    debugLog(QString("Exception caught, retrying: %1").arg(e.what()));
-                    QThread::msleep(1000);
-                    continue;
-                }
-                return createErrorResult(QString("Exception: %1").arg(e.what()));
-            } catch (...) {
-                if (retry < maxRetries) {
-                    debugLog("Unknown exception caught, retrying...");
-                    QThread::msleep(1000);
-                    continue;
-                }
-                return createErrorResult("Unknown exception occurred");
-            }
-        }
-        
-        return createErrorResult("Failed after all retries");
+        return executeCommandAsync(m_server ? m_server->currentToolCall() : MCPServerStdio::ToolCall(),
+                                   std::move(command), timeoutMs, std::move(done));
     }
 
-    // Overload with custom timeout parameter
-    QJsonObject executeCommand(std::function<void(CDPClient*, CDPClient::ResponseCallback)> command, int timeoutMs)
+    // As above for a command issued once the handler has returned, e.g.
+    // from the callback of an earlier one, taking the target from call
+    std::function<void()> executeCommandAsync(const MCPServerStdio::ToolCall& call,
+                                              std::function<void(CDPClient*, CDPClient::ResponseCallback)> command,
+                                              int timeoutMs,
+                                              std::function<void(const QJsonObject&)> done)
     {
-        const int maxRetries = 0;  // No retries - fail fast to keep MCP connection responsive
-
-        for (int retry = 0; retry <= maxRetries; retry++) {
-            try {
-                if (retry > 0) {
-                    debugLog(QString("Attempting command retry %1/%2").arg(retry).arg(maxRetries));
-                }
-
-                if (!ensureConnected()) {
-                    debugLog(QString("CDP connection failed after retries - port: %1").arg(m_client->getDevToolsPort()));
-                    return createErrorResult(QString("Chrome DevTools not responding after multiple connection attempts. Make sure Tau5 is running in dev mode with --devtools (port %1). Check that the browser is not frozen or crashed.").arg(m_client->getDevToolsPort()));
-                }
-
-                QEventLoop loop;
-                QTimer timeout;
-                timeout.setSingleShot(true);
-                timeout.setInterval(timeoutMs);  // Use custom timeout
-
-                QJsonObject result;
-                QString error;
-                bool completed = false;
-
-                connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
-
-                command(m_client, [&](const QJsonObject& cdpResult, const QString& cdpError) {
-                    result = cdpResult;
-                    error = cdpError;
-                    completed = true;
-                    loop.quit();
-                });
-
-                timeout.start();
-                loop.exec();
-
-                if (!completed) {
-                    QString connectionStatus = m_client->isConnected() ? "connected" : "disconnected";
-                    auto connectionState = m_client->getConnectionState();
-                    QString stateStr = (connectionState == CDPClient::ConnectionState::Connected) ? "Connected" :
-                                      (connectionState == CDPClient::ConnectionState::Connecting) ? "Connecting" :
-                                      (connectionState == CDPClient::ConnectionState::NotConnected) ? "NotConnected" : "Unknown";
-
-                    debugLog(QString("Command timeout - connection: %1, state: %2, retry: %3/%4")
-                            .arg(connectionStatus).arg(stateStr).arg(retry).arg(maxRetries));
-
-                    // Terminate long-running JavaScript to prevent CDP connection poisoning
-                    if (m_client->isConnected()) {
-                        debugLog("Terminating long-running JavaScript execution to prevent CDP deadlock...");
-                        m_client->terminateExecution([](const QJsonObject& result, const QString& error) {
-                            if (error.isEmpty()) {
-                                debugLog("JavaScript execution terminated successfully");
-                            } else {
-                                debugLog(QString("Termination failed (non-fatal): %1").arg(error));
-                            }
-                        });
-                        QThread::msleep(200);
-
-                        // Test if browser is responsive after termination
-                        debugLog("Testing browser responsiveness...");
-                        bool browserResponsive = false;
-                        QEventLoop testLoop;
-                        QTimer testTimeout;
-                        testTimeout.setSingleShot(true);
-                        testTimeout.setInterval(500);  // Quick 500ms test
-
-                        m_client->evaluateJavaScript("1+1", [&](const QJsonObject& result, const QString& error) {
-                            if (error.isEmpty() && !result.isEmpty()) {
-                                browserResponsive = true;
-                                debugLog("Browser is responsive after termination");
-                            }
-                            testLoop.quit();
-                        });
-
-                        connect(&testTimeout, &QTimer::timeout, &testLoop, &QEventLoop::quit);
-                        testTimeout.start();
-                        testLoop.exec();
-
-                        // If browser is still frozen, force a hard refresh to recover
-                        if (!browserResponsive) {
-                            debugLog("Browser is frozen - triggering automatic hard refresh for recovery...");
-
-                            // Try hard refresh (fire-and-forget, may not work if browser is frozen)
-                            m_client->evaluateJavaScript("window.tau5 && window.tau5.hardRefresh ? window.tau5.hardRefresh() : null",
-                                [](const QJsonObject&, const QString&) {
-                                    debugLog("Hard refresh triggered");
-                                });
-
-                            QThread::msleep(500);
-
-                            return createErrorResult(QString("CDP command timed out after %1ms and browser became unresponsive. "
-                                "Attempted automatic recovery via hard refresh. The page should reload and become responsive again. "
-                                "Note: Page state has been reset.").arg(timeoutMs));
-                        }
-                    }
-
-                    // Check if this is a connection issue
-                    if (!m_client->isConnected() && retry < maxRetries) {
-                        debugLog("Connection lost, retrying command...");
-                        QThread::msleep(1000);
-                        continue;
-                    }
-
-                    // Provide detailed timeout error message
-                    QString timeoutMsg = QString("CDP command timed out after %1ms. Connection state: %2 (%3). ")
-                                        .arg(timeoutMs).arg(stateStr).arg(connectionStatus);
+        if (!ensureConnected()) {
+            debugLog(QString("CDP connection failed after retries - port: %1").arg(m_client->getDevToolsPort()));
+            done(createErrorResult(QString("Chrome DevTools not responding after multiple connection attempts. Make sure Tau5 is running in dev mode with --devtools (port %1). Check that the browser is not frozen or crashed.").arg(m_client->getDevToolsPort())));
+            return []() {};
+        }
 
-                    if (m_client->isConnected()) {
-                        timeoutMsg += "Successfully terminated execution and browser is responsive. ";
-                        timeoutMsg += "You can continue using Spectra normally.";
-                    } else {
-                        timeoutMsg += QString("DevTools disconnected. Ensure Tau5 is running with --devtools on port %1. ")
-                                     .arg(m_client->getDevToolsPort());
-                        timeoutMsg += "Restart Spectra to reconnect.";
-                    }
+        struct Pending {
+            bool finished = false;
+            QList<int> commandIds;
+            QTimer* timeout = nullptr;
+            std::function<void(const QJsonObject&)> done;
+        };
+        auto pending = std::make_shared<Pending>();
+        pending->done = std::move(done);
+        pending->timeout = new QTimer(this);
+        pending->timeout->setSingleShot(true);
 
-                    return createErrorResult(timeoutMsg);
-                }
+        auto complete = [pending](const QJsonObject& result) {
+            if (pending->finished) {
+                return;
+            }
+            pending->finished = true;
+            pending->timeout->deleteLater();
+            std::function<void(const QJsonObject&)> done = std::move(pending->done);
+            done(result);
+        };
 
-                if (!error.isEmpty()) {
-                    // Check if this is a connection-related error and we can retry
-                    if ((error.contains("Not connected") || error.contains("Connection lost")) && retry < maxRetries) {
-                        debugLog(QString("Connection error, retrying command: %1").arg(error));
-                        QThread::msleep(1000);
-                        continue;
+        QString target = call.arguments().value("target").toString();
+        pending->commandIds = m_client->trackCommands([this, &command, &target, complete]() {
+            auto issue = [this, &command, complete]() {
+                command(m_client, [this, complete](const QJsonObject& cdpResult, const QString& cdpError) {
+                    if (!cdpError.isEmpty()) {
+                        debugLog(QString("Command error: %1").arg(cdpError));
+                        complete(createErrorResult(cdpError));
+                        return;
                     }
-                    debugLog(QString("Command error: %1").arg(error));
-                    return createErrorResult(error);
-                }
-
-                return result;
-            } catch (const std::exception& e) {
-                if (retry < maxRetries) {
-                    debugLog(QString("Exception caught, retrying: %1").arg(e.what()));
-                    QThread::msleep(1000);
-                    continue;
-                }
-                return createErrorResult(QString("Exception: %1").arg(e.what()));
-            } catch (...) {
-                if (retry < maxRetries) {
-                    debugLog("Unknown exception caught, retrying...");
-                    QThread::msleep(1000);
-                    continue;
-                }
-                return createErrorResult("Unknown exception occurred");
+                    complete(cdpResult);
+                });
+            };
+            if (target.isEmpty()) {
+                issue();
+            } else if (!m_client->withTarget(target, issue)) {
+                complete(createErrorResult(QString("No attached target matches '%1'. Use spectra_list_targets to see the attached targets.").arg(target)));
             }
+        });
+
+        connect(pending->timeout, &QTimer::timeout, this, [this, pending, complete, timeoutMs]() {
+            // Recovery below terminates execution itself
+            m_client->cancelCommands(pending->commandIds, false);
+            recoverFromTimeout(timeoutMs, complete);
+        });
+        if (!pending->finished) {
+            pending->timeout->start(timeoutMs);
         }
 
-        return createErrorResult("Failed after all retries");
+        return [this, pending]() {
+            if (pending->finished) {
+                return;
+            }
+            pending->finished = true;
+            pending->timeout->deleteLater();
+            pending->done = nullptr;
+            m_client->cancelCommands(pending->commandIds);
+        };
     }
 
     QJsonObject formatResponse(const QJsonValue& data, bool returnRawJson = false)
@@ -686,7 +543,88 @@ private:
         };
     }
 
+    // A command timed out: terminate long-running JavaScript to prevent CDP
+    // connection poisoning, probe the page, and hard refresh it if it is
+    // still frozen. done gets the timeout error to report.
+    void recoverFromTimeout(int timeoutMs, std::function<void(const QJsonObject&)> done)
+    {
+        QString connectionStatus = m_client->isConnected() ? "connected" : "disconnected";
+        auto connectionState = m_client->getConnectionState();
+        QString stateStr = (connectionState == CDPClient::ConnectionState::Connected) ? "Connected" :
+                          (connectionState == CDPClient::ConnectionState::Connecting) ? "Connecting" :
+                          (connectionState == CDPClient::ConnectionState::NotConnected) ? "NotConnected" : "Unknown";
+
+        debugLog(QString("Command timeout - connection: %1, state: %2").arg(connectionStatus).arg(stateStr));
+
+        auto timeoutError = [this, timeoutMs, stateStr, connectionStatus]() {
+            QString timeoutMsg = QString("CDP command timed out after %1ms. Connection state: %2 (%3). ")
+                                .arg(timeoutMs).arg(stateStr).arg(connectionStatus);
+
+            if (m_client->isConnected()) {
+                timeoutMsg += "Successfully terminated execution and browser is responsive. ";
+                timeoutMsg += "You can continue using Spectra normally.";
+            } else {
+                timeoutMsg += QString("DevTools disconnected. Ensure Tau5 is running with --devtools on port %1. ")
+                             .arg(m_client->getDevToolsPort());
+                timeoutMsg += "Restart Spectra to reconnect.";
+            }
+            return createErrorResult(timeoutMsg);
+        };
+
+        if (!m_client->isConnected()) {
+            done(timeoutError());
+            return;
+        }
+
+        debugLog("Terminating long-running JavaScript execution to prevent CDP deadlock...");
+        m_client->terminateExecution([](const QJsonObject&, const QString& error) {
+            if (error.isEmpty()) {
+                debugLog("JavaScript execution terminated successfully");
+            } else {
+                debugLog(QString("Termination failed (non-fatal): %1").arg(error));
+            }
+        });
+
+        QTimer::singleShot(200, this, [this, timeoutMs, timeoutError, done]() {
+            debugLog("Testing browser responsiveness...");
+            auto answered = std::make_shared<bool>(false);
+            auto probed = [this, answered, timeoutMs, timeoutError, done](bool responsive) {
+                if (*answered) {
+                    return;
+                }
+                *answered = true;
+
+                if (responsive) {
+                    done(timeoutError());
+                    return;
+                }
+
+                // Still frozen: force a hard refresh to recover (fire-and-forget,
+                // may not work if the browser is frozen)
+                debugLog("Browser is frozen - triggering automatic hard refresh for recovery...");
+                m_client->evaluateJavaScript("window.tau5 && window.tau5.hardRefresh ? window.tau5.hardRefresh() : null",
+                    [](const QJsonObject&, const QString&) {
+                        debugLog("Hard refresh triggered");
+                    });
+
+                done(createErrorResult(QString("CDP command timed out after %1ms and browser became unresponsive. "
+                    "Attempted automatic recovery via hard refresh. The page should reload and become responsive again. "
+                    "Note: Page state has been reset.").arg(timeoutMs)));
+            };
+
+            m_client->evaluateJavaScript("1+1", [probed](const QJsonObject& result, const QString& error) {
+                bool responsive = error.isEmpty() && !result.isEmpty();
+                if (responsive) {
+                    debugLog("Browser is responsive after termination");
+                }
+                probed(responsive);
+            });
+            QTimer::singleShot(500, this, [probed]() { probed(false); });  // Quick 500ms test
+        });
+    }
+
     CDPClient* m_client;
+    MCPServerStdio* m_server;
     QTimer* m_reconnectionTimer;
 };
 
@@ -701,6 +639,8 @@ int main(int argc, char *argv[])
     int channel = 0; // Default channel
     quint16 devToolsPort = 0; // 0 means not explicitly set
     bool debugMode = false;
+    qint64 maxMessageBytes = 0; // 0 means use the framer's default
+    CDPClient::HistoryLimits historyLimits;
 
     for (int i = 1; i < argc; i++) {
         QString arg = QString::fromUtf8(argv[i]);
@@ -714,6 +654,31 @@ int main(int argc, char *argv[])
             devToolsPort = QString::fromUtf8(argv[++i]).toUInt();
         } else if (arg == "--debug") {
             debugMode = true;
+        } else if (arg == "--max-message-mb" && i + 1 < argc) {
+            int megabytes = QString::fromUtf8(argv[++i]).toInt();
+            if (megabytes <= 0) {
+                std::cerr << "Error: --max-message-mb must be a positive number\n";
+                return 1;
+            }
+            maxMessageBytes = static_cast<qint64>(megabytes) * 1024 * 1024;
+        } else if ((arg == "--console-history" || arg == "--network-history" || arg == "--websocket-history" ||
+                    arg == "--exception-history" || arg == "--dom-mutation-history") && i + 1 < argc) {
+            int events = QString::fromUtf8(argv[++i]).toInt();
+            if (events <= 0) {
+                std::cerr << "Error: " << arg.toStdString() << " must be a positive number\n";
+                return 1;
+            }
+            if (arg == "--console-history") {
+                historyLimits.consoleMessages = events;
+            } else if (arg == "--network-history") {
+                historyLimits.networkRequests = events;
+            } else if (arg == "--websocket-history") {
+                historyLimits.webSocketFrames = events;
+            } else if (arg == "--exception-history") {
+                historyLimits.exceptions = events;
+            } else {
+                historyLimits.domMutations = events;
+            }
         } else if (arg == "--help" || arg == "-h") {
             std::cout << "Tau5 Spectra\n\n";
             std::cout << "This server provides MCP (Model Context Protocol) access to Chrome DevTools.\n";
@@ -724,6 +689,13 @@ int main(int argc, char *argv[])
             std::cout << "                          Modifies default port: Chrome=922X\n";
             std::cout << "  --port-chrome-dev <n>   Chrome DevTools port (overrides channel default)\n";
             std::cout << "  --debug                 Enable debug logging to tau5-spectra-debug.log\n";
+            std::cout << "  --max-message-mb <n>    Largest accepted request in MB (default: 32)\n";
+            std::cout << "  --console-history <n>   Console messages to keep (default: 1000)\n";
+            std::cout << "  --network-history <n>   Network requests to keep (default: 500)\n";
+            std::cout << "  --websocket-history <n> WebSocket frames to keep (default: 200)\n";
+            std::cout << "  --exception-history <n> Exceptions to keep (default: 1000)\n";
+            std::cout << "  --dom-mutation-history <n>\n";
+            std::cout << "                          DOM mutations to keep (default: 5000)\n";
             std::cout << "  --help, -h              Show this help message\n\n";
             std::cout << "Configure in Claude Code with:\n";
             std::cout << "  \"mcpServers\": {\n";
@@ -761,11 +733,15 @@ int main(int argc, char *argv[])
         {"tools", QJsonObject{}}
     });
     server.setDebugMode(debugMode);
+    if (maxMessageBytes > 0) {
+        server.setMaxMessageBytes(maxMessageBytes);
+    }
 
     auto cdpClient = std::make_unique<CDPClient>(devToolsPort);
+    cdpClient->setHistoryLimits(historyLimits);
     auto tidewaveProxy = std::make_unique<TidewaveProxy>(tidewavePort);
 
-    CDPBridge bridge(cdpClient.get());
+    CDPBridge bridge(cdpClient.get(), &server);
     TidewaveBridge tidewaveBridge(tidewaveProxy.get());
 
     // Initialize Tidewave proxy
@@ -828,7 +804,7 @@ int main(int argc, char *argv[])
 
     server.registerTool({
         "spectra_list_targets",
-        "List all available Chrome DevTools targets",
+        "List all available Chrome DevTools targets, and the pages, workers and worklets attached over the current connection",
         QJsonObject{
             {"type", "object"},
             {"properties", QJsonObject{}}
@@ -859,17 +835,41 @@ int main(int argc, char *argv[])
                 output += QString("Current target: %1").arg(cdpClient->getCurrentTargetTitle());
             }
 
+            // Any of these can be given as the target of a chromium_devtools_*
+            // tool, by id, type, title or part of its URL
+            QJsonArray attached;
+            const QList<CDPClient::TargetInfo> attachedTargets = cdpClient->attachedTargets();
+            if (!attachedTargets.isEmpty()) {
+                output += "\n\nAttached targets (pass one as \"target\" to chromium_devtools_* tools):\n";
+            }
+            for (const CDPClient::TargetInfo& info : attachedTargets) {
+                output += QString("  - [%1] %2%3\n    id: %4\n")
+                    .arg(info.type)
+                    .arg(info.title.isEmpty() ? info.url : info.title)
+                    .arg(info.primary ? " (current)" : "")
+                    .arg(info.targetId);
+                attached.append(QJsonObject{
+                    {"targetId", info.targetId},
+                    {"sessionId", info.sessionId},
+                    {"type", info.type},
+                    {"title", info.title},
+                    {"url", info.url},
+                    {"primary", info.primary}
+                });
+            }
+
             return QJsonObject{
                 {"type", "text"},
                 {"text", output},
-                {"data", targets}
+                {"data", targets},
+                {"attached", attached}
             };
         }
     });
 
     server.registerTool({
         "spectra_set_target",
-        "Set the Chrome DevTools target by title",
+        "Set the Chrome DevTools target by title. An attached page is switched to without reconnecting",
         QJsonObject{
             {"type", "object"},
             {"properties", QJsonObject{
@@ -936,42 +936,45 @@ int main(int argc, char *argv[])
                 }}
             }}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QString requestId = QUuid::createUuid().toString();
             QElapsedTimer timer;
             timer.start();
 
-            QJsonObject result = bridge.executeCommand([params](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([params](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->getDocument(params, cb);
-            });
-            
-            qint64 duration = timer.elapsed();
+            }, 8000, [&chromiumLogger, call, params, requestId, timer](const QJsonObject& result) {
+                qint64 duration = timer.elapsed();
             
-            if (result.contains("type") && result["type"].toString() == "text") {
-                QString errorText = result["text"].toString();
-                if (errorText.startsWith("Error: ")) {
-                    chromiumLogger.logActivity("chromium_devtools_getDocument", requestId, params, "error", duration, errorText);
-                } else {
-                    QString truncatedResponse = errorText.left(500);
-                    if (errorText.length() > 500) {
-                        truncatedResponse += "... (truncated)";
+                if (result.contains("type") && result["type"].toString() == "text") {
+                    QString errorText = result["text"].toString();
+                    if (errorText.startsWith("Error: ")) {
+                        chromiumLogger.logActivity("chromium_devtools_getDocument", requestId, params, "error", duration, errorText);
+                    } else {
+                        QString truncatedResponse = errorText.left(500);
+                        if (errorText.length() > 500) {
+                            truncatedResponse += "... (truncated)";
+                        }
+                        chromiumLogger.logActivity("chromium_devtools_getDocument", requestId, params, "success", duration, QString(), truncatedResponse);
                     }
-                    chromiumLogger.logActivity("chromium_devtools_getDocument", requestId, params, "success", duration, QString(), truncatedResponse);
+                    call.finish(result);
+                    return;
                 }
-                return result;
-            }
-            QJsonDocument doc(result);
-            QString fullText = QString::fromUtf8(doc.toJson(QJsonDocument::Compact));
-            QString truncatedResponse = fullText.left(500);
-            if (fullText.length() > 500) {
-                truncatedResponse += "... (truncated)";
-            }
-            chromiumLogger.logActivity("chromium_devtools_getDocument", requestId, params, "success", duration, QString(), truncatedResponse);
+                QJsonDocument doc(result);
+                QString fullText = QString::fromUtf8(doc.toJson(QJsonDocument::Compact));
+                QString truncatedResponse = fullText.left(500);
+                if (fullText.length() > 500) {
+                    truncatedResponse += "... (truncated)";
+                }
+                chromiumLogger.logActivity("chromium_devtools_getDocument", requestId, params, "success", duration, QString(), truncatedResponse);
             
-            QJsonObject resultObj;
-            resultObj["type"] = "text";
-            resultObj["text"] = QString::fromUtf8(doc.toJson(QJsonDocument::Indented));
-            return resultObj;
+                QJsonObject resultObj;
+                resultObj["type"] = "text";
+                resultObj["text"] = QString::fromUtf8(doc.toJson(QJsonDocument::Indented));
+                call.finish(resultObj);
+            });
+            call.onCancel(cancel);
         }
     });
     
@@ -988,83 +991,111 @@ int main(int argc, char *argv[])
             }},
             {"required", QJsonArray{"selector"}}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QString requestId = QUuid::createUuid().toString();
             QElapsedTimer timer;
             timer.start();
             
             QString selector = params["selector"].toString();
             
-            QJsonObject result = bridge.executeCommand([selector](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([selector](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->querySelector(selector, cb);
-            });
-            
-            qint64 duration = timer.elapsed();
+            }, 8000, [&chromiumLogger, call, params, requestId, timer, selector](const QJsonObject& result) {
+                qint64 duration = timer.elapsed();
             
-            if (result.contains("type") && result["type"].toString() == "text") {
-                QString errorText = result["text"].toString();
-                chromiumLogger.logActivity("chromium_devtools_querySelector", requestId, params, "error", duration, errorText);
-                return result;
-            }
+                if (result.contains("type") && result["type"].toString() == "text") {
+                    QString errorText = result["text"].toString();
+                    chromiumLogger.logActivity("chromium_devtools_querySelector", requestId, params, "error", duration, errorText);
+                    call.finish(result);
+                    return;
+                }
             
-            int nodeId = result["nodeId"].toInt();
-            if (nodeId == 0) {
-                QString notFoundText = QString("No element found matching selector: %1").arg(selector);
-                chromiumLogger.logActivity("chromium_devtools_querySelector", requestId, params, "not_found", duration, QString(), notFoundText);
-                return QJsonObject{
-                    {"type", "text"},
-                    {"text", notFoundText}
-                };
-            }
+                int nodeId = result["nodeId"].toInt();
+                if (nodeId == 0) {
+                    QString notFoundText = QString("No element found matching selector: %1").arg(selector);
+                    chromiumLogger.logActivity("chromium_devtools_querySelector", requestId, params, "not_found", duration, QString(), notFoundText);
+                    call.finish(QJsonObject{
+                        {"type", "text"},
+                        {"text", notFoundText}
+                    });
+                    return;
+                }
             
-            QString responseText = QString("Found element with nodeId: %1").arg(nodeId);
-            chromiumLogger.logActivity("chromium_devtools_querySelector", requestId, params, "success", duration, QString(), responseText);
+                QString responseText = QString("Found element with nodeId: %1").arg(nodeId);
+                chromiumLogger.logActivity("chromium_devtools_querySelector", requestId, params, "success", duration, QString(), responseText);
             
-            return QJsonObject{
-                {"type", "text"},
-                {"text", responseText}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", responseText}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
     
     server.registerTool({
         "chromium_devtools_getOuterHTML",
-        "Get the outer HTML of a DOM node",
+        "Get the outer HTML of a DOM node, by nodeId or directly by CSS selector",
         QJsonObject{
             {"type", "object"},
             {"properties", QJsonObject{
                 {"nodeId", QJsonObject{
                     {"type", "integer"},
                     {"description", "Node ID from querySelector or getDocument"}
+                }},
+                {"selector", QJsonObject{
+                    {"type", "string"},
+                    {"description", "CSS selector of the element, instead of nodeId; saves a querySelector call"}
                 }}
-            }},
-            {"required", QJsonArray{"nodeId"}}
+            }}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QString requestId = QUuid::createUuid().toString();
             QElapsedTimer timer;
             timer.start();
             
             int nodeId = params["nodeId"].toInt();
+            QString selector = params["selector"].toString();
+            if (nodeId == 0 && selector.isEmpty()) {
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", "Error: Either nodeId or selector is required"}
+                });
+                return;
+            }
             
-            QJsonObject result = bridge.executeCommand([nodeId](CDPClient* client, CDPClient::ResponseCallback cb) {
-                client->getOuterHTML(nodeId, cb);
-            });
-            
-            qint64 duration = timer.elapsed();
+            auto cancel = bridge.executeCommandAsync([nodeId, selector](CDPClient* client, CDPClient::ResponseCallback cb) {
+                if (selector.isEmpty()) {
+                    client->getOuterHTML(nodeId, cb);
+                } else {
+                    client->getOuterHTML(selector, cb);
+                }
+            }, 8000, [&chromiumLogger, call, params, requestId, timer, selector](const QJsonObject& result) {
+                qint64 duration = timer.elapsed();
             
-            if (result.contains("type") && result["type"].toString() == "text") {
-                QString errorText = result["text"].toString();
-                chromiumLogger.logActivity("chromium_devtools_getOuterHTML", requestId, params, "error", duration, errorText);
-                return result;
-            }
+                if (result.contains("type") && result["type"].toString() == "text") {
+                    QString errorText = result["text"].toString();
+                    chromiumLogger.logActivity("chromium_devtools_getOuterHTML", requestId, params, "error", duration, errorText);
+                    call.finish(result);
+                    return;
+                }
             
-            chromiumLogger.logActivity("chromium_devtools_getOuterHTML", requestId, params, "success", duration);
+                // Where a selector's round trips went
+                QStringList steps;
+                for (const QJsonValue& timing : result["timings"].toArray()) {
+                    steps.append(QString("%1 %2ms").arg(timing["method"].toString()).arg(timing["ms"].toInteger()));
+                }
+                chromiumLogger.logActivity("chromium_devtools_getOuterHTML", requestId, params, "success", duration, QString(),
+                                           steps.isEmpty() ? QJsonValue() : QJsonValue(steps.join(", ")));
             
-            return QJsonObject{
-                {"type", "text"},
-                {"text", result["outerHTML"].toString()}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", result["outerHTML"].toString()}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
     
@@ -1085,7 +1116,8 @@ int main(int argc, char *argv[])
             }},
             {"required", QJsonArray{"expression"}}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QString requestId = QUuid::createUuid().toString();
             QElapsedTimer timer;
             timer.start();
@@ -1096,81 +1128,86 @@ int main(int argc, char *argv[])
             int timeoutMs = params.value("timeout_ms").toInt(8000);
             timeoutMs = qBound(1000, timeoutMs, 30000);  // Clamp to 1-30 seconds
 
-            // First try with object references to avoid serialization issues
-            QJsonObject result = bridge.executeCommand([expression](CDPClient* client, CDPClient::ResponseCallback cb) {
+            // Runs without blocking other requests; cancelling the call
+            // terminates the script. Object references avoid serialization issues.
+            auto cancel = bridge.executeCommandAsync([expression](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->evaluateJavaScriptWithObjectReferences(expression, cb);
-            }, timeoutMs);
+            }, timeoutMs, [&chromiumLogger, call, params, requestId, timer](const QJsonObject& result) {
+                qint64 duration = timer.elapsed();
             
-            qint64 duration = timer.elapsed();
-            
-            if (result.contains("type") && result["type"].toString() == "text") {
-                QString errorText = result["text"].toString();
-                chromiumLogger.logActivity("chromium_devtools_evaluateJavaScript", requestId, params, "error", duration, errorText);
-                return result;
-            }
+                if (result.contains("type") && result["type"].toString() == "text") {
+                    QString errorText = result["text"].toString();
+                    chromiumLogger.logActivity("chromium_devtools_evaluateJavaScript", requestId, params, "error", duration, errorText);
+                    call.finish(result);
+                    return;
+                }
             
-            if (result.contains("exceptionDetails")) {
-                QJsonObject exception = result["exceptionDetails"].toObject();
-                QString errorText = exception["text"].toString();
-                chromiumLogger.logActivity("chromium_devtools_evaluateJavaScript", requestId, params, "exception", duration, errorText);
-                return QJsonObject{
-                    {"type", "text"},
-                    {"text", QString("JavaScript exception: %1").arg(errorText)}
-                };
-            }
+                if (result.contains("exceptionDetails")) {
+                    QJsonObject exception = result["exceptionDetails"].toObject();
+                    QString errorText = exception["text"].toString();
+                    chromiumLogger.logActivity("chromium_devtools_evaluateJavaScript", requestId, params, "exception", duration, errorText);
+                    call.finish(QJsonObject{
+                        {"type", "text"},
+                        {"text", QString("JavaScript exception: %1").arg(errorText)}
+                    });
+                    return;
+                }
             
-            QJsonObject resultObj = result["result"].toObject();
+                QJsonObject resultObj = result["result"].toObject();
             
-            // Check if we got an object reference instead of a value
-            if (resultObj.contains("objectId") && !resultObj.contains("value")) {
-                QString objectId = resultObj["objectId"].toString();
-                QString className = resultObj["className"].toString();
-                QString subtype = resultObj["subtype"].toString();
-                QString type = resultObj["type"].toString();
-                QString description = resultObj["description"].toString();
+                // Check if we got an object reference instead of a value
+                if (resultObj.contains("objectId") && !resultObj.contains("value")) {
+                    QString objectId = resultObj["objectId"].toString();
+                    QString className = resultObj["className"].toString();
+                    QString subtype = resultObj["subtype"].toString();
+                    QString type = resultObj["type"].toString();
+                    QString description = resultObj["description"].toString();
                 
-                QJsonObject objRef;
-                objRef["type"] = "object_reference";
-                objRef["objectId"] = objectId;
-                objRef["className"] = className;
-                objRef["objectType"] = type;
-                objRef["subtype"] = subtype;
-                objRef["description"] = description;
+                    QJsonObject objRef;
+                    objRef["type"] = "object_reference";
+                    objRef["objectId"] = objectId;
+                    objRef["className"] = className;
+                    objRef["objectType"] = type;
+                    objRef["subtype"] = subtype;
+                    objRef["description"] = description;
                 
-                // Return as JSON for complex objects
-                QJsonDocument doc(objRef);
-                QJsonObject responseObj;
-                responseObj["type"] = "text";
-                responseObj["text"] = QString::fromUtf8(doc.toJson(QJsonDocument::Indented));
-                chromiumLogger.logActivity("chromium_devtools_evaluateJavaScript", requestId, params, "success", duration, QString(), objRef);
-                return responseObj;
-            }
+                    // Return as JSON for complex objects
+                    QJsonDocument doc(objRef);
+                    QJsonObject responseObj;
+                    responseObj["type"] = "text";
+                    responseObj["text"] = QString::fromUtf8(doc.toJson(QJsonDocument::Indented));
+                    chromiumLogger.logActivity("chromium_devtools_evaluateJavaScript", requestId, params, "success", duration, QString(), objRef);
+                    call.finish(responseObj);
+                    return;
+                }
             
-            // Handle regular values (primitives)
-            QJsonValue value = resultObj["value"];
-            
-            QString resultText;
-            if (value.isString()) {
-                resultText = value.toString();
-            } else if (value.isDouble()) {
-                resultText = QString::number(value.toDouble());
-            } else if (value.isBool()) {
-                resultText = value.toBool() ? "true" : "false";
-            } else if (value.isObject() || value.isArray()) {
-                QJsonDocument doc(value.isArray() ? QJsonDocument(value.toArray()) : QJsonDocument(value.toObject()));
-                resultText = doc.toJson(QJsonDocument::Indented);
-            } else if (value.isNull()) {
-                resultText = "null";
-            } else {
-                resultText = "undefined";
-            }
+                // Handle regular values (primitives)
+                QJsonValue value = resultObj["value"];
             
-            chromiumLogger.logActivity("chromium_devtools_evaluateJavaScript", requestId, params, "success", duration, QString(), resultText);
+                QString resultText;
+                if (value.isString()) {
+                    resultText = value.toString();
+                } else if (value.isDouble()) {
+                    resultText = QString::number(value.toDouble());
+                } else if (value.isBool()) {
+                    resultText = value.toBool() ? "true" : "false";
+                } else if (value.isObject() || value.isArray()) {
+                    QJsonDocument doc(value.isArray() ? QJsonDocument(value.toArray()) : QJsonDocument(value.toObject()));
+                    resultText = doc.toJson(QJsonDocument::Indented);
+                } else if (value.isNull()) {
+                    resultText = "null";
+                } else {
+                    resultText = "undefined";
+                }
             
-            return QJsonObject{
-                {"type", "text"},
-                {"text", resultText}
-            };
+                chromiumLogger.logActivity("chromium_devtools_evaluateJavaScript", requestId, params, "success", duration, QString(), resultText);
+            
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", resultText}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -1182,7 +1219,8 @@ int main(int argc, char *argv[])
             {"properties", QJsonObject{}},
             {"required", QJsonArray{}}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QString requestId = QUuid::createUuid().toString();
             QElapsedTimer timer;
             timer.start();
@@ -1190,36 +1228,39 @@ int main(int argc, char *argv[])
             // Execute the hard refresh via JavaScript
             QString jsExpression = "window.tau5 && window.tau5.hardRefresh ? window.tau5.hardRefresh() : 'tau5.hardRefresh() not available (dev mode only)'";
 
-            QJsonObject result = bridge.executeCommand([jsExpression](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([jsExpression](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->evaluateJavaScript(jsExpression, cb);
-            });
-
-            qint64 duration = timer.elapsed();
-
-            if (result.contains("type") && result["type"].toString() == "text") {
-                QString resultText = result["text"].toString();
+            }, 8000, [&chromiumLogger, call, params, requestId, timer](const QJsonObject& result) {
+                qint64 duration = timer.elapsed();
+
+                if (result.contains("type") && result["type"].toString() == "text") {
+                    QString resultText = result["text"].toString();
+
+                    // Check if it's an error message about dev mode
+                    if (resultText.contains("not available")) {
+                        chromiumLogger.logActivity("chromium_devtools_hardRefresh", requestId, params, "error", duration, resultText);
+                        call.finish(QJsonObject{
+                            {"type", "text"},
+                            {"text", resultText}
+                        });
+                        return;
+                    }
 
-                // Check if it's an error message about dev mode
-                if (resultText.contains("not available")) {
-                    chromiumLogger.logActivity("chromium_devtools_hardRefresh", requestId, params, "error", duration, resultText);
-                    return QJsonObject{
+                    chromiumLogger.logActivity("chromium_devtools_hardRefresh", requestId, params, "success", duration);
+                    call.finish(QJsonObject{
                         {"type", "text"},
-                        {"text", resultText}
-                    };
+                        {"text", "Hard refresh initiated"}
+                    });
+                    return;
                 }
 
-                chromiumLogger.logActivity("chromium_devtools_hardRefresh", requestId, params, "success", duration);
-                return QJsonObject{
+                chromiumLogger.logActivity("chromium_devtools_hardRefresh", requestId, params, "error", duration, "Unexpected response");
+                call.finish(QJsonObject{
                     {"type", "text"},
-                    {"text", "Hard refresh initiated"}
-                };
-            }
-
-            chromiumLogger.logActivity("chromium_devtools_hardRefresh", requestId, params, "error", duration, "Unexpected response");
-            return QJsonObject{
-                {"type", "text"},
-                {"text", "Failed to execute hard refresh"}
-            };
+                    {"text", "Failed to execute hard refresh"}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -1231,35 +1272,39 @@ int main(int argc, char *argv[])
             {"properties", QJsonObject{}},
             {"required", QJsonArray{}}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QString requestId = QUuid::createUuid().toString();
             QElapsedTimer timer;
             timer.start();
 
-            QJsonObject result = bridge.executeCommand([](CDPClient* client, CDPClient::ResponseCallback cb) {
+            // 2 second timeout for this operation
+            auto cancel = bridge.executeCommandAsync([](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->terminateExecution(cb);
-            }, 2000);  // 2 second timeout for this operation
-
-            qint64 duration = timer.elapsed();
-
-            if (result.contains("type") && result["type"].toString() == "text") {
-                QString resultText = result["text"].toString();
-
-                // Check if it's an error
-                if (resultText.contains("error") || resultText.contains("timeout") || resultText.contains("failed")) {
-                    chromiumLogger.logActivity("chromium_devtools_terminateExecution", requestId, params, "error", duration, resultText);
-                    return QJsonObject{
-                        {"type", "text"},
-                        {"text", QString("Failed to terminate execution: %1").arg(resultText)}
-                    };
+            }, 2000, [&chromiumLogger, call, params, requestId, timer](const QJsonObject& result) {
+                qint64 duration = timer.elapsed();
+
+                if (result.contains("type") && result["type"].toString() == "text") {
+                    QString resultText = result["text"].toString();
+
+                    // Check if it's an error
+                    if (resultText.contains("error") || resultText.contains("timeout") || resultText.contains("failed")) {
+                        chromiumLogger.logActivity("chromium_devtools_terminateExecution", requestId, params, "error", duration, resultText);
+                        call.finish(QJsonObject{
+                            {"type", "text"},
+                            {"text", QString("Failed to terminate execution: %1").arg(resultText)}
+                        });
+                        return;
+                    }
                 }
-            }
 
-            chromiumLogger.logActivity("chromium_devtools_terminateExecution", requestId, params, "success", duration);
-            return QJsonObject{
-                {"type", "text"},
-                {"text", "JavaScript execution terminated successfully. The page should be responsive again."}
-            };
+                chromiumLogger.logActivity("chromium_devtools_terminateExecution", requestId, params, "success", duration);
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", "JavaScript execution terminated successfully. The page should be responsive again."}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -1319,23 +1364,26 @@ int main(int argc, char *argv[])
             }},
             {"required", QJsonArray{"nodeId", "name", "value"}}
         },
-        [&bridge](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             int nodeId = params["nodeId"].toInt();
             QString name = params["name"].toString();
             QString value = params["value"].toString();
             
-            QJsonObject result = bridge.executeCommand([nodeId, name, value](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([nodeId, name, value](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->setAttributeValue(nodeId, name, value, cb);
-            });
-            
-            if (result.contains("type") && result["type"].toString() == "text") {
-                return result;
-            }
+            }, 8000, [call, nodeId, name, value](const QJsonObject& result) {
+                if (result.contains("type") && result["type"].toString() == "text") {
+                    call.finish(result);
+                    return;
+                }
             
-            return QJsonObject{
-                {"type", "text"},
-                {"text", QString("Set attribute '%1' = '%2' on node %3").arg(name, value).arg(nodeId)}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", QString("Set attribute '%1' = '%2' on node %3").arg(name, value).arg(nodeId)}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
     
@@ -1356,22 +1404,25 @@ int main(int argc, char *argv[])
             }},
             {"required", QJsonArray{"nodeId", "name"}}
         },
-        [&bridge](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             int nodeId = params["nodeId"].toInt();
             QString name = params["name"].toString();
             
-            QJsonObject result = bridge.executeCommand([nodeId, name](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([nodeId, name](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->removeAttribute(nodeId, name, cb);
-            });
-            
-            if (result.contains("type") && result["type"].toString() == "text") {
-                return result;
-            }
+            }, 8000, [call, nodeId, name](const QJsonObject& result) {
+                if (result.contains("type") && result["type"].toString() == "text") {
+                    call.finish(result);
+                    return;
+                }
             
-            return QJsonObject{
-                {"type", "text"},
-                {"text", QString("Removed attribute '%1' from node %2").arg(name).arg(nodeId)}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", QString("Removed attribute '%1' from node %2").arg(name).arg(nodeId)}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
     
@@ -1388,32 +1439,35 @@ int main(int argc, char *argv[])
             }},
             {"required", QJsonArray{"url"}}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QElapsedTimer timer;
             timer.start();
             QString requestId = QUuid::createUuid().toString();
 
             QString url = params["url"].toString();
 
-            QJsonObject result = bridge.executeCommand([url](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([url](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->navigateTo(url, cb);
-            });
-
-            qint64 duration = timer.elapsed();
-
-            if (result.contains("type") && result["type"].toString() == "text") {
-                QString errorText = result["text"].toString();
-                chromiumLogger.logActivity("chromium_devtools_navigate", requestId, params, "error", duration, errorText);
-                return result;
-            }
+            }, 8000, [&chromiumLogger, call, params, timer, requestId, url](const QJsonObject& result) {
+                qint64 duration = timer.elapsed();
+
+                if (result.contains("type") && result["type"].toString() == "text") {
+                    QString errorText = result["text"].toString();
+                    chromiumLogger.logActivity("chromium_devtools_navigate", requestId, params, "error", duration, errorText);
+                    call.finish(result);
+                    return;
+                }
 
-            QString responseText = QString("Navigated to: %1").arg(url);
-            chromiumLogger.logActivity("chromium_devtools_navigate", requestId, params, "success", duration, QString(), responseText);
+                QString responseText = QString("Navigated to: %1").arg(url);
+                chromiumLogger.logActivity("chromium_devtools_navigate", requestId, params, "success", duration, QString(), responseText);
 
-            return QJsonObject{
-                {"type", "text"},
-                {"text", responseText}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", responseText}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
     
@@ -1439,7 +1493,8 @@ int main(int argc, char *argv[])
             }},
             {"required", QJsonArray{"selector"}}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QElapsedTimer timer;
             timer.start();
             QString requestId = QUuid::createUuid().toString();
@@ -1481,37 +1536,41 @@ int main(int argc, char *argv[])
                 })()
             )").arg(selector.replace("'", "\\'"), propsArrayStr);
             
-            QJsonObject result = bridge.executeCommand([jsExpression](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([jsExpression](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->evaluateJavaScript(jsExpression, cb);
-            });
-            
-            qint64 duration = timer.elapsed();
-
-            if (result.contains("type") && result["type"].toString() == "text") {
-                QString errorText = result["text"].toString();
-                chromiumLogger.logActivity("chromium_devtools_getComputedStyle", requestId, params, "error", duration, errorText);
-                return result;
-            }
-
-            QJsonObject resultObj = result["result"].toObject();
-            QJsonValue value = resultObj["value"];
+            }, 8000, [&bridge, &chromiumLogger, call, params, timer, requestId, rawJson](const QJsonObject& result) {
+                qint64 duration = timer.elapsed();
+
+                if (result.contains("type") && result["type"].toString() == "text") {
+                    QString errorText = result["text"].toString();
+                    chromiumLogger.logActivity("chromium_devtools_getComputedStyle", requestId, params, "error", duration, errorText);
+                    call.finish(result);
+                    return;
+                }
 
-            if (value.isObject() && value.toObject().contains("error")) {
-                QString errorText = value.toObject()["error"].toString();
-                chromiumLogger.logActivity("chromium_devtools_getComputedStyle", requestId, params, "error", duration, errorText);
-                if (rawJson) {
-                    return QJsonObject{{"error", errorText}};
+                QJsonObject resultObj = result["result"].toObject();
+                QJsonValue value = resultObj["value"];
+
+                if (value.isObject() && value.toObject().contains("error")) {
+                    QString errorText = value.toObject()["error"].toString();
+                    chromiumLogger.logActivity("chromium_devtools_getComputedStyle", requestId, params, "error", duration, errorText);
+                    if (rawJson) {
+                        call.finish(QJsonObject{{"error", errorText}});
+                        return;
+                    }
+                    call.finish(QJsonObject{
+                        {"type", "text"},
+                        {"text", errorText}
+                    });
+                    return;
                 }
-                return QJsonObject{
-                    {"type", "text"},
-                    {"text", errorText}
-                };
-            }
 
-            QJsonObject response = bridge.formatResponse(value, rawJson);
-            QString responseText = response.contains("text") ? response["text"].toString().left(500) : "Computed styles retrieved";
-            chromiumLogger.logActivity("chromium_devtools_getComputedStyle", requestId, params, "success", duration, QString(), responseText);
-            return response;
+                QJsonObject response = bridge.formatResponse(value, rawJson);
+                QString responseText = response.contains("text") ? response["text"].toString().left(500) : "Computed styles retrieved";
+                chromiumLogger.logActivity("chromium_devtools_getComputedStyle", requestId, params, "success", duration, QString(), responseText);
+                call.finish(response);
+            });
+            call.onCancel(cancel);
         }
     });
     
@@ -1528,59 +1587,63 @@ int main(int argc, char *argv[])
             }},
             {"required", QJsonArray{"objectId"}}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QString requestId = QUuid::createUuid().toString();
             QElapsedTimer timer;
             timer.start();
             
             QString objectId = params["objectId"].toString();
             
-            QJsonObject result = bridge.executeCommand([objectId](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([objectId](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->getProperties(objectId, cb);
-            });
-            
-            qint64 duration = timer.elapsed();
+            }, 8000, [&chromiumLogger, call, params, requestId, timer](const QJsonObject& result) {
+                qint64 duration = timer.elapsed();
             
-            if (result.contains("type") && result["type"].toString() == "text") {
-                QString errorText = result["text"].toString();
-                chromiumLogger.logActivity("chromium_devtools_getProperties", requestId, params, "error", duration, errorText);
-                return result;
-            }
+                if (result.contains("type") && result["type"].toString() == "text") {
+                    QString errorText = result["text"].toString();
+                    chromiumLogger.logActivity("chromium_devtools_getProperties", requestId, params, "error", duration, errorText);
+                    call.finish(result);
+                    return;
+                }
             
-            if (result.contains("exceptionDetails")) {
-                QJsonObject exception = result["exceptionDetails"].toObject();
-                QString errorText = exception["text"].toString();
-                chromiumLogger.logActivity("chromium_devtools_getProperties", requestId, params, "exception", duration, errorText);
-                return QJsonObject{
-                    {"type", "text"},
-                    {"text", QString("Error: %1").arg(errorText)}
-                };
-            }
+                if (result.contains("exceptionDetails")) {
+                    QJsonObject exception = result["exceptionDetails"].toObject();
+                    QString errorText = exception["text"].toString();
+                    chromiumLogger.logActivity("chromium_devtools_getProperties", requestId, params, "exception", duration, errorText);
+                    call.finish(QJsonObject{
+                        {"type", "text"},
+                        {"text", QString("Error: %1").arg(errorText)}
+                    });
+                    return;
+                }
             
-            // Format the properties for display
-            QJsonArray properties = result["result"].toArray();
-            QJsonObject formattedProps;
+                // Format the properties for display
+                QJsonArray properties = result["result"].toArray();
+                QJsonObject formattedProps;
             
-            for (const auto& prop : properties) {
-                QJsonObject propObj = prop.toObject();
-                QString name = propObj["name"].toString();
-                QJsonObject value = propObj["value"].toObject();
+                for (const auto& prop : properties) {
+                    QJsonObject propObj = prop.toObject();
+                    QString name = propObj["name"].toString();
+                    QJsonObject value = propObj["value"].toObject();
                 
-                QJsonObject propInfo;
-                propInfo["type"] = value["type"].toString();
-                propInfo["value"] = value.contains("value") ? value["value"] : QJsonValue();
-                propInfo["description"] = value["description"].toString();
-                propInfo["className"] = value["className"].toString();
-                formattedProps[name] = propInfo;
-            }
+                    QJsonObject propInfo;
+                    propInfo["type"] = value["type"].toString();
+                    propInfo["value"] = value.contains("value") ? value["value"] : QJsonValue();
+                    propInfo["description"] = value["description"].toString();
+                    propInfo["className"] = value["className"].toString();
+                    formattedProps[name] = propInfo;
+                }
             
-            chromiumLogger.logActivity("chromium_devtools_getProperties", requestId, params, "success", duration, QString(), formattedProps);
+                chromiumLogger.logActivity("chromium_devtools_getProperties", requestId, params, "success", duration, QString(), formattedProps);
             
-            QJsonDocument doc(formattedProps);
-            QJsonObject responseObj;
-            responseObj["type"] = "text";
-            responseObj["text"] = QString::fromUtf8(doc.toJson(QJsonDocument::Indented));
-            return responseObj;
+                QJsonDocument doc(formattedProps);
+                QJsonObject responseObj;
+                responseObj["type"] = "text";
+                responseObj["text"] = QString::fromUtf8(doc.toJson(QJsonDocument::Indented));
+                call.finish(responseObj);
+            });
+            call.onCancel(cancel);
         }
     });
     
@@ -1601,68 +1664,73 @@ int main(int argc, char *argv[])
             }},
             {"required", QJsonArray{"objectId", "functionDeclaration"}}
         },
-        [&bridge](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QString objectId = params["objectId"].toString();
             QString functionDecl = params["functionDeclaration"].toString();
             
-            QJsonObject result = bridge.executeCommand([objectId, functionDecl](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([objectId, functionDecl](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->callFunctionOn(objectId, functionDecl, cb);
-            });
-            
-            if (result.contains("type") && result["type"].toString() == "text") {
-                return result;
-            }
+            }, 8000, [call, objectId](const QJsonObject& result) {
+                if (result.contains("type") && result["type"].toString() == "text") {
+                    call.finish(result);
+                    return;
+                }
             
-            if (result.contains("exceptionDetails")) {
-                QJsonObject exception = result["exceptionDetails"].toObject();
-                QString errorText = exception["text"].toString();
-                return QJsonObject{
-                    {"type", "text"},
-                    {"text", QString("Error: %1").arg(errorText)}
-                };
-            }
+                if (result.contains("exceptionDetails")) {
+                    QJsonObject exception = result["exceptionDetails"].toObject();
+                    QString errorText = exception["text"].toString();
+                    call.finish(QJsonObject{
+                        {"type", "text"},
+                        {"text", QString("Error: %1").arg(errorText)}
+                    });
+                    return;
+                }
             
-            // Handle the result
-            QJsonObject resultObj = result["result"].toObject();
+                // Handle the result
+                QJsonObject resultObj = result["result"].toObject();
             
-            // Check if we got another object reference
-            if (resultObj.contains("objectId") && !resultObj.contains("value")) {
-                QJsonObject objRef;
-                objRef["type"] = "object_reference";
-                objRef["objectId"] = resultObj["objectId"].toString();
-                objRef["className"] = resultObj["className"].toString();
-                objRef["description"] = resultObj["description"].toString();
+                // Check if we got another object reference
+                if (resultObj.contains("objectId") && !resultObj.contains("value")) {
+                    QJsonObject objRef;
+                    objRef["type"] = "object_reference";
+                    objRef["objectId"] = resultObj["objectId"].toString();
+                    objRef["className"] = resultObj["className"].toString();
+                    objRef["description"] = resultObj["description"].toString();
                 
-                QJsonDocument doc(objRef);
-                QJsonObject responseObj;
-                responseObj["type"] = "text";
-                responseObj["text"] = QString::fromUtf8(doc.toJson(QJsonDocument::Indented));
-                return responseObj;
-            }
+                    QJsonDocument doc(objRef);
+                    QJsonObject responseObj;
+                    responseObj["type"] = "text";
+                    responseObj["text"] = QString::fromUtf8(doc.toJson(QJsonDocument::Indented));
+                    call.finish(responseObj);
+                    return;
+                }
             
-            // Handle regular values
-            QJsonValue value = resultObj["value"];
-            QString resultText;
-            
-            if (value.isString()) {
-                resultText = value.toString();
-            } else if (value.isDouble()) {
-                resultText = QString::number(value.toDouble());
-            } else if (value.isBool()) {
-                resultText = value.toBool() ? "true" : "false";
-            } else if (value.isObject() || value.isArray()) {
-                QJsonDocument doc(value.isArray() ? QJsonDocument(value.toArray()) : QJsonDocument(value.toObject()));
-                resultText = doc.toJson(QJsonDocument::Indented);
-            } else if (value.isNull()) {
-                resultText = "null";
-            } else {
-                resultText = "undefined";
-            }
+                // Handle regular values
+                QJsonValue value = resultObj["value"];
+                QString resultText;
             
-            return QJsonObject{
-                {"type", "text"},
-                {"text", resultText}
-            };
+                if (value.isString()) {
+                    resultText = value.toString();
+                } else if (value.isDouble()) {
+                    resultText = QString::number(value.toDouble());
+                } else if (value.isBool()) {
+                    resultText = value.toBool() ? "true" : "false";
+                } else if (value.isObject() || value.isArray()) {
+                    QJsonDocument doc(value.isArray() ? QJsonDocument(value.toArray()) : QJsonDocument(value.toObject()));
+                    resultText = doc.toJson(QJsonDocument::Indented);
+                } else if (value.isNull()) {
+                    resultText = "null";
+                } else {
+                    resultText = "undefined";
+                }
+            
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", resultText}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
     
@@ -1679,21 +1747,24 @@ int main(int argc, char *argv[])
             }},
             {"required", QJsonArray{"objectId"}}
         },
-        [&bridge](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QString objectId = params["objectId"].toString();
             
-            QJsonObject result = bridge.executeCommand([objectId](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([objectId](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->releaseObject(objectId, cb);
-            });
-            
-            if (result.contains("type") && result["type"].toString() == "text") {
-                return result;
-            }
+            }, 8000, [call, objectId](const QJsonObject& result) {
+                if (result.contains("type") && result["type"].toString() == "text") {
+                    call.finish(result);
+                    return;
+                }
             
-            return QJsonObject{
-                {"type", "text"},
-                {"text", QString("Released object: %1").arg(objectId)}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", QString("Released object: %1").arg(objectId)}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
     
@@ -1726,7 +1797,8 @@ int main(int argc, char *argv[])
             }},
             {"required", QJsonArray{}}
         },
-        [&bridge](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             bool includeContext = params.contains("includeContext") ? params["includeContext"].toBool() : true;
             int contextLength = params.contains("contextLength") ? params["contextLength"].toInt() : 50;
             bool includeStyles = params.contains("includeStyles") ? params["includeStyles"].toBool() : false;
@@ -1963,97 +2035,109 @@ int main(int argc, char *argv[])
                .arg(includeStyles ? "true" : "false")
                .arg(includeHtml ? "true" : "false");
             
-            QJsonObject result = bridge.executeCommand([jsExpression](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([jsExpression](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->evaluateJavaScript(jsExpression, cb);
-            });
+            }, 8000, [&bridge, call, includeStyles, includeHtml, rawJson](const QJsonObject& result) {
+                if (result.contains("type") && result["type"].toString() == "text") {
+                    call.finish(result);
+                    return;
+                }
             
-            if (result.contains("type") && result["type"].toString() == "text") {
-                return result;
-            }
+                if (result.contains("exceptionDetails")) {
+                    QJsonObject exception = result["exceptionDetails"].toObject();
+                    QString errorText = exception["text"].toString();
+                    call.finish(QJsonObject{
+                        {"type", "text"},
+                        {"text", QString("JavaScript exception: %1").arg(errorText)}
+                    });
+                    return;
+                }
             
-            if (result.contains("exceptionDetails")) {
-                QJsonObject exception = result["exceptionDetails"].toObject();
-                QString errorText = exception["text"].toString();
-                return QJsonObject{
-                    {"type", "text"},
-                    {"text", QString("JavaScript exception: %1").arg(errorText)}
-                };
-            }
+                QJsonObject resultObj = result["result"].toObject();
+                QJsonValue value = resultObj["value"];
             
-            QJsonObject resultObj = result["result"].toObject();
-            QJsonValue value = resultObj["value"];
+                if (!value.isObject()) {
+                    call.finish(QJsonObject{
+                        {"type", "text"},
+                        {"text", "Unexpected result format"}
+                    });
+                    return;
+                }
             
-            if (value.isObject()) {
                 QJsonObject selectionInfo = value.toObject();
                 
                 if (!selectionInfo["hasSelection"].toBool()) {
-                    return QJsonObject{
+                    call.finish(QJsonObject{
                         {"type", "text"},
                         {"text", "No text is currently selected"}
-                    };
+                    });
+                    return;
                 }
                 
-                // If styles or HTML were requested, batch fetch them in a single request
-                if ((includeStyles || includeHtml) && selectionInfo.contains("elementDetails")) {
-                    QJsonArray elementDetails = selectionInfo["elementDetails"].toArray();
-                    
-                    // Build paths array for batch processing
-                    QStringList pathsList;
-                    for (const auto& elem : elementDetails) {
-                        QJsonObject elemObj = elem.toObject();
-                        QString path = elemObj["path"].toString();
-                        if (!path.isEmpty() && !path.endsWith(" > #text")) {
-                            pathsList.append(QString("'%1'").arg(path.replace("'", "\\'").replace("\\", "\\\\")));
-                        } else {
-                            pathsList.append("null");
-                        }
+                if (!(includeStyles || includeHtml) || !selectionInfo.contains("elementDetails")) {
+                    call.finish(bridge.formatResponse(selectionInfo, rawJson));
+                    return;
+                }
+                
+                // Styles and HTML are batch fetched in a single follow-up request
+                QJsonArray elementDetails = selectionInfo["elementDetails"].toArray();
+                
+                // Build paths array for batch processing
+                QStringList pathsList;
+                for (const auto& elem : elementDetails) {
+                    QJsonObject elemObj = elem.toObject();
+                    QString path = elemObj["path"].toString();
+                    if (!path.isEmpty() && !path.endsWith(" > #text")) {
+                        pathsList.append(QString("'%1'").arg(path.replace("'", "\\'").replace("\\", "\\\\")));
+                    } else {
+                        pathsList.append("null");
                     }
-                    
-                    QString batchExpr = QString(R"(
-                        (function() {
-                            const paths = [%1];
-                            const results = [];
+                }
+                
+                QString batchExpr = QString(R"(
+                    (function() {
+                        const paths = [%1];
+                        const results = [];
+                        
+                        for (let i = 0; i < paths.length; i++) {
+                            const path = paths[i];
+                            const result = {};
                             
-                            for (let i = 0; i < paths.length; i++) {
-                                const path = paths[i];
-                                const result = {};
-                                
-                                if (path) {
-                                    const elem = document.querySelector(path);
-                                    if (elem) {
-                                        %2
-                                        %3
-                                    }
+                            if (path) {
+                                const elem = document.querySelector(path);
+                                if (elem) {
+                                    %2
+                                    %3
                                 }
-                                
-                                results.push(result);
                             }
                             
-                            return results;
-                        })()
-                    )").arg(pathsList.join(","))
-                       .arg(includeStyles ? R"(
-                                        const styles = window.getComputedStyle(elem);
-                                        result.styles = {
-                                            display: styles.display,
-                                            position: styles.position,
-                                            color: styles.color,
-                                            backgroundColor: styles.backgroundColor,
-                                            fontSize: styles.fontSize,
-                                            fontWeight: styles.fontWeight,
-                                            fontFamily: styles.fontFamily,
-                                            lineHeight: styles.lineHeight,
-                                            textAlign: styles.textAlign,
-                                            padding: styles.padding,
-                                            margin: styles.margin,
-                                            border: styles.border
-                                        };)" : "")
-                       .arg(includeHtml ? "result.outerHtml = elem.outerHTML;" : "");
-                    
-                    QJsonObject batchResult = bridge.executeCommand([batchExpr](CDPClient* client, CDPClient::ResponseCallback cb) {
-                        client->evaluateJavaScript(batchExpr, cb);
-                    });
-                    
+                            results.push(result);
+                        }
+                        
+                        return results;
+                    })()
+                )").arg(pathsList.join(","))
+                   .arg(includeStyles ? R"(
+                                    const styles = window.getComputedStyle(elem);
+                                    result.styles = {
+                                        display: styles.display,
+                                        position: styles.position,
+                                        color: styles.color,
+                                        backgroundColor: styles.backgroundColor,
+                                        fontSize: styles.fontSize,
+                                        fontWeight: styles.fontWeight,
+                                        fontFamily: styles.fontFamily,
+                                        lineHeight: styles.lineHeight,
+                                        textAlign: styles.textAlign,
+                                        padding: styles.padding,
+                                        margin: styles.margin,
+                                        border: styles.border
+                                    };)" : "")
+                   .arg(includeHtml ? "result.outerHtml = elem.outerHTML;" : "");
+                
+                auto cancelBatch = bridge.executeCommandAsync(call, [batchExpr](CDPClient* client, CDPClient::ResponseCallback cb) {
+                    client->evaluateJavaScript(batchExpr, cb);
+                }, 8000, [&bridge, call, selectionInfo, elementDetails, rawJson](const QJsonObject& batchResult) mutable {
                     if (!batchResult.contains("type") || batchResult["type"].toString() != "text") {
                         QJsonObject resultObj = batchResult["result"].toObject();
                         if (resultObj.contains("value") && resultObj["value"].isArray()) {
@@ -2077,16 +2161,13 @@ int main(int argc, char *argv[])
                             selectionInfo["elementDetails"] = elementDetails;
                         }
                     }
-                }
-                
-                // Return the selection info
-                return bridge.formatResponse(selectionInfo, rawJson);
-            }
-            
-            return QJsonObject{
-                {"type", "text"},
-                {"text", "Unexpected result format"}
-            };
+                    
+                    // Return the selection info
+                    call.finish(bridge.formatResponse(selectionInfo, rawJson));
+                });
+                call.onCancel(cancelBatch);
+            });
+            call.onCancel(cancel);
         }
     });
     
@@ -2122,7 +2203,9 @@ int main(int argc, char *argv[])
                     {"properties", QJsonObject{
                         {"start", QJsonObject{{"type", "integer"}, {"description", "Starting line number (1-based)"}}},
                         {"end", QJsonObject{{"type", "integer"}, {"description", "Ending line number (inclusive)"}}},
-                        {"last", QJsonObject{{"type", "integer"}, {"description", "Last N lines from end"}}}
+                        {"last", QJsonObject{{"type", "integer"}, {"description", "Last N lines from end"}}},
+                        {"since", QJsonObject{{"type", "string"}, {"description", "Only lines logged at or after this local time (ISO 8601, e.g. 2025-01-31T14:05:00)"}}},
+                        {"until", QJsonObject{{"type", "string"}, {"description", "Only lines logged at or before this local time (ISO 8601)"}}}
                     }},
                     {"description", "Line range to search (omit for entire file)"}
                 }},
@@ -2158,26 +2241,28 @@ int main(int argc, char *argv[])
             int maxResults = params.value("maxResults").toInt(100);
             QString format = params.value("format").toString("full");
             
-            // Convert levels array to set for fast lookup
-            QSet<QString> levelFilter;
+            // Convert levels array to a mask over the index's level column
+            quint32 levelMask = 0;
             for (const auto& level : levelsArray) {
                 QString levelStr = level.toString().toUpper();
-                if (levelStr == "WARNING") levelStr = "WARN";
-                levelFilter.insert(QString("[%1]").arg(levelStr));
+                if (levelStr == "DEBUG") levelMask |= Tau5Common::LogIndexReader::levelBit(LogLevel::Debug);
+                else if (levelStr == "INFO") levelMask |= Tau5Common::LogIndexReader::levelBit(LogLevel::Info);
+                else if (levelStr == "WARNING" || levelStr == "WARN") levelMask |= Tau5Common::LogIndexReader::levelBit(LogLevel::Warning);
+                else if (levelStr == "ERROR") levelMask |= Tau5Common::LogIndexReader::levelBit(LogLevel::Error);
+                else if (levelStr == "CRITICAL") levelMask |= Tau5Common::LogIndexReader::levelBit(LogLevel::Critical);
             }
+            bool filterLevels = !levelsArray.isEmpty();
             
-            // Prepare regex if needed
-            QRegularExpression regex;
-            if (isRegex && !pattern.isEmpty()) {
-                QRegularExpression::PatternOptions options = QRegularExpression::NoPatternOption;
-                if (!caseSensitive) options |= QRegularExpression::CaseInsensitiveOption;
-                regex = QRegularExpression(pattern, options);
-                if (!regex.isValid()) {
-                    return QJsonObject{
-                        {"type", "text"},
-                        {"text", QString("Invalid regex pattern: %1").arg(regex.errorString())}
-                    };
-                }
+            // Prepare the byte-level matcher (literal or regex)
+            Qt::CaseSensitivity cs = caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+            Tau5Common::LogSearch search = isRegex
+                ? Tau5Common::LogSearch::regex(pattern, cs)
+                : Tau5Common::LogSearch::literal(pattern, cs);
+            if (!pattern.isEmpty() && !search.isValid()) {
+                return QJsonObject{
+                    {"type", "text"},
+                    {"text", QString("Invalid regex pattern: %1").arg(search.errorString())}
+                };
             }
             
             QString tau5DataPath = Tau5Logger::getTau5DataPath();
@@ -2223,124 +2308,142 @@ int main(int argc, char *argv[])
                 }
             }
             
-            // Process each session
-            QJsonArray jsonResults;
-            QStringList textResults;
+            struct SessionMatch {
+                int lineNum;
+                QString text;
+                QJsonArray before;
+                QJsonArray after;
+            };
+            struct SessionResult {
+                QString sessionName;
+                QString logFilePath;
+                bool opened = false;
+                QVector<SessionMatch> matches;
+            };
             
-            for (int sessionIdx : sessionIndices) {
-                QString sessionName = sessionDirs.at(sessionIdx);
-                QString sessionPath = QDir(tau5LogsPath).absoluteFilePath(sessionName);
-                QString logFilePath = QDir(sessionPath).absoluteFilePath("gui.log");
+            // Searches one session; runs on the global thread pool
+            auto searchSession = [&](int sessionIdx) -> SessionResult {
+                SessionResult result;
+                result.sessionName = sessionDirs.at(sessionIdx);
+                QString sessionPath = QDir(tau5LogsPath).absoluteFilePath(result.sessionName);
+                result.logFilePath = QDir(sessionPath).absoluteFilePath("gui.log");
                 
-                QFile logFile(logFilePath);
-                if (!logFile.exists() || !logFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-                    continue;
+                // Map the log and its sidecar index; only lines we inspect are read
+                Tau5Common::LogIndexReader reader;
+                if (!reader.open(result.logFilePath)) {
+                    return result;
                 }
+                result.opened = true;
                 
-                // Read file into memory with line numbers
-                QTextStream stream(&logFile);
-                QVector<QPair<int, QString>> lines;
-                int lineNum = 1;
-                while (!stream.atEnd()) {
-                    lines.append(qMakePair(lineNum++, stream.readLine()));
-                }
-                logFile.close();
-                
-                // Apply range filter if specified
+                // Resolve the range to [first, last) line indices
+                qint64 totalLines = reader.lineCount();
+                qint64 first = 0;
+                qint64 last = totalLines;
                 if (!range.isEmpty()) {
                     if (range.contains("last")) {
-                        int last = range["last"].toInt();
-                        int start = qMax(0, lines.size() - last);
-                        lines = lines.mid(start);
+                        first = qMax<qint64>(0, totalLines - range["last"].toInt());
                     } else {
-                        int start = range.value("start").toInt(1) - 1;
-                        int end = range.value("end").toInt(lines.size());
-                        start = qMax(0, start);
-                        end = qMin(lines.size(), end);
-                        lines = lines.mid(start, end - start);
+                        first = qMax<qint64>(0, range.value("start").toInt(1) - 1);
+                        last = qMin<qint64>(totalLines, range.value("end").toInteger(totalLines));
+                    }
+                    QDateTime since = QDateTime::fromString(range.value("since").toString(), Qt::ISODate);
+                    if (since.isValid()) {
+                        first = qMax(first, reader.lowerBoundTime(since.toMSecsSinceEpoch()));
+                    }
+                    QDateTime until = QDateTime::fromString(range.value("until").toString(), Qt::ISODate);
+                    if (until.isValid()) {
+                        last = qMin(last, reader.lowerBoundTime(until.toMSecsSinceEpoch() + 1));
                     }
                 }
                 
-                // Search and filter (iterate in reverse for newest-first)
-                QVector<QPair<int, QString>> matches;
-                for (auto it = lines.rbegin(); it != lines.rend(); ++it) {
-                    const auto& [lineNum, line] = *it;
-                    // Check level filter
-                    if (!levelFilter.isEmpty()) {
-                        bool hasLevel = false;
-                        for (const QString& levelTag : levelFilter) {
-                            if (line.contains(levelTag)) {
-                                hasLevel = true;
-                                break;
-                            }
+                // Levels come straight from the index entries, so only the
+                // lines walked before maxResults is reached are checked
+                auto levelMatches = [&reader, levelMask](qint64 i) {
+                    return reader.levelMatches(i, levelMask);
+                };
+                
+                // Matching line indices, newest first
+                QVector<qint64> lineIndices;
+                if (!pattern.isEmpty()) {
+                    std::function<bool(qint64)> lineFilter;
+                    if (filterLevels) {
+                        lineFilter = levelMatches;
+                    }
+                    lineIndices = search.matchingLines(reader, first, last, maxResults, lineFilter);
+                } else {
+                    for (qint64 i = last - 1; i >= first && lineIndices.size() < maxResults; --i) {
+                        if (filterLevels && !levelMatches(i)) {
+                            continue;
                         }
-                        if (!hasLevel) continue;
+                        lineIndices.append(i);
                     }
-
-                    // Check pattern
-                    if (!pattern.isEmpty()) {
-                        bool matched = false;
-                        if (isRegex) {
-                            matched = regex.match(line).hasMatch();
-                        } else {
-                            Qt::CaseSensitivity cs = caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
-                            matched = line.contains(pattern, cs);
+                }
+                
+                for (qint64 matchIdx : lineIndices) {
+                    SessionMatch match;
+                    match.lineNum = static_cast<int>(matchIdx + 1);
+                    match.text = reader.line(matchIdx);
+                    
+                    // Add context if requested (direct index lookups, no rescan)
+                    if (format == "json" && contextLines > 0) {
+                        for (qint64 i = qMax(first, matchIdx - contextLines); i < matchIdx; ++i) {
+                            match.before.append(reader.line(i));
+                        }
+                        for (qint64 i = matchIdx + 1; i < qMin(last, matchIdx + contextLines + 1); ++i) {
+                            match.after.append(reader.line(i));
                         }
-                        if (!matched) continue;
                     }
-
-                    matches.append(qMakePair(lineNum, line));
-                    if (matches.size() >= maxResults) break;
+                    result.matches.append(match);
+                }
+                return result;
+            };
+            
+            // Sessions are independent, so search them in parallel
+            QList<SessionResult> sessionResults;
+            if (sessionIndices.size() > 1) {
+                sessionResults = QtConcurrent::blockingMapped<QList<SessionResult>>(sessionIndices, searchSession);
+            } else {
+                for (int sessionIdx : sessionIndices) {
+                    sessionResults.append(searchSession(sessionIdx));
+                }
+            }
+            
+            // Format results in session order
+            QJsonArray jsonResults;
+            QStringList textResults;
+            
+            for (const SessionResult& result : sessionResults) {
+                if (!result.opened) {
+                    continue;
                 }
                 
-                // Format results
                 if (format == "json") {
                     QJsonObject sessionResult;
-                    sessionResult["session"] = sessionName;
-                    sessionResult["file"] = logFilePath;
+                    sessionResult["session"] = result.sessionName;
+                    sessionResult["file"] = result.logFilePath;
                     QJsonArray matchArray;
-                    for (const auto& [lineNum, line] : matches) {
+                    for (const SessionMatch& sessionMatch : result.matches) {
                         QJsonObject match;
-                        match["line"] = lineNum;
-                        match["text"] = line;
-                        
-                        // Add context if requested
-                        if (contextLines > 0) {
-                            QJsonArray beforeContext, afterContext;
-                            int matchIdx = -1;
-                            for (int i = 0; i < lines.size(); ++i) {
-                                if (lines[i].first == lineNum) {
-                                    matchIdx = i;
-                                    break;
-                                }
-                            }
-                            if (matchIdx >= 0) {
-                                for (int i = qMax(0, matchIdx - contextLines); i < matchIdx; ++i) {
-                                    beforeContext.append(lines[i].second);
-                                }
-                                for (int i = matchIdx + 1; i < qMin(lines.size(), matchIdx + contextLines + 1); ++i) {
-                                    afterContext.append(lines[i].second);
-                                }
-                            }
-                            if (!beforeContext.isEmpty()) match["before"] = beforeContext;
-                            if (!afterContext.isEmpty()) match["after"] = afterContext;
-                        }
+                        match["line"] = sessionMatch.lineNum;
+                        match["text"] = sessionMatch.text;
+                        if (!sessionMatch.before.isEmpty()) match["before"] = sessionMatch.before;
+                        if (!sessionMatch.after.isEmpty()) match["after"] = sessionMatch.after;
                         matchArray.append(match);
                     }
                     sessionResult["matches"] = matchArray;
-                    sessionResult["matchCount"] = matches.size();
+                    sessionResult["matchCount"] = result.matches.size();
                     jsonResults.append(sessionResult);
                 } else {
                     // Text format
-                    if (!matches.isEmpty()) {
+                    if (!result.matches.isEmpty()) {
                         if (format == "full") {
-                            textResults.append(QString("\n=== Session: %1 ===").arg(sessionName));
+                            textResults.append(QString("\n=== Session: %1 ===").arg(result.sessionName));
                         }
-                        for (const auto& [lineNum, line] : matches) {
+                        for (const SessionMatch& sessionMatch : result.matches) {
                             if (format == "full") {
-                                textResults.append(QString("[%1] %2").arg(lineNum, 6).arg(line));
+                                textResults.append(QString("[%1] %2").arg(sessionMatch.lineNum, 6).arg(sessionMatch.text));
                             } else {
-                                textResults.append(line);
+                                textResults.append(sessionMatch.text);
                             }
                         }
                     }
@@ -2417,16 +2520,11 @@ int main(int argc, char *argv[])
                     sessionInfo["size"] = fileInfo.size();
                     sessionInfo["modified"] = fileInfo.lastModified().toString(Qt::ISODate);
                     
-                    // Count lines
-                    if (logFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-                        int lines = 0;
-                        QTextStream stream(&logFile);
-                        while (!stream.atEnd()) {
-                            stream.readLine();
-                            lines++;
-                        }
-                        logFile.close();
-                        sessionInfo["lines"] = lines;
+                    // Line count comes straight from the sidecar index when present
+                    Tau5Common::LogIndexReader reader;
+                    if (reader.open(logFilePath)) {
+                        sessionInfo["lines"] = reader.lineCount();
+                        sessionInfo["indexed"] = reader.usedSidecar();
                     }
                 }
                 
@@ -2496,26 +2594,20 @@ int main(int argc, char *argv[])
             QString sessionPath = QDir(tau5LogsPath).absoluteFilePath(sessionDirs.at(sessionIdx));
             QString logFilePath = QDir(sessionPath).absoluteFilePath("gui.log");
             
-            QFile logFile(logFilePath);
-            if (!logFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            Tau5Common::LogIndexReader reader;
+            if (!reader.open(logFilePath)) {
                 return QJsonObject{
                     {"type", "text"},
                     {"text", "Could not open log file"}
                 };
             }
             
-            // Read all lines
-            QStringList allLines;
-            QTextStream stream(&logFile);
-            while (!stream.atEnd()) {
-                allLines.append(stream.readLine());
+            // Get last N lines in newest-first order, reading only those lines
+            QStringList resultLines;
+            qint64 startIdx = qMax<qint64>(0, reader.lineCount() - numLines);
+            for (qint64 i = reader.lineCount() - 1; i >= startIdx; --i) {
+                resultLines.append(reader.line(i));
             }
-            logFile.close();
-            
-            // Get last N lines and reverse for newest-first order
-            int startIdx = qMax(0, allLines.size() - numLines);
-            QStringList resultLines = allLines.mid(startIdx);
-            std::reverse(resultLines.begin(), resultLines.end());
 
             QString resultText = QString("Session: %1\n%2")
                 .arg(sessionDirs.at(sessionIdx))
@@ -2580,95 +2672,98 @@ int main(int argc, char *argv[])
                 }}
             }}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QString requestId = QUuid::createUuid().toString();
             QElapsedTimer timer;
             timer.start();
 
-            QJsonObject result = bridge.executeCommand([params](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([params](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->getConsoleMessages(params, cb);
-            });
-
-            if (result.contains("type") && result["type"].toString() == "text") {
-                QString errorText = result["text"].toString();
-                if (errorText.startsWith("Error: ")) {
-                    qint64 duration = timer.elapsed();
-                    chromiumLogger.logActivity("chromium_devtools_getConsoleMessages", requestId, params, "error", duration, errorText);
-                    return result;
+            }, 8000, [&chromiumLogger, call, params, requestId, timer](const QJsonObject& result) {
+                if (result.contains("type") && result["type"].toString() == "text") {
+                    QString errorText = result["text"].toString();
+                    if (errorText.startsWith("Error: ")) {
+                        qint64 duration = timer.elapsed();
+                        chromiumLogger.logActivity("chromium_devtools_getConsoleMessages", requestId, params, "error", duration, errorText);
+                        call.finish(result);
+                        return;
+                    }
                 }
-            }
 
-            // Get format parameter and messages
-            QString format = result.value("format").toString("json");
-            QJsonArray messages = result["messages"].toArray();
-            int count = result["count"].toInt();
-
-            // Format output based on requested format
-            QString output;
+                // Get format parameter and messages
+                QString format = result.value("format").toString("json");
+                QJsonArray messages = result["messages"].toArray();
+                int count = result["count"].toInt();
+
+                // Format output based on requested format
+                QString output;
+
+                if (format == "plain") {
+                    QStringList lines;
+                    for (const QJsonValue& val : messages) {
+                        QJsonObject msg = val.toObject();
+                        QString timestamp = msg["timestamp"].toString();
+                        QString level = msg["level"].toString().toUpper();
+                        QString text = msg["text"].toString();
+                        QString location;
+
+                        if (msg.contains("url") && msg.contains("lineNumber")) {
+                            QString url = msg["url"].toString();
+                            int line = msg["lineNumber"].toInt();
+                            location = QString(" (%1:%2)").arg(url).arg(line);
+                        }
 
-            if (format == "plain") {
-                QStringList lines;
-                for (const QJsonValue& val : messages) {
-                    QJsonObject msg = val.toObject();
-                    QString timestamp = msg["timestamp"].toString();
-                    QString level = msg["level"].toString().toUpper();
-                    QString text = msg["text"].toString();
-                    QString location;
+                        lines.append(QString("[%1] [%2] %3%4")
+                            .arg(timestamp)
+                            .arg(level)
+                            .arg(text)
+                            .arg(location));
 
-                    if (msg.contains("url") && msg.contains("lineNumber")) {
-                        QString url = msg["url"].toString();
-                        int line = msg["lineNumber"].toInt();
-                        location = QString(" (%1:%2)").arg(url).arg(line);
+                        // Add stack trace if present
+                        if (msg.contains("stackTrace")) {
+                            lines.append(msg["stackTrace"].toString());
+                        }
                     }
 
-                    lines.append(QString("[%1] [%2] %3%4")
-                        .arg(timestamp)
-                        .arg(level)
-                        .arg(text)
-                        .arg(location));
-
-                    // Add stack trace if present
-                    if (msg.contains("stackTrace")) {
-                        lines.append(msg["stackTrace"].toString());
+                    output = lines.join("\n");
+                    if (output.isEmpty()) {
+                        output = "No console messages found";
+                    }
+                } else if (format == "csv") {
+                    QStringList csvLines;
+                    csvLines.append("Timestamp,Level,Message,URL,Line,Column,Function");
+
+                    for (const QJsonValue& val : messages) {
+                        QJsonObject msg = val.toObject();
+                        QStringList fields;
+                        fields << msg["timestamp"].toString();
+                        fields << msg["level"].toString();
+                        fields << QString("\"%1\"").arg(msg["text"].toString().replace("\"", "\\\""));
+                        fields << msg.value("url").toString();
+                        fields << QString::number(msg.value("lineNumber").toInt());
+                        fields << QString::number(msg.value("columnNumber").toInt());
+                        fields << msg.value("functionName").toString();
+                        csvLines.append(fields.join(","));
                     }
-                }
-
-                output = lines.join("\n");
-                if (output.isEmpty()) {
-                    output = "No console messages found";
-                }
-            } else if (format == "csv") {
-                QStringList csvLines;
-                csvLines.append("Timestamp,Level,Message,URL,Line,Column,Function");
 
-                for (const QJsonValue& val : messages) {
-                    QJsonObject msg = val.toObject();
-                    QStringList fields;
-                    fields << msg["timestamp"].toString();
-                    fields << msg["level"].toString();
-                    fields << QString("\"%1\"").arg(msg["text"].toString().replace("\"", "\\\""));
-                    fields << msg.value("url").toString();
-                    fields << QString::number(msg.value("lineNumber").toInt());
-                    fields << QString::number(msg.value("columnNumber").toInt());
-                    fields << msg.value("functionName").toString();
-                    csvLines.append(fields.join(","));
+                    output = csvLines.join("\n");
+                } else {
+                    // JSON format - return structured data
+                    QJsonDocument doc(messages);
+                    output = QString("=== Console Messages (%1 total) ===\n").arg(count);
+                    output += QString::fromUtf8(doc.toJson(QJsonDocument::Indented));
                 }
 
-                output = csvLines.join("\n");
-            } else {
-                // JSON format - return structured data
-                QJsonDocument doc(messages);
-                output = QString("=== Console Messages (%1 total) ===\n").arg(count);
-                output += QString::fromUtf8(doc.toJson(QJsonDocument::Indented));
-            }
-
-            qint64 duration = timer.elapsed();
-            chromiumLogger.logActivity("chromium_devtools_getConsoleMessages", requestId, params, "success", duration, QString(), output);
+                qint64 duration = timer.elapsed();
+                chromiumLogger.logActivity("chromium_devtools_getConsoleMessages", requestId, params, "success", duration, QString(), output);
 
-            return QJsonObject{
-                {"type", "text"},
-                {"text", output}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", output}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -2680,23 +2775,25 @@ int main(int argc, char *argv[])
             {"type", "object"},
             {"properties", QJsonObject{}}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QString requestId = QUuid::createUuid().toString();
             QElapsedTimer timer;
             timer.start();
 
-            bridge.executeCommand([](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->clearConsoleMessages();
                 cb(QJsonObject{{"cleared", true}}, QString());
-            });
-
-            qint64 duration = timer.elapsed();
-            chromiumLogger.logActivity("chromium_devtools_clearConsoleMessages", requestId, params, "success", duration);
+            }, 8000, [&chromiumLogger, call, params, requestId, timer](const QJsonObject&) {
+                qint64 duration = timer.elapsed();
+                chromiumLogger.logActivity("chromium_devtools_clearConsoleMessages", requestId, params, "success", duration);
 
-            return QJsonObject{
-                {"type", "text"},
-                {"text", "Console messages cleared successfully"}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", "Console messages cleared successfully"}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -2725,83 +2822,600 @@ int main(int argc, char *argv[])
                 }}
             }}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QElapsedTimer timer;
             timer.start();
             QString requestId = QUuid::createUuid().toString();
-            QJsonObject result = bridge.executeCommand([params](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([params](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->getNetworkRequests(params, cb);
+            }, 8000, [call](const QJsonObject& result) {
+                if (result.contains("requests")) {
+                    QJsonArray requests = result["requests"].toArray();
+                    QString output = QString("=== Network Requests (%1 total) ===\n\n").arg(requests.size());
+
+                    for (const QJsonValue& val : requests) {
+                        QJsonObject req = val.toObject();
+                        output += QString("[%1] %2 %3\n")
+                            .arg(req["timestamp"].toString())
+                            .arg(req["method"].toString())
+                            .arg(req["url"].toString());
+
+                        if (req.contains("statusCode")) {
+                            output += QString("  Status: %1 %2\n")
+                                .arg(req["statusCode"].toInt())
+                                .arg(req["statusText"].toString());
+                        }
+
+                        if (req.contains("failureReason")) {
+                            output += QString("  FAILED: %1\n").arg(req["failureReason"].toString());
+                        }
+
+                        if (req.contains("responseHeaders")) {
+                            QJsonObject headers = req["responseHeaders"].toObject();
+                            if (headers.contains("cross-origin-opener-policy") ||
+                                headers.contains("cross-origin-embedder-policy")) {
+                                output += "  CORS Headers:\n";
+                                if (headers.contains("cross-origin-opener-policy")) {
+                                    output += QString("    COOP: %1\n").arg(headers["cross-origin-opener-policy"].toString());
+                                }
+                                if (headers.contains("cross-origin-embedder-policy")) {
+                                    output += QString("    COEP: %1\n").arg(headers["cross-origin-embedder-policy"].toString());
+                                }
+                            }
+                        }
+                        output += "\n";
+                    }
+
+                    call.finish(QJsonObject{
+                        {"type", "text"},
+                        {"text", output}
+                    });
+                    return;
+                }
+
+                call.finish(result);
             });
+            call.onCancel(cancel);
+        }
+    });
+
+    // Tool: Get Memory Usage
+    server.registerTool({
+        "chromium_devtools_getMemoryUsage",
+        "Get JavaScript heap and memory metrics",
+        QJsonObject{
+            {"type", "object"},
+            {"properties", QJsonObject{}}
+        },
+        nullptr,
+        [&bridge](const QJsonObject&, const MCPServerStdio::ToolCall& call) {
+            auto cancel = bridge.executeCommandAsync([](CDPClient* client, CDPClient::ResponseCallback cb) {
+                client->getMemoryUsage(cb);
+            }, 8000, [call](const QJsonObject& result) {
+                QString output = "=== Memory Usage ===\n";
+                for (auto it = result.begin(); it != result.end(); ++it) {
+                    output += QString("%1: %2\n").arg(it.key()).arg(it.value().toDouble());
+                }
+
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", output}
+                });
+            });
+            call.onCancel(cancel);
+        }
+    });
+
+    // Snapshots and traces are parsed on the thread pool, and the tool call
+    // finished from done back on this thread, so other tool calls carry on
+    // meanwhile
+    auto runInPool = [](std::function<void()> work, std::function<void()> done) {
+        auto* watcher = new QFutureWatcher<void>();
+        QObject::connect(watcher, &QFutureWatcher<void>::finished, watcher, [watcher, done]() {
+            watcher->deleteLater();
+            done();
+        });
+        watcher->setFuture(QtConcurrent::run(std::move(work)));
+    };
+
+    // The last heap snapshot summarised is the baseline for the next
+    std::shared_ptr<HeapSnapshot> lastHeapSnapshot;
+
+    // Snapshots and profiles go next to the GUI log of the latest session
+    // on this channel, or with the MCP logs if there is none
+    auto sessionLogDir = [channel]() -> QString {
+        QString guiLogsPath = QDir(Tau5Logger::getTau5DataPath()).absoluteFilePath("logs/gui");
+        QStringList sessionDirs = QDir(guiLogsPath).entryList(QStringList{QString("*_c%1").arg(channel)},
+                                                              QDir::Dirs | QDir::NoDotAndDotDot,
+                                                              QDir::Name | QDir::Reversed);
+        if (!sessionDirs.isEmpty()) {
+            return QDir(guiLogsPath).absoluteFilePath(sessionDirs.first());
+        }
+        return QFileInfo(Tau5Logger::getGlobalMCPLogPath("spectra")).absolutePath();
+    };
+
+    // Tool: Heap Snapshot Diff
+    server.registerTool({
+        "chromium_devtools_heapDiff",
+        "Take a JavaScript heap snapshot and summarise what retains memory by constructor, then compare it with the previous snapshot to show which objects accumulated. The snapshot is saved to disk and only a compact summary is returned.",
+        QJsonObject{
+            {"type", "object"},
+            {"properties", QJsonObject{
+                {"snapshot", QJsonObject{
+                    {"type", "string"},
+                    {"description", "Path of a saved .heapsnapshot to summarise instead of taking a new one"}
+                }},
+                {"baseline", QJsonObject{
+                    {"type", "string"},
+                    {"description", "Path of an earlier .heapsnapshot to compare against (default: the snapshot from the previous call)"}
+                }},
+                {"limit", QJsonObject{
+                    {"type", "integer"},
+                    {"description", "Number of constructors and objects to list (default: 20)"}
+                }}
+            }}
+        },
+        nullptr,
+        [&bridge, &chromiumLogger, &lastHeapSnapshot, runInPool, sessionLogDir](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
+            QElapsedTimer timer;
+            timer.start();
+            QString requestId = QUuid::createUuid().toString();
 
-            if (result.contains("requests")) {
-                QJsonArray requests = result["requests"].toArray();
-                QString output = QString("=== Network Requests (%1 total) ===\n\n").arg(requests.size());
+            int limit = params["limit"].toInt(20);
+            if (limit <= 0) {
+                limit = 20;
+            }
 
-                for (const QJsonValue& val : requests) {
-                    QJsonObject req = val.toObject();
-                    output += QString("[%1] %2 %3\n")
-                        .arg(req["timestamp"].toString())
-                        .arg(req["method"].toString())
-                        .arg(req["url"].toString());
+            auto summarise = [&chromiumLogger, &lastHeapSnapshot, runInPool, call, params, requestId, timer, limit](const QString& path) {
+                QString baselinePath = params["baseline"].toString();
+                auto snapshot = std::make_shared<HeapSnapshot>();
+                std::shared_ptr<HeapSnapshot> baseline = baselinePath.isEmpty() ? lastHeapSnapshot : std::make_shared<HeapSnapshot>();
+                runInPool([snapshot, baseline, path, baselinePath]() {
+                    if (snapshot->load(path) && !baselinePath.isEmpty()) {
+                        baseline->load(baselinePath);
+                    }
+                }, [&chromiumLogger, &lastHeapSnapshot, call, params, requestId, timer, limit, path, snapshot, baseline]() {
+                    if (call.isCancelled()) {
+                        return;
+                    }
 
-                    if (req.contains("statusCode")) {
-                        output += QString("  Status: %1 %2\n")
-                            .arg(req["statusCode"].toInt())
-                            .arg(req["statusText"].toString());
+                    QString failure = snapshot->errorString();
+                    if (failure.isEmpty() && baseline) {
+                        failure = baseline->errorString();
+                    }
+                    if (!failure.isEmpty()) {
+                        chromiumLogger.logActivity("chromium_devtools_heapDiff", requestId, params, "error", timer.elapsed(), failure);
+                        call.finish(QJsonObject{
+                            {"type", "text"},
+                            {"text", QString("Error: %1").arg(failure)}
+                        });
+                        return;
+                    }
+                    lastHeapSnapshot = snapshot;
+
+                    QString output = "=== Heap Snapshot ===\n";
+                    output += QString("File: %1 (%2)\n").arg(path, formatBytes(QFileInfo(path).size()));
+                    output += QString("Live objects: %1 of %2 nodes, %3 in total\n\n")
+                        .arg(snapshot->objectCount())
+                        .arg(snapshot->nodeCount())
+                        .arg(formatBytes(snapshot->totalSize()));
+
+                    output += "Top retainers by constructor:\n";
+                    output += QString("  %1 %2 %3  %4\n").arg(QString("Retained"), 10).arg(QString("Self"), 10).arg(QString("Count"), 9).arg(QString("Constructor"));
+                    const QVector<HeapSnapshot::ClassSummary>& classes = snapshot->classes();
+                    for (int i = 0; i < qMin(limit, static_cast<int>(classes.size())); ++i) {
+                        const HeapSnapshot::ClassSummary& summary = classes.at(i);
+                        output += QString("  %1 %2 %3  %4\n")
+                            .arg(formatBytes(summary.retainedSize), 10)
+                            .arg(formatBytes(summary.selfSize), 10)
+                            .arg(summary.count, 9)
+                            .arg(summary.name);
                     }
 
-                    if (req.contains("failureReason")) {
-                        output += QString("  FAILED: %1\n").arg(req["failureReason"].toString());
+                    output += "\nLargest objects:\n";
+                    const QVector<HeapSnapshot::ObjectSummary>& objects = snapshot->largestObjects();
+                    for (int i = 0; i < qMin(limit, static_cast<int>(objects.size())); ++i) {
+                        const HeapSnapshot::ObjectSummary& object = objects.at(i);
+                        QString name = object.name.isEmpty() || object.name == object.className
+                            ? QString() : QString(" '%1'").arg(object.name);
+                        output += QString("  %1 %2  %3%4 @%5\n")
+                            .arg(formatBytes(object.retainedSize), 10)
+                            .arg(formatBytes(object.selfSize), 10)
+                            .arg(object.className, name)
+                            .arg(object.id);
                     }
 
-                    if (req.contains("responseHeaders")) {
-                        QJsonObject headers = req["responseHeaders"].toObject();
-                        if (headers.contains("cross-origin-opener-policy") ||
-                            headers.contains("cross-origin-embedder-policy")) {
-                            output += "  CORS Headers:\n";
-                            if (headers.contains("cross-origin-opener-policy")) {
-                                output += QString("    COOP: %1\n").arg(headers["cross-origin-opener-policy"].toString());
-                            }
-                            if (headers.contains("cross-origin-embedder-policy")) {
-                                output += QString("    COEP: %1\n").arg(headers["cross-origin-embedder-policy"].toString());
+                    if (!baseline) {
+                        output += "\nNo baseline yet. Call again later, or pass baseline, to see what accumulated since this snapshot.\n";
+                    } else {
+                        QVector<HeapSnapshot::ClassDiff> diffs = HeapSnapshot::diff(*baseline, *snapshot);
+                        output += QString("\nChanges since %1 (%2 -> %3):\n")
+                            .arg(baseline->path(), formatBytes(baseline->totalSize()), formatBytes(snapshot->totalSize()));
+                        if (diffs.isEmpty()) {
+                            output += "  No objects allocated or freed.\n";
+                        } else {
+                            output += QString("  %1 %2 %3  %4  %5\n")
+                                .arg(QString("Size"), 10).arg(QString("New"), 9).arg(QString("Freed"), 9).arg(QString("Retained"), 23).arg(QString("Constructor"));
+                            for (int i = 0; i < qMin(limit, static_cast<int>(diffs.size())); ++i) {
+                                const HeapSnapshot::ClassDiff& diff = diffs.at(i);
+                                QString retained = QString("%1 -> %2").arg(formatBytes(diff.retainedBefore), formatBytes(diff.retainedAfter));
+                                output += QString("  %1 %2 %3  %4  %5\n")
+                                    .arg((diff.sizeDelta() > 0 ? "+" : "") + formatBytes(diff.sizeDelta()), 10)
+                                    .arg(QString("+%1").arg(diff.added), 9)
+                                    .arg(QString("-%1").arg(diff.removed), 9)
+                                    .arg(retained, 23)
+                                    .arg(diff.name);
                             }
                         }
                     }
-                    output += "\n";
+
+                    chromiumLogger.logActivity("chromium_devtools_heapDiff", requestId, params, "success", timer.elapsed(), QString(),
+                                               QJsonObject{{"path", path}, {"objects", snapshot->objectCount()}});
+
+                    call.finish(QJsonObject{
+                        {"type", "text"},
+                        {"text", output}
+                    });
+                });
+            };
+
+            QString path = params["snapshot"].toString();
+            if (!path.isEmpty()) {
+                summarise(path);
+                return;
+            }
+
+            QString fileName = QString("heap-%1.heapsnapshot").arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss-zzz"));
+            path = QDir(sessionLogDir()).absoluteFilePath(fileName);
+
+            // Large pages take a while to walk and serialise
+            auto cancel = bridge.executeCommandAsync([path](CDPClient* client, CDPClient::ResponseCallback cb) {
+                client->takeHeapSnapshot(path, cb);
+            }, 120000, [&chromiumLogger, call, params, requestId, timer, path, summarise](const QJsonObject& result) {
+                if (result["type"].toString() == "text") {
+                    chromiumLogger.logActivity("chromium_devtools_heapDiff", requestId, params, "error", timer.elapsed(), result["text"].toString());
+                    call.finish(result);
+                    return;
                 }
+                summarise(path);
+            });
+            call.onCancel(cancel);
+        }
+    });
 
-                return QJsonObject{
+    // Tool: CPU Profile
+    server.registerTool({
+        "chromium_devtools_profileCpu",
+        "Sample the page's JavaScript CPU usage and return the hottest functions by self and total time. Use profile_for_ms to profile for a fixed time in one call, or action 'start' and later 'stop'. Folded stacks for a flame graph are saved to disk; the raw profile is not returned.",
+        QJsonObject{
+            {"type", "object"},
+            {"properties", QJsonObject{
+                {"profile_for_ms", QJsonObject{
+                    {"type", "integer"},
+                    {"description", "Profile for this many milliseconds (max 120000) and return the result"}
+                }},
+                {"action", QJsonObject{
+                    {"type", "string"},
+                    {"enum", QJsonArray{"start", "stop"}},
+                    {"description", "Start profiling, or stop and return the result (ignored with profile_for_ms)"}
+                }},
+                {"sampling_interval_us", QJsonObject{
+                    {"type", "integer"},
+                    {"description", "Sampling interval in microseconds (default: Chrome's, about 1000)"}
+                }},
+                {"limit", QJsonObject{
+                    {"type", "integer"},
+                    {"description", "Number of functions to list (default: 20)"}
+                }}
+            }}
+        },
+        nullptr,
+        [&bridge, &chromiumLogger, sessionLogDir](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
+            QElapsedTimer timer;
+            timer.start();
+            QString requestId = QUuid::createUuid().toString();
+
+            int durationMs = qMin(params["profile_for_ms"].toInt(0), 120000);
+            int samplingIntervalUs = qMax(params["sampling_interval_us"].toInt(0), 0);
+            QString action = params["action"].toString();
+            int limit = params["limit"].toInt(20);
+            if (limit <= 0) {
+                limit = 20;
+            }
+
+            auto summarise = [&chromiumLogger, sessionLogDir, call, params, requestId, timer, limit](const QJsonObject& result) {
+                if (result["type"].toString() == "text") {
+                    chromiumLogger.logActivity("chromium_devtools_profileCpu", requestId, params, "error", timer.elapsed(), result["text"].toString());
+                    call.finish(result);
+                    return;
+                }
+
+                CpuProfile profile;
+                if (!profile.load(result["profile"].toObject())) {
+                    chromiumLogger.logActivity("chromium_devtools_profileCpu", requestId, params, "error", timer.elapsed(), profile.errorString());
+                    call.finish(QJsonObject{
+                        {"type", "text"},
+                        {"text", QString("Error: %1").arg(profile.errorString())}
+                    });
+                    return;
+                }
+
+                QString fileName = QString("cpu-%1.folded").arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss-zzz"));
+                QString foldedPath = QDir(sessionLogDir()).absoluteFilePath(fileName);
+                QFile foldedFile(foldedPath);
+                if (!foldedFile.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+                    foldedFile.write(profile.foldedStacks()) != profile.foldedStacks().size()) {
+                    foldedPath = QString("not saved (%1)").arg(foldedFile.errorString());
+                }
+                foldedFile.close();
+
+                // Percentages are of busy time, so an idle page does not
+                // flatten everything towards zero
+                qint64 busy = qMax<qint64>(1, profile.duration() - profile.idleTime());
+                auto ms = [](qint64 us) { return QString::number(us / 1000.0, 'f', 1); };
+                auto percent = [busy](qint64 us) { return QString::number(100.0 * us / busy, 'f', 1) + "%"; };
+
+                QString output = "=== CPU Profile ===\n";
+                output += QString("Duration: %1 ms, %2 samples, busy %3 ms (idle %4 ms)\n")
+                    .arg(ms(profile.duration()))
+                    .arg(profile.sampleCount())
+                    .arg(ms(busy))
+                    .arg(ms(profile.idleTime()));
+                output += QString("Folded stacks: %1\n\n").arg(foldedPath);
+
+                output += QString("  %1 %2 %3 %4  %5\n")
+                    .arg(QString("Self ms"), 10).arg(QString("Self"), 6)
+                    .arg(QString("Total ms"), 10).arg(QString("Total"), 6)
+                    .arg(QString("Function"));
+                const QVector<CpuProfile::Function>& functions = profile.functions();
+                int listed = 0;
+                for (const CpuProfile::Function& function : functions) {
+                    if (listed == limit) {
+                        break;
+                    }
+                    if (function.selfTime == 0 || (function.name == "(idle)" && function.url.isEmpty())) {
+                        continue;
+                    }
+                    QString location = function.url.isEmpty()
+                        ? QString() : QString(" %1:%2").arg(function.url).arg(function.lineNumber);
+                    output += QString("  %1 %2 %3 %4  %5%6\n")
+                        .arg(ms(function.selfTime), 10)
+                        .arg(percent(function.selfTime), 6)
+                        .arg(ms(function.totalTime), 10)
+                        .arg(percent(function.totalTime), 6)
+                        .arg(function.name, location);
+                    listed++;
+                }
+                if (listed == 0) {
+                    output += "  No JavaScript ran while profiling.\n";
+                }
+
+                chromiumLogger.logActivity("chromium_devtools_profileCpu", requestId, params, "success", timer.elapsed(), QString(),
+                                           QJsonObject{{"folded", foldedPath}, {"samples", profile.sampleCount()}});
+
+                call.finish(QJsonObject{
                     {"type", "text"},
                     {"text", output}
-                };
-            }
+                });
+            };
 
-            return result;
+            // Profiling for a while leaves other tool calls free to run
+            std::function<void()> cancel;
+            if (durationMs > 0) {
+                cancel = bridge.executeCommandAsync([durationMs, samplingIntervalUs](CDPClient* client, CDPClient::ResponseCallback cb) {
+                    client->profileFor(durationMs, samplingIntervalUs, cb);
+                }, durationMs + 15000, summarise);
+            } else if (action == "start") {
+                cancel = bridge.executeCommandAsync([samplingIntervalUs](CDPClient* client, CDPClient::ResponseCallback cb) {
+                    client->startProfiling(QString(), samplingIntervalUs, cb);
+                }, 8000, [&chromiumLogger, call, params, requestId, timer](const QJsonObject& result) {
+                    if (result["type"].toString() == "text") {
+                        call.finish(result);
+                        return;
+                    }
+                    chromiumLogger.logActivity("chromium_devtools_profileCpu", requestId, params, "success", timer.elapsed());
+                    call.finish(QJsonObject{
+                        {"type", "text"},
+                        {"text", "CPU profiler started. Call again with action 'stop' to get the result."}
+                    });
+                });
+            } else if (action == "stop") {
+                // Stopping and serialising a long profile takes a moment
+                cancel = bridge.executeCommandAsync([](CDPClient* client, CDPClient::ResponseCallback cb) {
+                    client->stopProfiling(QString(), cb);
+                }, 30000, summarise);
+            } else {
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", "Error: Pass profile_for_ms, or action 'start' and later 'stop'"}
+                });
+                return;
+            }
+            call.onCancel(cancel);
         }
     });
 
-    // Tool: Get Memory Usage
+    // Tool: Trace
     server.registerTool({
-        "chromium_devtools_getMemoryUsage",
-        "Get JavaScript heap and memory metrics",
+        "chromium_devtools_trace",
+        "Record a Chrome trace and analyse it for jank: frame time percentiles and dropped frames, long main-thread tasks (>50ms) and GPU/raster stalls. Use trace_for_ms to trace for a fixed time in one call, or action 'start' and later 'stop'. The trace is saved to disk (openable in Perfetto) and only the analysis is returned.",
         QJsonObject{
             {"type", "object"},
-            {"properties", QJsonObject{}}
+            {"properties", QJsonObject{
+                {"trace_for_ms", QJsonObject{
+                    {"type", "integer"},
+                    {"description", "Trace for this many milliseconds (max 120000) and return the analysis"}
+                }},
+                {"action", QJsonObject{
+                    {"type", "string"},
+                    {"enum", QJsonArray{"start", "stop"}},
+                    {"description", "Start tracing, or stop and return the analysis (ignored with trace_for_ms)"}
+                }},
+                {"categories", QJsonObject{
+                    {"type", "string"},
+                    {"description", QString("Comma-separated trace categories (default: %1)").arg(QString(CDPClient::DEFAULT_TRACE_CATEGORIES))}
+                }},
+                {"file", QJsonObject{
+                    {"type", "string"},
+                    {"description", "Path of a saved trace to analyse instead of recording one"}
+                }},
+                {"limit", QJsonObject{
+                    {"type", "integer"},
+                    {"description", "Number of long tasks and stalls to list (default: 10)"}
+                }}
+            }}
         },
-        [&bridge](const QJsonObject&) -> QJsonObject {
-            QJsonObject result = bridge.executeCommand([](CDPClient* client, CDPClient::ResponseCallback cb) {
-                client->getMemoryUsage(cb);
-            });
+        nullptr,
+        [&bridge, &chromiumLogger, runInPool, sessionLogDir](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
+            QElapsedTimer timer;
+            timer.start();
+            QString requestId = QUuid::createUuid().toString();
 
-            QString output = "=== Memory Usage ===\n";
-            for (auto it = result.begin(); it != result.end(); ++it) {
-                output += QString("%1: %2\n").arg(it.key()).arg(it.value().toDouble());
+            int durationMs = qMin(params["trace_for_ms"].toInt(0), 120000);
+            QString action = params["action"].toString();
+            QString categories = params["categories"].toString();
+            int limit = params["limit"].toInt(10);
+            if (limit <= 0) {
+                limit = 10;
             }
 
-            return QJsonObject{
-                {"type", "text"},
-                {"text", output}
+            // Analysed on the thread pool, as heap snapshots are
+            auto analyse = [&chromiumLogger, runInPool, call, params, requestId, timer, limit](const QString& path) {
+                auto trace = std::make_shared<TraceAnalysis>();
+                runInPool([trace, path]() {
+                    trace->load(path);
+                }, [&chromiumLogger, call, params, requestId, timer, limit, path, trace]() {
+                    if (call.isCancelled()) {
+                        return;
+                    }
+
+                    const TraceAnalysis& analysis = *trace;
+                    if (!analysis.errorString().isEmpty()) {
+                        chromiumLogger.logActivity("chromium_devtools_trace", requestId, params, "error", timer.elapsed(), analysis.errorString());
+                        call.finish(QJsonObject{
+                            {"type", "text"},
+                            {"text", QString("Error: %1").arg(analysis.errorString())}
+                        });
+                        return;
+                    }
+
+                    auto ms = [](double value) { return QString::number(value, 'f', 1); };
+
+                    QString output = "=== Trace Analysis ===\n";
+                    output += QString("File: %1 (%2)\n").arg(path, formatBytes(QFileInfo(path).size()));
+                    output += QString("Duration: %1 ms, %2 events\n\n").arg(ms(analysis.durationMs())).arg(analysis.eventCount());
+
+                    output += "Frames:\n";
+                    if (analysis.frameCount() < 2) {
+                        output += "  No frames drawn (is the disabled-by-default-devtools.timeline.frame category enabled?)\n";
+                    } else {
+                        const TraceAnalysis::Percentiles& frames = analysis.frameTimes();
+                        output += QString("  %1 frames, budget %2 ms (%3 fps)\n")
+                            .arg(analysis.frameCount())
+                            .arg(ms(analysis.frameBudgetMs()))
+                            .arg(ms(1000.0 / analysis.frameBudgetMs()));
+                        output += QString("  Frame time p50 %1, p90 %2, p95 %3, p99 %4, max %5 ms\n")
+                            .arg(ms(frames.p50), ms(frames.p90), ms(frames.p95), ms(frames.p99), ms(frames.max));
+                        output += QString("  Janky frames: %1, estimated dropped: %2\n")
+                            .arg(analysis.jankyFrames())
+                            .arg(analysis.droppedFrames());
+                    }
+                    if (analysis.reportedDroppedFrames() > 0) {
+                        output += QString("  Dropped frames reported by the compositor: %1\n").arg(analysis.reportedDroppedFrames());
+                    }
+
+                    output += QString("\nLong tasks (>%1 ms on the renderer main thread): %2, %3 ms in total\n")
+                        .arg(TraceAnalysis::LONG_TASK_MS)
+                        .arg(analysis.longTasks().size())
+                        .arg(ms(analysis.longTaskTotalMs()));
+                    const QVector<TraceAnalysis::Task>& longTasks = analysis.longTasks();
+                    for (int i = 0; i < qMin(limit, static_cast<int>(longTasks.size())); ++i) {
+                        const TraceAnalysis::Task& task = longTasks.at(i);
+                        output += QString("  %1 ms at +%2 ms%3\n")
+                            .arg(ms(task.durationMs), 8)
+                            .arg(ms(task.startMs))
+                            .arg(task.longestChild.isEmpty() ? QString() : QString(": %1").arg(task.longestChild));
+                    }
+
+                    output += QString("\nGPU/raster stalls (tasks over one frame budget): %1\n").arg(analysis.stalls().size());
+                    for (const TraceAnalysis::ThreadStalls& stalls : analysis.stallsByThread()) {
+                        output += QString("  %1: %2 stalls, %3 ms in total, longest %4 ms\n")
+                            .arg(stalls.thread)
+                            .arg(stalls.count)
+                            .arg(ms(stalls.totalMs))
+                            .arg(ms(stalls.longestMs));
+                    }
+                    const QVector<TraceAnalysis::Task>& stalls = analysis.stalls();
+                    for (int i = 0; i < qMin(limit, static_cast<int>(stalls.size())); ++i) {
+                        const TraceAnalysis::Task& task = stalls.at(i);
+                        output += QString("  %1 ms at +%2 ms on %3%4\n")
+                            .arg(ms(task.durationMs), 8)
+                            .arg(ms(task.startMs))
+                            .arg(task.thread)
+                            .arg(task.longestChild.isEmpty() ? QString() : QString(": %1").arg(task.longestChild));
+                    }
+
+                    chromiumLogger.logActivity("chromium_devtools_trace", requestId, params, "success", timer.elapsed(), QString(),
+                                               QJsonObject{{"path", path}, {"events", analysis.eventCount()}});
+
+                    call.finish(QJsonObject{
+                        {"type", "text"},
+                        {"text", output}
+                    });
+                });
+            };
+
+            QString path = params["file"].toString();
+            if (!path.isEmpty()) {
+                analyse(path);
+                return;
+            }
+
+            QString fileName = QString("trace-%1.json").arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss-zzz"));
+            QString newPath = QDir(sessionLogDir()).absoluteFilePath(fileName);
+
+            auto recorded = [&chromiumLogger, call, params, requestId, timer, analyse](const QJsonObject& result) {
+                if (result["type"].toString() == "text") {
+                    chromiumLogger.logActivity("chromium_devtools_trace", requestId, params, "error", timer.elapsed(), result["text"].toString());
+                    call.finish(result);
+                    return;
+                }
+                analyse(result["path"].toString());
             };
+
+            std::function<void()> cancel;
+            if (durationMs > 0) {
+                // Chrome flushes the trace buffers after Tracing.end
+                cancel = bridge.executeCommandAsync([durationMs, newPath, categories](CDPClient* client, CDPClient::ResponseCallback cb) {
+                    client->traceFor(durationMs, newPath, categories, cb);
+                }, durationMs + 30000, recorded);
+            } else if (action == "start") {
+                cancel = bridge.executeCommandAsync([newPath, categories](CDPClient* client, CDPClient::ResponseCallback cb) {
+                    client->startTracing(newPath, categories, cb);
+                }, 8000, [&chromiumLogger, call, params, requestId, timer, newPath](const QJsonObject& result) {
+                    if (result["type"].toString() == "text") {
+                        call.finish(result);
+                        return;
+                    }
+                    chromiumLogger.logActivity("chromium_devtools_trace", requestId, params, "success", timer.elapsed());
+                    call.finish(QJsonObject{
+                        {"type", "text"},
+                        {"text", QString("Tracing to %1. Call again with action 'stop' to get the analysis.").arg(newPath)}
+                    });
+                });
+            } else if (action == "stop") {
+                cancel = bridge.executeCommandAsync([](CDPClient* client, CDPClient::ResponseCallback cb) {
+                    client->stopTracing(cb);
+                }, 30000, recorded);
+            } else {
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", "Error: Pass trace_for_ms, file, or action 'start' and later 'stop'"}
+                });
+                return;
+            }
+            call.onCancel(cancel);
         }
     });
 
@@ -2813,40 +3427,43 @@ int main(int argc, char *argv[])
             {"type", "object"},
             {"properties", QJsonObject{}}
         },
-        [&bridge](const QJsonObject&) -> QJsonObject {
-            QJsonObject result = bridge.executeCommand([](CDPClient* client, CDPClient::ResponseCallback cb) {
+        nullptr,
+        [&bridge](const QJsonObject&, const MCPServerStdio::ToolCall& call) {
+            auto cancel = bridge.executeCommandAsync([](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->getPendingExceptions(cb);
-            });
-
-            if (result.contains("exceptions")) {
-                QJsonArray exceptions = result["exceptions"].toArray();
-                QString output = QString("=== Runtime Exceptions (%1 total) ===\n\n").arg(exceptions.size());
-
-                for (const QJsonValue& val : exceptions) {
-                    QJsonObject ex = val.toObject();
-                    output += QString("[%1] %2\n")
-                        .arg(ex["timestamp"].toString())
-                        .arg(ex["text"].toString());
-                    output += QString("  Location: %1:%2:%3\n")
-                        .arg(ex["url"].toString())
-                        .arg(ex["lineNumber"].toInt())
-                        .arg(ex["columnNumber"].toInt());
-
-                    if (ex.contains("stackTrace")) {
-                        output += "  Stack Trace:\n";
-                        QJsonDocument doc(ex["stackTrace"].toObject());
-                        output += QString::fromUtf8(doc.toJson(QJsonDocument::Indented));
+            }, 8000, [call](const QJsonObject& result) {
+                if (result.contains("exceptions")) {
+                    QJsonArray exceptions = result["exceptions"].toArray();
+                    QString output = QString("=== Runtime Exceptions (%1 total) ===\n\n").arg(exceptions.size());
+
+                    for (const QJsonValue& val : exceptions) {
+                        QJsonObject ex = val.toObject();
+                        output += QString("[%1] %2\n")
+                            .arg(ex["timestamp"].toString())
+                            .arg(ex["text"].toString());
+                        output += QString("  Location: %1:%2:%3\n")
+                            .arg(ex["url"].toString())
+                            .arg(ex["lineNumber"].toInt())
+                            .arg(ex["columnNumber"].toInt());
+
+                        if (ex.contains("stackTrace")) {
+                            output += "  Stack Trace:\n";
+                            QJsonDocument doc(ex["stackTrace"].toObject());
+                            output += QString::fromUtf8(doc.toJson(QJsonDocument::Indented));
+                        }
+                        output += "\n";
                     }
-                    output += "\n";
-                }
 
-                return QJsonObject{
-                    {"type", "text"},
-                    {"text", output}
-                };
-            }
+                    call.finish(QJsonObject{
+                        {"type", "text"},
+                        {"text", output}
+                    });
+                    return;
+                }
 
-            return result;
+                call.finish(result);
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -2858,36 +3475,39 @@ int main(int argc, char *argv[])
             {"type", "object"},
             {"properties", QJsonObject{}}
         },
-        [&bridge](const QJsonObject&) -> QJsonObject {
-            QJsonObject result = bridge.executeCommand([](CDPClient* client, CDPClient::ResponseCallback cb) {
+        nullptr,
+        [&bridge](const QJsonObject&, const MCPServerStdio::ToolCall& call) {
+            auto cancel = bridge.executeCommandAsync([](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->getLoadedResources(cb);
-            });
-
-            if (result.contains("resources")) {
-                QJsonArray resources = result["resources"].toArray();
-                QString output = QString("=== Loaded Resources (%1 total) ===\n\n").arg(resources.size());
+            }, 8000, [call](const QJsonObject& result) {
+                if (result.contains("resources")) {
+                    QJsonArray resources = result["resources"].toArray();
+                    QString output = QString("=== Loaded Resources (%1 total) ===\n\n").arg(resources.size());
+
+                    QMap<QString, int> typeCount;
+                    for (const QJsonValue& val : resources) {
+                        QJsonObject res = val.toObject();
+                        QString type = res["type"].toString();
+                        QString url = res["url"].toString();
+                        typeCount[type]++;
+                        output += QString("[%1] %2\n").arg(type).arg(url);
+                    }
 
-                QMap<QString, int> typeCount;
-                for (const QJsonValue& val : resources) {
-                    QJsonObject res = val.toObject();
-                    QString type = res["type"].toString();
-                    QString url = res["url"].toString();
-                    typeCount[type]++;
-                    output += QString("[%1] %2\n").arg(type).arg(url);
-                }
+                    output += "\n=== Summary by Type ===\n";
+                    for (auto it = typeCount.begin(); it != typeCount.end(); ++it) {
+                        output += QString("%1: %2\n").arg(it.key()).arg(it.value());
+                    }
 
-                output += "\n=== Summary by Type ===\n";
-                for (auto it = typeCount.begin(); it != typeCount.end(); ++it) {
-                    output += QString("%1: %2\n").arg(it.key()).arg(it.value());
+                    call.finish(QJsonObject{
+                        {"type", "text"},
+                        {"text", output}
+                    });
+                    return;
                 }
 
-                return QJsonObject{
-                    {"type", "text"},
-                    {"text", output}
-                };
-            }
-
-            return result;
+                call.finish(result);
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -2899,35 +3519,37 @@ int main(int argc, char *argv[])
             {"type", "object"},
             {"properties", QJsonObject{}}
         },
-        [&bridge](const QJsonObject&) -> QJsonObject {
-            QJsonObject result = bridge.executeCommand([](CDPClient* client, CDPClient::ResponseCallback cb) {
+        nullptr,
+        [&bridge](const QJsonObject&, const MCPServerStdio::ToolCall& call) {
+            auto cancel = bridge.executeCommandAsync([](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->getAudioContexts(cb);
-            });
-
-            QString output = "=== Audio Contexts ===\n";
-            if (result.contains("result")) {
-                QJsonObject evalResult = result["result"].toObject();
-                if (evalResult.contains("value")) {
-                    QJsonArray contexts = evalResult["value"].toArray();
-                    if (contexts.isEmpty()) {
-                        output += "No AudioContext instances found\n";
-                    } else {
-                        for (const QJsonValue& val : contexts) {
-                            QJsonObject ctx = val.toObject();
-                            output += QString("State: %1\n").arg(ctx["state"].toString());
-                            output += QString("Sample Rate: %1\n").arg(ctx["sampleRate"].toDouble());
-                            output += QString("Current Time: %1\n").arg(ctx["currentTime"].toDouble());
-                            output += QString("Base Latency: %1\n").arg(ctx["baseLatency"].toDouble());
-                            output += QString("Output Latency: %1\n").arg(ctx["outputLatency"].toDouble());
+            }, 8000, [call](const QJsonObject& result) {
+                QString output = "=== Audio Contexts ===\n";
+                if (result.contains("result")) {
+                    QJsonObject evalResult = result["result"].toObject();
+                    if (evalResult.contains("value")) {
+                        QJsonArray contexts = evalResult["value"].toArray();
+                        if (contexts.isEmpty()) {
+                            output += "No AudioContext instances found\n";
+                        } else {
+                            for (const QJsonValue& val : contexts) {
+                                QJsonObject ctx = val.toObject();
+                                output += QString("State: %1\n").arg(ctx["state"].toString());
+                                output += QString("Sample Rate: %1\n").arg(ctx["sampleRate"].toDouble());
+                                output += QString("Current Time: %1\n").arg(ctx["currentTime"].toDouble());
+                                output += QString("Base Latency: %1\n").arg(ctx["baseLatency"].toDouble());
+                                output += QString("Output Latency: %1\n").arg(ctx["outputLatency"].toDouble());
+                            }
                         }
                     }
                 }
-            }
 
-            return QJsonObject{
-                {"type", "text"},
-                {"text", output}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", output}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -2939,31 +3561,34 @@ int main(int argc, char *argv[])
             {"type", "object"},
             {"properties", QJsonObject{}}
         },
-        [&bridge](const QJsonObject&) -> QJsonObject {
-            QJsonObject result = bridge.executeCommand([](CDPClient* client, CDPClient::ResponseCallback cb) {
+        nullptr,
+        [&bridge](const QJsonObject&, const MCPServerStdio::ToolCall& call) {
+            auto cancel = bridge.executeCommandAsync([](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->getWorkers(cb);
-            });
-
-            if (result.contains("workers")) {
-                QJsonArray workers = result["workers"].toArray();
-                QString output = QString("=== Workers (%1 total) ===\n\n").arg(workers.size());
+            }, 8000, [call](const QJsonObject& result) {
+                if (result.contains("workers")) {
+                    QJsonArray workers = result["workers"].toArray();
+                    QString output = QString("=== Workers (%1 total) ===\n\n").arg(workers.size());
+
+                    for (const QJsonValue& val : workers) {
+                        QJsonObject worker = val.toObject();
+                        output += QString("[%1] %2\n")
+                            .arg(worker["type"].toString())
+                            .arg(worker["url"].toString());
+                        output += QString("  Title: %1\n").arg(worker["title"].toString());
+                        output += QString("  ID: %1\n\n").arg(worker["targetId"].toString());
+                    }
 
-                for (const QJsonValue& val : workers) {
-                    QJsonObject worker = val.toObject();
-                    output += QString("[%1] %2\n")
-                        .arg(worker["type"].toString())
-                        .arg(worker["url"].toString());
-                    output += QString("  Title: %1\n").arg(worker["title"].toString());
-                    output += QString("  ID: %1\n\n").arg(worker["targetId"].toString());
+                    call.finish(QJsonObject{
+                        {"type", "text"},
+                        {"text", output}
+                    });
+                    return;
                 }
 
-                return QJsonObject{
-                    {"type", "text"},
-                    {"text", output}
-                };
-            }
-
-            return result;
+                call.finish(result);
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -2975,37 +3600,39 @@ int main(int argc, char *argv[])
             {"type", "object"},
             {"properties", QJsonObject{}}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QElapsedTimer timer;
             timer.start();
             QString requestId = QUuid::createUuid().toString();
 
-            QJsonObject result = bridge.executeCommand([](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->getCrossOriginIsolationStatus(cb);
-            });
-
-            qint64 duration = timer.elapsed();
-
-            QString output = "=== Cross-Origin Isolation Status ===\n";
-            output += QString("SharedArrayBuffer Available: %1\n")
-                .arg(result["sharedArrayBufferAvailable"].toBool() ? "YES" : "NO");
-            output += QString("Cross-Origin Isolated: %1\n")
-                .arg(result["crossOriginIsolated"].toBool() ? "YES" : "NO");
-            output += QString("COEP Status: %1\n").arg(result["coep"].toString());
-            output += QString("User Agent: %1\n").arg(result["userAgent"].toString());
-
-            if (!result["crossOriginIsolated"].toBool()) {
-                output += "\n⚠️ SharedArrayBuffer requires proper COOP/COEP headers:\n";
-                output += "  - Cross-Origin-Opener-Policy: same-origin\n";
-                output += "  - Cross-Origin-Embedder-Policy: require-corp\n";
-            }
+            }, 8000, [&chromiumLogger, call, params, timer, requestId](const QJsonObject& result) {
+                qint64 duration = timer.elapsed();
+
+                QString output = "=== Cross-Origin Isolation Status ===\n";
+                output += QString("SharedArrayBuffer Available: %1\n")
+                    .arg(result["sharedArrayBufferAvailable"].toBool() ? "YES" : "NO");
+                output += QString("Cross-Origin Isolated: %1\n")
+                    .arg(result["crossOriginIsolated"].toBool() ? "YES" : "NO");
+                output += QString("COEP Status: %1\n").arg(result["coep"].toString());
+                output += QString("User Agent: %1\n").arg(result["userAgent"].toString());
+
+                if (!result["crossOriginIsolated"].toBool()) {
+                    output += "\n⚠️ SharedArrayBuffer requires proper COOP/COEP headers:\n";
+                    output += "  - Cross-Origin-Opener-Policy: same-origin\n";
+                    output += "  - Cross-Origin-Embedder-Policy: require-corp\n";
+                }
 
-            chromiumLogger.logActivity("chromium_devtools_getCrossOriginIsolationStatus", requestId, params, "success", duration, QString(), "Cross-origin isolation status retrieved");
+                chromiumLogger.logActivity("chromium_devtools_getCrossOriginIsolationStatus", requestId, params, "success", duration, QString(), "Cross-origin isolation status retrieved");
 
-            return QJsonObject{
-                {"type", "text"},
-                {"text", output}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", output}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -3017,32 +3644,34 @@ int main(int argc, char *argv[])
             {"type", "object"},
             {"properties", QJsonObject{}}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QElapsedTimer timer;
             timer.start();
             QString requestId = QUuid::createUuid().toString();
 
-            QJsonObject result = bridge.executeCommand([](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->getSecurityState(cb);
-            });
-
-            qint64 duration = timer.elapsed();
+            }, 8000, [&chromiumLogger, call, params, timer, requestId](const QJsonObject& result) {
+                qint64 duration = timer.elapsed();
 
-            QString output = "=== Security State ===\n";
-            output += QString("Security State: %1\n").arg(result["securityState"].toString());
+                QString output = "=== Security State ===\n";
+                output += QString("Security State: %1\n").arg(result["securityState"].toString());
 
-            if (result.contains("certificateSecurityState")) {
-                QJsonObject cert = result["certificateSecurityState"].toObject();
-                output += QString("Certificate Valid: %1\n").arg(cert["certificateHasWeakSignature"].toBool() ? "NO" : "YES");
-                output += QString("Protocol: %1\n").arg(cert["protocol"].toString());
-            }
+                if (result.contains("certificateSecurityState")) {
+                    QJsonObject cert = result["certificateSecurityState"].toObject();
+                    output += QString("Certificate Valid: %1\n").arg(cert["certificateHasWeakSignature"].toBool() ? "NO" : "YES");
+                    output += QString("Protocol: %1\n").arg(cert["protocol"].toString());
+                }
 
-            chromiumLogger.logActivity("chromium_devtools_getSecurityState", requestId, params, "success", duration, QString(), "Security state retrieved");
+                chromiumLogger.logActivity("chromium_devtools_getSecurityState", requestId, params, "success", duration, QString(), "Security state retrieved");
 
-            return QJsonObject{
-                {"type", "text"},
-                {"text", output}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", output}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -3054,51 +3683,53 @@ int main(int argc, char *argv[])
             {"type", "object"},
             {"properties", QJsonObject{}}
         },
-        [&bridge](const QJsonObject&) -> QJsonObject {
-            QJsonObject result = bridge.executeCommand([](CDPClient* client, CDPClient::ResponseCallback cb) {
+        nullptr,
+        [&bridge](const QJsonObject&, const MCPServerStdio::ToolCall& call) {
+            auto cancel = bridge.executeCommandAsync([](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->monitorWasmInstantiation(cb);
-            });
-
-            QString output = "=== WASM Instantiation Monitor ===\n";
+            }, 8000, [call](const QJsonObject& result) {
+                QString output = "=== WASM Instantiation Monitor ===\n";
 
-            if (result.contains("available") && !result["available"].toBool()) {
-                output += "WebAssembly API not available\n";
-            } else {
-                output += QString("Monitoring Enabled: %1\n")
-                    .arg(result["monitoringEnabled"].toBool() ? "YES" : "NO");
-
-                if (result.contains("instantiations")) {
-                    QJsonArray instantiations = result["instantiations"].toArray();
-                    output += QString("\nInstantiation Attempts: %1\n\n").arg(instantiations.size());
-
-                    for (const QJsonValue& val : instantiations) {
-                        QJsonObject inst = val.toObject();
-                        output += QString("[%1] Method: %2\n")
-                            .arg(inst["timestamp"].toString())
-                            .arg(inst["method"].toString());
-                        output += QString("  Success: %1\n")
-                            .arg(inst["success"].toBool() ? "YES" : "NO");
-
-                        if (!inst["success"].toBool()) {
-                            output += QString("  Error: %1\n").arg(inst["error"].toString());
-                        } else {
-                            if (inst.contains("exports")) {
-                                QJsonArray exports = inst["exports"].toArray();
-                                output += QString("  Exports: %1 functions\n").arg(exports.size());
+                if (result.contains("available") && !result["available"].toBool()) {
+                    output += "WebAssembly API not available\n";
+                } else {
+                    output += QString("Monitoring Enabled: %1\n")
+                        .arg(result["monitoringEnabled"].toBool() ? "YES" : "NO");
+
+                    if (result.contains("instantiations")) {
+                        QJsonArray instantiations = result["instantiations"].toArray();
+                        output += QString("\nInstantiation Attempts: %1\n\n").arg(instantiations.size());
+
+                        for (const QJsonValue& val : instantiations) {
+                            QJsonObject inst = val.toObject();
+                            output += QString("[%1] Method: %2\n")
+                                .arg(inst["timestamp"].toString())
+                                .arg(inst["method"].toString());
+                            output += QString("  Success: %1\n")
+                                .arg(inst["success"].toBool() ? "YES" : "NO");
+
+                            if (!inst["success"].toBool()) {
+                                output += QString("  Error: %1\n").arg(inst["error"].toString());
+                            } else {
+                                if (inst.contains("exports")) {
+                                    QJsonArray exports = inst["exports"].toArray();
+                                    output += QString("  Exports: %1 functions\n").arg(exports.size());
+                                }
                             }
-                        }
 
-                        output += QString("  Duration: %1ms\n\n").arg(inst["duration"].toDouble());
+                            output += QString("  Duration: %1ms\n\n").arg(inst["duration"].toDouble());
+                        }
                     }
-                }
 
-                output += "\n📝 Console will show [WASM] prefixed messages for future instantiations\n";
-            }
+                    output += "\n📝 Console will show [WASM] prefixed messages for future instantiations\n";
+                }
 
-            return QJsonObject{
-                {"type", "text"},
-                {"text", output}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", output}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -3110,50 +3741,52 @@ int main(int argc, char *argv[])
             {"type", "object"},
             {"properties", QJsonObject{}}
         },
-        [&bridge](const QJsonObject&) -> QJsonObject {
-            QJsonObject result = bridge.executeCommand([](CDPClient* client, CDPClient::ResponseCallback cb) {
+        nullptr,
+        [&bridge](const QJsonObject&, const MCPServerStdio::ToolCall& call) {
+            auto cancel = bridge.executeCommandAsync([](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->getAudioWorkletState(cb);
-            });
-
-            QString output = "=== AudioWorklet State ===\n";
+            }, 8000, [call](const QJsonObject& result) {
+                QString output = "=== AudioWorklet State ===\n";
 
-            // Check AudioWorklet availability
-            if (result.contains("audioWorkletNodeAvailable")) {
-                output += QString("AudioWorkletNode API: %1\n")
-                    .arg(result["audioWorkletNodeAvailable"].toBool() ? "Available" : "Not Available");
-            }
-
-            if (result.contains("audioWorkletAvailable")) {
-                output += QString("AudioWorklet on Context: %1\n")
-                    .arg(result["audioWorkletAvailable"].toBool() ? "Available" : "Not Available");
-            }
-
-            output += QString("SharedArrayBuffer: %1\n")
-                .arg(result["sharedArrayBufferAvailable"].toBool() ? "Available" : "Not Available");
+                // Check AudioWorklet availability
+                if (result.contains("audioWorkletNodeAvailable")) {
+                    output += QString("AudioWorkletNode API: %1\n")
+                        .arg(result["audioWorkletNodeAvailable"].toBool() ? "Available" : "Not Available");
+                }
 
-            // Audio contexts
-            if (result.contains("audioContexts")) {
-                QJsonArray contexts = result["audioContexts"].toArray();
-                output += QString("\nAudio Contexts: %1\n").arg(contexts.size());
+                if (result.contains("audioWorkletAvailable")) {
+                    output += QString("AudioWorklet on Context: %1\n")
+                        .arg(result["audioWorkletAvailable"].toBool() ? "Available" : "Not Available");
+                }
 
-                for (const QJsonValue& val : contexts) {
-                    QJsonObject ctx = val.toObject();
-                    output += QString("\n  State: %1\n").arg(ctx["state"].toString());
-                    output += QString("  Sample Rate: %1\n").arg(ctx["sampleRate"].toDouble());
-                    output += QString("  Current Time: %1\n").arg(ctx["currentTime"].toDouble());
-                    output += QString("  Has Worklet: %1\n")
-                        .arg(ctx["hasWorklet"].toBool() ? "YES" : "NO");
+                output += QString("SharedArrayBuffer: %1\n")
+                    .arg(result["sharedArrayBufferAvailable"].toBool() ? "Available" : "Not Available");
+
+                // Audio contexts
+                if (result.contains("audioContexts")) {
+                    QJsonArray contexts = result["audioContexts"].toArray();
+                    output += QString("\nAudio Contexts: %1\n").arg(contexts.size());
+
+                    for (const QJsonValue& val : contexts) {
+                        QJsonObject ctx = val.toObject();
+                        output += QString("\n  State: %1\n").arg(ctx["state"].toString());
+                        output += QString("  Sample Rate: %1\n").arg(ctx["sampleRate"].toDouble());
+                        output += QString("  Current Time: %1\n").arg(ctx["currentTime"].toDouble());
+                        output += QString("  Has Worklet: %1\n")
+                            .arg(ctx["hasWorklet"].toBool() ? "YES" : "NO");
+                    }
                 }
-            }
 
-            if (!result["audioWorkletAvailable"].toBool()) {
-                output += "\n⚠️ AudioWorklet not available - needed for WASM audio processing\n";
-            }
+                if (!result["audioWorkletAvailable"].toBool()) {
+                    output += "\n⚠️ AudioWorklet not available - needed for WASM audio processing\n";
+                }
 
-            return QJsonObject{
-                {"type", "text"},
-                {"text", output}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", output}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -3165,63 +3798,65 @@ int main(int argc, char *argv[])
             {"type", "object"},
             {"properties", QJsonObject{}}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QElapsedTimer timer;
             timer.start();
             QString requestId = QUuid::createUuid().toString();
 
-            QJsonObject result = bridge.executeCommand([](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->getPerformanceTimeline(cb);
-            });
+            }, 8000, [&chromiumLogger, call, params, timer, requestId](const QJsonObject& result) {
+                qint64 duration = timer.elapsed();
 
-            qint64 duration = timer.elapsed();
+                QString output = "=== Performance Timeline ===\n";
+
+                // Navigation timing
+                if (result.contains("result")) {
+                    QJsonObject timeline = result["result"].toObject()["value"].toObject();
+
+                    if (timeline.contains("navigation")) {
+                        QJsonObject nav = timeline["navigation"].toObject();
+                        output += "\nNavigation Timing:\n";
+                        output += QString("  DOM Content Loaded: %1ms\n").arg(nav["domContentLoaded"].toDouble());
+                        output += QString("  Page Load Complete: %1ms\n").arg(nav["loadComplete"].toDouble());
+                    }
 
-            QString output = "=== Performance Timeline ===\n";
-
-            // Navigation timing
-            if (result.contains("result")) {
-                QJsonObject timeline = result["result"].toObject()["value"].toObject();
-
-                if (timeline.contains("navigation")) {
-                    QJsonObject nav = timeline["navigation"].toObject();
-                    output += "\nNavigation Timing:\n";
-                    output += QString("  DOM Content Loaded: %1ms\n").arg(nav["domContentLoaded"].toDouble());
-                    output += QString("  Page Load Complete: %1ms\n").arg(nav["loadComplete"].toDouble());
-                }
-
-                // WASM and AudioWorklet resources
-                if (timeline.contains("resources")) {
-                    QJsonArray resources = timeline["resources"].toArray();
-                    if (!resources.isEmpty()) {
-                        output += "\nWASM/AudioWorklet Resources:\n";
-                        for (const QJsonValue& val : resources) {
-                            QJsonObject res = val.toObject();
-                            output += QString("\n  %1\n").arg(res["name"].toString());
-                            output += QString("    Duration: %1ms\n").arg(res["duration"].toDouble());
-                            output += QString("    Start Time: %1ms\n").arg(res["startTime"].toDouble());
-                            output += QString("    Transfer Size: %1 bytes\n").arg(res["transferSize"].toDouble());
-                            output += QString("    Decoded Size: %1 bytes\n").arg(res["decodedBodySize"].toDouble());
+                    // WASM and AudioWorklet resources
+                    if (timeline.contains("resources")) {
+                        QJsonArray resources = timeline["resources"].toArray();
+                        if (!resources.isEmpty()) {
+                            output += "\nWASM/AudioWorklet Resources:\n";
+                            for (const QJsonValue& val : resources) {
+                                QJsonObject res = val.toObject();
+                                output += QString("\n  %1\n").arg(res["name"].toString());
+                                output += QString("    Duration: %1ms\n").arg(res["duration"].toDouble());
+                                output += QString("    Start Time: %1ms\n").arg(res["startTime"].toDouble());
+                                output += QString("    Transfer Size: %1 bytes\n").arg(res["transferSize"].toDouble());
+                                output += QString("    Decoded Size: %1 bytes\n").arg(res["decodedBodySize"].toDouble());
+                            }
+                        } else {
+                            output += "\nNo WASM or AudioWorklet resources found in timeline\n";
                         }
-                    } else {
-                        output += "\nNo WASM or AudioWorklet resources found in timeline\n";
                     }
-                }
 
-                // Memory info
-                if (timeline.contains("memory")) {
-                    QJsonObject mem = timeline["memory"].toObject();
-                    output += "\nMemory Usage:\n";
-                    output += QString("  Used JS Heap: %1 MB\n").arg(mem["usedJSHeapSize"].toDouble() / 1048576);
-                    output += QString("  Total JS Heap: %1 MB\n").arg(mem["totalJSHeapSize"].toDouble() / 1048576);
+                    // Memory info
+                    if (timeline.contains("memory")) {
+                        QJsonObject mem = timeline["memory"].toObject();
+                        output += "\nMemory Usage:\n";
+                        output += QString("  Used JS Heap: %1 MB\n").arg(mem["usedJSHeapSize"].toDouble() / 1048576);
+                        output += QString("  Total JS Heap: %1 MB\n").arg(mem["totalJSHeapSize"].toDouble() / 1048576);
+                    }
                 }
-            }
 
-            chromiumLogger.logActivity("chromium_devtools_getPerformanceTimeline", requestId, params, "success", duration, QString(), "Performance timeline retrieved");
+                chromiumLogger.logActivity("chromium_devtools_getPerformanceTimeline", requestId, params, "success", duration, QString(), "Performance timeline retrieved");
 
-            return QJsonObject{
-                {"type", "text"},
-                {"text", output}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", output}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -3239,47 +3874,49 @@ int main(int argc, char *argv[])
             }},
             {"required", QJsonArray{"requestId"}}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QString requestId = params["requestId"].toString();
 
-            QJsonObject result = bridge.executeCommand([requestId](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([requestId](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->getResponseBody(requestId, cb);
-            });
-
-            QString output = "=== Response Body Info ===\n";
-            output += QString("Request ID: %1\n").arg(requestId);
+            }, 8000, [call, requestId](const QJsonObject& result) {
+                QString output = "=== Response Body Info ===\n";
+                output += QString("Request ID: %1\n").arg(requestId);
 
-            if (result.contains("base64Encoded")) {
-                output += QString("Base64 Encoded: %1\n").arg(result["base64Encoded"].toBool() ? "YES" : "NO");
+                if (result.contains("base64Encoded")) {
+                    output += QString("Base64 Encoded: %1\n").arg(result["base64Encoded"].toBool() ? "YES" : "NO");
 
-                if (result.contains("decodedSize")) {
-                    output += QString("Decoded Size: %1 bytes\n").arg(result["decodedSize"].toInt());
-                }
+                    if (result.contains("decodedSize")) {
+                        output += QString("Decoded Size: %1 bytes\n").arg(result["decodedSize"].toInt());
+                    }
 
-                if (result.contains("isWasmModule") && result["isWasmModule"].toBool()) {
-                    output += "\n✅ Valid WASM Module Detected!\n";
-                    output += QString("WASM Version: %1\n").arg(result["wasmVersion"].toInt());
-                } else if (result["base64Encoded"].toBool()) {
-                    output += "\n❌ Not a valid WASM module (wrong magic number)\n";
-                }
+                    if (result.contains("isWasmModule") && result["isWasmModule"].toBool()) {
+                        output += "\n✅ Valid WASM Module Detected!\n";
+                        output += QString("WASM Version: %1\n").arg(result["wasmVersion"].toInt());
+                    } else if (result["base64Encoded"].toBool()) {
+                        output += "\n❌ Not a valid WASM module (wrong magic number)\n";
+                    }
 
-                // Show first 100 chars of body if not binary
-                if (!result["base64Encoded"].toBool()) {
-                    QString body = result["body"].toString();
-                    if (body.length() > 100) {
-                        output += QString("\nFirst 100 chars:\n%1...\n").arg(body.left(100));
-                    } else {
-                        output += QString("\nBody:\n%1\n").arg(body);
+                    // Show first 100 chars of body if not binary
+                    if (!result["base64Encoded"].toBool()) {
+                        QString body = result["body"].toString();
+                        if (body.length() > 100) {
+                            output += QString("\nFirst 100 chars:\n%1...\n").arg(body.left(100));
+                        } else {
+                            output += QString("\nBody:\n%1\n").arg(body);
+                        }
                     }
+                } else {
+                    output += "Unable to retrieve response body\n";
                 }
-            } else {
-                output += "Unable to retrieve response body\n";
-            }
 
-            return QJsonObject{
-                {"type", "text"},
-                {"text", output}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", output}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -3313,58 +3950,60 @@ int main(int argc, char *argv[])
                 }}
             }}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QElapsedTimer timer;
             timer.start();
             QString requestId = QUuid::createUuid().toString();
-            QJsonObject result = bridge.executeCommand([params](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([params](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->getWebSocketFrames(params, cb);
-            });
-
-            QString output = "=== WebSocket Frames ===\n\n";
-            QJsonArray frames = result["frames"].toArray();
-            int total = result["total"].toInt();
-
-            if (frames.isEmpty()) {
-                output += "No WebSocket frames captured.\n";
-            } else {
-                for (const QJsonValue& val : frames) {
-                    QJsonObject frame = val.toObject();
-                    output += QString("[%1] %2 %3\n")
-                        .arg(frame["timestamp"].toString())
-                        .arg(frame["direction"].toString().toUpper())
-                        .arg(frame["url"].toString());
-
-                    if (frame.contains("liveViewEvent")) {
-                        output += QString("  LiveView Event: %1\n").arg(frame["liveViewEvent"].toString());
-                    }
+            }, 8000, [&chromiumLogger, call, params, timer, requestId](const QJsonObject& result) {
+                QString output = "=== WebSocket Frames ===\n\n";
+                QJsonArray frames = result["frames"].toArray();
+                int total = result["total"].toInt();
 
-                    if (frame.contains("parsedData")) {
-                        QJsonDocument doc(frame["parsedData"].toObject());
-                        if (doc.isEmpty()) {
-                            doc = QJsonDocument(frame["parsedData"].toArray());
+                if (frames.isEmpty()) {
+                    output += "No WebSocket frames captured.\n";
+                } else {
+                    for (const QJsonValue& val : frames) {
+                        QJsonObject frame = val.toObject();
+                        output += QString("[%1] %2 %3\n")
+                            .arg(frame["timestamp"].toString())
+                            .arg(frame["direction"].toString().toUpper())
+                            .arg(frame["url"].toString());
+
+                        if (frame.contains("liveViewEvent")) {
+                            output += QString("  LiveView Event: %1\n").arg(frame["liveViewEvent"].toString());
                         }
-                        output += "  Parsed: " + doc.toJson(QJsonDocument::Compact) + "\n";
-                    } else if (frame.contains("data")) {
-                        QString data = frame["data"].toString();
-                        if (data.length() > 200) {
-                            data = data.left(200) + "...";
+
+                        if (frame.contains("parsedData")) {
+                            QJsonDocument doc(frame["parsedData"].toObject());
+                            if (doc.isEmpty()) {
+                                doc = QJsonDocument(frame["parsedData"].toArray());
+                            }
+                            output += "  Parsed: " + doc.toJson(QJsonDocument::Compact) + "\n";
+                        } else if (frame.contains("data")) {
+                            QString data = frame["data"].toString();
+                            if (data.length() > 200) {
+                                data = data.left(200) + "...";
+                            }
+                            output += "  Data: " + data + "\n";
                         }
-                        output += "  Data: " + data + "\n";
+                        output += "\n";
                     }
-                    output += "\n";
                 }
-            }
 
-            output += QString("\nTotal frames captured: %1\n").arg(total);
+                output += QString("\nTotal frames captured: %1\n").arg(total);
 
-            qint64 duration = timer.elapsed();
-            chromiumLogger.logActivity("chromium_devtools_getWebSocketFrames", requestId, params, "success", duration, QString(), QString("Retrieved %1 WebSocket frames").arg(frames.size()));
+                qint64 duration = timer.elapsed();
+                chromiumLogger.logActivity("chromium_devtools_getWebSocketFrames", requestId, params, "success", duration, QString(), QString("Retrieved %1 WebSocket frames").arg(frames.size()));
 
-            return QJsonObject{
-                {"type", "text"},
-                {"text", output}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", output}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -3376,15 +4015,18 @@ int main(int argc, char *argv[])
             {"type", "object"},
             {"properties", QJsonObject{}}
         },
-        [&bridge](const QJsonObject&) -> QJsonObject {
-            bridge.executeCommand([](CDPClient* client, CDPClient::ResponseCallback) {
+        nullptr,
+        [&bridge](const QJsonObject&, const MCPServerStdio::ToolCall& call) {
+            auto cancel = bridge.executeCommandAsync([](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->clearWebSocketFrames();
+                cb(QJsonObject{{"cleared", true}}, QString());
+            }, 8000, [call](const QJsonObject&) {
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", "WebSocket frames cleared successfully"}
+                });
             });
-
-            return QJsonObject{
-                {"type", "text"},
-                {"text", "WebSocket frames cleared successfully"}
-            };
+            call.onCancel(cancel);
         }
     });
 
@@ -3401,31 +4043,33 @@ int main(int argc, char *argv[])
                 }}
             }}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QString selector = params["selector"].toString();
             if (selector.isEmpty()) {
                 selector = "body";
             }
 
-            QJsonObject result = bridge.executeCommand([selector](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([selector](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->startDOMMutationObserver(selector, cb);
-            });
-
-            QString output;
-            if (result.contains("error")) {
-                output = QString("Failed to start observer: %1").arg(result["error"].toString());
-            } else if (result["success"].toBool()) {
-                output = QString("DOM Mutation Observer started on: %1\n").arg(result["observing"].toString());
-                output += "\nMutations will be captured in the console with [DOM_MUTATION] prefix.\n";
-                output += "Use getDOMMutations to retrieve captured mutations.";
-            } else {
-                output = "Failed to start DOM Mutation Observer";
-            }
+            }, 8000, [call](const QJsonObject& result) {
+                QString output;
+                if (result.contains("error")) {
+                    output = QString("Failed to start observer: %1").arg(result["error"].toString());
+                } else if (result["success"].toBool()) {
+                    output = QString("DOM Mutation Observer started on: %1\n").arg(result["observing"].toString());
+                    output += "\nMutations are batched per animation frame and kept separately from console messages.\n";
+                    output += "Use getDOMMutations to retrieve captured mutations.";
+                } else {
+                    output = "Failed to start DOM Mutation Observer";
+                }
 
-            return QJsonObject{
-                {"type", "text"},
-                {"text", output}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", output}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -3437,22 +4081,24 @@ int main(int argc, char *argv[])
             {"type", "object"},
             {"properties", QJsonObject{}}
         },
-        [&bridge](const QJsonObject&) -> QJsonObject {
-            QJsonObject result = bridge.executeCommand([](CDPClient* client, CDPClient::ResponseCallback cb) {
+        nullptr,
+        [&bridge](const QJsonObject&, const MCPServerStdio::ToolCall& call) {
+            auto cancel = bridge.executeCommandAsync([](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->stopDOMMutationObserver(cb);
-            });
-
-            QString output;
-            if (result["success"].toBool()) {
-                output = "DOM Mutation Observer stopped successfully";
-            } else {
-                output = QString("Failed to stop observer: %1").arg(result.value("error").toString("Unknown error"));
-            }
+            }, 8000, [call](const QJsonObject& result) {
+                QString output;
+                if (result["success"].toBool()) {
+                    output = "DOM Mutation Observer stopped successfully";
+                } else {
+                    output = QString("Failed to stop observer: %1").arg(result.value("error").toString("Unknown error"));
+                }
 
-            return QJsonObject{
-                {"type", "text"},
-                {"text", output}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", output}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -3469,63 +4115,71 @@ int main(int argc, char *argv[])
                 }}
             }}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
-            QJsonObject result = bridge.executeCommand([params](CDPClient* client, CDPClient::ResponseCallback cb) {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
+            auto cancel = bridge.executeCommandAsync([params](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->getDOMMutations(params, cb);
-            });
+            }, 8000, [call](const QJsonObject& result) {
+                QString output = "=== DOM Mutations ===\n\n";
+                QJsonArray mutations = result["mutations"].toArray();
 
-            QString output = "=== DOM Mutations ===\n\n";
-            QJsonArray mutations = result["mutations"].toArray();
-
-            if (mutations.isEmpty()) {
-                output += "No DOM mutations captured.\n";
-                output += "Start observing with chromium_devtools_startDOMMutationObserver first.";
-            } else {
-                for (const QJsonValue& val : mutations) {
-                    QJsonObject mutation = val.toObject();
-                    output += QString("[%1] %2\n")
-                        .arg(mutation["timestamp"].toString())
-                        .arg(mutation["type"].toString());
-
-                    if (mutation.contains("target")) {
-                        output += QString("  Target: %1\n").arg(mutation["target"].toString());
-                    }
-                    if (mutation.contains("attributeName")) {
-                        output += QString("  Attribute: %1\n").arg(mutation["attributeName"].toString());
-                    }
-                    if (mutation.contains("oldValue")) {
-                        output += QString("  Old Value: %1\n").arg(mutation["oldValue"].toString());
-                    }
-                    if (mutation.contains("addedNodes")) {
-                        QJsonArray added = mutation["addedNodes"].toArray();
-                        if (!added.isEmpty()) {
-                            output += "  Added: ";
-                            for (const QJsonValue& node : added) {
-                                output += node.toString() + " ";
+                if (mutations.isEmpty()) {
+                    output += "No DOM mutations captured.\n";
+                    output += "Start observing with chromium_devtools_startDOMMutationObserver first.";
+                } else {
+                    for (const QJsonValue& val : mutations) {
+                        QJsonObject mutation = val.toObject();
+                        output += QString("[%1] %2\n")
+                            .arg(mutation["timestamp"].toString())
+                            .arg(mutation["type"].toString());
+
+                        if (mutation.contains("target")) {
+                            output += QString("  Target: %1\n").arg(mutation["target"].toString());
+                        }
+                        if (mutation.contains("attributeName")) {
+                            output += QString("  Attribute: %1\n").arg(mutation["attributeName"].toString());
+                        }
+                        if (mutation.contains("oldValue")) {
+                            output += QString("  Old Value: %1\n").arg(mutation["oldValue"].toString());
+                        }
+                        if (mutation.contains("newValue")) {
+                            output += QString("  New Value: %1\n").arg(mutation["newValue"].toString());
+                        }
+                        if (mutation.contains("addedNodes")) {
+                            QJsonArray added = mutation["addedNodes"].toArray();
+                            if (!added.isEmpty()) {
+                                output += "  Added: ";
+                                for (const QJsonValue& node : added) {
+                                    output += node.toString() + " ";
+                                }
+                                output += "\n";
                             }
-                            output += "\n";
                         }
-                    }
-                    if (mutation.contains("removedNodes")) {
-                        QJsonArray removed = mutation["removedNodes"].toArray();
-                        if (!removed.isEmpty()) {
-                            output += "  Removed: ";
-                            for (const QJsonValue& node : removed) {
-                                output += node.toString() + " ";
+                        if (mutation.contains("removedNodes")) {
+                            QJsonArray removed = mutation["removedNodes"].toArray();
+                            if (!removed.isEmpty()) {
+                                output += "  Removed: ";
+                                for (const QJsonValue& node : removed) {
+                                    output += node.toString() + " ";
+                                }
+                                output += "\n";
                             }
-                            output += "\n";
                         }
+                        output += "\n";
                     }
-                    output += "\n";
                 }
-            }
 
-            output += QString("\nTotal mutations: %1\n").arg(mutations.size());
+                output += QString("\nTotal mutations: %1\n").arg(mutations.size());
+                if (result.contains("dropped")) {
+                    output += QString("Dropped by the per-frame cap: %1\n").arg(result["dropped"].toInteger());
+                }
 
-            return QJsonObject{
-                {"type", "text"},
-                {"text", output}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", output}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -3537,15 +4191,18 @@ int main(int argc, char *argv[])
             {"type", "object"},
             {"properties", QJsonObject{}}
         },
-        [&bridge](const QJsonObject&) -> QJsonObject {
-            bridge.executeCommand([](CDPClient* client, CDPClient::ResponseCallback) {
+        nullptr,
+        [&bridge](const QJsonObject&, const MCPServerStdio::ToolCall& call) {
+            auto cancel = bridge.executeCommandAsync([](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->clearDOMMutations();
+                cb(QJsonObject{{"cleared", true}}, QString());
+            }, 8000, [call](const QJsonObject&) {
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", "DOM mutations cleared successfully"}
+                });
             });
-
-            return QJsonObject{
-                {"type", "text"},
-                {"text", "DOM mutations cleared successfully"}
-            };
+            call.onCancel(cancel);
         }
     });
 
@@ -3557,56 +4214,58 @@ int main(int argc, char *argv[])
             {"type", "object"},
             {"properties", QJsonObject{}}
         },
-        [&bridge](const QJsonObject&) -> QJsonObject {
-            QJsonObject result = bridge.executeCommand([](CDPClient* client, CDPClient::ResponseCallback cb) {
+        nullptr,
+        [&bridge](const QJsonObject&, const MCPServerStdio::ToolCall& call) {
+            auto cancel = bridge.executeCommandAsync([](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->getJavaScriptProfile(cb);
-            });
-
-            QString output = "=== JavaScript Performance Profile ===\n\n";
-
-            // Performance measures
-            QJsonArray measures = result["measures"].toArray();
-            if (!measures.isEmpty()) {
-                output += "Performance Measures:\n";
-                for (const QJsonValue& val : measures) {
-                    QJsonObject measure = val.toObject();
-                    output += QString("  %1: %2ms (start: %3ms)\n")
-                        .arg(measure["name"].toString())
-                        .arg(measure["duration"].toDouble(), 0, 'f', 2)
-                        .arg(measure["startTime"].toDouble(), 0, 'f', 2);
+            }, 8000, [call](const QJsonObject& result) {
+                QString output = "=== JavaScript Performance Profile ===\n\n";
+
+                // Performance measures
+                QJsonArray measures = result["measures"].toArray();
+                if (!measures.isEmpty()) {
+                    output += "Performance Measures:\n";
+                    for (const QJsonValue& val : measures) {
+                        QJsonObject measure = val.toObject();
+                        output += QString("  %1: %2ms (start: %3ms)\n")
+                            .arg(measure["name"].toString())
+                            .arg(measure["duration"].toDouble(), 0, 'f', 2)
+                            .arg(measure["startTime"].toDouble(), 0, 'f', 2);
+                    }
+                    output += "\n";
                 }
-                output += "\n";
-            }
 
-            // Hook stats
-            QJsonObject hookStats = result["hookStats"].toObject();
-            if (!hookStats.isEmpty()) {
-                output += "LiveView Hook Stats:\n";
-                for (auto it = hookStats.begin(); it != hookStats.end(); ++it) {
-                    output += QString("  %1: %2\n").arg(it.key()).arg(it.value().toString());
+                // Hook stats
+                QJsonObject hookStats = result["hookStats"].toObject();
+                if (!hookStats.isEmpty()) {
+                    output += "LiveView Hook Stats:\n";
+                    for (auto it = hookStats.begin(); it != hookStats.end(); ++it) {
+                        output += QString("  %1: %2\n").arg(it.key()).arg(it.value().toString());
+                    }
+                    output += "\n";
                 }
-                output += "\n";
-            }
 
-            // Memory usage
-            if (result.contains("usedJSHeapSize")) {
-                double used = result["usedJSHeapSize"].toDouble() / 1024 / 1024;
-                double total = result["totalJSHeapSize"].toDouble() / 1024 / 1024;
-                output += QString("Memory Usage:\n");
-                output += QString("  Used: %.2f MB\n").arg(used);
-                output += QString("  Total: %.2f MB\n").arg(total);
-                output += QString("  Usage: %.1f%%\n").arg((used / total) * 100);
-            }
+                // Memory usage
+                if (result.contains("usedJSHeapSize")) {
+                    double used = result["usedJSHeapSize"].toDouble() / 1024 / 1024;
+                    double total = result["totalJSHeapSize"].toDouble() / 1024 / 1024;
+                    output += QString("Memory Usage:\n");
+                    output += QString("  Used: %.2f MB\n").arg(used);
+                    output += QString("  Total: %.2f MB\n").arg(total);
+                    output += QString("  Usage: %.1f%%\n").arg((used / total) * 100);
+                }
 
-            if (measures.isEmpty() && hookStats.isEmpty()) {
-                output += "No performance data captured.\n";
-                output += "LiveView hooks can be profiled by adding performance.mark() calls.";
-            }
+                if (measures.isEmpty() && hookStats.isEmpty()) {
+                    output += "No performance data captured.\n";
+                    output += "LiveView hooks can be profiled by adding performance.mark() calls.";
+                }
 
-            return QJsonObject{
-                {"type", "text"},
-                {"text", output}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", output}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -3625,24 +4284,9 @@ int main(int argc, char *argv[])
                 }}
             }}
         },
-        [&tidewaveBridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
-            QString requestId = QUuid::createUuid().toString();
-            QElapsedTimer timer;
-            timer.start();
-
-            QJsonObject result = tidewaveBridge.executeCommand("get_logs", params);
-
-            if (result.contains("error")) {
-                QString error = result["message"].toString();
-// Logging disabled for non-chromium tools:                 chromiumLogger.logActivity("tidewave_get_logs", requestId, params, "error", timer.elapsed(), error);
-                return QJsonObject{
-                    {"type", "text"},
-                    {"text", error}
-                };
-            }
-
-// Logging disabled for non-chromium tools:             chromiumLogger.logActivity("tidewave_get_logs", requestId, params, "success", timer.elapsed(), QString(), result);
-            return tidewaveBridge.formatResponse(result);
+        nullptr,
+        [&tidewaveBridge](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
+            tidewaveBridge.callTool("get_logs", params, call);
         }
     });
 
@@ -3659,24 +4303,9 @@ int main(int argc, char *argv[])
                 }}
             }}
         },
-        [&tidewaveBridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
-            QString requestId = QUuid::createUuid().toString();
-            QElapsedTimer timer;
-            timer.start();
-
-            QJsonObject result = tidewaveBridge.executeCommand("get_source_location", params);
-
-            if (result.contains("error")) {
-                QString error = result["message"].toString();
-// Logging disabled for non-chromium tools:                 chromiumLogger.logActivity("tidewave_get_source_location", requestId, params, "error", timer.elapsed(), error);
-                return QJsonObject{
-                    {"type", "text"},
-                    {"text", error}
-                };
-            }
-
-// Logging disabled for non-chromium tools:             chromiumLogger.logActivity("tidewave_get_source_location", requestId, params, "success", timer.elapsed(), QString(), result);
-            return tidewaveBridge.formatResponse(result);
+        nullptr,
+        [&tidewaveBridge](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
+            tidewaveBridge.callTool("get_source_location", params, call);
         }
     });
 
@@ -3693,24 +4322,9 @@ int main(int argc, char *argv[])
                 }}
             }}
         },
-        [&tidewaveBridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
-            QString requestId = QUuid::createUuid().toString();
-            QElapsedTimer timer;
-            timer.start();
-
-            QJsonObject result = tidewaveBridge.executeCommand("get_docs", params);
-
-            if (result.contains("error")) {
-                QString error = result["message"].toString();
-// Logging disabled for non-chromium tools:                 chromiumLogger.logActivity("tidewave_get_docs", requestId, params, "error", timer.elapsed(), error);
-                return QJsonObject{
-                    {"type", "text"},
-                    {"text", error}
-                };
-            }
-
-// Logging disabled for non-chromium tools:             chromiumLogger.logActivity("tidewave_get_docs", requestId, params, "success", timer.elapsed(), QString(), result);
-            return tidewaveBridge.formatResponse(result);
+        nullptr,
+        [&tidewaveBridge](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
+            tidewaveBridge.callTool("get_docs", params, call);
         }
     });
 
@@ -3736,25 +4350,9 @@ int main(int argc, char *argv[])
                 }}
             }}
         },
-        [&tidewaveBridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
-            QString requestId = QUuid::createUuid().toString();
-            QElapsedTimer timer;
-            timer.start();
-
-            QJsonObject result = tidewaveBridge.executeCommand("project_eval", params);
-
-            if (result.contains("error")) {
-                QString error = result["message"].toString();
-// Logging disabled for non-chromium tools:                 chromiumLogger.logActivity("tidewave_project_eval", requestId, params, "error", timer.elapsed(), error);
-                return QJsonObject{
-                    {"type", "text"},
-                    {"text", error},
-                    {"isError", true}
-                };
-            }
-
-// Logging disabled for non-chromium tools:             chromiumLogger.logActivity("tidewave_project_eval", requestId, params, "success", timer.elapsed(), QString(), result);
-            return tidewaveBridge.formatResponse(result);
+        nullptr,
+        [&tidewaveBridge](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
+            tidewaveBridge.callTool("project_eval", params, call, true);
         }
     });
 
@@ -3771,7 +4369,8 @@ int main(int argc, char *argv[])
                 }}
             }}
         },
-        [&bridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
+        nullptr,
+        [&bridge, &chromiumLogger](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
             QString requestId = QUuid::createUuid().toString();
             QElapsedTimer timer;
             timer.start();
@@ -3802,42 +4401,44 @@ int main(int argc, char *argv[])
 })()
             )JS").arg(escapedCode);
 
-            QJsonObject result = bridge.executeCommand([jsExpression](CDPClient* client, CDPClient::ResponseCallback cb) {
+            auto cancel = bridge.executeCommandAsync([jsExpression](CDPClient* client, CDPClient::ResponseCallback cb) {
                 client->evaluateJavaScript(jsExpression, cb);
-            });
-
-            qint64 duration = timer.elapsed();
-
-            if (result.contains("exceptionDetails")) {
-                QJsonObject exception = result["exceptionDetails"].toObject();
-                QString errorText = exception["text"].toString();
-                chromiumLogger.logActivity("tau5_hydra_eval", requestId, params, "exception", duration, errorText);
-                return QJsonObject{
-                    {"type", "text"},
-                    {"text", QString("JavaScript exception: %1").arg(errorText)},
-                    {"isError", true}
-                };
-            }
+            }, 8000, [&chromiumLogger, call, params, requestId, timer](const QJsonObject& result) {
+                qint64 duration = timer.elapsed();
+
+                if (result.contains("exceptionDetails")) {
+                    QJsonObject exception = result["exceptionDetails"].toObject();
+                    QString errorText = exception["text"].toString();
+                    chromiumLogger.logActivity("tau5_hydra_eval", requestId, params, "exception", duration, errorText);
+                    call.finish(QJsonObject{
+                        {"type", "text"},
+                        {"text", QString("JavaScript exception: %1").arg(errorText)},
+                        {"isError", true}
+                    });
+                    return;
+                }
 
-            // Extract the result
-            QString resultText;
-            if (result.contains("result")) {
-                QJsonObject resultObj = result["result"].toObject();
-                if (resultObj.contains("value")) {
-                    resultText = resultObj["value"].toString();
+                // Extract the result
+                QString resultText;
+                if (result.contains("result")) {
+                    QJsonObject resultObj = result["result"].toObject();
+                    if (resultObj.contains("value")) {
+                        resultText = resultObj["value"].toString();
+                    }
                 }
-            }
 
-            if (resultText.isEmpty()) {
-                resultText = "Hydra sketch update attempted";
-            }
+                if (resultText.isEmpty()) {
+                    resultText = "Hydra sketch update attempted";
+                }
 
-            chromiumLogger.logActivity("tau5_hydra_eval", requestId, params, "success", duration, QString(), resultText);
+                chromiumLogger.logActivity("tau5_hydra_eval", requestId, params, "success", duration, QString(), resultText);
 
-            return QJsonObject{
-                {"type", "text"},
-                {"text", resultText}
-            };
+                call.finish(QJsonObject{
+                    {"type", "text"},
+                    {"text", resultText}
+                });
+            });
+            call.onCancel(cancel);
         }
     });
 
@@ -3859,24 +4460,9 @@ int main(int argc, char *argv[])
                 }}
             }}
         },
-        [&tidewaveBridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
-            QString requestId = QUuid::createUuid().toString();
-            QElapsedTimer timer;
-            timer.start();
-
-            QJsonObject result = tidewaveBridge.executeCommand("search_package_docs", params);
-
-            if (result.contains("error")) {
-                QString error = result["message"].toString();
-// Logging disabled for non-chromium tools:                 chromiumLogger.logActivity("tidewave_search_package_docs", requestId, params, "error", timer.elapsed(), error);
-                return QJsonObject{
-                    {"type", "text"},
-                    {"text", error}
-                };
-            }
-
-// Logging disabled for non-chromium tools:             chromiumLogger.logActivity("tidewave_search_package_docs", requestId, params, "success", timer.elapsed(), QString(), result);
-            return tidewaveBridge.formatResponse(result);
+        nullptr,
+        [&tidewaveBridge](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
+            tidewaveBridge.callTool("search_package_docs", params, call);
         }
     });
 
@@ -3902,24 +4488,9 @@ int main(int argc, char *argv[])
                 }}
             }}
         },
-        [&tidewaveBridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
-            QString requestId = QUuid::createUuid().toString();
-            QElapsedTimer timer;
-            timer.start();
-
-            QJsonObject result = tidewaveBridge.executeCommand("execute_sql_query", params);
-
-            if (result.contains("error")) {
-                QString error = result["message"].toString();
-// Logging disabled for non-chromium tools:                 chromiumLogger.logActivity("tidewave_execute_sql_query", requestId, params, "error", timer.elapsed(), error);
-                return QJsonObject{
-                    {"type", "text"},
-                    {"text", error}
-                };
-            }
-
-// Logging disabled for non-chromium tools:             chromiumLogger.logActivity("tidewave_execute_sql_query", requestId, params, "success", timer.elapsed(), QString(), result);
-            return tidewaveBridge.formatResponse(result);
+        nullptr,
+        [&tidewaveBridge](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
+            tidewaveBridge.callTool("execute_sql_query", params, call);
         }
     });
 
@@ -3935,24 +4506,9 @@ int main(int argc, char *argv[])
                 }}
             }}
         },
-        [&tidewaveBridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
-            QString requestId = QUuid::createUuid().toString();
-            QElapsedTimer timer;
-            timer.start();
-
-            QJsonObject result = tidewaveBridge.executeCommand("get_ecto_schemas", params);
-
-            if (result.contains("error")) {
-                QString error = result["message"].toString();
-// Logging disabled for non-chromium tools:                 chromiumLogger.logActivity("tidewave_get_ecto_schemas", requestId, params, "error", timer.elapsed(), error);
-                return QJsonObject{
-                    {"type", "text"},
-                    {"text", error}
-                };
-            }
-
-// Logging disabled for non-chromium tools:             chromiumLogger.logActivity("tidewave_get_ecto_schemas", requestId, params, "success", timer.elapsed(), QString(), result);
-            return tidewaveBridge.formatResponse(result);
+        nullptr,
+        [&tidewaveBridge](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
+            tidewaveBridge.callTool("get_ecto_schemas", params, call);
         }
     });
 
@@ -3974,28 +4530,9 @@ int main(int argc, char *argv[])
                 }}
             }}
         },
-        [&tidewaveBridge, &chromiumLogger](const QJsonObject& params) -> QJsonObject {
-            QString requestId = QUuid::createUuid().toString();
-            QElapsedTimer timer;
-            timer.start();
-
-            QString toolName = params["name"].toString();
-            QJsonObject arguments = params["arguments"].toObject();
-
-            QJsonObject result = tidewaveBridge.executeCommand(toolName, arguments);
-
-            if (result.contains("error")) {
-                QString error = result["message"].toString();
-// Logging disabled for non-chromium tools:                 chromiumLogger.logActivity("tidewave_call_tool", requestId, params, "error", timer.elapsed(), error);
-                return QJsonObject{
-                    {"type", "text"},
-                    {"text", error},
-                    {"isError", true}
-                };
-            }
-
-// Logging disabled for non-chromium tools:             chromiumLogger.logActivity("tidewave_call_tool", requestId, params, "success", timer.elapsed(), QString(), result);
-            return tidewaveBridge.formatResponse(result);
+        nullptr,
+        [&tidewaveBridge](const QJsonObject& params, const MCPServerStdio::ToolCall& call) {
+            tidewaveBridge.callTool(params["name"].toString(), params["arguments"].toObject(), call, true);
         }
     });
 
@@ -4004,6 +4541,12 @@ int main(int argc, char *argv[])
         QTimer::singleShot(100, &app, &QCoreApplication::quit);
     });
     
+    // Every CDP command goes through CDPBridge, which honours this
+    server.addToolProperty("chromium_devtools_", "target", QJsonObject{
+        {"type", "string"},
+        {"description", "Attached target to run against instead of the current one: a target id, a type (page, iframe, worker, service_worker, worklet) or a title or URL, whole or in part. See spectra_list_targets."}
+    });
+
     server.start();
 
     debugLog("MCP server ready. Starting pre-emptive CDP connection...");
@@ -4062,10 +4605,14 @@ int main(int argc, char *argv[])
     });
     
     
-    QObject::connect(cdpClient.get(), &CDPClient::consoleMessage,
-                     [](const QString& level, const QString& text) {
-        debugLog(QString("[Console %1] %2").arg(level).arg(text));
-    });
+    // Only in debug mode: with a listener attached every console event is
+    // decoded on arrival instead of when a query asks for it
+    if (debugMode) {
+        QObject::connect(cdpClient.get(), &CDPClient::consoleMessage,
+                         [](const QString& level, const QString& text) {
+            debugLog(QString("[Console %1] %2").arg(level).arg(text));
+        });
+    }
     
     return app.exec();
 }
\ No newline at end of file
@@ -89,7 +89,7 @@ QJsonObject TidewaveProxy::createJsonRpcRequest(const QString& method, const QJs
     return request;
 }
 
-void TidewaveProxy::sendRequest(const QJsonObject& request, ResponseCallback callback)
+int TidewaveProxy::sendRequest(const QJsonObject& request, ResponseCallback callback)
 {
     QNetworkRequest netRequest(m_baseUrl);
     netRequest.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
@@ -112,6 +112,44 @@ void TidewaveProxy::sendRequest(const QJsonObject& request, ResponseCallback cal
         Q_UNUSED(error)
         emit logMessage(QString("Tidewave proxy network error: %1").arg(reply->errorString()));
     });
+
+    return requestId;
+}
+
+void TidewaveProxy::cancelRequest(int requestId)
+{
+    QNetworkReply* reply = nullptr;
+    {
+        QMutexLocker locker(&m_requestMutex);
+        if (!m_pendingCallbacks.remove(requestId)) {
+            return;
+        }
+        reply = m_replyToRequestId.key(requestId, nullptr);
+        if (reply) {
+            m_replyToRequestId.remove(reply);
+        }
+    }
+
+    if (reply) {
+        reply->abort();
+    }
+
+    // Closing the HTTP request doesn't necessarily stop an evaluation that
+    // is already running, so tell the server as well (fire and forget)
+    QJsonObject notification{
+        {"jsonrpc", JSONRPC_VERSION},
+        {"method", "notifications/cancelled"},
+        {"params", QJsonObject{
+            {"requestId", requestId},
+            {"reason", "Cancelled by client"}
+        }}
+    };
+
+    QNetworkRequest netRequest(m_baseUrl);
+    netRequest.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    netRequest.setRawHeader("User-Agent", "Tau5-Spectra-TidewaveProxy/1.0");
+    QNetworkReply* notifyReply = m_networkManager->post(netRequest, QJsonDocument(notification).toJson(QJsonDocument::Compact));
+    connect(notifyReply, &QNetworkReply::finished, notifyReply, &QObject::deleteLater);
 }
 
 void TidewaveProxy::handleNetworkReply()
@@ -202,12 +240,12 @@ void TidewaveProxy::listTools(ResponseCallback callback)
     sendRequest(request, callback);
 }
 
-void TidewaveProxy::callTool(const QString& toolName, const QJsonObject& arguments, ResponseCallback callback)
+int TidewaveProxy::callTool(const QString& toolName, const QJsonObject& arguments, ResponseCallback callback)
 {
     QJsonObject params;
     params["name"] = toolName;
     params["arguments"] = arguments;
 
     QJsonObject request = createJsonRpcRequest("tools/call", params);
-    sendRequest(request, callback);
+    return sendRequest(request, callback);
 }
\ No newline at end of file
@@ -29,7 +29,12 @@ public:
     // MCP protocol methods
     void initialize(const QJsonObject& params, ResponseCallback callback);
     void listTools(ResponseCallback callback);
-    void callTool(const QString& toolName, const QJsonObject& arguments, ResponseCallback callback);
+    // Returns the request id, for cancelRequest()
+    int callTool(const QString& toolName, const QJsonObject& arguments, ResponseCallback callback);
+
+    // Aborts an in-flight request and asks Tidewave to stop working on it.
+    // The request's callback is dropped without being called.
+    void cancelRequest(int requestId);
 
 signals:
     void availabilityChanged(bool available);
@@ -40,7 +45,7 @@ private slots:
     void checkHealth();
 
 private:
-    void sendRequest(const QJsonObject& request, ResponseCallback callback);
+    int sendRequest(const QJsonObject& request, ResponseCallback callback);
     QJsonObject createJsonRpcRequest(const QString& method, const QJsonObject& params);
 
 private:
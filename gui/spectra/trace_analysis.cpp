@@ -0,0 +1,309 @@
+#include "trace_analysis.h"
+#include "cdp_peek.h"
+#include <QByteArrayView>
+#include <QFile>
+#include <QHash>
+#include <QPair>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+constexpr double DEFAULT_FRAME_BUDGET_MS = 1000.0 / 60;
+constexpr double JANK_FACTOR = 1.5;
+// Shorter complete events are not kept: they can be neither a long task,
+// a stall, nor much of either
+constexpr qint64 MIN_EVENT_US = 2000;
+
+using ThreadKey = QPair<qint64, qint64>;  // pid, tid
+
+struct Event {
+    ThreadKey thread;
+    QByteArray name;
+    QString detail;
+    qint64 ts;   // Microseconds
+    qint64 dur;
+};
+
+// Top-level scheduler tasks of the threads we look at
+bool isTask(QByteArrayView name)
+{
+    return name == "RunTask" ||
+           name == "ThreadControllerImpl::RunTask" ||
+           name == "ThreadPool_RunTask" ||
+           name == "TaskGraphRunner::RunTask" ||
+           name == "GPUTask";
+}
+
+bool isGpuThread(const QString& thread)
+{
+    return thread == "CrGpuMain" ||
+           thread == "VizCompositorThread" ||
+           thread == "Compositor" ||
+           thread.startsWith("CompositorTileWorker");
+}
+
+// "CompositorTileWorker3" and "CompositorTileWorker1/23" group together
+QString threadGroup(const QString& thread)
+{
+    qsizetype end = thread.size();
+    while (end > 0 && (thread.at(end - 1).isDigit() || thread.at(end - 1) == '/')) {
+        --end;
+    }
+    return end > 0 ? thread.left(end) : thread;
+}
+
+qint64 number(QByteArrayView event, QByteArrayView key)
+{
+    QByteArrayView text = CDPPeek::value(event, {key});
+    bool ok = false;
+    qint64 value = text.toLongLong(&ok);
+    if (!ok) {
+        value = std::llround(text.toDouble(&ok));
+    }
+    return ok ? value : 0;
+}
+
+// What a script event ran, e.g. "FunctionCall tick (app.js:120)"
+QString describe(QByteArrayView event, QByteArrayView name)
+{
+    QString detail = QString::fromUtf8(name);
+    QString function = CDPPeek::string(event, {"args", "data", "functionName"});
+    QString type = CDPPeek::string(event, {"args", "data", "type"});
+    QString url = CDPPeek::string(event, {"args", "data", "url"});
+    if (!function.isEmpty()) {
+        detail += " " + function;
+    } else if (!type.isEmpty()) {
+        detail += " " + type;
+    }
+    if (!url.isEmpty()) {
+        QString file = url.section('/', -1);
+        qint64 line = number(CDPPeek::value(event, {"args", "data"}), "lineNumber");
+        detail += QString(" (%1%2)").arg(file.isEmpty() ? url : file,
+                                         line > 0 ? QString(":%1").arg(line) : QString());
+    }
+    return detail;
+}
+
+// The next whole {...} in an array, skipping separators; false at ']'
+bool nextObject(const char*& p, const char* end, QByteArrayView& object)
+{
+    while (p < end && *p != '{') {
+        if (*p == ']') {
+            return false;
+        }
+        ++p;
+    }
+
+    const char* start = p;
+    int depth = 0;
+    bool inString = false;
+    for (; p < end; ++p) {
+        char c = *p;
+        if (inString) {
+            if (c == '\\') {
+                ++p;
+            } else if (c == '"') {
+                inString = false;
+            }
+        } else if (c == '"') {
+            inString = true;
+        } else if (c == '{' || c == '[') {
+            depth++;
+        } else if ((c == '}' || c == ']') && --depth == 0) {
+            ++p;
+            object = QByteArrayView(start, p - start);
+            return true;
+        }
+    }
+    return false;
+}
+
+double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    return sorted[qBound<size_t>(1, rank, sorted.size()) - 1];
+}
+
+} // namespace
+
+bool TraceAnalysis::load(const QString& path)
+{
+    *this = TraceAnalysis();
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        m_error = QString("Cannot open %1: %2").arg(path, file.errorString());
+        return false;
+    }
+    qint64 size = file.size();
+    const char* data = size > 0 ? reinterpret_cast<const char*>(file.map(0, size)) : nullptr;
+    if (!data) {
+        m_error = QString("Cannot read %1: %2").arg(path, file.errorString());
+        return false;
+    }
+
+    // Either {"traceEvents": [...], ...} or a bare array of events
+    QByteArrayView text(data, size);
+    qsizetype key = text.indexOf("\"traceEvents\"");
+    qsizetype open = text.indexOf('[', key < 0 ? 0 : key);
+    if (open < 0) {
+        m_error = QString("%1 is not a Chrome trace").arg(path);
+        return false;
+    }
+
+    QHash<ThreadKey, QString> threadNames;
+    QHash<qint64, std::vector<qint64>> drawFrames;  // Timestamps by pid
+    std::vector<Event> events;
+    qint64 first = std::numeric_limits<qint64>::max();
+    qint64 last = std::numeric_limits<qint64>::min();
+
+    const char* p = data + open + 1;
+    const char* end = data + size;
+    QByteArrayView event;
+    while (nextObject(p, end, event)) {
+        m_eventCount++;
+        QByteArrayView ph = CDPPeek::rawString(event, {"ph"});
+        QByteArrayView name = CDPPeek::rawString(event, {"name"});
+        ThreadKey thread(number(event, "pid"), number(event, "tid"));
+
+        // Thread names usually come last, so names are resolved at the end
+        if (ph == "M") {
+            if (name == "thread_name") {
+                threadNames.insert(thread, CDPPeek::string(event, {"args", "name"}));
+            }
+            continue;
+        }
+
+        qint64 ts = number(event, "ts");
+        if (ts <= 0) {
+            continue;
+        }
+        first = qMin(first, ts);
+        last = qMax(last, ts);
+
+        if (ph == "X") {
+            qint64 dur = number(event, "dur");
+            last = qMax(last, ts + dur);
+            if (dur >= MIN_EVENT_US) {
+                Event complete{thread, name.toByteArray(), QString(), ts, dur};
+                if (!isTask(name)) {
+                    complete.detail = describe(event, name);
+                }
+                events.push_back(std::move(complete));
+            }
+        } else if (name == "DrawFrame" && (ph == "I" || ph == "i" || ph == "n" || ph == "b")) {
+            drawFrames[thread.first].push_back(ts);
+        } else if (name == "PipelineReporter" && ph == "b") {
+            if (CDPPeek::rawString(event, {"args", "chrome_frame_reporter", "state"}) == "STATE_DROPPED") {
+                m_reportedDroppedFrames++;
+            }
+        }
+    }
+    if (m_eventCount == 0) {
+        m_error = QString("%1 has no trace events").arg(path);
+        return false;
+    }
+    if (first <= last) {
+        m_durationMs = static_cast<double>(last - first) / 1000.0;
+    }
+
+    // Frames: intervals between draws of the renderer drawing the most
+    std::vector<qint64> frames;
+    for (auto it = drawFrames.begin(); it != drawFrames.end(); ++it) {
+        if (it.value().size() > frames.size()) {
+            frames = it.value();
+        }
+    }
+    std::sort(frames.begin(), frames.end());
+    m_frameCount = static_cast<qint64>(frames.size());
+    std::vector<double> intervals;
+    for (size_t i = 1; i < frames.size(); ++i) {
+        intervals.push_back(static_cast<double>(frames[i] - frames[i - 1]) / 1000.0);
+    }
+    std::vector<double> sorted = intervals;
+    std::sort(sorted.begin(), sorted.end());
+    m_frameTimes.p50 = percentile(sorted, 0.50);
+    m_frameTimes.p90 = percentile(sorted, 0.90);
+    m_frameTimes.p95 = percentile(sorted, 0.95);
+    m_frameTimes.p99 = percentile(sorted, 0.99);
+    m_frameTimes.max = sorted.empty() ? 0 : sorted.back();
+    m_frameBudgetMs = sorted.empty() ? DEFAULT_FRAME_BUDGET_MS : qBound(4.0, m_frameTimes.p50, 50.0);
+    for (double interval : intervals) {
+        if (interval > m_frameBudgetMs * JANK_FACTOR) {
+            m_jankyFrames++;
+            m_droppedFrames += qMax<qint64>(0, std::llround(interval / m_frameBudgetMs) - 1);
+        }
+    }
+
+    // Tasks, each with the longest event nested in it on its thread
+    std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+        if (a.thread != b.thread) {
+            return a.thread < b.thread;
+        }
+        return a.ts < b.ts;
+    });
+    QHash<QString, int> stallGroups;
+    for (size_t i = 0; i < events.size(); ++i) {
+        const Event& task = events[i];
+        if (!isTask(task.name)) {
+            continue;
+        }
+        QString thread = threadNames.value(task.thread);
+        double durationMs = static_cast<double>(task.dur) / 1000.0;
+        bool longTask = thread == "CrRendererMain" && durationMs > LONG_TASK_MS;
+        bool stall = isGpuThread(thread) && durationMs > m_frameBudgetMs;
+        if (!longTask && !stall) {
+            continue;
+        }
+
+        Task summary;
+        summary.thread = thread;
+        summary.name = QString::fromUtf8(task.name);
+        summary.startMs = static_cast<double>(task.ts - first) / 1000.0;
+        summary.durationMs = durationMs;
+        qint64 longest = 0;
+        for (size_t j = i + 1; j < events.size() && events[j].thread == task.thread &&
+                               events[j].ts < task.ts + task.dur; ++j) {
+            const Event& child = events[j];
+            if (!isTask(child.name) && child.ts + child.dur <= task.ts + task.dur && child.dur > longest) {
+                longest = child.dur;
+                summary.longestChild = QString("%1, %2 ms").arg(child.detail).arg(static_cast<double>(child.dur) / 1000.0, 0, 'f', 1);
+            }
+        }
+
+        if (longTask) {
+            m_longTasks.append(summary);
+            m_longTaskTotalMs += durationMs;
+        } else {
+            m_stalls.append(summary);
+            QString group = threadGroup(thread);
+            auto it = stallGroups.find(group);
+            if (it == stallGroups.end()) {
+                it = stallGroups.insert(group, m_stallsByThread.size());
+                ThreadStalls stalls;
+                stalls.thread = group;
+                m_stallsByThread.append(stalls);
+            }
+            ThreadStalls& stalls = m_stallsByThread[it.value()];
+            stalls.count++;
+            stalls.totalMs += durationMs;
+            stalls.longestMs = qMax(stalls.longestMs, durationMs);
+        }
+    }
+
+    auto longestFirst = [](const Task& a, const Task& b) {
+        return a.durationMs > b.durationMs;
+    };
+    std::sort(m_longTasks.begin(), m_longTasks.end(), longestFirst);
+    std::sort(m_stalls.begin(), m_stalls.end(), longestFirst);
+    std::sort(m_stallsByThread.begin(), m_stallsByThread.end(), [](const ThreadStalls& a, const ThreadStalls& b) {
+        return a.totalMs > b.totalMs;
+    });
+    return true;
+}
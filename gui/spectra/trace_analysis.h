@@ -0,0 +1,94 @@
+#ifndef TRACE_ANALYSIS_H
+#define TRACE_ANALYSIS_H
+
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * Frame-level summary of a Chrome trace (JSON trace format, as written by
+ * CDPClient::startTracing()).
+ *
+ * The file is memory-mapped and walked one event at a time; only the few
+ * fields needed are peeked out of each event, so a trace of a long show
+ * is never parsed whole. From it come:
+ *
+ *  - frame intervals between DrawFrame events of the busiest renderer,
+ *    as percentiles, with janky frames (over 1.5 budgets) and an estimate
+ *    of dropped frames; the frame budget is the median interval
+ *  - long tasks: top-level tasks over LONG_TASK_MS on a renderer main
+ *    thread, each with the longest event inside it
+ *  - GPU and raster stalls: tasks over one frame budget on the GPU main,
+ *    viz, compositor and raster worker threads
+ *
+ * Times are in milliseconds, task start times relative to the first event.
+ */
+class TraceAnalysis
+{
+public:
+    struct Percentiles {
+        double p50 = 0;
+        double p90 = 0;
+        double p95 = 0;
+        double p99 = 0;
+        double max = 0;
+    };
+
+    struct Task {
+        QString thread;
+        QString name;
+        QString longestChild;  // Longest event within the task, if any
+        double startMs = 0;
+        double durationMs = 0;
+    };
+
+    struct ThreadStalls {
+        QString thread;
+        qint64 count = 0;
+        double totalMs = 0;
+        double longestMs = 0;
+    };
+
+    static constexpr double LONG_TASK_MS = 50.0;
+
+    bool load(const QString& path);
+    QString errorString() const { return m_error; }
+
+    qint64 eventCount() const { return m_eventCount; }
+    double durationMs() const { return m_durationMs; }
+
+    qint64 frameCount() const { return m_frameCount; }
+    double frameBudgetMs() const { return m_frameBudgetMs; }
+    const Percentiles& frameTimes() const { return m_frameTimes; }
+    qint64 jankyFrames() const { return m_jankyFrames; }
+    qint64 droppedFrames() const { return m_droppedFrames; }
+    // Frames the compositor itself reported dropped, where the trace has
+    // PipelineReporter events
+    qint64 reportedDroppedFrames() const { return m_reportedDroppedFrames; }
+
+    // Longest first
+    const QVector<Task>& longTasks() const { return m_longTasks; }
+    double longTaskTotalMs() const { return m_longTaskTotalMs; }
+
+    // Longest first
+    const QVector<Task>& stalls() const { return m_stalls; }
+    // Most total stall time first
+    const QVector<ThreadStalls>& stallsByThread() const { return m_stallsByThread; }
+
+private:
+    QString m_error;
+    qint64 m_eventCount = 0;
+    double m_durationMs = 0;
+    qint64 m_frameCount = 0;
+    double m_frameBudgetMs = 0;
+    Percentiles m_frameTimes;
+    qint64 m_jankyFrames = 0;
+    qint64 m_droppedFrames = 0;
+    qint64 m_reportedDroppedFrames = 0;
+    QVector<Task> m_longTasks;
+    double m_longTaskTotalMs = 0;
+    QVector<Task> m_stalls;
+    QVector<ThreadStalls> m_stallsByThread;
+};
+
+#endif // TRACE_ANALYSIS_H
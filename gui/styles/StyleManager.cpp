@@ -308,6 +308,18 @@ QString StyleManager::consoleOutput()
   return textEdit() + tau5Scrollbar();
 }
 
+QString StyleManager::logView()
+{
+  // LogView paints its own text, so no colour or font here
+  return QString(
+             "LogView { "
+             "  %1 "
+             "  border: none; "
+             "}")
+      .arg(darkGradientBackground()) +
+         contextMenu() + tau5Scrollbar();
+}
+
 QString StyleManager::guiButton()
 {
   return primaryButton();
@@ -122,6 +122,7 @@ public:
   // Component-specific styles
   static QString consoleHeader();
   static QString consoleOutput();
+  static QString logView();
   static QString consoleScrollbar();
   static QString guiButton();
   static QString invertedButton();
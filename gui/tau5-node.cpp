@@ -1,5 +1,6 @@
 #include <iostream>
 #include <memory>
+#include <string_view>
 #include <cstdlib>
 #include <QCoreApplication>
 #include <QDir>
@@ -24,12 +25,16 @@
 #include "shared/qt_message_handler.h"
 #include "shared/server_info.h"
 #include "shared/cli_help.h"
+#include "shared/startup_trace.h"
 
 using namespace Tau5Common;
 
 
 
 int main(int argc, char *argv[]) {
+    // Starts the startup trace clock
+    StartupTrace::start("tau5-node").begin("args");
+
 #ifdef Q_OS_WIN
     // Set console to UTF-8 mode immediately on Windows
     SetConsoleOutputCP(CP_UTF8);
@@ -154,6 +159,7 @@ int main(int argc, char *argv[]) {
     }
 
     Tau5CLI::ServerConfig serverConfig(args, "tau5-node");
+    StartupTrace::instance().end("args");
 
     // Handle --check flag for health check
     if (args.check) {
@@ -218,7 +224,9 @@ int main(int argc, char *argv[]) {
 
     logConfig.baseLogDir = Tau5Logger::getBaseLogDir();
 
+    StartupTrace::instance().begin("logger.init");
     Tau5Logger::initialize(logConfig);
+    StartupTrace::instance().end("logger.init");
 
     installQtMessageHandler();
 
@@ -258,6 +266,7 @@ int main(int argc, char *argv[]) {
                 }
             } else {
                 quint16 allocatedPort = 0;
+                StartupTrace::Scope allocateTrace("port.allocate");
                 auto portHolder = allocatePort(allocatedPort);
                 if (!portHolder || allocatedPort == 0) {
                     if (args.verbose) {
@@ -470,8 +479,10 @@ int main(int argc, char *argv[]) {
         }
 
         // Create Beam instance with server configuration
+        StartupTrace::instance().begin("beam.construct");
         beam = std::make_shared<Beam>(&app, serverConfig, basePath, Config::APP_NAME,
                                      Config::APP_VERSION, port);
+        StartupTrace::instance().end("beam.construct");
 
         // Get session token from beam
         serverInfo.sessionToken = beam->getSessionToken();
@@ -542,6 +553,8 @@ int main(int argc, char *argv[]) {
         // Connect to OTP ready signal
         QObject::connect(beam.get(), &Beam::otpReady, [&args, &serverInfo, &beam, &serverInfoShown, dotsTimer, portTimeoutTimer, port]() {
             serverInfo.otpReady = true;
+            StartupTrace::instance().instant("otp.ready");
+            StartupTrace::instance().finish(args.verbose);
             
             // Stop the dots timer
             if (dotsTimer) {
@@ -589,6 +602,26 @@ int main(int argc, char *argv[]) {
         });
 
         // Connect standard output/error for visibility
+        QObject::connect(beam.get(), &Beam::outputBatch, [&args](const Tau5Common::BeamOutputBatch& batch) {
+            // Beam has already logged the batch to the beam category, which
+            // reaches the console in verbose mode
+            if (args.verbose) {
+                return;
+            }
+            for (const Tau5Common::BeamOutputLine& line : batch.lines) {
+                if (!line.isError) {
+                    continue;
+                }
+                // In quiet mode, still show critical errors to stderr
+                std::string_view text(batch.text(line).data(), static_cast<size_t>(line.length));
+                if (text.find("ERROR") != std::string_view::npos ||
+                    text.find("CRITICAL") != std::string_view::npos ||
+                    text.find("FATAL") != std::string_view::npos) {
+                    std::cerr << "Error: " << text << "\n";
+                }
+            }
+            });
+
         QObject::connect(beam.get(), &Beam::standardOutput, [&args](const QString& output) {
             // Log BEAM output to the beam category only in verbose mode
             if (args.verbose) {
@@ -1,5 +1,6 @@
 #include "debugpane.h"
 #include "logwidget.h"
+#include "logtailer.h"
 #include "debugwidget.h"
 #include "debugpane/customsplitter.h"
 #include "debugpane/buttonutilities.h"
@@ -140,7 +141,7 @@ DebugPane::DebugPane(QWidget *parent, const Tau5CLI::ServerConfig& config)
       m_dragHandleWidget(nullptr), m_dragHandleAnimationTimer(nullptr), m_animationBar(nullptr),
       m_restartLabel(nullptr), m_restartButton(nullptr), m_resetButton(nullptr), m_closeButton(nullptr),
       m_newBootLogWidget(nullptr), m_newBeamLogWidget(nullptr), m_newGuiLogWidget(nullptr), m_newTau5MCPWidget(nullptr),
-      m_newTidewaveMCPWidget(nullptr), m_newGuiMCPWidget(nullptr), m_consoleToolbarStack(nullptr),
+      m_newTidewaveMCPWidget(nullptr), m_newGuiMCPWidget(nullptr), m_logTailer(nullptr), m_consoleToolbarStack(nullptr),
       m_bootLogTabButton(nullptr), m_elixirConsoleTabButton(nullptr), m_tau5MCPTabButton(nullptr), m_tidewaveMCPTabButton(nullptr), m_guiMCPTabButton(nullptr),
       m_devMode(config.getArgs().env == Tau5CLI::CommonArgs::Env::Dev),
       m_mcpEnabled(config.getArgs().mcp), m_replEnabled(config.getArgs().repl)
@@ -411,6 +412,14 @@ void DebugPane::setupConsole()
   m_newTidewaveMCPWidget = new LogWidget(LogWidget::MCPLog, nullptr);
   m_newGuiMCPWidget = new LogWidget(LogWidget::MCPLog, nullptr);
 
+  // One worker thread follows the log files for every widget
+  m_logTailer = new LogTailer(this);
+  for (LogWidget *widget : {m_newBootLogWidget, m_newBeamLogWidget, m_newGuiLogWidget,
+                            m_newTau5MCPWidget, m_newTidewaveMCPWidget, m_newGuiMCPWidget})
+  {
+    widget->setLogTailer(m_logTailer);
+  }
+
   QString tau5LogFilePath = Tau5Logger::instance().getMCPLogPath("tau5");
   m_newTau5MCPWidget->setLogFilePath(tau5LogFilePath);
   Tau5Logger::instance().debug(QString("DebugPane: Setting Tau5 MCP log path to: %1").arg(tau5LogFilePath));
@@ -16,6 +16,7 @@
 class QPushButton;
 class ActivityTabButton;
 class LogWidget;
+class LogTailer;
 class QLabel;
 class QPropertyAnimation;
 class QTextEdit;
@@ -176,6 +177,7 @@ private:
   LogWidget *m_newTau5MCPWidget;
   LogWidget *m_newTidewaveMCPWidget;
   LogWidget *m_newGuiMCPWidget;
+  LogTailer *m_logTailer;
   bool m_activityIndicatorsEnabled = true;
   QPushButton *m_activityToggleButton;
   QString m_liveDashboardUrl;
@@ -0,0 +1,98 @@
+#include "loglinestore.h"
+
+void LogLineStore::append(QStringView text, Style style)
+{
+  appendUtf8(text.toUtf8(), style);
+}
+
+void LogLineStore::appendUtf8(QByteArrayView utf8, Style style)
+{
+  qsizetype from = 0;
+  while (true) {
+    qsizetype newline = utf8.indexOf('\n', from);
+    qsizetype end = newline < 0 ? utf8.size() : newline;
+    if (end > from) {
+      quint32 start = static_cast<quint32>(m_openLine.size());
+      m_openLine.append(utf8.constData() + from, end - from);
+      quint32 spanEnd = static_cast<quint32>(m_openLine.size());
+      if (!m_openSpans.isEmpty() && m_openSpans.last().style == style) {
+        m_openSpans.last().end = spanEnd;
+      } else {
+        m_openSpans.append({start, spanEnd, style});
+      }
+    }
+    if (newline < 0) {
+      break;
+    }
+    completeLine();
+    from = newline + 1;
+  }
+}
+
+void LogLineStore::completeLine()
+{
+  if (m_chunks.empty() || m_chunks.back().lineStarts.size() == LINES_PER_CHUNK) {
+    m_chunks.emplace_back();
+    m_chunks.back().lineStarts.reserve(LINES_PER_CHUNK);
+    m_chunks.back().spanStarts.reserve(LINES_PER_CHUNK);
+  }
+
+  Chunk &chunk = m_chunks.back();
+  chunk.lineStarts.append(static_cast<quint32>(chunk.bytes.size()));
+  chunk.spanStarts.append(static_cast<quint32>(chunk.spans.size()));
+  chunk.bytes.append(m_openLine);
+  chunk.spans.append(m_openSpans);
+
+  m_byteCount += m_openLine.size();
+  m_maxLineLength = qMax(m_maxLineLength, static_cast<int>(m_openLine.size()));
+  m_lineCount++;
+
+  m_openLine.resize(0);
+  m_openSpans.resize(0);
+}
+
+qint64 LogLineStore::evict(qint64 maxLines)
+{
+  // Every chunk but the last is full, so the front one always holds
+  // LINES_PER_CHUNK lines
+  qint64 dropped = 0;
+  while (m_chunks.size() > 1 && m_lineCount - LINES_PER_CHUNK >= maxLines) {
+    m_byteCount -= m_chunks.front().bytes.size();
+    m_chunks.pop_front();
+    m_lineCount -= LINES_PER_CHUNK;
+    m_firstLineNumber += LINES_PER_CHUNK;
+    dropped += LINES_PER_CHUNK;
+  }
+  return dropped;
+}
+
+void LogLineStore::clear()
+{
+  m_chunks.clear();
+  m_openLine.clear();
+  m_openSpans.clear();
+  m_firstLineNumber += m_lineCount;
+  m_lineCount = 0;
+  m_byteCount = 0;
+  m_maxLineLength = 0;
+}
+
+QByteArrayView LogLineStore::line(qint64 index) const
+{
+  const Chunk &chunk = m_chunks[static_cast<size_t>(index / LINES_PER_CHUNK)];
+  qsizetype i = index % LINES_PER_CHUNK;
+  quint32 start = chunk.lineStarts.at(i);
+  quint32 end = i + 1 < chunk.lineStarts.size() ? chunk.lineStarts.at(i + 1)
+                                                 : static_cast<quint32>(chunk.bytes.size());
+  return QByteArrayView(chunk.bytes.constData() + start, end - start);
+}
+
+LogLineStore::SpanRange LogLineStore::spans(qint64 index) const
+{
+  const Chunk &chunk = m_chunks[static_cast<size_t>(index / LINES_PER_CHUNK)];
+  qsizetype i = index % LINES_PER_CHUNK;
+  quint32 first = chunk.spanStarts.at(i);
+  quint32 last = i + 1 < chunk.spanStarts.size() ? chunk.spanStarts.at(i + 1)
+                                                  : static_cast<quint32>(chunk.spans.size());
+  return {chunk.spans.constData() + first, chunk.spans.constData() + last};
+}
@@ -0,0 +1,80 @@
+#ifndef LOGLINESTORE_H
+#define LOGLINESTORE_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QStringView>
+#include <QVector>
+#include <QtGlobal>
+#include <deque>
+
+// Log lines as UTF-8 bytes plus style spans, kept in fixed-size chunks so
+// the oldest lines can be dropped a chunk at a time. Every chunk but the
+// last holds exactly LINES_PER_CHUNK lines, so finding a line is a divide.
+class LogLineStore
+{
+public:
+  enum Style : quint8 {
+    Text,
+    Timestamp,
+    Error,
+    Success,
+    Accent,
+    AccentBold
+  };
+
+  struct Span {
+    quint32 start;  // Byte offsets within the line
+    quint32 end;
+    Style style;
+  };
+
+  struct SpanRange {
+    const Span *first = nullptr;
+    const Span *last = nullptr;
+    const Span *begin() const { return first; }
+    const Span *end() const { return last; }
+  };
+
+  static constexpr int LINES_PER_CHUNK = 1024;
+
+  // Appends text in one style; '\n' completes the current line. A partial
+  // line is held back until it is completed.
+  void append(QStringView text, Style style);
+  void appendUtf8(QByteArrayView utf8, Style style);
+  void clear();
+
+  // Drops whole chunks from the front while at least maxLines would remain
+  // and returns the number of lines dropped
+  qint64 evict(qint64 maxLines);
+
+  qint64 lineCount() const { return m_lineCount; }
+  // Absolute number of line 0; grows as chunks are evicted
+  qint64 firstLineNumber() const { return m_firstLineNumber; }
+  qint64 byteCount() const { return m_byteCount; }
+  // Longest line seen since the last clear(), in bytes
+  int maxLineLength() const { return m_maxLineLength; }
+
+  QByteArrayView line(qint64 index) const;
+  SpanRange spans(qint64 index) const;
+
+private:
+  struct Chunk {
+    QByteArray bytes;             // Lines back to back, without terminators
+    QVector<quint32> lineStarts;  // Byte offset of each line in bytes
+    QVector<Span> spans;          // Byte offsets relative to each line
+    QVector<quint32> spanStarts;  // Index of each line's first span
+  };
+
+  void completeLine();
+
+  std::deque<Chunk> m_chunks;
+  QByteArray m_openLine;
+  QVector<Span> m_openSpans;
+  qint64 m_lineCount = 0;
+  qint64 m_firstLineNumber = 0;
+  qint64 m_byteCount = 0;
+  int m_maxLineLength = 0;
+};
+
+#endif // LOGLINESTORE_H
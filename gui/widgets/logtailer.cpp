@@ -0,0 +1,426 @@
+#include "logtailer.h"
+#include "../shared/tau5logger.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QJsonValue>
+#include <QThread>
+#include <utility>
+
+void LogTailBatch::add(const QString &text, LogLineStore::Style style)
+{
+  addUtf8(text.toUtf8(), style);
+}
+
+void LogTailBatch::addUtf8(QByteArrayView utf8, LogLineStore::Style style)
+{
+  if (utf8.isEmpty()) {
+    return;
+  }
+  if (!fragments.isEmpty() && fragments.last().style == style) {
+    fragments.last().utf8.append(utf8);
+  } else {
+    fragments.append({utf8.toByteArray(), style});
+  }
+  lineCount += static_cast<int>(utf8.count('\n'));
+}
+
+namespace {
+
+// A partial line longer than this is passed on as it is rather than read
+// again on every change until its newline arrives
+constexpr qint64 MAX_PARTIAL_LINE_BYTES = 64 * 1024;
+
+void appendMcpEntry(LogTailBatch &batch, const QByteArray &line)
+{
+  QJsonParseError parseError;
+  QJsonDocument doc = QJsonDocument::fromJson(line, &parseError);
+
+  if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+    batch.addUtf8(line, LogLineStore::Text);
+    batch.addUtf8("\n", LogLineStore::Text);
+    return;
+  }
+
+  QJsonObject entry = doc.object();
+
+  QString timestamp = entry["timestamp"].toString();
+  QString tool = entry["tool"].toString();
+  QString status = entry["status"].toString();
+  int duration = entry["duration_ms"].toInt(-1);
+  QJsonObject params = entry["params"].toObject();
+
+  if (timestamp.contains("T")) {
+    timestamp = timestamp.mid(timestamp.indexOf("T") + 1, 12);
+  }
+
+  if (tool == "_session") {
+    QString sessionId = entry["session_id"].toString();
+    qint64 pid = entry["pid"].toInteger();
+
+    batch.add("\n", LogLineStore::Text);
+    batch.add("════════════════════════════════════════════════════════════\n", LogLineStore::AccentBold);
+    batch.add(QString("  NEW SESSION - %1\n").arg(timestamp), LogLineStore::AccentBold);
+    if (!sessionId.isEmpty()) {
+      batch.add(QString("  Session ID: %1  PID: %2\n").arg(sessionId).arg(pid), LogLineStore::AccentBold);
+    }
+    batch.add("════════════════════════════════════════════════════════════\n", LogLineStore::AccentBold);
+    batch.add("\n", LogLineStore::AccentBold);
+    return;
+  }
+
+  bool failed = status == "error" || status == "exception" || status == "crash";
+  LogLineStore::Style lineStyle = failed ? LogLineStore::Error : LogLineStore::Text;
+
+  batch.add(QString("[%1] ").arg(timestamp), LogLineStore::Timestamp);
+  batch.add(QString("%1 ").arg(tool), lineStyle);
+
+  QString statusStr;
+  if (status == "started") {
+    statusStr = "→";
+  } else if (status == "success") {
+    statusStr = "✓";
+  } else if (status == "error") {
+    statusStr = "✗";
+  } else {
+    statusStr = status;
+  }
+
+  batch.add(statusStr, lineStyle);
+
+  if (duration >= 0) {
+    batch.add(QString(" (%1ms)").arg(duration), lineStyle);
+  }
+
+  if (!params.isEmpty() && !failed) {
+    QJsonDocument paramsDoc(params);
+    QString paramsStr = paramsDoc.toJson(QJsonDocument::Compact);
+    if (paramsStr.length() > 200) {
+      QString truncated = paramsStr.left(197) + "...";
+      batch.add(QString("\n  %1").arg(truncated), lineStyle);
+    } else {
+      batch.add(QString("\n  %1").arg(paramsStr), lineStyle);
+    }
+  }
+
+  if (status == "success" && entry.contains("response")) {
+    QJsonValue response = entry["response"];
+    QString responseStr;
+
+    if (response.isString()) {
+      responseStr = response.toString();
+    } else if (response.isObject()) {
+      responseStr = QJsonDocument(response.toObject()).toJson(QJsonDocument::Compact);
+    } else if (response.isArray()) {
+      responseStr = QJsonDocument(response.toArray()).toJson(QJsonDocument::Compact);
+    } else if (response.isDouble()) {
+      responseStr = QString::number(response.toDouble());
+    } else if (response.isBool()) {
+      responseStr = response.toBool() ? "true" : "false";
+    } else if (response.isNull()) {
+      responseStr = "null";
+    }
+
+    if (responseStr.length() > 300) {
+      QString truncated = responseStr.left(297) + "...";
+      batch.add(QString("\n  → %1").arg(truncated), LogLineStore::Success);
+    } else {
+      batch.add(QString("\n  → %1").arg(responseStr), LogLineStore::Success);
+    }
+  }
+
+  QString errorMsg = entry["error"].toString();
+  if (!errorMsg.isEmpty() && failed) {
+    errorMsg = errorMsg.replace('\n', ' ');
+
+    if (errorMsg.length() > 200) {
+      QString truncated = errorMsg.left(197) + "...";
+      batch.add(QString("\n  Error: %1").arg(truncated), lineStyle);
+    } else {
+      batch.add(QString("\n  Error: %1").arg(errorMsg), lineStyle);
+    }
+  }
+
+  batch.add("\n", lineStyle);
+}
+
+} // namespace
+
+// Lives on the tailer's thread; everything here runs there
+class LogTailerWorker : public QObject
+{
+public:
+  explicit LogTailerWorker(LogTailer *tailer) : m_tailer(tailer) {}
+
+  void watch(int id, const QString &path, LogTailer::Format format);
+  void unwatch(int id);
+
+private:
+  struct Watch {
+    QString path;
+    LogTailer::Format format;
+    qint64 position = 0;          // End of the last complete line read
+    bool waitingForFile = false;  // Watching the directory until the file appears
+    bool replaced = false;        // Reappeared after being removed
+  };
+
+  void ensureWatcher();
+  void addFile(const QString &path);
+  void waitForFile(Watch &watch);
+  void onFileChanged(const QString &path);
+  void onDirectoryChanged(const QString &path);
+  void readNew(int id, Watch &watch);
+
+  LogTailer *m_tailer;  // Only the context for deliveries to the GUI thread
+  QFileSystemWatcher *m_watcher = nullptr;
+  QHash<int, Watch> m_watches;
+};
+
+void LogTailerWorker::ensureWatcher()
+{
+  // Created here so it belongs to, and is notified on, this thread
+  if (m_watcher) {
+    return;
+  }
+  m_watcher = new QFileSystemWatcher(this);
+  QObject::connect(m_watcher, &QFileSystemWatcher::fileChanged, this,
+                   [this](const QString &path) { onFileChanged(path); });
+  QObject::connect(m_watcher, &QFileSystemWatcher::directoryChanged, this,
+                   [this](const QString &path) { onDirectoryChanged(path); });
+}
+
+void LogTailerWorker::watch(int id, const QString &path, LogTailer::Format format)
+{
+  ensureWatcher();
+
+  Watch watch;
+  watch.path = path;
+  watch.format = format;
+
+  QFileInfo fileInfo(path);
+  if (fileInfo.exists()) {
+    // Only what is written from now on
+    watch.position = fileInfo.size();
+    addFile(path);
+  } else {
+    waitForFile(watch);
+  }
+  m_watches.insert(id, watch);
+}
+
+void LogTailerWorker::unwatch(int id)
+{
+  Watch watch = m_watches.take(id);
+  if (watch.path.isEmpty() || !m_watcher) {
+    return;
+  }
+
+  for (const Watch &other : std::as_const(m_watches)) {
+    if (other.path == watch.path) {
+      return;
+    }
+  }
+  m_watcher->removePath(watch.path);
+}
+
+void LogTailerWorker::addFile(const QString &path)
+{
+  if (!m_watcher->addPath(path) && !m_watcher->files().contains(path)) {
+    Tau5Logger::instance().warning(QString("Failed to add file watcher for: %1").arg(path));
+  }
+
+  QFileInfo fileInfo(path);
+  if (fileInfo.isSymLink()) {
+    QString targetPath = fileInfo.canonicalFilePath();
+    if (!targetPath.isEmpty() && targetPath != path) {
+      m_watcher->addPath(targetPath);
+      Tau5Logger::instance().debug(QString("Watching symlink %1 and target %2").arg(path).arg(targetPath));
+    }
+  }
+}
+
+void LogTailerWorker::waitForFile(Watch &watch)
+{
+  watch.waitingForFile = true;
+  watch.position = 0;
+
+  QString dirPath = QFileInfo(watch.path).absolutePath();
+  if (!QDir(dirPath).exists()) {
+    Tau5Logger::instance().warning(QString("Cannot watch for file creation: directory does not exist: %1").arg(dirPath));
+    return;
+  }
+  if (m_watcher->directories().contains(dirPath) || m_watcher->addPath(dirPath)) {
+    Tau5Logger::instance().debug(QString("Watching directory for file creation: %1").arg(dirPath));
+  } else {
+    Tau5Logger::instance().warning(QString("Failed to watch directory: %1").arg(dirPath));
+  }
+}
+
+void LogTailerWorker::onFileChanged(const QString &path)
+{
+  QString canonicalPath = QFileInfo(path).canonicalFilePath();
+  bool exists = QFile::exists(path);
+
+  for (auto it = m_watches.begin(); it != m_watches.end(); ++it) {
+    Watch &watch = it.value();
+    if (watch.waitingForFile) {
+      continue;
+    }
+    bool matches = watch.path == path ||
+                   (!canonicalPath.isEmpty() && QFileInfo(watch.path).canonicalFilePath() == canonicalPath);
+    if (!matches) {
+      continue;
+    }
+
+    if (QFile::exists(watch.path)) {
+      readNew(it.key(), watch);
+    } else {
+      // Removed; pick it up again when it is recreated
+      watch.replaced = true;
+      waitForFile(watch);
+    }
+  }
+
+  // Replacing a file (log rotation, atomic saves) drops it from the watch
+  if (exists && !m_watcher->files().contains(path)) {
+    m_watcher->addPath(path);
+  }
+}
+
+void LogTailerWorker::onDirectoryChanged(const QString &path)
+{
+  bool stillWaiting = false;
+  for (auto it = m_watches.begin(); it != m_watches.end(); ++it) {
+    Watch &watch = it.value();
+    if (!watch.waitingForFile || QFileInfo(watch.path).absolutePath() != path) {
+      continue;
+    }
+    if (!QFile::exists(watch.path)) {
+      stillWaiting = true;
+      continue;
+    }
+
+    // A new file, so everything in it is new
+    Tau5Logger::instance().debug(QString("Target log file created: %1").arg(watch.path));
+    watch.waitingForFile = false;
+    watch.position = 0;
+    addFile(watch.path);
+    readNew(it.key(), watch);
+  }
+
+  if (!stillWaiting) {
+    m_watcher->removePath(path);
+  }
+}
+
+void LogTailerWorker::readNew(int id, Watch &watch)
+{
+  QFile file(watch.path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    Tau5Logger::instance().debug(QString("Failed to open file, might be recreated: %1").arg(watch.path));
+    return;
+  }
+
+  LogTailBatch batch;
+  batch.reset = std::exchange(watch.replaced, false);
+
+  qint64 size = file.size();
+  if (size < watch.position) {
+    Tau5Logger::instance().debug(QString("File replaced detected: %1 (old size: %2, new size: %3)")
+      .arg(watch.path)
+      .arg(watch.position)
+      .arg(size));
+    batch.reset = true;
+    watch.position = 0;
+  }
+
+  if (size > watch.position && file.seek(watch.position)) {
+    QByteArray bytes = file.read(size - watch.position);
+
+    // Whole lines only; a partial last line is read again once it is done,
+    // unless it has grown too long to keep waiting for
+    qsizetype complete = bytes.lastIndexOf('\n') + 1;
+    if (bytes.size() - complete >= MAX_PARTIAL_LINE_BYTES) {
+      complete = bytes.size();
+    }
+    watch.position += complete;
+
+    QString timestamp = QDateTime::currentDateTime().toString("[HH:mm:ss.zzz] ");
+    qsizetype start = 0;
+    while (start < complete) {
+      qsizetype end = bytes.indexOf('\n', start);
+      if (end < 0) {
+        end = complete;
+      }
+      QByteArray line = bytes.mid(start, end - start);
+      start = end + 1;
+      if (line.endsWith('\r')) {
+        line.chop(1);
+      }
+
+      if (watch.format == LogTailer::McpJsonl) {
+        if (!line.isEmpty()) {
+          appendMcpEntry(batch, line);
+        }
+      } else {
+        batch.add(timestamp, LogLineStore::Timestamp);
+        line.append('\n');
+        batch.addUtf8(line, LogLineStore::Text);
+      }
+    }
+  }
+
+  if (batch.isEmpty()) {
+    return;
+  }
+
+  LogTailer *tailer = m_tailer;
+  QMetaObject::invokeMethod(tailer, [tailer, id, batch = std::move(batch)]() {
+    emit tailer->batchReady(id, batch);
+  }, Qt::QueuedConnection);
+}
+
+LogTailer::LogTailer(QObject *parent)
+    : QObject(parent)
+    , m_thread(new QThread(this))
+    , m_worker(new LogTailerWorker(this))
+    , m_nextId(1)
+{
+  qRegisterMetaType<LogTailBatch>();
+
+  m_thread->setObjectName("LogTailer");
+  m_worker->moveToThread(m_thread);
+  connect(m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+  m_thread->start(QThread::LowPriority);
+}
+
+LogTailer::~LogTailer()
+{
+  m_thread->quit();
+  m_thread->wait();
+}
+
+int LogTailer::watch(const QString &path, Format format)
+{
+  int id = m_nextId++;
+  LogTailerWorker *worker = m_worker;
+  QMetaObject::invokeMethod(worker, [worker, id, path, format]() {
+    worker->watch(id, path, format);
+  }, Qt::QueuedConnection);
+  return id;
+}
+
+void LogTailer::unwatch(int id)
+{
+  LogTailerWorker *worker = m_worker;
+  QMetaObject::invokeMethod(worker, [worker, id]() {
+    worker->unwatch(id);
+  }, Qt::QueuedConnection);
+}
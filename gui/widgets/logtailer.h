@@ -0,0 +1,67 @@
+#ifndef LOGTAILER_H
+#define LOGTAILER_H
+
+#include "loglinestore.h"
+#include <QByteArray>
+#include <QMetaType>
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QThread;
+QT_END_NAMESPACE
+
+class LogTailerWorker;
+
+// Lines read from a log file, already formatted, styled and encoded for
+// LogView
+struct LogTailBatch
+{
+  struct Fragment {
+    QByteArray utf8;
+    LogLineStore::Style style;
+  };
+
+  bool reset = false;  // The file was truncated or replaced; drop what is shown
+  QVector<Fragment> fragments;
+  int lineCount = 0;
+
+  void add(const QString &text, LogLineStore::Style style);
+  void addUtf8(QByteArrayView utf8, LogLineStore::Style style);
+  bool isEmpty() const { return !reset && fragments.isEmpty(); }
+};
+
+Q_DECLARE_METATYPE(LogTailBatch)
+
+// Follows log files for the debug pane on one worker thread. Watching,
+// reading and parsing (JSONL for MCP logs) all happen there; the GUI thread
+// only receives batches that are ready to append.
+class LogTailer : public QObject
+{
+  Q_OBJECT
+
+public:
+  enum Format {
+    PlainText,
+    McpJsonl
+  };
+
+  explicit LogTailer(QObject *parent = nullptr);
+  ~LogTailer();
+
+  // Follows path from its current end, or from the start if it does not
+  // exist yet. Returns the id batchReady() reports it under.
+  int watch(const QString &path, Format format);
+  void unwatch(int id);
+
+signals:
+  void batchReady(int id, const LogTailBatch &batch);
+
+private:
+  QThread *m_thread;
+  LogTailerWorker *m_worker;
+  int m_nextId;
+};
+
+#endif // LOGTAILER_H
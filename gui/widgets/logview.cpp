@@ -0,0 +1,463 @@
+#include "logview.h"
+#include "../styles/StyleManager.h"
+#include <QApplication>
+#include <QClipboard>
+#include <QContextMenuEvent>
+#include <QFontDatabase>
+#include <QKeyEvent>
+#include <QMenu>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QScrollBar>
+#include <algorithm>
+
+namespace {
+
+constexpr int PADDING = 12;
+
+QColor styleColor(LogLineStore::Style style)
+{
+  switch (style) {
+    case LogLineStore::Timestamp: return QColor(StyleManager::Colors::TIMESTAMP_GRAY);
+    case LogLineStore::Error: return QColor(StyleManager::Colors::ERROR_BLUE);
+    case LogLineStore::Success: return QColor(StyleManager::Colors::STATUS_SUCCESS);
+    case LogLineStore::Accent:
+    case LogLineStore::AccentBold: return QColor(StyleManager::Colors::ACCENT_HIGHLIGHT);
+    case LogLineStore::Text: break;
+  }
+  return QColor(StyleManager::Colors::PRIMARY_ORANGE);
+}
+
+bool precedes(const LogView::Position &a, const LogView::Position &b)
+{
+  return a.line < b.line || (a.line == b.line && a.offset < b.offset);
+}
+
+} // namespace
+
+LogView::LogView(QWidget *parent)
+    : QAbstractScrollArea(parent)
+    , m_lineCount(0)
+    , m_maxLines(DEFAULT_MAX_LINES)
+    , m_lineHeight(1)
+    , m_ascent(0)
+    , m_charWidth(1)
+    , m_currentHighlight(-1)
+    , m_selectionAnchor{-1, 0}
+    , m_selectionEnd{-1, 0}
+    , m_selecting(false)
+{
+  setFocusPolicy(Qt::StrongFocus);
+  setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+  setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+  viewport()->setCursor(Qt::IBeamCursor);
+  setFontPixelSize(12);
+}
+
+void LogView::append(QStringView text, LogLineStore::Style style)
+{
+  m_store.append(text, style);
+}
+
+void LogView::appendUtf8(QByteArrayView utf8, LogLineStore::Style style)
+{
+  m_store.appendUtf8(utf8, style);
+}
+
+void LogView::commit()
+{
+  QScrollBar *scrollBar = verticalScrollBar();
+  int top = scrollBar->value();
+  qint64 dropped = m_store.evict(m_maxLines);
+  m_lineCount = m_store.lineCount();
+
+  if (dropped > 0) {
+    qint64 firstLine = m_store.firstLineNumber();
+    auto kept = std::lower_bound(m_highlights.begin(), m_highlights.end(), firstLine,
+                                 [](const Highlight &highlight, qint64 line) { return highlight.line < line; });
+    int removed = static_cast<int>(kept - m_highlights.begin());
+    m_highlights.erase(m_highlights.begin(), kept);
+    m_currentHighlight = m_currentHighlight >= removed ? m_currentHighlight - removed : -1;
+
+    if (qMax(m_selectionAnchor.line, m_selectionEnd.line) < firstLine) {
+      m_selectionAnchor = m_selectionEnd = {-1, 0};
+    } else {
+      for (Position *position : {&m_selectionAnchor, &m_selectionEnd}) {
+        if (position->line >= 0 && position->line < firstLine) {
+          *position = {firstLine, 0};
+        }
+      }
+    }
+  }
+
+  updateScrollBars();
+
+  // Keep the same lines on screen when older ones are dropped
+  if (dropped > 0) {
+    scrollBar->setValue(static_cast<int>(qMax<qint64>(0, top - dropped)));
+  }
+  viewport()->update();
+}
+
+void LogView::clear()
+{
+  m_store.clear();
+  m_lineCount = 0;
+  m_highlights.clear();
+  m_currentHighlight = -1;
+  m_selectionAnchor = m_selectionEnd = {-1, 0};
+  updateScrollBars();
+  viewport()->update();
+}
+
+void LogView::setMaxLines(qint64 lines)
+{
+  lines = qMax<qint64>(1, lines);
+  bool lowered = lines < m_maxLines;
+  m_maxLines = lines;
+
+  // Trim the store and scroll range now rather than on the next append
+  if (lowered) {
+    commit();
+  }
+}
+
+void LogView::setFontPixelSize(int size)
+{
+  QFont logFont = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+  logFont.setFamilies({"Consolas", "Monaco", "Courier New", logFont.family()});
+  logFont.setPixelSize(size);
+  setFont(logFont);
+  m_boldFont = logFont;
+  m_boldFont.setBold(true);
+
+  QFontMetrics metrics(logFont);
+  m_lineHeight = qMax(1, metrics.height());
+  m_ascent = metrics.ascent();
+  m_charWidth = qMax(1, metrics.horizontalAdvance(QLatin1Char('M')));
+
+  updateScrollBars();
+  viewport()->update();
+}
+
+void LogView::scrollToBottom()
+{
+  QScrollBar *scrollBar = verticalScrollBar();
+  scrollBar->setValue(scrollBar->maximum());
+}
+
+void LogView::setHighlights(const QVector<Highlight> &highlights, int current)
+{
+  m_highlights = highlights;
+  m_currentHighlight = current >= 0 && current < m_highlights.size() ? current : -1;
+  if (m_currentHighlight >= 0) {
+    ensureHighlightVisible(m_highlights.at(m_currentHighlight));
+  }
+  viewport()->update();
+}
+
+QString LogView::selectedText() const
+{
+  if (!hasSelection()) {
+    // The current search match stands in for the selection, as it did
+    // when it was a text cursor
+    if (m_currentHighlight >= 0) {
+      const Highlight &highlight = m_highlights.at(m_currentHighlight);
+      QByteArrayView bytes = m_store.line(highlight.line - m_store.firstLineNumber());
+      return QString::fromUtf8(bytes.sliced(highlight.start, highlight.end - highlight.start));
+    }
+    return QString();
+  }
+
+  const bool reversed = precedes(m_selectionEnd, m_selectionAnchor);
+  const Position &start = reversed ? m_selectionEnd : m_selectionAnchor;
+  const Position &stop = reversed ? m_selectionAnchor : m_selectionEnd;
+  const qint64 base = m_store.firstLineNumber();
+  const qint64 first = qMax<qint64>(0, start.line - base);
+  const qint64 last = qMin(m_lineCount - 1, stop.line - base);
+  QByteArray bytes;
+  for (qint64 i = first; i <= last; ++i) {
+    const QByteArrayView line = m_store.line(i);
+    const qsizetype from = base + i == start.line ? qMin<qsizetype>(start.offset, line.size()) : 0;
+    const qsizetype to = base + i == stop.line ? qMin<qsizetype>(stop.offset, line.size()) : line.size();
+    if (i > first) {
+      bytes.append('\n');
+    }
+    bytes.append(line.sliced(from, qMax<qsizetype>(0, to - from)));
+  }
+  return QString::fromUtf8(bytes);
+}
+
+void LogView::copy()
+{
+  QString text = selectedText();
+  if (!text.isEmpty()) {
+    QApplication::clipboard()->setText(text);
+  }
+}
+
+void LogView::selectAll()
+{
+  if (m_lineCount == 0) {
+    return;
+  }
+  m_selectionAnchor = {m_store.firstLineNumber(), 0};
+  m_selectionEnd = {m_selectionAnchor.line + m_lineCount - 1,
+                    static_cast<qint32>(m_store.line(m_lineCount - 1).size())};
+  viewport()->update();
+}
+
+void LogView::paintEvent(QPaintEvent *)
+{
+  QPainter painter(viewport());
+  const QFontMetrics normalMetrics(font());
+  const QFontMetrics boldMetrics(m_boldFont);
+
+  const QColor colors[] = {
+    styleColor(LogLineStore::Text), styleColor(LogLineStore::Timestamp), styleColor(LogLineStore::Error),
+    styleColor(LogLineStore::Success), styleColor(LogLineStore::Accent), styleColor(LogLineStore::AccentBold)
+  };
+  const QColor selectionBackground(StyleManager::Colors::DEEP_PINK);
+  const QColor matchBackground(StyleManager::Colors::PRIMARY_ORANGE);
+
+  const qint64 base = m_store.firstLineNumber();
+  const qint64 first = verticalScrollBar()->value();
+  const qint64 last = qMin(m_lineCount, first + visibleLineCount() + 1);
+  const int left = PADDING - horizontalScrollBar()->value();
+  const int width = viewport()->width();
+  const bool selection = hasSelection();
+  const bool reversed = selection && precedes(m_selectionEnd, m_selectionAnchor);
+  const Position &selectionStart = reversed ? m_selectionEnd : m_selectionAnchor;
+  const Position &selectionStop = reversed ? m_selectionAnchor : m_selectionEnd;
+
+  auto highlight = std::lower_bound(m_highlights.cbegin(), m_highlights.cend(), base + first,
+                                    [](const Highlight &h, qint64 line) { return h.line < line; });
+
+  for (qint64 i = first; i < last; ++i) {
+    const int y = PADDING + static_cast<int>(i - first) * m_lineHeight;
+    const qint64 lineNumber = base + i;
+    const QByteArrayView bytes = m_store.line(i);
+
+    int x = left;
+    for (const LogLineStore::Span &span : m_store.spans(i)) {
+      if (x >= width) {
+        break;
+      }
+      const bool bold = span.style == LogLineStore::AccentBold;
+      const QString text = QString::fromUtf8(bytes.sliced(span.start, span.end - span.start));
+      painter.setFont(spanFont(span.style));
+      painter.setPen(colors[span.style]);
+      painter.drawText(x, y + m_ascent, text);
+      x += (bold ? boldMetrics : normalMetrics).horizontalAdvance(text);
+    }
+
+    // The selection and search matches are drawn over the line
+    if (selection && lineNumber >= selectionStart.line && lineNumber <= selectionStop.line) {
+      const qint32 from = lineNumber == selectionStart.line ? selectionStart.offset : 0;
+      const qint32 to = lineNumber == selectionStop.line ? selectionStop.offset : static_cast<qint32>(bytes.size());
+      const int endX = drawRange(painter, i, left, y, from, to, selectionBackground);
+      if (lineNumber != selectionStop.line) {
+        // The line break is selected too
+        painter.fillRect(QRect(endX, y, m_charWidth, m_lineHeight), selectionBackground);
+      }
+    }
+
+    for (; highlight != m_highlights.cend() && highlight->line == lineNumber; ++highlight) {
+      const bool current = static_cast<int>(highlight - m_highlights.cbegin()) == m_currentHighlight;
+      drawRange(painter, i, left, y, highlight->start, highlight->end,
+                current ? selectionBackground : matchBackground);
+    }
+  }
+}
+
+void LogView::resizeEvent(QResizeEvent *event)
+{
+  QAbstractScrollArea::resizeEvent(event);
+  updateScrollBars();
+}
+
+void LogView::mousePressEvent(QMouseEvent *event)
+{
+  if (event->button() != Qt::LeftButton) {
+    QAbstractScrollArea::mousePressEvent(event);
+    return;
+  }
+
+  Position position = positionAt(event->position().toPoint());
+  if ((event->modifiers() & Qt::ShiftModifier) && m_selectionAnchor.line >= 0) {
+    m_selectionEnd = position;
+  } else {
+    // A plain click clears the selection; dragging starts a new one
+    m_selectionAnchor = position;
+    m_selectionEnd = {-1, 0};
+  }
+  m_selecting = position.line >= 0;
+  viewport()->update();
+}
+
+void LogView::mouseMoveEvent(QMouseEvent *event)
+{
+  if (!m_selecting) {
+    QAbstractScrollArea::mouseMoveEvent(event);
+    return;
+  }
+
+  QPoint pos = event->position().toPoint();
+  if (pos.y() < 0) {
+    verticalScrollBar()->triggerAction(QAbstractSlider::SliderSingleStepSub);
+  } else if (pos.y() > viewport()->height()) {
+    verticalScrollBar()->triggerAction(QAbstractSlider::SliderSingleStepAdd);
+  }
+  m_selectionEnd = positionAt(pos);
+  viewport()->update();
+}
+
+void LogView::mouseReleaseEvent(QMouseEvent *event)
+{
+  m_selecting = false;
+  QAbstractScrollArea::mouseReleaseEvent(event);
+}
+
+void LogView::keyPressEvent(QKeyEvent *event)
+{
+  if (event == QKeySequence::Copy) {
+    copy();
+  } else if (event == QKeySequence::SelectAll) {
+    selectAll();
+  } else if (event == QKeySequence::MoveToStartOfDocument) {
+    verticalScrollBar()->setValue(0);
+  } else if (event == QKeySequence::MoveToEndOfDocument) {
+    scrollToBottom();
+  } else {
+    QAbstractScrollArea::keyPressEvent(event);
+  }
+}
+
+void LogView::contextMenuEvent(QContextMenuEvent *event)
+{
+  QMenu menu(this);
+  QAction *copyAction = menu.addAction("Copy", this, &LogView::copy);
+  copyAction->setEnabled(!selectedText().isEmpty());
+  menu.addAction("Select All", this, &LogView::selectAll);
+  menu.exec(event->globalPos());
+}
+
+void LogView::updateScrollBars()
+{
+  int visible = visibleLineCount();
+  QScrollBar *vertical = verticalScrollBar();
+  vertical->setSingleStep(1);
+  vertical->setPageStep(visible);
+  vertical->setRange(0, static_cast<int>(qMax<qint64>(0, m_lineCount - visible)));
+
+  // An estimate from the longest line in bytes; exact for ASCII
+  int contentWidth = m_store.maxLineLength() * m_charWidth + 2 * PADDING;
+  QScrollBar *horizontal = horizontalScrollBar();
+  horizontal->setSingleStep(m_charWidth * 4);
+  horizontal->setPageStep(viewport()->width());
+  horizontal->setRange(0, qMax(0, contentWidth - viewport()->width()));
+}
+
+void LogView::ensureHighlightVisible(const Highlight &highlight)
+{
+  qint64 index = highlight.line - m_store.firstLineNumber();
+  if (index < 0 || index >= m_lineCount) {
+    return;
+  }
+
+  int visible = visibleLineCount();
+  QScrollBar *vertical = verticalScrollBar();
+  if (index < vertical->value() || index >= vertical->value() + visible) {
+    vertical->setValue(static_cast<int>(qMax<qint64>(0, index - visible / 2)));
+  }
+
+  int matchX = textWidth(index, 0, highlight.start);
+  int matchWidth = textWidth(index, highlight.start, highlight.end);
+  int viewWidth = viewport()->width() - 2 * PADDING;
+  QScrollBar *horizontal = horizontalScrollBar();
+  if (matchX < horizontal->value() || matchX + matchWidth > horizontal->value() + viewWidth) {
+    horizontal->setValue(qMax(0, matchX - viewWidth / 2));
+  }
+}
+
+int LogView::visibleLineCount() const
+{
+  return qMax(1, (viewport()->height() - 2 * PADDING) / m_lineHeight);
+}
+
+LogView::Position LogView::positionAt(const QPoint &pos) const
+{
+  if (m_lineCount == 0) {
+    return {-1, 0};
+  }
+  int row = pos.y() < PADDING ? 0 : (pos.y() - PADDING) / m_lineHeight;
+  qint64 index = qBound<qint64>(0, verticalScrollBar()->value() + row, m_lineCount - 1);
+  qint64 line = m_store.firstLineNumber() + index;
+
+  // Walk the characters to the one whose middle is past the pointer
+  const QByteArrayView bytes = m_store.line(index);
+  const int target = pos.x() - (PADDING - horizontalScrollBar()->value());
+  int x = 0;
+  for (const LogLineStore::Span &span : m_store.spans(index)) {
+    const QString text = QString::fromUtf8(bytes.sliced(span.start, span.end - span.start));
+    const QFontMetrics metrics(spanFont(span.style));
+    for (qsizetype i = 0; i < text.size();) {
+      const qsizetype length = text.at(i).isHighSurrogate() && i + 1 < text.size() ? 2 : 1;
+      const int advance = length == 1 ? metrics.horizontalAdvance(text.at(i))
+                                      : metrics.horizontalAdvance(text.mid(i, length));
+      if (target < x + advance / 2) {
+        return {line, static_cast<qint32>(span.start + QStringView(text).first(i).toUtf8().size())};
+      }
+      x += advance;
+      i += length;
+    }
+  }
+  return {line, static_cast<qint32>(bytes.size())};
+}
+
+bool LogView::hasSelection() const
+{
+  return m_selectionAnchor.line >= 0 && m_selectionEnd.line >= 0;
+}
+
+int LogView::textWidth(qint64 index, qint32 from, qint32 to) const
+{
+  const QByteArrayView bytes = m_store.line(index);
+  int width = 0;
+  for (const LogLineStore::Span &span : m_store.spans(index)) {
+    const qint32 start = qMax(from, static_cast<qint32>(span.start));
+    const qint32 end = qMin(to, static_cast<qint32>(span.end));
+    if (start < end) {
+      width += QFontMetrics(spanFont(span.style)).horizontalAdvance(QString::fromUtf8(bytes.sliced(start, end - start)));
+    }
+  }
+  return width;
+}
+
+int LogView::drawRange(QPainter &painter, qint64 index, int left, int y, qint32 from, qint32 to,
+                       const QColor &background) const
+{
+  const QByteArrayView bytes = m_store.line(index);
+  int x = left + textWidth(index, 0, from);
+  painter.setPen(QColor(StyleManager::Colors::BLACK));
+  for (const LogLineStore::Span &span : m_store.spans(index)) {
+    const qint32 start = qMax(from, static_cast<qint32>(span.start));
+    const qint32 end = qMin(to, static_cast<qint32>(span.end));
+    if (start >= end) {
+      continue;
+    }
+    const QFont &textFont = spanFont(span.style);
+    const QString text = QString::fromUtf8(bytes.sliced(start, end - start));
+    const int advance = QFontMetrics(textFont).horizontalAdvance(text);
+    painter.fillRect(QRect(x, y, advance, m_lineHeight), background);
+    painter.setFont(textFont);
+    painter.drawText(x, y + m_ascent, text);
+    x += advance;
+  }
+  return x;
+}
+
+const QFont &LogView::spanFont(LogLineStore::Style style) const
+{
+  return style == LogLineStore::AccentBold ? m_boldFont : font();
+}
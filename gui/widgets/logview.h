@@ -0,0 +1,101 @@
+#ifndef LOGVIEW_H
+#define LOGVIEW_H
+
+#include "loglinestore.h"
+#include <QAbstractScrollArea>
+#include <QFont>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QPainter;
+QT_END_NAMESPACE
+
+// Read-only view over a LogLineStore. Lines are never wrapped, so every row
+// has the same height and a repaint only decodes and draws the rows that
+// are on screen, however many lines the store holds.
+class LogView : public QAbstractScrollArea
+{
+  Q_OBJECT
+
+public:
+  struct Highlight {
+    qint64 line;  // Absolute line number, see LogLineStore::firstLineNumber()
+    qint32 start; // Byte offsets within the line
+    qint32 end;
+  };
+
+  struct Position {
+    qint64 line;   // Absolute line number, -1 for none
+    qint32 offset; // Byte offset within the line
+  };
+
+  static constexpr qint64 DEFAULT_MAX_LINES = 100000;
+
+  explicit LogView(QWidget *parent = nullptr);
+
+  const LogLineStore &store() const { return m_store; }
+  // Lines on show: those in the store as of the last commit()
+  qint64 lineCount() const { return m_lineCount; }
+
+  // Appended text is queued in the store and shows up, trimmed to
+  // maxLines(), once commit() is called
+  void append(QStringView text, LogLineStore::Style style);
+  void appendUtf8(QByteArrayView utf8, LogLineStore::Style style);
+  void commit();
+  void clear();
+
+  void setMaxLines(qint64 lines);
+  qint64 maxLines() const { return m_maxLines; }
+
+  void setFontPixelSize(int size);
+
+  void scrollToBottom();
+
+  // Search matches, sorted; current is drawn as the selection and scrolled
+  // into view, -1 for none
+  void setHighlights(const QVector<Highlight> &highlights, int current);
+
+  QString selectedText() const;
+
+public slots:
+  void copy();
+  void selectAll();
+
+protected:
+  void paintEvent(QPaintEvent *event) override;
+  void resizeEvent(QResizeEvent *event) override;
+  void mousePressEvent(QMouseEvent *event) override;
+  void mouseMoveEvent(QMouseEvent *event) override;
+  void mouseReleaseEvent(QMouseEvent *event) override;
+  void keyPressEvent(QKeyEvent *event) override;
+  void contextMenuEvent(QContextMenuEvent *event) override;
+
+private:
+  void updateScrollBars();
+  void ensureHighlightVisible(const Highlight &highlight);
+  int visibleLineCount() const;
+  Position positionAt(const QPoint &pos) const;
+  bool hasSelection() const;
+  // Width of bytes [from, to) of the line at index, each span in its own font
+  int textWidth(qint64 index, qint32 from, qint32 to) const;
+  // Draws bytes [from, to) of the line at index over a background and
+  // returns where they end
+  int drawRange(QPainter &painter, qint64 index, int left, int y, qint32 from, qint32 to,
+                const QColor &background) const;
+  const QFont &spanFont(LogLineStore::Style style) const;
+
+  LogLineStore m_store;
+  qint64 m_lineCount;
+  qint64 m_maxLines;
+  int m_lineHeight;
+  int m_ascent;
+  int m_charWidth;
+  QFont m_boldFont;
+  QVector<Highlight> m_highlights;
+  int m_currentHighlight;
+  Position m_selectionAnchor;  // line is -1 for no selection
+  Position m_selectionEnd;      // line is -1 until the mouse is dragged
+  bool m_selecting;
+};
+
+#endif // LOGVIEW_H
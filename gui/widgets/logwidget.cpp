@@ -1,58 +1,49 @@
 #include "logwidget.h"
 #include "../styles/StyleManager.h"
 #include "../shared/tau5logger.h"
+#include "../shared/log_search.h"
 #include <QDebug>
-#include <QTextEdit>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QPushButton>
 #include <QLineEdit>
 #include <QShortcut>
 #include <QFrame>
-#include <QScrollBar>
-#include <QTextCursor>
-#include <QFileSystemWatcher>
-#include <QMutexLocker>
-#include <QFile>
-#include <QThread>
-#include <QPointer>
-#include <QTextStream>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonArray>
-#include <QJsonValue>
-#include <QJsonParseError>
-#include <QDir>
+#include <QTimer>
 #include <QDateTime>
 #include <QLabel>
 #include <QToolBar>
 #include <QFontDatabase>
-#include <QRegularExpression>
+#include <algorithm>
+#include <utility>
 
 LogWidget::LogWidget(LogType type, QWidget *parent)
     : DebugWidget(parent)
     , m_type(type)
+    , m_currentMatch{-1, 0, 0}
+    , m_matchesScannedTo(0)
+    , m_searchTimer(nullptr)
     , m_autoScroll(true)
     , m_paused(false)
     , m_pausedLineCount(0)
+    , m_flushTimer(nullptr)
     , m_pauseButton(nullptr)
-    , m_maxLines(5000)
     , m_fontSize(12)
-    , m_fileWatcher(nullptr)
-    , m_isWatchingDirectory(false)
-    , m_lastFilePosition(0)
-    , m_lastActivityCheckPosition(0)
+    , m_tailId(0)
     , m_hasUnreadContent(false)
 {
   setupUI();
   setupShortcuts();
+  
+  m_flushTimer = new QTimer(this);
+  m_flushTimer->setSingleShot(true);
+  m_flushTimer->setInterval(FLUSH_INTERVAL_MS);
+  connect(m_flushTimer, &QTimer::timeout, this, &LogWidget::flushAppends);
 }
 
 LogWidget::~LogWidget()
 {
-  if (m_fileWatcher) {
-    m_fileWatcher->deleteLater();
-  }
+  stopFileMonitoring();
 }
 
 void LogWidget::setupToolbar()
@@ -132,14 +123,12 @@ void LogWidget::setupToolbar()
 void LogWidget::setupContent()
 {
   DebugWidget::setupContent();
-  m_textEdit = new QTextEdit(m_contentWidget);
-  m_textEdit->setReadOnly(true);
-  m_textEdit->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
-  m_textEdit->setStyleSheet(StyleManager::consoleOutput());
+  m_logView = new LogView(m_contentWidget);
+  m_logView->setStyleSheet(StyleManager::logView());
   
   applyFontSize();
   
-  m_contentLayout->addWidget(m_textEdit);
+  m_contentLayout->addWidget(m_logView);
   m_searchWidget = new QWidget(m_contentWidget);
   m_searchWidget->setStyleSheet(QString(
       "QWidget {"
@@ -172,7 +161,11 @@ void LogWidget::setupContent()
       "  outline: none;"
       "}")
       .arg(StyleManager::Colors::WHITE));
-  connect(m_searchInput, &QLineEdit::textChanged, this, &LogWidget::performSearch);
+  m_searchTimer = new QTimer(this);
+  m_searchTimer->setSingleShot(true);
+  m_searchTimer->setInterval(SEARCH_DELAY_MS);
+  connect(m_searchTimer, &QTimer::timeout, this, &LogWidget::performSearch);
+  connect(m_searchInput, &QLineEdit::textChanged, m_searchTimer, qOverload<>(&QTimer::start));
   connect(m_searchInput, &QLineEdit::returnPressed, this, &LogWidget::findNext);
   searchLayout->addWidget(m_searchInput);
   
@@ -200,7 +193,6 @@ void LogWidget::setupContent()
 void LogWidget::onActivated()
 {
   m_hasUnreadContent = false;
-  m_lastActivityCheckPosition = m_lastFilePosition;
 }
 
 void LogWidget::onDeactivated()
@@ -236,88 +228,47 @@ void LogWidget::appendLog(const QString &text, bool isError)
 
 void LogWidget::appendLogWithTimestamp(const QString &timestamp, const QString &text, bool isError)
 {
-  if (m_paused) {
-    QString fullLine = timestamp + text;
-    if (!text.endsWith('\n')) {
-      fullLine += '\n';
-    }
-    m_pausedBuffer.append(fullLine);
-    m_pausedLineCount++;
-    
-    if (m_pauseButton) {
-      m_pauseButton->setToolTip(QString("Resume log updates (%1 lines buffered)").arg(m_pausedLineCount));
-    }
-    
-    emit logActivity();
-    return;
-  }
-  
-  QTextCursor cursor(m_textEdit->document());
-  cursor.movePosition(QTextCursor::End);
-  
-  QTextCharFormat timestampFormat;
-  timestampFormat.setForeground(QColor(StyleManager::Colors::TIMESTAMP_GRAY));
-  cursor.setCharFormat(timestampFormat);
-  cursor.insertText(timestamp);
-  
-  QTextCharFormat textFormat;
-  textFormat.setForeground(isError ? 
-    QColor(StyleManager::Colors::ERROR_BLUE) : 
-    QColor(StyleManager::Colors::PRIMARY_ORANGE));
-  cursor.setCharFormat(textFormat);
-  cursor.insertText(text);
-  
+  write(timestamp, LogLineStore::Timestamp);
+  write(text, isError ? LogLineStore::Error : LogLineStore::Text);
   if (!text.endsWith('\n')) {
-    cursor.insertText("\n");
+    write(QStringLiteral("\n"), LogLineStore::Text);
   }
-  
-  enforceMaxLines();
-  
-  if (m_autoScroll) {
-    QScrollBar *scrollBar = m_textEdit->verticalScrollBar();
-    scrollBar->setValue(scrollBar->maximum());
+  scheduleFlush();
+}
+
+void LogWidget::write(const QString &text, LogLineStore::Style style)
+{
+  if (m_paused) {
+    m_pausedBuffer.append(text);
+    m_pausedLineCount += text.count('\n');
+  } else {
+    m_logView->append(text, style);
   }
-  
-  if (!isVisible()) {
-    m_hasUnreadContent = true;
+}
+
+void LogWidget::scheduleFlush()
+{
+  if (!m_flushTimer->isActive()) {
+    m_flushTimer->start();
   }
-  emit logActivity();
 }
 
-void LogWidget::appendFormattedText(const std::function<void(QTextCursor&)> &formatter)
+void LogWidget::flushAppends()
 {
   if (m_paused) {
-    QTextDocument tempDoc;
-    QTextCursor tempCursor(&tempDoc);
-    formatter(tempCursor);
-    
-    QString bufferedText = tempDoc.toPlainText();
-    if (!bufferedText.isEmpty()) {
-      m_pausedBuffer.append(bufferedText);
-      m_pausedLineCount += bufferedText.count('\n');
-      if (!bufferedText.endsWith('\n')) {
-        m_pausedLineCount++;
-      }
-      
-      if (m_pauseButton) {
-        m_pauseButton->setToolTip(QString("Resume log updates (%1 lines buffered)").arg(m_pausedLineCount));
-      }
+    if (m_pauseButton && m_pausedLineCount > 0) {
+      m_pauseButton->setToolTip(QString("Resume log updates (%1 lines buffered)").arg(m_pausedLineCount));
     }
     
     emit logActivity();
     return;
   }
   
-  QTextCursor cursor(m_textEdit->document());
-  cursor.movePosition(QTextCursor::End);
-  
-  formatter(cursor);
-  
-  enforceMaxLines();
+  // Everything appended since the last flush goes in as one commit
+  m_logView->commit();
   
   if (m_autoScroll) {
-    QScrollBar *scrollBar = m_textEdit->verticalScrollBar();
-    scrollBar->setValue(scrollBar->maximum());
+    m_logView->scrollToBottom();
   }
   
   if (!isVisible()) {
@@ -328,16 +279,15 @@ void LogWidget::appendFormattedText(const std::function<void(QTextCursor&)> &for
 
 void LogWidget::clear()
 {
-  m_textEdit->clear();
-  m_lastFilePosition = 0;
+  m_logView->clear();
+  m_currentMatch.line = -1;
 }
 
 void LogWidget::setAutoScroll(bool enabled)
 {
   m_autoScroll = enabled;
   if (enabled) {
-    QScrollBar *scrollBar = m_textEdit->verticalScrollBar();
-    scrollBar->setValue(scrollBar->maximum());
+    m_logView->scrollToBottom();
   }
 }
 
@@ -350,42 +300,19 @@ void LogWidget::setFontSize(int size)
 
 void LogWidget::applyFontSize()
 {
-  QString currentStyle = m_textEdit->styleSheet();
-  
-  QString fontSizeRule = QString("font-size: %1px;").arg(m_fontSize);
-  
-  if (currentStyle.contains("font-size:")) {
-    QRegularExpression re("font-size:\\s*[^;]+;");
-    currentStyle.replace(re, fontSizeRule);
-  } else {
-    int qtextEditPos = currentStyle.indexOf("QTextEdit {");
-    if (qtextEditPos >= 0) {
-      int openBrace = currentStyle.indexOf("{", qtextEditPos);
-      if (openBrace >= 0) {
-        currentStyle.insert(openBrace + 1, " " + fontSizeRule + " ");
-      }
-    }
-  }
-  
-  m_textEdit->setStyleSheet(currentStyle);
+  m_logView->setFontPixelSize(m_fontSize);
   
-  Tau5Logger::instance().debug(QString("LogWidget::applyFontSize() applied size: %1 to stylesheet").arg(m_fontSize));
+  Tau5Logger::instance().debug(QString("LogWidget::applyFontSize() applied size: %1").arg(m_fontSize));
 }
 
-void LogWidget::enforceMaxLines()
+void LogWidget::setMaxLines(int lines)
 {
-  QTextDocument *doc = m_textEdit->document();
-  int blockCount = doc->blockCount();
-  
-  if (blockCount > m_maxLines) {
-    QTextCursor cursor(doc);
-    cursor.movePosition(QTextCursor::Start);
-    for (int i = 0; i < blockCount - m_maxLines; ++i) {
-      cursor.movePosition(QTextCursor::EndOfBlock, QTextCursor::KeepAnchor);
-      cursor.movePosition(QTextCursor::Right, QTextCursor::KeepAnchor);
-    }
-    cursor.removeSelectedText();
-  }
+  m_logView->setMaxLines(lines);
+}
+
+int LogWidget::maxLines() const
+{
+  return static_cast<int>(m_logView->maxLines());
 }
 
 void LogWidget::zoomIn()
@@ -427,32 +354,14 @@ void LogWidget::performSearch()
   QString searchText = m_searchInput->text();
   
   if (searchText.isEmpty()) {
-    QTextCursor cursor = m_textEdit->textCursor();
-    cursor.clearSelection();
-    m_textEdit->setTextCursor(cursor);
+    m_currentMatch.line = -1;
+    m_logView->setHighlights({}, -1);
     return;
   }
   
-  if (searchText != m_lastSearchText) {
-    QTextCursor cursor = m_textEdit->textCursor();
-    cursor.movePosition(QTextCursor::Start);
-    m_textEdit->setTextCursor(cursor);
-    m_lastSearchText = searchText;
-  }
-  
-  bool found = m_textEdit->find(searchText);
-  
-  if (!found) {
-    QTextCursor cursor = m_textEdit->textCursor();
-    cursor.movePosition(QTextCursor::Start);
-    m_textEdit->setTextCursor(cursor);
-    found = m_textEdit->find(searchText);
-  }
-  
-  if (found) {
-    QTextCursor currentMatchCursor = m_textEdit->textCursor();
-    highlightAllMatches(searchText, currentMatchCursor);
-  }
+  // The text was edited, so start again from the top
+  m_currentMatch.line = -1;
+  selectMatch(searchText, false);
 }
 
 void LogWidget::findNext()
@@ -462,19 +371,9 @@ void LogWidget::findNext()
     return;
   }
   
-  bool found = m_textEdit->find(searchText);
-  
-  if (!found) {
-    QTextCursor cursor = m_textEdit->textCursor();
-    cursor.movePosition(QTextCursor::Start);
-    m_textEdit->setTextCursor(cursor);
-    found = m_textEdit->find(searchText);
-  }
-  
-  if (found) {
-    QTextCursor currentMatchCursor = m_textEdit->textCursor();
-    highlightAllMatches(searchText, currentMatchCursor);
-  }
+  // Takes the place of a search still waiting on typing to pause
+  m_searchTimer->stop();
+  selectMatch(searchText, false);
 }
 
 void LogWidget::findPrevious()
@@ -484,327 +383,157 @@ void LogWidget::findPrevious()
     return;
   }
   
-  bool found = m_textEdit->find(searchText, QTextDocument::FindBackward);
-  
-  if (!found) {
-    QTextCursor cursor = m_textEdit->textCursor();
-    cursor.movePosition(QTextCursor::End);
-    m_textEdit->setTextCursor(cursor);
-    found = m_textEdit->find(searchText, QTextDocument::FindBackward);
-  }
-  
-  if (found) {
-    QTextCursor currentMatchCursor = m_textEdit->textCursor();
-    highlightAllMatches(searchText, currentMatchCursor);
-  }
+  // Takes the place of a search still waiting on typing to pause
+  m_searchTimer->stop();
+  selectMatch(searchText, true);
 }
 
-void LogWidget::highlightAllMatches(const QString &searchText, const QTextCursor &currentMatch)
+void LogWidget::updateMatches(const QString &searchText)
 {
-  QList<QTextEdit::ExtraSelection> extraSelections;
-  QTextDocument *document = m_textEdit->document();
-  QTextCursor highlightCursor(document);
-  
-  QTextEdit::ExtraSelection extraSelection;
-  QTextCharFormat format;
-  format.setBackground(QColor(StyleManager::Colors::PRIMARY_ORANGE));
-  format.setForeground(QColor(StyleManager::Colors::BLACK));
-  
-  while (!highlightCursor.isNull() && !highlightCursor.atEnd()) {
-    highlightCursor = document->find(searchText, highlightCursor);
-    if (!highlightCursor.isNull()) {
-      if (!currentMatch.isNull() && 
-          (highlightCursor.position() != currentMatch.position() || 
-           highlightCursor.anchor() != currentMatch.anchor())) {
-        extraSelection.cursor = highlightCursor;
-        extraSelection.format = format;
-        extraSelections.append(extraSelection);
+  if (searchText != m_lastSearchText) {
+    m_lastSearchText = searchText;
+    m_matches.clear();
+    m_matchesScannedTo = 0;
+    m_currentMatch.line = -1;
+  }
+  
+  // Stored lines never change, so only matches on lines dropped since the
+  // last search are forgotten and only lines added since are scanned
+  const LogLineStore &store = m_logView->store();
+  const qint64 base = store.firstLineNumber();
+  auto kept = std::lower_bound(m_matches.begin(), m_matches.end(), base,
+                               [](const LogView::Highlight &match, qint64 line) { return match.line < line; });
+  m_matches.erase(m_matches.begin(), kept);
+  
+  // Same semantics as QTextDocument::find() with no flags: literal and
+  // case-insensitive. Lines are searched as stored, in UTF-8, so nothing
+  // is decoded.
+  Tau5Common::LogSearch search = Tau5Common::LogSearch::literal(searchText, Qt::CaseInsensitive);
+  const qint64 end = base + m_logView->lineCount();
+  if (!search.isEmpty()) {
+    Tau5Common::LogSearch::Match match;
+    for (qint64 lineNumber = qMax(m_matchesScannedTo, base); lineNumber < end; ++lineNumber) {
+      QByteArrayView line = store.line(lineNumber - base);
+      qint64 from = 0;
+      while (search.findNext(line.data(), line.size(), from, match)) {
+        m_matches.append({lineNumber, static_cast<qint32>(match.start), static_cast<qint32>(match.end)});
+        from = qMax(match.end, match.start + 1);
       }
     }
   }
+  m_matchesScannedTo = end;
+}
+
+void LogWidget::selectMatch(const QString &searchText, bool backward)
+{
+  updateMatches(searchText);
+  const QVector<LogView::Highlight> &matches = m_matches;
+  if (matches.isEmpty()) {
+    m_currentMatch.line = -1;
+    m_logView->setHighlights({}, -1);
+    return;
+  }
+  
+  // Next match after the current one, or the last one before it, wrapping
+  // around the log
+  auto precedes = [](const LogView::Highlight &a, const LogView::Highlight &b) {
+    return a.line < b.line || (a.line == b.line && a.start < b.start);
+  };
+  int index;
+  if (m_currentMatch.line < 0) {
+    index = backward ? static_cast<int>(matches.size()) - 1 : 0;
+  } else if (backward) {
+    auto it = std::lower_bound(matches.cbegin(), matches.cend(), m_currentMatch, precedes);
+    index = it == matches.cbegin() ? static_cast<int>(matches.size()) - 1 : static_cast<int>(it - matches.cbegin()) - 1;
+  } else {
+    auto it = std::upper_bound(matches.cbegin(), matches.cend(), m_currentMatch, precedes);
+    index = it == matches.cend() ? 0 : static_cast<int>(it - matches.cbegin());
+  }
   
-  m_textEdit->setExtraSelections(extraSelections);
+  m_currentMatch = matches.at(index);
+  m_logView->setHighlights(matches, index);
 }
 
 void LogWidget::closeSearch()
 {
   m_searchWidget->hide();
   m_searchInput->clear();
+  m_searchTimer->stop();
   m_lastSearchText.clear();
+  m_matches.clear();
+  m_currentMatch.line = -1;
   
-  QTextCursor cursor = m_textEdit->textCursor();
-  cursor.clearSelection();
-  m_textEdit->setTextCursor(cursor);
-  m_textEdit->setExtraSelections(QList<QTextEdit::ExtraSelection>());
-  m_textEdit->setFocus();
+  m_logView->setHighlights({}, -1);
+  m_logView->setFocus();
 }
 
-void LogWidget::setLogFilePath(const QString &path)
+void LogWidget::setLogTailer(LogTailer *tailer)
 {
-  if (m_fileWatcher) {
-    disconnect(m_fileWatcher, nullptr, this, nullptr);
-    m_fileWatcher->deleteLater();
-    m_fileWatcher = nullptr;
+  if (m_logTailer == tailer) {
+    return;
   }
   
-  {
-    QMutexLocker locker(&m_filePositionMutex);
-    m_logFilePath = path;
-    m_lastFilePosition = 0;
-    m_lastActivityCheckPosition = 0;
-    m_hasUnreadContent = false;
+  stopFileMonitoring();
+  if (m_logTailer) {
+    disconnect(m_logTailer, nullptr, this, nullptr);
   }
   
+  m_logTailer = tailer;
+  if (m_logTailer) {
+    connect(m_logTailer, &LogTailer::batchReady, this, &LogWidget::appendTailBatch);
+  }
+}
+
+void LogWidget::setLogFilePath(const QString &path)
+{
+  stopFileMonitoring();
+  m_logFilePath = path;
+  m_hasUnreadContent = false;
+  
   if (path.isEmpty()) {
     return;
   }
   
-  m_fileWatcher = new QFileSystemWatcher(this);
-  
-  connect(m_fileWatcher, &QFileSystemWatcher::fileChanged,
-          this, &LogWidget::onFileChanged);
-  connect(m_fileWatcher, &QFileSystemWatcher::directoryChanged,
-          this, &LogWidget::onDirectoryChanged);
-  
-  QFileInfo fileInfo(m_logFilePath);
-  
-  if (fileInfo.exists()) {
-    bool added = m_fileWatcher->addPath(m_logFilePath);
-    
-    if (fileInfo.isSymLink()) {
-      QString targetPath = fileInfo.canonicalFilePath();
-      if (!targetPath.isEmpty() && targetPath != m_logFilePath) {
-        m_fileWatcher->addPath(targetPath);
-        Tau5Logger::instance().debug(QString("Watching symlink %1 and target %2").arg(m_logFilePath).arg(targetPath));
-      }
-    }
-    
-    if (!added) {
-      Tau5Logger::instance().warning(QString("Failed to add file watcher for: %1").arg(m_logFilePath));
-    }
-    m_isWatchingDirectory = false;
-    initializeFilePosition();
-  } else {
-    watchForFileCreation();
+  if (!m_logTailer) {
+    Tau5Logger::instance().warning(QString("No log tailer to follow: %1").arg(path));
+    return;
   }
+  
+  m_tailId = m_logTailer->watch(path, m_type == MCPLog ? LogTailer::McpJsonl : LogTailer::PlainText);
 }
 
-
 void LogWidget::stopFileMonitoring()
 {
-  if (m_fileWatcher) {
-    m_fileWatcher->deleteLater();
-    m_fileWatcher = nullptr;
+  if (m_logTailer && m_tailId != 0) {
+    m_logTailer->unwatch(m_tailId);
   }
+  m_tailId = 0;
 }
 
-void LogWidget::updateFromFile()
+void LogWidget::appendTailBatch(int id, const LogTailBatch &batch)
 {
-  if (m_logFilePath.isEmpty()) {
-    return;
-  }
-  
-  qint64 readPosition;
-  bool shouldClear = false;
-  {
-    QMutexLocker locker(&m_filePositionMutex);
-    readPosition = m_lastFilePosition;
-  }
-  
-  QFile logFile(m_logFilePath);
-  if (!logFile.exists()) {
-    return;
-  }
-  
-  if (!logFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-    Tau5Logger::instance().warning(QString("Failed to open log file for reading: %1").arg(m_logFilePath));
-    return;
-  }
-  
-  qint64 currentSize = logFile.size();
-  if (currentSize == readPosition) {
-    logFile.close();
+  if (id != m_tailId || id == 0) {
     return;
   }
   
-  if (readPosition > 0 && readPosition < currentSize) {
-    logFile.seek(readPosition);
-  } else if (readPosition > currentSize) {
-    readPosition = 0;
-    logFile.seek(0);
-    shouldClear = true;
-  } else {
-    shouldClear = true;
-  }
-  
-  if (shouldClear) {
+  if (batch.reset) {
+    // Anything held back while paused came from the old file too
     clear();
+    m_pausedBuffer.clear();
+    m_pausedLineCount = 0;
   }
   
-  QTextStream stream(&logFile);
-  
-  if (m_type == MCPLog) {
-    appendFormattedText([this, &stream](QTextCursor &cursor) {
-      QTextCharFormat timestampFormat;
-      timestampFormat.setForeground(QColor(StyleManager::Colors::TIMESTAMP_GRAY));
-      
-      QTextCharFormat normalFormat;
-      normalFormat.setForeground(QColor(StyleManager::Colors::PRIMARY_ORANGE));
-      
-      QTextCharFormat successFormat;
-      successFormat.setForeground(QColor(StyleManager::Colors::STATUS_SUCCESS));
-      
-      QTextCharFormat errorFormat;
-      errorFormat.setForeground(QColor(StyleManager::Colors::ERROR_BLUE));
-      
-      while (!stream.atEnd()) {
-        QString line = stream.readLine();
-        if (line.isEmpty()) continue;
-        
-        QJsonParseError parseError;
-        QJsonDocument doc = QJsonDocument::fromJson(line.toUtf8(), &parseError);
-        
-        if (parseError.error == QJsonParseError::NoError && doc.isObject()) {
-          QJsonObject entry = doc.object();
-          
-          QString timestamp = entry["timestamp"].toString();
-          QString tool = entry["tool"].toString();
-          QString status = entry["status"].toString();
-          int duration = entry["duration_ms"].toInt(-1);
-          QJsonObject params = entry["params"].toObject();
-          
-          if (timestamp.contains("T")) {
-            timestamp = timestamp.mid(timestamp.indexOf("T") + 1, 12);
-          }
-          
-          if (tool == "_session") {
-            QTextCharFormat sessionFormat;
-            sessionFormat.setForeground(QColor(StyleManager::Colors::ACCENT_HIGHLIGHT));
-            sessionFormat.setFontWeight(QFont::Bold);
-            
-            QString sessionId = entry["session_id"].toString();
-            qint64 pid = entry["pid"].toInteger();
-            
-            cursor.insertText("\n");
-            cursor.setCharFormat(sessionFormat);
-            cursor.insertText("════════════════════════════════════════════════════════════\n");
-            cursor.insertText(QString("  NEW SESSION - %1\n").arg(timestamp));
-            if (!sessionId.isEmpty()) {
-              cursor.insertText(QString("  Session ID: %1  PID: %2\n").arg(sessionId).arg(pid));
-            }
-            cursor.insertText("════════════════════════════════════════════════════════════\n");
-            cursor.insertText("\n");
-          } else {
-            QTextCharFormat lineFormat = (status == "error" || status == "exception" || status == "crash") 
-                ? errorFormat : normalFormat;
-            
-            cursor.setCharFormat(timestampFormat);
-            cursor.insertText(QString("[%1] ").arg(timestamp));
-            
-            cursor.setCharFormat(lineFormat);
-            cursor.insertText(QString("%1 ").arg(tool));
-            
-            QString statusStr;
-            if (status == "started") {
-              statusStr = "→";
-            } else if (status == "success") {
-              statusStr = "✓";
-            } else if (status == "error") {
-              statusStr = "✗";
-            } else {
-              statusStr = status;
-            }
-            
-            cursor.setCharFormat(lineFormat);
-            cursor.insertText(statusStr);
-            
-            if (duration >= 0) {
-              cursor.setCharFormat(lineFormat);
-              cursor.insertText(QString(" (%1ms)").arg(duration));
-            }
-            
-            if (!params.isEmpty() && status != "error" && status != "exception" && status != "crash") {
-              QJsonDocument paramsDoc(params);
-              QString paramsStr = paramsDoc.toJson(QJsonDocument::Compact);
-              cursor.setCharFormat(lineFormat);
-              if (paramsStr.length() > 200) {
-                QString truncated = paramsStr.left(197) + "...";
-                cursor.insertText(QString("\n  %1").arg(truncated));
-              } else {
-                cursor.insertText(QString("\n  %1").arg(paramsStr));
-              }
-            }
-            
-            if (status == "success" && entry.contains("response")) {
-              QJsonValue response = entry["response"];
-              QString responseStr;
-              
-              if (response.isString()) {
-                responseStr = response.toString();
-              } else if (response.isObject() || response.isArray()) {
-                QJsonDocument responseDoc;
-                if (response.isObject()) {
-                  responseDoc = QJsonDocument(response.toObject());
-                } else {
-                  responseDoc = QJsonDocument(response.toArray());
-                }
-                responseStr = responseDoc.toJson(QJsonDocument::Compact);
-              } else if (response.isDouble()) {
-                responseStr = QString::number(response.toDouble());
-              } else if (response.isBool()) {
-                responseStr = response.toBool() ? "true" : "false";
-              } else if (response.isNull()) {
-                responseStr = "null";
-              }
-              
-              QTextCharFormat responseFormat;
-              responseFormat.setForeground(QColor(StyleManager::Colors::STATUS_SUCCESS));
-              cursor.setCharFormat(responseFormat);
-              
-              if (responseStr.length() > 300) {
-                QString truncated = responseStr.left(297) + "...";
-                cursor.insertText(QString("\n  → %1").arg(truncated));
-              } else {
-                cursor.insertText(QString("\n  → %1").arg(responseStr));
-              }
-            }
-            
-            QString errorMsg = entry["error"].toString();
-            if (!errorMsg.isEmpty() && (status == "error" || status == "exception" || status == "crash")) {
-              cursor.setCharFormat(lineFormat);  // Use same color as rest of error line
-              errorMsg = errorMsg.replace('\n', ' ');
-              
-              if (errorMsg.length() > 200) {
-                QString truncated = errorMsg.left(197) + "...";
-                cursor.insertText(QString("\n  Error: %1").arg(truncated));
-              } else {
-                cursor.insertText(QString("\n  Error: %1").arg(errorMsg));
-              }
-            }
-            
-            cursor.insertText("\n");
-          }
-        } else {
-          cursor.setCharFormat(normalFormat);
-          cursor.insertText(line + "\n");
-        }
-      }
-    });
-  } else {
-    while (!stream.atEnd()) {
-      QString line = stream.readLine();
-      appendLog(line, false);
+  for (const LogTailBatch::Fragment &fragment : batch.fragments) {
+    if (m_paused) {
+      m_pausedBuffer.append(QString::fromUtf8(fragment.utf8));
+    } else {
+      m_logView->appendUtf8(fragment.utf8, fragment.style);
     }
   }
-  
-  qint64 newPosition = logFile.pos();
-  logFile.close();
-  
-  {
-    QMutexLocker locker(&m_filePositionMutex);
-    m_lastFilePosition = newPosition;
-    m_hasUnreadContent = false;
+  if (m_paused) {
+    m_pausedLineCount += batch.lineCount;
   }
+  scheduleFlush();
 }
 
 void LogWidget::handleAutoScrollToggled(bool checked)
@@ -827,32 +556,19 @@ void LogWidget::setPaused(bool paused)
   
   if (!m_paused) {
     if (!m_pausedBuffer.isEmpty()) {
-      QTextCursor cursor(m_textEdit->document());
-      cursor.movePosition(QTextCursor::End);
-      
-      QTextCharFormat separatorFormat;
-      separatorFormat.setForeground(QColor(StyleManager::Colors::ACCENT_HIGHLIGHT));
-      cursor.setCharFormat(separatorFormat);
-      cursor.insertText(QString("\n══════ %1 lines buffered while paused ══════\n").arg(m_pausedLineCount));
-      
-      QTextCharFormat normalFormat;
-      normalFormat.setForeground(QColor(StyleManager::Colors::PRIMARY_ORANGE));
-      cursor.setCharFormat(normalFormat);
+      m_logView->append(QString("\n══════ %1 lines buffered while paused ══════\n").arg(m_pausedLineCount),
+                        LogLineStore::Accent);
       
-      for (const QString &bufferedLine : m_pausedBuffer) {
-        cursor.insertText(bufferedLine);
+      for (const QString &bufferedText : std::as_const(m_pausedBuffer)) {
+        m_logView->append(bufferedText, LogLineStore::Text);
       }
       
       m_pausedBuffer.clear();
       m_pausedLineCount = 0;
-      
-      enforceMaxLines();
-      
-      if (m_autoScroll) {
-        QScrollBar *scrollBar = m_textEdit->verticalScrollBar();
-        scrollBar->setValue(scrollBar->maximum());
-      }
     }
+    
+    // Also shows anything queued just before the pause
+    scheduleFlush();
   }
   
   if (m_pauseButton) {
@@ -870,169 +586,9 @@ void LogWidget::setPaused(bool paused)
 
 void LogWidget::updateIfNeeded()
 {
-  if (m_hasUnreadContent) {
-    updateFromFile();
-  }
-}
-
-void LogWidget::onFileChanged(const QString &path)
-{
-  bool shouldEmitActivity = false;
-  bool shouldUpdateDisplay = false;
-  bool fileReplaced = false;
-  
-  {
-    QMutexLocker locker(&m_filePositionMutex);
-    
-    QFileInfo fileInfo(path);
-    QString actualPath = fileInfo.canonicalFilePath();
-    if (actualPath.isEmpty()) {
-      actualPath = path;
-    }
-    
-    if (actualPath == m_logFilePath || path == m_logFilePath) {
-      QFile file(m_logFilePath);
-      if (file.open(QIODevice::ReadOnly)) {
-        qint64 newSize = file.size();
-        
-        if (newSize < m_lastActivityCheckPosition && m_lastActivityCheckPosition > 0) {
-          Tau5Logger::instance().debug(QString("File replaced detected: %1 (old size: %2, new size: %3)")
-            .arg(path)
-            .arg(m_lastActivityCheckPosition)
-            .arg(newSize));
-          
-          m_lastFilePosition = 0;
-          m_lastActivityCheckPosition = newSize;
-          fileReplaced = true;
-          m_hasUnreadContent = true;
-          shouldEmitActivity = true;
-        } else if (newSize > m_lastActivityCheckPosition) {
-          
-          m_lastActivityCheckPosition = newSize;
-          m_hasUnreadContent = true;
-          shouldEmitActivity = true;
-        }
-        
-        if (m_hasUnreadContent) {
-          shouldUpdateDisplay = true;
-        }
-        
-        file.close();
-      } else {
-        Tau5Logger::instance().debug(QString("Failed to open file, might be recreated: %1").arg(path));
-      }
-    }
-  }
-  QPointer<LogWidget> safeThis(this);
-  if (shouldEmitActivity && safeThis) {
-    emit logActivity();
-  }
-  
-  if (shouldUpdateDisplay && safeThis) {
-    QMetaObject::invokeMethod(this, "updateFromFile", Qt::QueuedConnection);
-  }
-  
-  if (m_fileWatcher && !m_fileWatcher->files().contains(path)) {
-    int retryCount = 0;
-    const int maxRetries = 3;
-    while (retryCount < maxRetries) {
-      bool added = m_fileWatcher->addPath(path);
-      if (added) {
-        if (retryCount > 0) {
-          Tau5Logger::instance().debug(QString("Successfully re-added file watcher for %1 after %2 retries")
-            .arg(path).arg(retryCount));
-        }
-        break;
-      }
-      retryCount++;
-      if (retryCount < maxRetries && QFile::exists(path)) {
-        QThread::msleep(10);
-      }
-    }
-    if (retryCount == maxRetries && QFile::exists(path)) {
-      Tau5Logger::instance().warning(QString("Failed to re-add file watcher for %1 after %2 retries")
-        .arg(path).arg(maxRetries));
-    }
-  }
-}
-
-void LogWidget::onDirectoryChanged(const QString &path)
-{
-  if (!m_isWatchingDirectory) {
-    return;
-  }
-  
-  QFileInfo fileInfo(m_logFilePath);
-  if (fileInfo.exists()) {
-    Tau5Logger::instance().debug(QString("Target log file created: %1").arg(m_logFilePath));
-    switchFromDirectoryToFileWatch();
-  } else {
-    QFileInfo dirInfo(path);
-    if (dirInfo.exists()) {
-      Tau5Logger::instance().debug(QString("Directory changed but target file not yet created: %1")
-        .arg(fileInfo.fileName()));
-    }
+  // Tailed batches arrive as they are read; just show anything queued
+  if (m_flushTimer->isActive()) {
+    m_flushTimer->stop();
+    flushAppends();
   }
 }
-
-void LogWidget::initializeFilePosition()
-{
-  QMutexLocker locker(&m_filePositionMutex);
-  
-  QFile logFile(m_logFilePath);
-  if (logFile.exists() && logFile.open(QIODevice::ReadOnly)) {
-    m_lastFilePosition = logFile.size();
-    m_lastActivityCheckPosition = m_lastFilePosition;
-    logFile.close();
-  } else {
-    m_lastFilePosition = 0;
-    m_lastActivityCheckPosition = 0;
-  }
-}
-
-void LogWidget::watchForFileCreation()
-{
-  if (!m_fileWatcher) {
-    Tau5Logger::instance().warning("Cannot watch for file creation: file watcher is null");
-    return;
-  }
-  
-  QFileInfo fileInfo(m_logFilePath);
-  QString dirPath = fileInfo.absolutePath();
-  
-  if (QDir(dirPath).exists()) {
-    bool added = m_fileWatcher->addPath(dirPath);
-    if (added) {
-      m_isWatchingDirectory = true;
-      Tau5Logger::instance().debug(QString("Watching directory for file creation: %1").arg(dirPath));
-    } else {
-      Tau5Logger::instance().warning(QString("Failed to watch directory: %1").arg(dirPath));
-    }
-  } else {
-    Tau5Logger::instance().warning(QString("Cannot watch for file creation: directory does not exist: %1").arg(dirPath));
-  }
-}
-
-void LogWidget::switchFromDirectoryToFileWatch()
-{
-  if (!m_fileWatcher) return;
-  
-  QFileInfo fileInfo(m_logFilePath);
-  QString dirPath = fileInfo.absolutePath();
-  bool removed = m_fileWatcher->removePath(dirPath);
-  if (!removed) {
-    Tau5Logger::instance().debug(QString("Directory was not being watched: %1").arg(dirPath));
-  }
-  
-  bool added = m_fileWatcher->addPath(m_logFilePath);
-  if (added) {
-    m_isWatchingDirectory = false;
-    Tau5Logger::instance().debug(QString("Switched to watching file: %1").arg(m_logFilePath));
-  } else {
-    Tau5Logger::instance().warning(QString("Failed to watch file after creation: %1").arg(m_logFilePath));
-  }
-  
-  initializeFilePosition();
-  
-  QMetaObject::invokeMethod(this, "updateFromFile", Qt::QueuedConnection);
-}
@@ -2,19 +2,20 @@
 #define LOGWIDGET_H
 
 #include "debugwidget.h"
+#include "logview.h"
+#include "logtailer.h"
 #include <QString>
-#include <QTextCharFormat>
 #include <QMap>
 #include <QUrl>
-#include <QMutex>
+#include <QPointer>
+#include <QVector>
 
 QT_BEGIN_NAMESPACE
-class QTextEdit;
 class QVBoxLayout;
 class QPushButton;
 class QLineEdit;
 class QShortcut;
-class QFileSystemWatcher;
+class QTimer;
 QT_END_NAMESPACE
 
 class LogWidget : public DebugWidget
@@ -29,13 +30,17 @@ public:
     MCPLog
   };
 
+  // Appends are shown, trimmed and scrolled at most once per interval
+  static constexpr int FLUSH_INTERVAL_MS = 16;
+  // The search runs once typing pauses for this long
+  static constexpr int SEARCH_DELAY_MS = 150;
+
   explicit LogWidget(LogType type, QWidget *parent = nullptr);
   ~LogWidget();
 
   void appendLog(const QString &text, bool isError = false);
   void appendLogWithTimestamp(const QString &timestamp, const QString &text, bool isError = false);
   void clear();
-  void appendFormattedText(const std::function<void(QTextCursor&)> &formatter);
   void setAutoScroll(bool enabled);
   bool autoScroll() const { return m_autoScroll; }
   
@@ -43,14 +48,16 @@ public:
   bool isPaused() const { return m_paused; }
   bool hasPendingContent() const { return !m_pausedBuffer.isEmpty(); }
   
-  void setMaxLines(int lines) { m_maxLines = lines; }
-  int maxLines() const { return m_maxLines; }
+  void setMaxLines(int lines);
+  int maxLines() const;
   
   void setFontSize(int size);
   int fontSize() const { return m_fontSize; }
+  // File logs are followed by a tailer shared between widgets
+  void setLogTailer(LogTailer *tailer);
   void setLogFilePath(const QString &path);
   void stopFileMonitoring();
-  QTextEdit* textEdit() { return m_textEdit; }
+  LogView* logView() { return m_logView; }
   void markAsRead() { m_hasUnreadContent = false; }
   bool hasUnreadContent() const { return m_hasUnreadContent; }
   bool hasNewContent() const { return m_hasUnreadContent; }
@@ -70,11 +77,10 @@ public slots:
 private slots:
   void performSearch();
   void closeSearch();
-  void updateFromFile();
   void handleAutoScrollToggled(bool checked);
   void handlePauseToggled(bool checked);
-  void onFileChanged(const QString &path);
-  void onDirectoryChanged(const QString &path);
+  void appendTailBatch(int id, const LogTailBatch &batch);
+  void flushAppends();
   
 protected:
   void setupToolbar() override;
@@ -87,20 +93,23 @@ public:
 private:
   void setupShortcuts();
   void applyFontSize();
-  void highlightAllMatches(const QString &searchText, const QTextCursor &currentMatch);
-  void enforceMaxLines();
-  void initializeFilePosition();
-  void watchForFileCreation();
-  void switchFromDirectoryToFileWatch();
+  void updateMatches(const QString &searchText);
+  void selectMatch(const QString &searchText, bool backward);
+  void write(const QString &text, LogLineStore::Style style);
+  void scheduleFlush();
   
 private:
   LogType m_type;
-  QTextEdit *m_textEdit;
+  LogView *m_logView;
   
   QWidget *m_searchWidget;
   QLineEdit *m_searchInput;
   QPushButton *m_searchCloseButton;
   QString m_lastSearchText;
+  QVector<LogView::Highlight> m_matches;  // For m_lastSearchText, sorted
+  qint64 m_matchesScannedTo;  // Absolute line number the matches run up to
+  QTimer *m_searchTimer;
+  LogView::Highlight m_currentMatch;  // line is -1 until a match is selected
   QShortcut *m_searchShortcut;
   QShortcut *m_findNextShortcut;
   QShortcut *m_findPrevShortcut;
@@ -108,16 +117,13 @@ private:
   bool m_paused;
   QStringList m_pausedBuffer;
   int m_pausedLineCount;
+  QTimer *m_flushTimer;
   QPushButton *m_pauseButton;
-  int m_maxLines;
   int m_fontSize;
   QString m_logFilePath;
-  QFileSystemWatcher *m_fileWatcher;
-  QMutex m_filePositionMutex;  // Protects: m_lastFilePosition, m_lastActivityCheckPosition, m_hasUnreadContent
-  bool m_isWatchingDirectory;
-  qint64 m_lastFilePosition;     // Protected by m_filePositionMutex
-  qint64 m_lastActivityCheckPosition;  // Protected by m_filePositionMutex
-  bool m_hasUnreadContent;       // Protected by m_filePositionMutex
+  QPointer<LogTailer> m_logTailer;
+  int m_tailId;  // 0 when not following a file
+  bool m_hasUnreadContent;
   
 };
 
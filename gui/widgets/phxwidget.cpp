@@ -21,6 +21,7 @@
 #include "tau5devbridge.h"
 #include "StyleManager.h"
 #include "../shared/tau5logger.h"
+#include "../shared/startup_trace.h"
 
 PhxWidget::PhxWidget(bool devMode, QWidget *parent)
     : PhxWidget(devMode, false, parent)
@@ -134,6 +135,7 @@ void PhxWidget::connectToTauPhx(QUrl url)
 
         if (status == "ready") {
           Tau5Logger::instance().info(QString("[PHX] - app page ready (LiveView mounted after %1ms)").arg(pollAttempts * 100));
+          Tau5Common::StartupTrace::instance().end("app.liveview_poll");
           if (!appPageEmitted) {
             emit appPageReady();
             appPageEmitted = true;
@@ -146,6 +148,7 @@ void PhxWidget::connectToTauPhx(QUrl url)
         } else if (pollAttempts >= 50) {
           // Timeout after 5 seconds - emit anyway
           Tau5Logger::instance().warning(QString("[PHX] - app page timeout after 5s (status: %1)").arg(status));
+          Tau5Common::StartupTrace::instance().end("app.liveview_poll");
           if (!appPageEmitted) {
             emit appPageReady();
             appPageEmitted = true;
@@ -161,6 +164,7 @@ void PhxWidget::connectToTauPhx(QUrl url)
         }
       });
     });
+    Tau5Common::StartupTrace::instance().begin("app.liveview_poll");
     appPageTimer->start();
   }
 }
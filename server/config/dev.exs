@@ -11,7 +11,13 @@ port = String.to_integer(System.get_env("TAU5_LOCAL_PORT") || "0")
 
 config :tau5, Tau5Web.Endpoint,
   # Internal endpoint - localhost only with app token required
-  http: [ip: {127, 0, 0, 1}, port: port],
+  # reuseaddr (ThousandIsland's default, made explicit) lets a restarted
+  # BEAM rebind the port the GUI just saw released
+  http: [
+    ip: {127, 0, 0, 1},
+    port: port,
+    thousand_island_options: [transport_options: [reuseaddr: true]]
+  ],
   check_origin: false,
   code_reloader: true,
   debug_errors: true,
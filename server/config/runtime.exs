@@ -208,7 +208,9 @@ if config_env() == :prod do
     http: [
       # Always localhost only
       ip: {127, 0, 0, 1},
-      port: port
+      port: port,
+      # Rebind immediately on restart, matching the GUI's port probe
+      thousand_island_options: [transport_options: [reuseaddr: true]]
     ],
     check_origin: check_origin_config,
     server: true,
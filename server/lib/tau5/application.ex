@@ -2,10 +2,14 @@ defmodule Tau5.Application do
   use Application
   require Logger
 
+  @supervisor_opts [strategy: :one_for_one, name: Tau5.Supervisor]
+
   @impl true
   def start(_type, _args) do
+    Tau5.StartupTrace.record_vm_boot()
+
     if System.get_env("TAU5_USE_STDIN_CONFIG") == "true" do
-      case Tau5.SecureConfig.read_stdin_config() do
+      case Tau5.StartupTrace.span("stdin_config", &Tau5.SecureConfig.read_stdin_config/0) do
         {:ok, secrets} when map_size(secrets) > 0 ->
           Application.put_env(:tau5, :session_token, secrets.session_token)
           Application.put_env(:tau5, :heartbeat_token, secrets.heartbeat_token)
@@ -27,11 +31,6 @@ defmodule Tau5.Application do
       end
     end
 
-    http_port = 0
-
-    public_endpoint_enabled = Application.get_env(:tau5, :public_endpoint_enabled, false)
-    public_port = Application.get_env(:tau5, :public_port, 0)
-
     friend_mode = Application.get_env(:tau5, :friend_mode_enabled, false)
     friend_token = Application.get_env(:tau5, :friend_token)
 
@@ -41,126 +40,26 @@ defmodule Tau5.Application do
       )
     end
 
-    public_endpoint_port =
-      if public_port > 0 or public_endpoint_enabled do
-        case Tau5.PortFinder.configure_endpoint_port(Tau5Web.PublicEndpoint) do
-          {:ok, port} ->
-            Logger.info("PublicEndpoint: Successfully configured on port #{port}")
-            port
-
-          {:error, reason} ->
-            Logger.warning("PublicEndpoint: Could not configure port: #{inspect(reason)}")
-            nil
-        end
-      else
-        nil
-      end
-
-    should_start_public_endpoint = public_endpoint_port != nil
-
-    base_children = [
-      Tau5.ConfigRepo,
-      Tau5.ConfigRepoMigrator,
-      Tau5Web.Telemetry,
-      {Phoenix.PubSub, name: Tau5.PubSub},
-      {Finch, name: Tau5.Finch},
-      Hermes.Server.Registry,
-      {Tau5MCP.Server, transport: :streamable_http}
-    ]
-
-    local_endpoint_children =
-      if System.get_env("TAU5_NO_LOCAL_ENDPOINT") == "true" do
-        Logger.info("Local endpoint disabled via TAU5_NO_LOCAL_ENDPOINT")
-        []
-      else
-        [Tau5Web.Endpoint]
-      end
-
-    public_endpoint_children =
-      if should_start_public_endpoint do
-        [
-          Tau5Web.PublicEndpoint,
-          {Tau5.PublicEndpoint, [enabled: public_endpoint_enabled]}
-        ]
-      else
-        []
-      end
-
-    mcp_endpoint_children =
-      if Application.get_env(:tau5, :mcp_enabled, true) do
-        [Tau5Web.MCPEndpoint]
-      else
-        []
-      end
-
-    heartbeat_children =
-      if heartbeat_enabled?() do
-        [
-          %{
-            id: Tau5.KillSwitch,
-            start: {Tau5.KillSwitch, :start_link, [[]]},
-            restart: :temporary
-          },
-          Tau5.Heartbeat
-        ]
+    # A standby boots everything that doesn't hold a port or device and
+    # starts the rest when promoted
+    children =
+      if Tau5.ControlChannel.standby?() do
+        base_children() ++ control_children()
       else
-        []
+        base_children() ++ endpoint_children() ++ control_children() ++ service_children()
       end
 
-    additional_children =
-      heartbeat_children ++
-        [
-          Tau5.Link,
-          Tau5.MIDI,
-          {Tau5.Discovery, %{http_port: http_port}}
-        ]
-
-    children =
-      base_children ++
-        local_endpoint_children ++
-        public_endpoint_children ++ mcp_endpoint_children ++ additional_children
-
-    opts = [strategy: :one_for_one, name: Tau5.Supervisor]
+    opts = @supervisor_opts
 
-    case Supervisor.start_link(children, opts) do
+    case Tau5.StartupTrace.span("supervisor", fn -> Supervisor.start_link(children, opts) end) do
       {:ok, pid} ->
-        Tau5MCP.ActivityLogger.init()
-
-        if System.get_env("TAU5_TIDEWAVE_ENABLED", "false") in ["1", "true", "yes"] do
-          TidewaveMCP.ActivityLogger.init()
+        if Tau5.ControlChannel.standby?() do
+          Logger.info("Standby server booted, waiting to be promoted")
+          Tau5.ControlChannel.report_standby(String.to_integer(System.pid()))
+        else
+          announce_ready(opts)
         end
 
-        ascii_art =
-          "\n" <>
-            "                           ╘\n" <>
-            "                    ─       ╛▒╛\n" <>
-            "                     ▐╫       ▄█├\n" <>
-            "              ─╟╛      █▄      ╪▓▀\n" <>
-            "    ╓┤┤┤┤┤┤┤┤┤  ╩▌      ██      ▀▓▌\n" <>
-            "     ▐▒   ╬▒     ╟▓╘    ─▓█      ▓▓├\n" <>
-            "     ▒╫   ▒╪      ▓█     ▓▓─     ▓▓▄\n" <>
-            "    ╒▒─  │▒       ▓█     ▓▓     ─▓▓─\n" <>
-            "    ╬▒   ▄▒ ╒    ╪▓═    ╬▓╬     ▌▓▄\n" <>
-            "    ╥╒   ╦╥     ╕█╒    ╙▓▐     ▄▓╫\n" <>
-            "               ▐╩     ▒▒      ▀▀\n" <>
-            "                    ╒╪      ▐▄\n" <>
-            "\n" <>
-            "        ______           ______\n" <>
-            "       /_  __/___  __  _/ ____/\n" <>
-            "        / / / __ `/ / / /___ \\\n" <>
-            "       / / / /_/ / /_/ /___/ /\n" <>
-            "      /_/  \\__,_/\\__,_/_____/\n" <>
-            "\n" <>
-            "        Code. Art. Together.\n\n"
-
-        :ok = :io.put_chars(:standard_io, ascii_art)
-
-        Task.start(fn -> Tau5.StartupInfo.report_server_info() end)
-
-        Logger.info(
-          "[TAU5 SERVER READY] - Elixir OTP supervision tree started with opts: #{inspect(opts)}"
-        )
-
         {:ok, pid}
 
       {:error, {:shutdown, {:failed_to_start_child, child, {:shutdown, {:failed_to_start_child, sub_child, :eaddrinuse}}}}} ->
@@ -215,6 +114,171 @@ defmodule Tau5.Application do
     :ok
   end
 
+  @doc """
+  Starts the endpoints and services a standby server held back, then
+  reports ready exactly as a normal start does.
+  """
+  def promote do
+    Logger.info("Standby server promoted, starting endpoints")
+
+    result =
+      Tau5.StartupTrace.span("promote", fn ->
+        Enum.reduce_while(endpoint_children() ++ service_children(), :ok, fn child, :ok ->
+          case Supervisor.start_child(Tau5.Supervisor, child) do
+            {:ok, _pid} -> {:cont, :ok}
+            {:ok, _pid, _info} -> {:cont, :ok}
+            {:error, reason} -> {:halt, {:error, child, reason}}
+          end
+        end)
+      end)
+
+    case result do
+      :ok ->
+        announce_ready(@supervisor_opts)
+
+      {:error, child, reason} ->
+        child_name = Supervisor.child_spec(child, []).id |> inspect() |> String.replace("Elixir.", "")
+
+        error_message =
+          if inspect(reason) =~ "eaddrinuse", do: "port already in use", else: inspect(reason)
+
+        Tau5.StartupInfo.report_startup_error("#{child_name}: #{error_message}")
+    end
+  end
+
+  defp announce_ready(opts) do
+    Tau5MCP.ActivityLogger.init()
+
+    if System.get_env("TAU5_TIDEWAVE_ENABLED", "false") in ["1", "true", "yes"] do
+      TidewaveMCP.ActivityLogger.init()
+    end
+
+    ascii_art =
+      "\n" <>
+        "                           ╘\n" <>
+        "                    ─       ╛▒╛\n" <>
+        "                     ▐╫       ▄█├\n" <>
+        "              ─╟╛      █▄      ╪▓▀\n" <>
+        "    ╓┤┤┤┤┤┤┤┤┤  ╩▌      ██      ▀▓▌\n" <>
+        "     ▐▒   ╬▒     ╟▓╘    ─▓█      ▓▓├\n" <>
+        "     ▒╫   ▒╪      ▓█     ▓▓─     ▓▓▄\n" <>
+        "    ╒▒─  │▒       ▓█     ▓▓     ─▓▓─\n" <>
+        "    ╬▒   ▄▒ ╒    ╪▓═    ╬▓╬     ▌▓▄\n" <>
+        "    ╥╒   ╦╥     ╕█╒    ╙▓▐     ▄▓╫\n" <>
+        "               ▐╩     ▒▒      ▀▀\n" <>
+        "                    ╒╪      ▐▄\n" <>
+        "\n" <>
+        "        ______           ______\n" <>
+        "       /_  __/___  __  _/ ____/\n" <>
+        "        / / / __ `/ / / /___ \\\n" <>
+        "       / / / /_/ / /_/ /___/ /\n" <>
+        "      /_/  \\__,_/\\__,_/_____/\n" <>
+        "\n" <>
+        "        Code. Art. Together.\n\n"
+
+    :ok = :io.put_chars(:standard_io, ascii_art)
+
+    Task.start(fn -> Tau5.StartupInfo.report_server_info() end)
+
+    Logger.info(
+      "[TAU5 SERVER READY] - Elixir OTP supervision tree started with opts: #{inspect(opts)}"
+    )
+  end
+
+  defp base_children do
+    [
+      Tau5.ConfigRepo,
+      Tau5.ConfigRepoMigrator,
+      Tau5Web.Telemetry,
+      {Phoenix.PubSub, name: Tau5.PubSub},
+      {Finch, name: Tau5.Finch},
+      Hermes.Server.Registry,
+      {Tau5MCP.Server, transport: :streamable_http}
+    ]
+  end
+
+  defp endpoint_children do
+    public_endpoint_enabled = Application.get_env(:tau5, :public_endpoint_enabled, false)
+    public_port = Application.get_env(:tau5, :public_port, 0)
+
+    public_endpoint_port =
+      if public_port > 0 or public_endpoint_enabled do
+        case Tau5.PortFinder.configure_endpoint_port(Tau5Web.PublicEndpoint) do
+          {:ok, port} ->
+            Logger.info("PublicEndpoint: Successfully configured on port #{port}")
+            port
+
+          {:error, reason} ->
+            Logger.warning("PublicEndpoint: Could not configure port: #{inspect(reason)}")
+            nil
+        end
+      else
+        nil
+      end
+
+    should_start_public_endpoint = public_endpoint_port != nil
+
+    local_endpoint_children =
+      if System.get_env("TAU5_NO_LOCAL_ENDPOINT") == "true" do
+        Logger.info("Local endpoint disabled via TAU5_NO_LOCAL_ENDPOINT")
+        []
+      else
+        [Tau5Web.Endpoint]
+      end
+
+    public_endpoint_children =
+      if should_start_public_endpoint do
+        [
+          Tau5Web.PublicEndpoint,
+          {Tau5.PublicEndpoint, [enabled: public_endpoint_enabled]}
+        ]
+      else
+        []
+      end
+
+    mcp_endpoint_children =
+      if Application.get_env(:tau5, :mcp_enabled, true) do
+        [Tau5Web.MCPEndpoint]
+      else
+        []
+      end
+
+    local_endpoint_children ++ public_endpoint_children ++ mcp_endpoint_children
+  end
+
+  # With a control channel, heartbeats arrive over it rather than UDP
+  defp control_children do
+    if Tau5.ControlChannel.enabled?() do
+      [Tau5.ControlChannel]
+    else
+      []
+    end
+  end
+
+  defp service_children do
+    http_port = 0
+
+    heartbeat_children =
+      if heartbeat_enabled?() do
+        [
+          %{
+            id: Tau5.KillSwitch,
+            start: {Tau5.KillSwitch, :start_link, [[]]},
+            restart: :temporary
+          }
+        ] ++ if(Tau5.ControlChannel.enabled?(), do: [], else: [Tau5.Heartbeat])
+      else
+        []
+      end
+
+    heartbeat_children ++
+      [
+        Tau5.Link,
+        Tau5.MIDI,
+        {Tau5.Discovery, %{http_port: http_port}}
+      ]
+  end
+
   defp extract_endpoint_name(child, sub_child) do
     # Try to extract a meaningful name from the nested error structure
     endpoint_name = 
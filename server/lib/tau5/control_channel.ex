@@ -0,0 +1,203 @@
+defmodule Tau5.ControlChannel do
+  @moduledoc """
+  Binary control connection to the GUI/tau5-node process that launched
+  this server (see gui/shared/control_channel.h for the C++ side).
+
+  The launcher listens on localhost and passes the port in
+  TAU5_CONTROL_PORT. We connect with `{packet, 4}` framing, so every frame
+  is a 4-byte big-endian length followed by a 1-byte message type and the
+  payload. The first frame we send is a Hello carrying the heartbeat token.
+
+  This replaces scanning stdout for `[TAU5_SERVER_INFO:...]` markers and
+  the UDP heartbeat: readiness, startup errors and metrics go up the
+  connection, heartbeats come down it, and the connection closing means
+  the launcher has gone.
+
+  A standby server (TAU5_STANDBY=true) boots everything except the
+  endpoints and other port-holding services, reports Standby and waits.
+  When the launcher restarts the active server it sends Promote, and we
+  start the rest of the tree on the ports the old server just released.
+  """
+  use GenServer
+  require Logger
+
+  @hello 1
+  @ready 2
+  @error 3
+  @metrics 4
+  @heartbeat 5
+  @standby 6
+  @promote 7
+  @trace 8
+
+  @connect_timeout 2_000
+  @metrics_interval 5_000
+
+  def start_link(opts) do
+    GenServer.start_link(__MODULE__, opts, name: __MODULE__)
+  end
+
+  @doc """
+  True when the launcher asked for a control connection.
+  """
+  def enabled?, do: control_port() > 0
+
+  @doc """
+  True when this server was started as a hot standby.
+  """
+  def standby?, do: enabled?() and System.get_env("TAU5_STANDBY") == "true"
+
+  @doc """
+  Tells the launcher the standby is booted and can be promoted.
+  """
+  def report_standby(os_pid) do
+    send_frame(@standby, <<os_pid::64>>)
+  end
+
+  @doc """
+  Sends the startup phases recorded by `Tau5.StartupTrace`.
+  """
+  def report_trace do
+    send_frame(@trace, Tau5.StartupTrace.encode())
+  end
+
+  @doc """
+  Tells the launcher the server is ready to serve requests.
+  """
+  def report_ready(os_pid, http_port, mcp_port) do
+    send_frame(@ready, <<os_pid::64, http_port::16, mcp_port::16>>)
+  end
+
+  @doc """
+  Tells the launcher startup failed. Works before the channel process has
+  started (or after it died with the supervision tree) by connecting just
+  for this one message.
+  """
+  def report_error(message) do
+    if Process.whereis(__MODULE__) do
+      send_frame(@error, message)
+    else
+      send_once(@error, message)
+    end
+  end
+
+  def init(_opts) do
+    token =
+      Application.get_env(:tau5, :heartbeat_token) ||
+        System.get_env("TAU5_HEARTBEAT_TOKEN", "")
+
+    case connect(token) do
+      {:ok, socket} ->
+        Logger.info("Control channel connected on port #{control_port()}")
+        Process.send_after(self(), :send_metrics, @metrics_interval)
+        {:ok, %{socket: socket, heartbeats: 0, promoted: false}}
+
+      {:error, reason} ->
+        {:stop, {:control_channel, reason}}
+    end
+  end
+
+  def handle_call({:send, type, payload}, _from, state) do
+    {:reply, :gen_tcp.send(state.socket, [type, payload]), state}
+  end
+
+  def handle_info({:tcp, _socket, <<@heartbeat>>}, state) do
+    Tau5.KillSwitch.reset()
+
+    if state.heartbeats == 0 do
+      Logger.info("First heartbeat received - kill switch reset")
+    end
+
+    {:noreply, %{state | heartbeats: state.heartbeats + 1}}
+  end
+
+  def handle_info({:tcp, _socket, <<@promote>>}, %{promoted: false} = state) do
+    if standby?() do
+      # Starting the endpoints reports back through this process, so it
+      # can't happen inside this call
+      Task.start(fn -> Tau5.Application.promote() end)
+      {:noreply, %{state | promoted: true}}
+    else
+      Logger.warning("Control channel: ignoring promote, not a standby")
+      {:noreply, state}
+    end
+  end
+
+  def handle_info({:tcp, _socket, <<@promote>>}, state) do
+    Logger.warning("Control channel: already promoted")
+    {:noreply, state}
+  end
+
+  def handle_info({:tcp, _socket, <<type, _payload::binary>>}, state) do
+    Logger.warning("Control channel: ignoring message type #{type}")
+    {:noreply, state}
+  end
+
+  def handle_info({:tcp_closed, _socket}, _state) do
+    Logger.error("FATAL: Control channel closed by launcher, shutting down")
+    System.halt(0)
+  end
+
+  def handle_info({:tcp_error, _socket, reason}, _state) do
+    Logger.error("FATAL: Control channel error: #{inspect(reason)}, shutting down")
+    System.halt(0)
+  end
+
+  def handle_info(:send_metrics, state) do
+    {uptime_ms, _} = :erlang.statistics(:wall_clock)
+
+    payload =
+      <<:erlang.memory(:total)::64, :erlang.memory(:processes)::64,
+        :erlang.system_info(:process_count)::32, :erlang.statistics(:total_run_queue_lengths)::32,
+        uptime_ms::64>>
+
+    :gen_tcp.send(state.socket, [@metrics, payload])
+    Process.send_after(self(), :send_metrics, @metrics_interval)
+    {:noreply, state}
+  end
+
+  def handle_info(msg, state) do
+    Logger.warning("Control channel received unexpected message: #{inspect(msg)}")
+    {:noreply, state}
+  end
+
+  defp send_frame(type, payload) do
+    if Process.whereis(__MODULE__) do
+      GenServer.call(__MODULE__, {:send, type, payload})
+    else
+      {:error, :not_connected}
+    end
+  end
+
+  defp send_once(type, payload) do
+    token =
+      Application.get_env(:tau5, :heartbeat_token) ||
+        System.get_env("TAU5_HEARTBEAT_TOKEN", "")
+
+    with true <- enabled?(),
+         {:ok, socket} <- connect(token) do
+      result = :gen_tcp.send(socket, [type, payload])
+      :gen_tcp.shutdown(socket, :write)
+      result
+    else
+      false -> {:error, :disabled}
+      error -> error
+    end
+  end
+
+  defp connect(token) do
+    opts = [:binary, {:packet, 4}, {:active, true}, {:nodelay, true}]
+
+    with {:ok, socket} <- :gen_tcp.connect({127, 0, 0, 1}, control_port(), opts, @connect_timeout),
+         :ok <- :gen_tcp.send(socket, [@hello, token]) do
+      {:ok, socket}
+    end
+  end
+
+  defp control_port do
+    case Integer.parse(System.get_env("TAU5_CONTROL_PORT", "")) do
+      {port, ""} when port > 0 and port <= 65535 -> port
+      _ -> 0
+    end
+  end
+end
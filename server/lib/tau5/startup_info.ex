@@ -12,20 +12,29 @@ defmodule Tau5.StartupInfo do
 
     # Wait for Phoenix to actually be ready to serve requests before signaling GUI
     if http_port > 0 do
-      wait_for_http_ready(http_port)
+      Tau5.StartupTrace.span("http_ready", fn -> wait_for_http_ready(http_port) end)
     end
 
     pid = System.pid()
-    heartbeat_port = Tau5.Heartbeat.get_port()
     mcp_port = get_mcp_port()
 
-    IO.puts(
-      "[TAU5_SERVER_INFO:PID=#{pid},HTTP_PORT=#{http_port},HEARTBEAT_PORT=#{heartbeat_port},MCP_PORT=#{mcp_port}]"
-    )
+    if Tau5.ControlChannel.enabled?() do
+      Tau5.ControlChannel.report_trace()
+      Tau5.ControlChannel.report_ready(String.to_integer(pid), http_port, mcp_port)
+      Logger.info("Server started - PID: #{pid}, HTTP: #{http_port}, MCP: #{mcp_port}")
+    else
+      # Launched without a control channel (e.g. by hand): fall back to
+      # the stdout marker
+      heartbeat_port = Tau5.Heartbeat.get_port()
+
+      IO.puts(
+        "[TAU5_SERVER_INFO:PID=#{pid},HTTP_PORT=#{http_port},HEARTBEAT_PORT=#{heartbeat_port},MCP_PORT=#{mcp_port}]"
+      )
 
-    Logger.info(
-      "Server started - PID: #{pid}, HTTP: #{http_port}, Heartbeat: #{heartbeat_port}, MCP: #{mcp_port}"
-    )
+      Logger.info(
+        "Server started - PID: #{pid}, HTTP: #{http_port}, Heartbeat: #{heartbeat_port}, MCP: #{mcp_port}"
+      )
+    end
   end
 
   defp wait_for_http_ready(port, attempt \\ 1) do
@@ -85,7 +94,12 @@ defmodule Tau5.StartupInfo do
   Reports a startup error to the parent process and then halts.
   """
   def report_startup_error(message) do
-    IO.puts("[TAU5_SERVER_ERROR:#{message}]")
+    if Tau5.ControlChannel.enabled?() do
+      Tau5.ControlChannel.report_error(message)
+    else
+      IO.puts("[TAU5_SERVER_ERROR:#{message}]")
+    end
+
     Logger.error("Server startup failed: #{message}")
     System.halt(1)
   end
@@ -0,0 +1,49 @@
+defmodule Tau5.StartupTrace do
+  @moduledoc """
+  Records how long each startup phase took so the launcher can place them
+  on its own startup trace (see gui/shared/startup_trace.h).
+
+  Times are OS wall-clock microseconds, the one clock this VM and the
+  launcher share. Spans are kept in `:persistent_term`, which is fine for
+  the handful written once at boot, and sent up the control channel just
+  before Ready.
+  """
+
+  @key {__MODULE__, :spans}
+
+  @doc """
+  Runs `fun`, recording how long it took under `name`.
+  """
+  def span(name, fun) do
+    start = now()
+    result = fun.()
+    record(name, start, now() - start)
+    result
+  end
+
+  def record(name, start_us, duration_us) do
+    :persistent_term.put(@key, [{name, start_us, duration_us} | :persistent_term.get(@key, [])])
+  end
+
+  @doc """
+  Records the time from the VM starting to now, i.e. emulator and kernel
+  boot plus loading the release, up to the start of our application.
+  """
+  def record_vm_boot do
+    now = now()
+    since_start = System.monotonic_time() - :erlang.system_info(:start_time)
+    boot_us = System.convert_time_unit(since_start, :native, :microsecond)
+    record("vm_boot", now - boot_us, boot_us)
+  end
+
+  @doc """
+  Spans in the control channel's Trace payload format.
+  """
+  def encode do
+    for {name, start_us, duration_us} <- Enum.reverse(:persistent_term.get(@key, [])), into: <<>> do
+      <<byte_size(name)::16, name::binary, start_us::64, duration_us::64>>
+    end
+  end
+
+  defp now, do: System.os_time(:microsecond)
+end